@@ -0,0 +1,82 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "cache/CacheManager.h"
+#include "core/AllocationTracker.h"
+#include "core/ReadResult.h"
+
+namespace opcua2http::bench {
+
+/**
+ * @brief Node ID used for the i-th benchmark node
+ */
+inline std::string nodeId(size_t index) {
+    return "ns=2;s=Bench.Node" + std::to_string(index);
+}
+
+/**
+ * @brief Consecutive benchmark node IDs starting at offset
+ */
+inline std::vector<std::string> nodeIds(size_t count, size_t offset = 0) {
+    std::vector<std::string> ids;
+    ids.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        ids.push_back(nodeId(offset + i));
+    }
+    return ids;
+}
+
+/**
+ * @brief Successful read results for the given nodes, as an OPC UA read would return them
+ */
+inline std::vector<ReadResult> readResults(const std::vector<std::string>& ids, uint64_t timestamp = 1700000000000) {
+    std::vector<ReadResult> results;
+    results.reserve(ids.size());
+    for (size_t i = 0; i < ids.size(); ++i) {
+        results.push_back(ReadResult::createSuccess(ids[i], std::to_string(20.0 + static_cast<double>(i) * 0.5),
+                                                    timestamp));
+    }
+    return results;
+}
+
+/**
+ * @brief Fill the cache with count fresh entries (nodes 0..count-1)
+ */
+inline void populate(CacheManager& cache, size_t count) {
+    cache.updateCacheBatch(readResults(nodeIds(count)));
+}
+
+/**
+ * @brief Reports this thread's heap allocations per iteration as allocs/iter and bytes/iter
+ *
+ * Construct before the benchmark loop; the counters are set on destruction.
+ * Setup done before construction is not counted.
+ */
+class AllocationCounter {
+public:
+    explicit AllocationCounter(benchmark::State& state)
+        : state_(state)
+        , start_(AllocationTracker::thread()) {
+    }
+
+    ~AllocationCounter() {
+        auto used = AllocationTracker::thread() - start_;
+        state_.counters["allocs/iter"] = benchmark::Counter(static_cast<double>(used.allocations),
+                                                            benchmark::Counter::kAvgIterations);
+        state_.counters["bytes/iter"] = benchmark::Counter(static_cast<double>(used.bytes),
+                                                           benchmark::Counter::kAvgIterations);
+    }
+
+    AllocationCounter(const AllocationCounter&) = delete;
+    AllocationCounter& operator=(const AllocationCounter&) = delete;
+
+private:
+    benchmark::State& state_;
+    AllocationTracker::Counts start_;
+};
+
+} // namespace opcua2http::bench
@@ -0,0 +1,458 @@
+#include "LoadGenerator.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <thread>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "ws2_32.lib")
+#else
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#endif
+
+namespace opcua2http::bench {
+
+namespace {
+
+#ifdef _WIN32
+using SocketHandle = SOCKET;
+
+bool initializeSockets() {
+    static const bool initialized = []() {
+        WSADATA wsaData;
+        return WSAStartup(MAKEWORD(2, 2), &wsaData) == 0;
+    }();
+    return initialized;
+}
+
+void closeSocket(SocketHandle sock) {
+    closesocket(sock);
+}
+#else
+using SocketHandle = int;
+
+bool initializeSockets() {
+    return true;
+}
+
+void closeSocket(SocketHandle sock) {
+    ::close(sock);
+}
+#endif
+
+// Case-insensitive search for a header name at the start of a line
+size_t findHeader(const std::string& headers, const char* name) {
+    size_t nameLength = std::strlen(name);
+    size_t pos = 0;
+    while ((pos = headers.find("\r\n", pos)) != std::string::npos) {
+        pos += 2;
+        if (headers.size() - pos < nameLength) {
+            break;
+        }
+        bool match = true;
+        for (size_t i = 0; i < nameLength && match; ++i) {
+            match = std::tolower(static_cast<unsigned char>(headers[pos + i])) ==
+                    std::tolower(static_cast<unsigned char>(name[i]));
+        }
+        if (match) {
+            return pos + nameLength;
+        }
+    }
+    return std::string::npos;
+}
+
+} // namespace
+
+// KeyDistribution
+
+KeyDistribution::KeyDistribution(Type type, size_t keyCount, double zipfExponent)
+    : type_(type)
+    , keyCount_(std::max<size_t>(keyCount, 1)) {
+
+    if (type_ == Type::ZIPF) {
+        cdf_.resize(keyCount_);
+        double total = 0.0;
+        for (size_t rank = 0; rank < keyCount_; ++rank) {
+            total += 1.0 / std::pow(static_cast<double>(rank + 1), zipfExponent);
+            cdf_[rank] = total;
+        }
+        for (auto& value : cdf_) {
+            value /= total;
+        }
+    }
+}
+
+size_t KeyDistribution::sampleOne(std::mt19937_64& rng) const {
+    if (type_ == Type::ZIPF) {
+        double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+        auto it = std::lower_bound(cdf_.begin(), cdf_.end(), u);
+        return std::min(static_cast<size_t>(it - cdf_.begin()), keyCount_ - 1);
+    }
+    return std::uniform_int_distribution<size_t>(0, keyCount_ - 1)(rng);
+}
+
+void KeyDistribution::sample(std::mt19937_64& rng, size_t& cursor, size_t count, std::vector<size_t>& out) const {
+    out.clear();
+    count = std::min(count, keyCount_);
+
+    if (type_ == Type::SWEEP) {
+        for (size_t i = 0; i < count; ++i) {
+            out.push_back(cursor);
+            cursor = (cursor + 1) % keyCount_;
+        }
+        return;
+    }
+
+    // Distinct keys; requests are small next to the key space, so rejection is cheap
+    while (out.size() < count) {
+        size_t key = sampleOne(rng);
+        if (std::find(out.begin(), out.end(), key) == out.end()) {
+            out.push_back(key);
+        }
+    }
+}
+
+std::optional<KeyDistribution::Type> KeyDistribution::parse(const std::string& name) {
+    if (name == "uniform") {
+        return Type::UNIFORM;
+    }
+    if (name == "zipf") {
+        return Type::ZIPF;
+    }
+    if (name == "sweep") {
+        return Type::SWEEP;
+    }
+    return std::nullopt;
+}
+
+const char* KeyDistribution::name(Type type) {
+    switch (type) {
+        case Type::UNIFORM: return "uniform";
+        case Type::ZIPF:    return "zipf";
+        case Type::SWEEP:   return "sweep";
+    }
+    return "unknown";
+}
+
+// HttpConnection
+
+HttpConnection::HttpConnection(std::string host, uint16_t port)
+    : host_(std::move(host))
+    , port_(port) {
+}
+
+HttpConnection::~HttpConnection() {
+    close();
+}
+
+bool HttpConnection::connect() {
+    if (!initializeSockets()) {
+        return false;
+    }
+
+    SocketHandle sock = ::socket(AF_INET, SOCK_STREAM, 0);
+#ifdef _WIN32
+    if (sock == INVALID_SOCKET) {
+        return false;
+    }
+#else
+    if (sock < 0) {
+        return false;
+    }
+#endif
+
+    // Requests are small and latency-bound; don't let Nagle hold them back
+    int noDelay = 1;
+    setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&noDelay), sizeof(noDelay));
+
+    sockaddr_in serverAddr{};
+    serverAddr.sin_family = AF_INET;
+    serverAddr.sin_port = htons(port_);
+    inet_pton(AF_INET, host_.c_str(), &serverAddr.sin_addr);
+
+    if (::connect(sock, reinterpret_cast<sockaddr*>(&serverAddr), sizeof(serverAddr)) < 0) {
+        closeSocket(sock);
+        return false;
+    }
+
+    socket_ = static_cast<std::intptr_t>(sock);
+    buffer_.clear();
+    connects_++;
+    return true;
+}
+
+void HttpConnection::close() {
+    if (socket_ != -1) {
+        closeSocket(static_cast<SocketHandle>(socket_));
+        socket_ = -1;
+    }
+    buffer_.clear();
+}
+
+bool HttpConnection::sendAll(const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        auto n = ::send(static_cast<SocketHandle>(socket_), data.data() + sent,
+                        static_cast<int>(data.size() - sent), 0);
+        if (n <= 0) {
+            return false;
+        }
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool HttpConnection::receiveMore() {
+    char chunk[16384];
+    auto n = ::recv(static_cast<SocketHandle>(socket_), chunk, sizeof(chunk), 0);
+    if (n <= 0) {
+        return false;
+    }
+    buffer_.append(chunk, static_cast<size_t>(n));
+    return true;
+}
+
+bool HttpConnection::readResponse(int& status, std::string& body, bool& keepAlive) {
+    size_t headerEnd;
+    while ((headerEnd = buffer_.find("\r\n\r\n")) == std::string::npos) {
+        if (!receiveMore()) {
+            return false;
+        }
+    }
+
+    // Status line: HTTP/1.1 200 OK
+    size_t space = buffer_.find(' ');
+    if (space == std::string::npos || space > headerEnd) {
+        return false;
+    }
+    status = std::atoi(buffer_.c_str() + space + 1);
+
+    std::string headers = buffer_.substr(0, headerEnd + 2);
+    size_t contentLength = 0;
+    size_t lengthPos = findHeader(headers, "content-length:");
+    if (lengthPos != std::string::npos) {
+        contentLength = static_cast<size_t>(std::strtoull(headers.c_str() + lengthPos, nullptr, 10));
+    }
+
+    keepAlive = true;
+    size_t connectionPos = findHeader(headers, "connection:");
+    if (connectionPos != std::string::npos) {
+        std::string value = headers.substr(connectionPos, headers.find("\r\n", connectionPos) - connectionPos);
+        std::transform(value.begin(), value.end(), value.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        keepAlive = value.find("close") == std::string::npos;
+    }
+
+    size_t bodyStart = headerEnd + 4;
+    while (buffer_.size() - bodyStart < contentLength) {
+        if (!receiveMore()) {
+            return false;
+        }
+    }
+
+    body.assign(buffer_, bodyStart, contentLength);
+    buffer_.erase(0, bodyStart + contentLength);
+    return true;
+}
+
+bool HttpConnection::get(const std::string& target, int& status, std::string& body) {
+    request_.clear();
+    request_.append("GET ").append(target).append(" HTTP/1.1\r\nHost: ")
+            .append(host_).append(":").append(std::to_string(port_))
+            .append("\r\nConnection: keep-alive\r\n\r\n");
+
+    // A kept-alive connection may have been closed since the last request; retry once on a new one
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        bool reused = socket_ != -1;
+        if (!reused && !connect()) {
+            return false;
+        }
+
+        bool keepAlive = true;
+        if (sendAll(request_) && readResponse(status, body, keepAlive)) {
+            if (!keepAlive) {
+                close();
+            }
+            return true;
+        }
+
+        close();
+        if (!reused) {
+            return false;
+        }
+    }
+    return false;
+}
+
+// LoadGenerator
+
+LoadGenerator::LoadGenerator(Options options)
+    : options_(std::move(options)) {
+
+    encodedIds_.reserve(options_.nodeIds.size());
+    for (const auto& nodeId : options_.nodeIds) {
+        encodedIds_.push_back(encodeNodeId(nodeId));
+    }
+}
+
+std::string LoadGenerator::encodeNodeId(const std::string& nodeId) {
+    static const char* hex = "0123456789ABCDEF";
+
+    std::string encoded;
+    encoded.reserve(nodeId.size() + 8);
+    for (char c : nodeId) {
+        auto byte = static_cast<unsigned char>(c);
+        if (std::isalnum(byte) || c == '-' || c == '_' || c == '.' || c == '~' || c == ':') {
+            encoded += c;
+        } else {
+            encoded += '%';
+            encoded += hex[byte >> 4];
+            encoded += hex[byte & 0x0F];
+        }
+    }
+    return encoded;
+}
+
+void LoadGenerator::workerLoop(size_t workerIndex, const KeyDistribution& distribution) {
+    HttpConnection connection(options_.host, options_.port);
+    std::mt19937_64 rng(options_.seed + workerIndex);
+
+    // Sweeping workers start spread over the key space so they don't warm each other's nodes
+    size_t cursor = workerIndex * distribution.getKeyCount() / std::max<size_t>(options_.connections, 1);
+
+    std::vector<size_t> keys;
+    std::string target;
+    std::string body;
+
+    while (!stopRequested_.load(std::memory_order_relaxed)) {
+        distribution.sample(rng, cursor, options_.idsPerRequest, keys);
+
+        target.assign("/iotgateway/read?ids=");
+        for (size_t i = 0; i < keys.size(); ++i) {
+            if (i > 0) {
+                target += ',';
+            }
+            target += encodedIds_[keys[i]];
+        }
+
+        int status = 0;
+        auto start = std::chrono::steady_clock::now();
+        bool ok = connection.get(target, status, body);
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        bool measuring = measuring_.load(std::memory_order_relaxed);
+        if (!ok) {
+            if (measuring) {
+                errors_.fetch_add(1, std::memory_order_relaxed);
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10)); // Don't spin on a refused connection
+            continue;
+        }
+        if (!measuring) {
+            continue;
+        }
+
+        latency_.record(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed));
+        requests_.fetch_add(1, std::memory_order_relaxed);
+        nodesRequested_.fetch_add(keys.size(), std::memory_order_relaxed);
+        if (status < 200 || status >= 300) {
+            non2xx_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    connects_.fetch_add(connection.getConnectCount(), std::memory_order_relaxed);
+}
+
+LoadGenerator::Report LoadGenerator::run() {
+    Report report;
+    if (encodedIds_.empty() || options_.connections == 0) {
+        return report;
+    }
+
+    KeyDistribution distribution(options_.distribution, encodedIds_.size(), options_.zipfExponent);
+
+    stopRequested_ = false;
+    measuring_ = false;
+
+    std::vector<std::thread> workers;
+    workers.reserve(options_.connections);
+    for (size_t i = 0; i < options_.connections; ++i) {
+        workers.emplace_back(&LoadGenerator::workerLoop, this, i, std::cref(distribution));
+    }
+
+    std::this_thread::sleep_for(options_.warmup);
+    measuring_ = true;
+    auto measureStart = std::chrono::steady_clock::now();
+
+    std::this_thread::sleep_for(options_.duration);
+    measuring_ = false;
+    auto measureEnd = std::chrono::steady_clock::now();
+
+    stopRequested_ = true;
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    report.requests = requests_.load();
+    report.errors = errors_.load();
+    report.non2xx = non2xx_.load();
+    report.nodesRequested = nodesRequested_.load();
+    report.connects = connects_.load();
+    report.elapsedSeconds = std::chrono::duration<double>(measureEnd - measureStart).count();
+    report.latency = latency_.snapshot();
+    return report;
+}
+
+// Prometheus text
+
+std::map<std::string, double> parsePrometheusText(const std::string& text) {
+    std::map<std::string, double> series;
+
+    std::istringstream stream(text);
+    std::string line;
+    while (std::getline(stream, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        // The value follows the last space; label values never contain one in our output
+        size_t space = line.rfind(' ');
+        if (space == std::string::npos) {
+            continue;
+        }
+        series[line.substr(0, space)] = std::strtod(line.c_str() + space + 1, nullptr);
+    }
+    return series;
+}
+
+double metricDelta(const std::map<std::string, double>& before,
+                   const std::map<std::string, double>& after,
+                   const std::string& prefix) {
+    double total = 0.0;
+    for (auto it = after.lower_bound(prefix); it != after.end() && it->first.compare(0, prefix.size(), prefix) == 0; ++it) {
+        auto previous = before.find(it->first);
+        total += it->second - (previous != before.end() ? previous->second : 0.0);
+    }
+    return total;
+}
+
+std::map<std::string, double> scrapeMetrics(HttpConnection& connection) {
+    int status = 0;
+    std::string body;
+    if (!connection.get("/metrics", status, body) || status != 200) {
+        return {};
+    }
+    return parsePrometheusText(body);
+}
+
+} // namespace opcua2http::bench
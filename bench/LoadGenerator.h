@@ -0,0 +1,202 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "cache/LatencyHistogram.h"
+
+namespace opcua2http::bench {
+
+/**
+ * @brief Chooses which nodes each load-test request asks for
+ *
+ * UNIFORM spreads requests evenly, ZIPF concentrates them on a hot set (rank
+ * r is requested in proportion to 1/r^s) and SWEEP walks the whole key space
+ * in order so that nearly every read finds a cold cache entry.
+ */
+class KeyDistribution {
+public:
+    enum class Type {
+        UNIFORM,
+        ZIPF,
+        SWEEP
+    };
+
+    /**
+     * @brief Constructor
+     * @param type Distribution type
+     * @param keyCount Number of keys (nodes) to choose from
+     * @param zipfExponent Exponent s of the Zipf distribution (ZIPF only)
+     */
+    KeyDistribution(Type type, size_t keyCount, double zipfExponent = 1.0);
+
+    /**
+     * @brief Choose the keys for one request
+     * @param rng Caller's random generator
+     * @param cursor Caller's position in the key space (SWEEP only)
+     * @param count Number of distinct keys to choose (at most the key count)
+     * @param out Receives the chosen key indices (replaced)
+     */
+    void sample(std::mt19937_64& rng, size_t& cursor, size_t count, std::vector<size_t>& out) const;
+
+    /**
+     * @brief Parse a distribution name ("uniform", "zipf" or "sweep")
+     * @return Type, or nullopt if the name is unknown
+     */
+    static std::optional<Type> parse(const std::string& name);
+
+    /**
+     * @brief Get the name of a distribution type
+     */
+    static const char* name(Type type);
+
+    Type getType() const { return type_; }
+    size_t getKeyCount() const { return keyCount_; }
+
+private:
+    Type type_;
+    size_t keyCount_;
+    std::vector<double> cdf_;      // Cumulative Zipf probabilities by rank (ZIPF only)
+
+    size_t sampleOne(std::mt19937_64& rng) const;
+};
+
+/**
+ * @brief Minimal blocking HTTP/1.1 client that keeps its connection alive
+ *
+ * Only what the load test needs: GET requests against a server that sends a
+ * Content-Length with every response. A connection closed by the server is
+ * reopened transparently on the next request.
+ */
+class HttpConnection {
+public:
+    /**
+     * @brief Constructor; connects lazily on the first request
+     * @param host IPv4 address of the server
+     * @param port Server port
+     */
+    HttpConnection(std::string host, uint16_t port);
+    ~HttpConnection();
+
+    HttpConnection(const HttpConnection&) = delete;
+    HttpConnection& operator=(const HttpConnection&) = delete;
+
+    /**
+     * @brief Send a GET request and read the whole response
+     * @param target Request target (path and query, already URL encoded)
+     * @param status Receives the HTTP status code
+     * @param body Receives the response body
+     * @return True if a complete response was received
+     */
+    bool get(const std::string& target, int& status, std::string& body);
+
+    /**
+     * @brief Get the number of TCP connections opened so far
+     */
+    uint64_t getConnectCount() const { return connects_; }
+
+private:
+    std::string host_;
+    uint16_t port_;
+    std::intptr_t socket_{-1};
+    std::string request_;                 // Reused request buffer
+    std::string buffer_;                  // Received bytes not yet consumed
+    uint64_t connects_{0};
+
+    bool connect();
+    void close();
+    bool sendAll(const std::string& data);
+    bool readResponse(int& status, std::string& body, bool& keepAlive);
+    bool receiveMore();
+};
+
+/**
+ * @brief Closed-loop HTTP load against /iotgateway/read
+ *
+ * Every connection runs on its own thread and issues its next request as soon
+ * as the previous response arrives, so throughput is bounded by the bridge
+ * rather than by a configured request rate.
+ */
+class LoadGenerator {
+public:
+    struct Options {
+        std::string host{"127.0.0.1"};
+        uint16_t port{3000};
+        size_t connections{16};
+        std::chrono::milliseconds warmup{2000};       // Load before measuring starts
+        std::chrono::milliseconds duration{10000};    // Measured load
+        size_t idsPerRequest{10};
+        KeyDistribution::Type distribution{KeyDistribution::Type::ZIPF};
+        double zipfExponent{1.0};
+        uint64_t seed{42};
+        std::vector<std::string> nodeIds;             // Key space, one entry per key
+    };
+
+    struct Report {
+        uint64_t requests{0};                  // Completed requests in the measured window
+        uint64_t errors{0};                    // Requests without a complete response
+        uint64_t non2xx{0};                    // Responses with a status outside 2xx
+        uint64_t nodesRequested{0};            // Node IDs asked for across all requests
+        uint64_t connects{0};                  // TCP connections opened, including warmup
+        double elapsedSeconds{0.0};
+        LatencyHistogram::Snapshot latency;    // Per-request latency, measured window only
+
+        double requestsPerSecond() const {
+            return elapsedSeconds > 0.0 ? static_cast<double>(requests) / elapsedSeconds : 0.0;
+        }
+    };
+
+    explicit LoadGenerator(Options options);
+
+    /**
+     * @brief Run warmup and measured load; blocks for warmup + duration
+     * @return Results of the measured window
+     */
+    Report run();
+
+    /**
+     * @brief URL-encode a node ID for the ids query parameter
+     */
+    static std::string encodeNodeId(const std::string& nodeId);
+
+private:
+    Options options_;
+    std::vector<std::string> encodedIds_;
+    std::atomic<bool> measuring_{false};
+    std::atomic<bool> stopRequested_{false};
+    LatencyHistogram latency_;
+    std::atomic<uint64_t> requests_{0};
+    std::atomic<uint64_t> errors_{0};
+    std::atomic<uint64_t> non2xx_{0};
+    std::atomic<uint64_t> nodesRequested_{0};
+    std::atomic<uint64_t> connects_{0};
+
+    void workerLoop(size_t workerIndex, const KeyDistribution& distribution);
+};
+
+/**
+ * @brief Parse Prometheus text into series name (with labels) -> value
+ *
+ * Used to diff the bridge's /metrics before and after a run.
+ */
+std::map<std::string, double> parsePrometheusText(const std::string& text);
+
+/**
+ * @brief Difference between two scrapes of the series starting with prefix, summed over labels
+ */
+double metricDelta(const std::map<std::string, double>& before,
+                   const std::map<std::string, double>& after,
+                   const std::string& prefix);
+
+/**
+ * @brief Scrape /metrics over a connection; empty if the bridge does not answer
+ */
+std::map<std::string, double> scrapeMetrics(HttpConnection& connection);
+
+} // namespace opcua2http::bench
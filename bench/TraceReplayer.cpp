@@ -0,0 +1,115 @@
+#include "TraceReplayer.h"
+
+#include <algorithm>
+#include <numeric>
+#include <thread>
+
+#include "LoadGenerator.h"
+
+namespace opcua2http::bench {
+
+TraceReplayer::TraceReplayer(Options options, const std::vector<RequestTraceRecord>& records)
+    : options_(std::move(options)) {
+    if (records.empty()) {
+        return;
+    }
+
+    // Concurrent requests can be appended slightly out of timestamp order
+    std::vector<size_t> order(records.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&records](size_t a, size_t b) {
+        return records[a].timestampUs < records[b].timestampUs;
+    });
+
+    uint64_t first = records[order.front()].timestampUs;
+    traceDuration_ = std::chrono::microseconds(records[order.back()].timestampUs - first);
+
+    targets_.reserve(records.size());
+    offsets_.reserve(records.size());
+    nodeCounts_.reserve(records.size());
+    for (size_t index : order) {
+        const auto& record = records[index];
+
+        std::string target = "/iotgateway/read?ids=";
+        for (size_t i = 0; i < record.nodeIds.size(); ++i) {
+            if (i > 0) {
+                target += ',';
+            }
+            target += LoadGenerator::encodeNodeId(record.nodeIds[i]);
+        }
+        targets_.push_back(std::move(target));
+        nodeCounts_.push_back(record.nodeIds.size());
+
+        double offsetUs = options_.speed > 0.0
+            ? static_cast<double>(record.timestampUs - first) / options_.speed
+            : 0.0;
+        offsets_.emplace_back(static_cast<int64_t>(offsetUs * 1000.0));
+    }
+}
+
+void TraceReplayer::workerLoop() {
+    HttpConnection connection(options_.host, options_.port);
+    std::string body;
+    bool paced = options_.speed > 0.0;
+
+    size_t index;
+    while ((index = next_.fetch_add(1, std::memory_order_relaxed)) < targets_.size()) {
+        auto due = start_ + offsets_[index];
+        if (paced) {
+            std::this_thread::sleep_until(due);
+        }
+
+        int status = 0;
+        auto sent = std::chrono::steady_clock::now();
+        bool ok = connection.get(targets_[index], status, body);
+        auto finished = std::chrono::steady_clock::now();
+
+        if (paced && sent - due > LATE_THRESHOLD) {
+            late_.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (!ok) {
+            errors_.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        latency_.record(std::chrono::duration_cast<std::chrono::nanoseconds>(finished - sent));
+        responseTime_.record(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            finished - (paced ? due : sent)));
+        requests_.fetch_add(1, std::memory_order_relaxed);
+        nodesRequested_.fetch_add(nodeCounts_[index], std::memory_order_relaxed);
+        if (status < 200 || status >= 300) {
+            non2xx_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+TraceReplayer::Report TraceReplayer::run() {
+    Report report;
+    if (targets_.empty() || options_.connections == 0) {
+        return report;
+    }
+
+    next_ = 0;
+    start_ = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> workers;
+    workers.reserve(options_.connections);
+    for (size_t i = 0; i < options_.connections; ++i) {
+        workers.emplace_back([this]() { workerLoop(); });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    report.elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+    report.requests = requests_.load();
+    report.errors = errors_.load();
+    report.non2xx = non2xx_.load();
+    report.nodesRequested = nodesRequested_.load();
+    report.late = late_.load();
+    report.latency = latency_.snapshot();
+    report.responseTime = responseTime_.snapshot();
+    return report;
+}
+
+} // namespace opcua2http::bench
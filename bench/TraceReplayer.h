@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "cache/LatencyHistogram.h"
+#include "http/RequestTrace.h"
+
+namespace opcua2http::bench {
+
+/**
+ * @brief Re-issues a recorded request trace against a running bridge
+ *
+ * Requests keep their recorded spacing, scaled by the speed factor, and are
+ * spread over a fixed set of keep-alive connections. When every connection
+ * is busy a request goes out late; response time is measured from when it
+ * was due rather than from when it was sent, so a slow bridge cannot hide
+ * its queueing delay behind a paced client.
+ */
+class TraceReplayer {
+public:
+    struct Options {
+        std::string host{"127.0.0.1"};
+        uint16_t port{3000};
+        size_t connections{16};
+        double speed{1.0};             // 2.0 replays twice as fast; 0 sends back to back
+    };
+
+    struct Report {
+        uint64_t requests{0};                       // Completed requests
+        uint64_t errors{0};                         // Requests without a complete response
+        uint64_t non2xx{0};                         // Responses with a status outside 2xx
+        uint64_t nodesRequested{0};                 // Node IDs asked for across all requests
+        uint64_t late{0};                           // Requests sent more than LATE_THRESHOLD after due
+        double elapsedSeconds{0.0};
+        LatencyHistogram::Snapshot latency;         // Send to response
+        LatencyHistogram::Snapshot responseTime;    // Due to response (equals latency when unpaced)
+
+        double requestsPerSecond() const {
+            return elapsedSeconds > 0.0 ? static_cast<double>(requests) / elapsedSeconds : 0.0;
+        }
+    };
+
+    static constexpr std::chrono::milliseconds LATE_THRESHOLD{10};
+
+    /**
+     * @brief Constructor
+     * @param options Target and pacing
+     * @param records Trace to replay; replayed in timestamp order
+     */
+    TraceReplayer(Options options, const std::vector<RequestTraceRecord>& records);
+
+    /**
+     * @brief Replay the whole trace; blocks until the last response arrives
+     */
+    Report run();
+
+    /**
+     * @brief Get the recorded duration of the trace
+     */
+    std::chrono::microseconds getTraceDuration() const { return traceDuration_; }
+
+private:
+    Options options_;
+    std::vector<std::string> targets_;                  // Request targets in replay order
+    std::vector<std::chrono::nanoseconds> offsets_;     // Due time of each target after the start
+    std::chrono::microseconds traceDuration_{0};
+
+    std::chrono::steady_clock::time_point start_;
+    std::atomic<size_t> next_{0};
+    LatencyHistogram latency_;
+    LatencyHistogram responseTime_;
+    std::atomic<uint64_t> requests_{0};
+    std::atomic<uint64_t> errors_{0};
+    std::atomic<uint64_t> non2xx_{0};
+    std::atomic<uint64_t> nodesRequested_{0};
+    std::atomic<uint64_t> late_{0};
+    std::vector<size_t> nodeCounts_;
+
+    void workerLoop();
+};
+
+} // namespace opcua2http::bench
@@ -0,0 +1,88 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+#include "BenchUtils.h"
+#include "cache/CacheManager.h"
+#include "core/BackgroundUpdater.h"
+#include "opcua/OPCUAClient.h"
+
+using namespace opcua2http;
+
+namespace {
+
+// BackgroundUpdater with the scheduling queue exposed; workers are never started
+class BenchBackgroundUpdater : public BackgroundUpdater {
+public:
+    using BackgroundUpdater::BackgroundUpdater;
+    using BackgroundUpdater::enqueueUpdate;
+    using BackgroundUpdater::getNextUpdate;
+    using BackgroundUpdater::calculateEffectiveDeadline;
+};
+
+// Queue range(0) distinct nodes and drain them in deadline order
+void BM_ScheduleAndDrain(benchmark::State& state) {
+    auto count = static_cast<size_t>(state.range(0));
+    CacheManager cache(60, count * 2);
+    OPCUAClient client;
+    bench::populate(cache, count);
+    auto ids = bench::nodeIds(count);
+
+    for (auto _ : state) {
+        // Drained nodes stay "in flight" in the updater, so each round needs a fresh one
+        state.PauseTiming();
+        auto updater = std::make_unique<BenchBackgroundUpdater>(&cache, &client);
+        updater->setUpdateQueueSize(count);
+        state.ResumeTiming();
+
+        for (const auto& id : ids) {
+            benchmark::DoNotOptimize(updater->enqueueUpdate(id));
+        }
+        for (size_t i = 0; i < count; ++i) {
+            benchmark::DoNotOptimize(updater->getNextUpdate());
+        }
+
+        state.PauseTiming();
+        updater.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ScheduleAndDrain)->Arg(64)->Arg(1024)->Arg(16384);
+
+// Repeat requests for already queued nodes, the common case under load
+void BM_ScheduleRepeatRequests(benchmark::State& state) {
+    auto queued = static_cast<size_t>(state.range(0));
+    CacheManager cache(60, queued * 2);
+    OPCUAClient client;
+    bench::populate(cache, queued);
+    auto ids = bench::nodeIds(queued);
+
+    BenchBackgroundUpdater updater(&cache, &client);
+    updater.setUpdateQueueSize(queued);
+    for (const auto& id : ids) {
+        updater.enqueueUpdate(id);
+    }
+
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(updater.enqueueUpdate(ids[i++ % queued]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ScheduleRepeatRequests)->Arg(64)->Arg(16384);
+
+void BM_CalculateEffectiveDeadline(benchmark::State& state) {
+    auto now = std::chrono::steady_clock::now();
+    double rate = 0.0;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(BenchBackgroundUpdater::calculateEffectiveDeadline(
+            std::chrono::milliseconds(7000), rate, now));
+        rate = rate < 50.0 ? rate + 0.25 : 0.0;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CalculateEffectiveDeadline);
+
+} // namespace
@@ -0,0 +1,122 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+#include "BenchUtils.h"
+#include "cache/CacheManager.h"
+
+using namespace opcua2http;
+
+namespace {
+
+// Shared by all threads of a multi-threaded run; built once per run by Setup
+std::unique_ptr<CacheManager> sharedCache;
+
+void setUpSharedCache(const benchmark::State& state) {
+    auto entries = static_cast<size_t>(state.range(0));
+    sharedCache = std::make_unique<CacheManager>(60, entries * 2);
+    bench::populate(*sharedCache, entries);
+}
+
+void tearDownSharedCache(const benchmark::State&) {
+    sharedCache.reset();
+}
+
+// Lookups spread over the whole cache; each thread starts at a different node
+void BM_CacheGetHit(benchmark::State& state) {
+    auto entries = static_cast<size_t>(state.range(0));
+    auto ids = bench::nodeIds(entries);
+    size_t i = static_cast<size_t>(state.thread_index()) * 7919;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sharedCache->getCachedValueWithStatus(ids[i++ % entries]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CacheGetHit)
+    ->Setup(setUpSharedCache)->Teardown(tearDownSharedCache)
+    ->Arg(100)->Arg(10000)
+    ->ThreadRange(1, 8)->UseRealTime();
+
+void BM_CacheGetMiss(benchmark::State& state) {
+    auto ids = bench::nodeIds(1024, static_cast<size_t>(state.range(0)));
+    size_t i = 0;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sharedCache->getCachedValueWithStatus(ids[i++ % ids.size()]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CacheGetMiss)
+    ->Setup(setUpSharedCache)->Teardown(tearDownSharedCache)
+    ->Arg(10000)
+    ->ThreadRange(1, 8)->UseRealTime();
+
+// Overwrites of existing entries, the steady state of subscription and background updates
+void BM_CacheUpdateExisting(benchmark::State& state) {
+    auto entries = static_cast<size_t>(state.range(0));
+    auto ids = bench::nodeIds(entries);
+    size_t i = static_cast<size_t>(state.thread_index()) * 7919;
+    uint64_t timestamp = 1700000000000;
+
+    for (auto _ : state) {
+        sharedCache->updateCache(ids[i++ % entries], "42.5", "Good", "Good", timestamp++);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CacheUpdateExisting)
+    ->Setup(setUpSharedCache)->Teardown(tearDownSharedCache)
+    ->Arg(100)->Arg(10000)
+    ->ThreadRange(1, 8)->UseRealTime();
+
+// Readers and writers on the same entries: even threads read, odd threads write
+void BM_CacheMixedReadWrite(benchmark::State& state) {
+    auto entries = static_cast<size_t>(state.range(0));
+    auto ids = bench::nodeIds(entries);
+    bool writer = state.thread_index() % 2 == 1;
+    size_t i = static_cast<size_t>(state.thread_index()) * 7919;
+    uint64_t timestamp = 1700000000000;
+
+    for (auto _ : state) {
+        const auto& id = ids[i++ % entries];
+        if (writer) {
+            sharedCache->updateCache(id, "42.5", "Good", "Good", timestamp++);
+        } else {
+            benchmark::DoNotOptimize(sharedCache->getCachedValueWithStatus(id));
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CacheMixedReadWrite)
+    ->Setup(setUpSharedCache)->Teardown(tearDownSharedCache)
+    ->Arg(1000)
+    ->ThreadRange(2, 8)->UseRealTime();
+
+// Batch lookups of range(1) nodes, as a multi-node /iotgateway/read does
+void BM_CacheGetBatch(benchmark::State& state) {
+    auto ids = bench::nodeIds(static_cast<size_t>(state.range(1)));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sharedCache->getCachedValuesWithStatus(ids));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+BENCHMARK(BM_CacheGetBatch)
+    ->Setup(setUpSharedCache)->Teardown(tearDownSharedCache)
+    ->ArgsProduct({{10000}, {1, 10, 100, 1000}})
+    ->ThreadRange(1, 8)->UseRealTime();
+
+void BM_CacheUpdateBatch(benchmark::State& state) {
+    auto results = bench::readResults(bench::nodeIds(static_cast<size_t>(state.range(1))));
+
+    for (auto _ : state) {
+        sharedCache->updateCacheBatch(results);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+BENCHMARK(BM_CacheUpdateBatch)
+    ->Setup(setUpSharedCache)->Teardown(tearDownSharedCache)
+    ->ArgsProduct({{10000}, {1, 10, 100, 1000}})
+    ->ThreadRange(1, 4)->UseRealTime();
+
+} // namespace
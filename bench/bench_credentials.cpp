@@ -0,0 +1,44 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "BenchUtils.h"
+#include "http/CredentialVerifier.h"
+
+using namespace opcua2http;
+
+namespace {
+
+const CredentialVerifier& verifier() {
+    static const CredentialVerifier instance("0123456789abcdef0123456789abcdef", "operator", "s3cret-passw0rd");
+    return instance;
+}
+
+// X-API-Key check on every authenticated request; range(0) selects a matching
+// (1) or wrong (0) key of the same length
+void BM_VerifyAPIKey(benchmark::State& state) {
+    std::string key = state.range(0) ? "0123456789abcdef0123456789abcdef" : "0123456789abcdef0123456789abcdeX";
+    bench::AllocationCounter allocations(state);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(verifier().verifyAPIKey(key));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_VerifyAPIKey)->Arg(1)->Arg(0);
+
+// Authorization header check: scheme match plus one compare against the
+// credentials encoded at startup
+void BM_VerifyBasicAuth(benchmark::State& state) {
+    std::string header = "Basic " + CredentialVerifier::encodeBase64(
+        state.range(0) ? "operator:s3cret-passw0rd" : "operator:s3cret-passw0rX");
+    bench::AllocationCounter allocations(state);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(verifier().verifyAuthorizationHeader(header));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_VerifyBasicAuth)->Arg(1)->Arg(0);
+
+} // namespace
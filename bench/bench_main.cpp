@@ -0,0 +1,48 @@
+#include <benchmark/benchmark.h>
+#include <spdlog/spdlog.h>
+
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+/**
+ * Runs every registered benchmark. Results are shown on the console and, unless
+ * --benchmark_out is given, also written as JSON to opcua2http_bench.json so
+ * runs can be tracked and compared over time (e.g. with Google Benchmark's
+ * tools/compare.py).
+ */
+int main(int argc, char** argv) {
+    std::vector<char*> args(argv, argv + argc);
+
+    bool hasOut = false;
+    for (int i = 1; i < argc; ++i) {
+        hasOut |= std::strncmp(argv[i], "--benchmark_out=", 16) == 0;
+    }
+
+    static char defaultOut[] = "--benchmark_out=opcua2http_bench.json";
+    static char defaultOutFormat[] = "--benchmark_out_format=json";
+    if (!hasOut) {
+        args.push_back(defaultOut);
+        args.push_back(defaultOutFormat);
+    }
+
+    int count = static_cast<int>(args.size());
+    benchmark::Initialize(&count, args.data());
+    if (benchmark::ReportUnrecognizedArguments(count, args.data())) {
+        return 1;
+    }
+
+    // Components log through spdlog and std::cout; keep both out of the results.
+    // The console reporter writes through its own stream on the same buffer.
+    spdlog::set_level(spdlog::level::off);
+    std::ostream reportStream(std::cout.rdbuf());
+    std::cout.setstate(std::ios::badbit);
+
+    benchmark::ConsoleReporter display;
+    display.SetOutputStream(&reportStream);
+    display.SetErrorStream(&std::cerr);
+
+    benchmark::RunSpecifiedBenchmarks(&display);
+    benchmark::Shutdown();
+    return 0;
+}
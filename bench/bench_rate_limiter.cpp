@@ -0,0 +1,55 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "http/RateLimiter.h"
+
+using namespace opcua2http;
+
+namespace {
+
+// Shared by all threads of a multi-threaded run; built once per run by Setup
+std::unique_ptr<RateLimiter> sharedLimiter;
+
+void setUpSharedLimiter(const benchmark::State&) {
+    RateLimiter::Settings settings;
+    settings.requestsPerSecond = 50000.0;
+    settings.maxClients = 10000;
+    sharedLimiter = std::make_unique<RateLimiter>();
+    sharedLimiter->configure(settings);
+}
+
+void tearDownSharedLimiter(const benchmark::State&) {
+    sharedLimiter.reset();
+}
+
+std::vector<std::string> clientAddresses(size_t count) {
+    std::vector<std::string> clients;
+    clients.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        clients.push_back("10." + std::to_string(i / 65536 % 256) + "." +
+                          std::to_string(i / 256 % 256) + "." + std::to_string(i % 256));
+    }
+    return clients;
+}
+
+// Admission check per request, the limiter's share of every read. range(0)
+// clients spread over all threads; 100000 exceeds maxClients, so that run
+// measures the eviction path too. The target is well above 50k requests/s.
+void BM_RateLimiterCheck(benchmark::State& state) {
+    auto clients = clientAddresses(static_cast<size_t>(state.range(0)));
+    size_t i = static_cast<size_t>(state.thread_index()) * 7919;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sharedLimiter->check(clients[i++ % clients.size()]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RateLimiterCheck)
+    ->Setup(setUpSharedLimiter)->Teardown(tearDownSharedLimiter)
+    ->Arg(1)->Arg(1000)->Arg(100000)
+    ->ThreadRange(1, 8)->UseRealTime();
+
+} // namespace
@@ -0,0 +1,227 @@
+#include <benchmark/benchmark.h>
+
+#include <open62541/types.h>
+
+#include <memory>
+#include <string>
+
+#include "BenchUtils.h"
+#include "cache/CacheManager.h"
+#include "core/ReadStrategy.h"
+#include "core/TagGroup.h"
+#include "http/APIHandler.h"
+#include "opcua/OPCUAClient.h"
+
+using namespace opcua2http;
+
+namespace {
+
+// APIHandler with the request parsing helpers exposed; never connected or routed
+class BenchAPIHandler : public APIHandler {
+public:
+    using APIHandler::APIHandler;
+    using APIHandler::parseNodeIds;
+    using APIHandler::validateNodeId;
+    using APIHandler::buildReadResponse;
+    using APIHandler::buildReadResponseBody;
+    using APIHandler::buildCachedReadResponse;
+};
+
+Configuration benchConfig() {
+    Configuration config;
+    config.opcEndpoint = "opc.tcp://localhost:4840";
+    config.serverPort = 3000;
+    return config;
+}
+
+// Components for the read path; the client is never connected, so only cached
+// data is served and no benchmark touches the network
+struct ReadPath {
+    CacheManager cache{60, 20000};
+    OPCUAClient client;
+    ReadStrategy strategy{&cache, &client};
+    BenchAPIHandler handler{&cache, &strategy, &client, benchConfig()};
+};
+
+std::string idsParam(size_t count) {
+    std::string param;
+    for (size_t i = 0; i < count; ++i) {
+        if (i > 0) {
+            param += ',';
+        }
+        param += bench::nodeId(i);
+    }
+    return param;
+}
+
+// Batch plan for range(0) nodes of which range(1) percent are cached
+void BM_CreateBatchPlan(benchmark::State& state) {
+    auto count = static_cast<size_t>(state.range(0));
+    auto cachedPercent = static_cast<size_t>(state.range(1));
+
+    ReadPath path;
+    bench::populate(path.cache, count * cachedPercent / 100);
+    auto ids = bench::nodeIds(count);
+
+    bench::AllocationCounter allocations(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(path.strategy.createBatchPlan(ids));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CreateBatchPlan)->ArgsProduct({{1, 10, 100, 1000}, {100, 50, 0}});
+
+// Full read of range(0) fresh nodes: plan, cache lookups and results; the
+// fresh-hit path whose allocation budget test_read_strategy.cpp enforces
+void BM_ProcessFreshNodes(benchmark::State& state) {
+    auto count = static_cast<size_t>(state.range(0));
+
+    ReadPath path;
+    bench::populate(path.cache, count);
+    auto ids = bench::nodeIds(count);
+
+    bench::AllocationCounter allocations(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(path.strategy.processNodeRequests(ids));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ProcessFreshNodes)->Arg(1)->Arg(10)->Arg(100)->Arg(1000);
+
+// The same fresh read as a tag group: no plan vectors and one cache lookup per
+// member; compare with BM_ProcessFreshNodes plus BM_ParseNodeIds and BM_ValidateNodeId
+void BM_ProcessGroup(benchmark::State& state) {
+    auto count = static_cast<size_t>(state.range(0));
+
+    ReadPath path;
+    bench::populate(path.cache, count);
+    auto ids = bench::nodeIds(count);
+    TagGroup group("bench", ids, path.client.prepareRead(ids));
+
+    bench::AllocationCounter allocations(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(path.strategy.processGroupRequest(group));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ProcessGroup)->Arg(1)->Arg(10)->Arg(100)->Arg(1000);
+
+// A repeated ids list answered from the response cache: key, per-entry version
+// check and nothing else; compare with BM_ProcessFreshNodes plus BM_BuildReadResponseBody
+void BM_ResponseCacheHit(benchmark::State& state) {
+    auto count = static_cast<size_t>(state.range(0));
+
+    ReadPath path;
+    bench::populate(path.cache, count);
+    auto ids = bench::nodeIds(count);
+    ResponseCache responses(&path.cache, 16);
+    auto build = [&path, &ids]() { return path.handler.buildCachedReadResponse(ids); };
+    responses.getOrBuild(ids, build);
+
+    bench::AllocationCounter allocations(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(responses.getOrBuild(ids, build));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ResponseCacheHit)->Arg(1)->Arg(10)->Arg(100)->Arg(1000);
+
+void BM_ParseNodeIds(benchmark::State& state) {
+    ReadPath path;
+    auto param = idsParam(static_cast<size_t>(state.range(0)));
+
+    bench::AllocationCounter allocations(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(path.handler.parseNodeIds(param));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(param.size()));
+}
+BENCHMARK(BM_ParseNodeIds)->Arg(1)->Arg(10)->Arg(100)->Arg(1000);
+
+void BM_ValidateNodeId(benchmark::State& state) {
+    ReadPath path;
+    const std::string ids[] = {
+        "ns=2;s=Bench.Node42",
+        "ns=2;i=1001",
+        "ns=3;g=72962B91-FA75-4AE6-8D28-B404DC7DAF63",
+        "not a node id"
+    };
+    size_t i = 0;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(path.handler.validateNodeId(ids[i++ % 4]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ValidateNodeId);
+
+void BM_BuildReadResponse(benchmark::State& state) {
+    ReadPath path;
+    auto results = bench::readResults(bench::nodeIds(static_cast<size_t>(state.range(0))));
+
+    bench::AllocationCounter allocations(state);
+    for (auto _ : state) {
+        auto json = path.handler.buildReadResponse(results);
+        benchmark::DoNotOptimize(json.dump());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BuildReadResponse)->Arg(1)->Arg(10)->Arg(100)->Arg(1000);
+
+// Fresh hits as the cache hands them out, with each object already serialized
+void BM_BuildReadResponseBody(benchmark::State& state) {
+    ReadPath path;
+    auto results = bench::readResults(bench::nodeIds(static_cast<size_t>(state.range(0))));
+    for (auto& result : results) {
+        result.json = result.serializeJson();
+    }
+
+    bench::AllocationCounter allocations(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(path.handler.buildReadResponseBody(results));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BuildReadResponseBody)->Arg(1)->Arg(10)->Arg(100)->Arg(1000);
+
+void BM_VariantToStringDouble(benchmark::State& state) {
+    UA_Double value = 21.375;
+    UA_Variant variant;
+    UA_Variant_init(&variant);
+    UA_Variant_setScalar(&variant, &value, &UA_TYPES[UA_TYPES_DOUBLE]);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(OPCUAClient::variantToString(variant));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_VariantToStringDouble);
+
+void BM_VariantToStringInt32(benchmark::State& state) {
+    UA_Int32 value = 123456;
+    UA_Variant variant;
+    UA_Variant_init(&variant);
+    UA_Variant_setScalar(&variant, &value, &UA_TYPES[UA_TYPES_INT32]);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(OPCUAClient::variantToString(variant));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_VariantToStringInt32);
+
+void BM_VariantToStringString(benchmark::State& state) {
+    UA_String value = UA_STRING_STATIC("Line 3 / Station 12 / Running");
+    UA_Variant variant;
+    UA_Variant_init(&variant);
+    UA_Variant_setScalar(&variant, &value, &UA_TYPES[UA_TYPES_STRING]);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(OPCUAClient::variantToString(variant));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_VariantToStringString);
+
+} // namespace
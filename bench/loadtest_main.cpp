@@ -0,0 +1,345 @@
+/**
+ * @file loadtest_main.cpp
+ * @brief End-to-end load test: HTTP client -> bridge -> MockOPCUAServer, all in one process
+ *
+ * Starts a mock OPC UA server with a configurable number of variables that
+ * change at a configurable rate, starts the bridge against it, drives
+ * keep-alive HTTP load at /iotgateway/read and reports throughput, latency
+ * percentiles, OPC UA reads and cache hit ratios taken from /metrics.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+#include "LoadGenerator.h"
+#include "common/MockOPCUAServer.h"
+#include "core/OPCUAHTTPBridge.h"
+
+using namespace opcua2http;
+using namespace opcua2http::bench;
+
+namespace {
+
+struct LoadTestOptions {
+    size_t variables{1000};
+    double updatesPerSecond{100.0};     // Value changes per second across all variables
+    bool mixedTypes{false};             // Mixed scalar/array types instead of Doubles only
+    bool stringIds{false};              // String node IDs instead of numeric ones
+    test::ReadFaultInjection faults;    // Injected into the mock server's reads
+    uint16_t opcPort{14840};
+    uint16_t httpPort{18080};
+    bool json{false};
+    LoadGenerator::Options load;
+};
+
+void printUsage(const char* programName) {
+    std::cout << "Usage: " << programName << " [OPTIONS]\n\n";
+    std::cout << "Options:\n";
+    std::cout << "  --variables N           Variables on the mock server (default: 1000)\n";
+    std::cout << "  --update-rate N         Variable value changes per second (default: 100)\n";
+    std::cout << "  --mixed-types           Mixed scalar and array variables instead of Doubles\n";
+    std::cout << "  --string-ids            String node IDs instead of numeric ones\n";
+    std::cout << "  --opc-latency MS        Mock server latency per read request (default: 0)\n";
+    std::cout << "  --opc-jitter MS         Extra random latency up to MS (default: 0)\n";
+    std::cout << "  --opc-failure-rate R    Fraction of variable reads that fail (default: 0)\n";
+    std::cout << "  --connections N         Concurrent keep-alive connections (default: 16)\n";
+    std::cout << "  --ids-per-request N     Node IDs per request (default: 10)\n";
+    std::cout << "  --distribution NAME     zipf, uniform or sweep (default: zipf)\n";
+    std::cout << "  --zipf-exponent S       Zipf skew; higher is hotter (default: 1.0)\n";
+    std::cout << "  --warmup SECONDS        Load before measuring (default: 2)\n";
+    std::cout << "  --duration SECONDS      Measured load (default: 10)\n";
+    std::cout << "  --seed N                Random seed (default: 42)\n";
+    std::cout << "  --opc-port PORT         Mock OPC UA server port (default: 14840)\n";
+    std::cout << "  --http-port PORT        Bridge HTTP port (default: 18080)\n";
+    std::cout << "  --json                  Print the report as JSON\n";
+    std::cout << "  -h, --help              Show this help message and exit\n";
+    std::cout << std::endl;
+}
+
+bool parseArguments(int argc, char* argv[], LoadTestOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> const char* {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument(arg + " requires a value");
+            }
+            return argv[++i];
+        };
+
+        if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            std::exit(0);
+        } else if (arg == "--variables") {
+            options.variables = std::stoul(value());
+        } else if (arg == "--update-rate") {
+            options.updatesPerSecond = std::stod(value());
+        } else if (arg == "--mixed-types") {
+            options.mixedTypes = true;
+        } else if (arg == "--string-ids") {
+            options.stringIds = true;
+        } else if (arg == "--opc-latency") {
+            options.faults.latency = std::chrono::microseconds(static_cast<int64_t>(std::stod(value()) * 1000));
+        } else if (arg == "--opc-jitter") {
+            options.faults.jitter = std::chrono::microseconds(static_cast<int64_t>(std::stod(value()) * 1000));
+        } else if (arg == "--opc-failure-rate") {
+            options.faults.failureRate = std::stod(value());
+        } else if (arg == "--connections") {
+            options.load.connections = std::stoul(value());
+        } else if (arg == "--ids-per-request") {
+            options.load.idsPerRequest = std::stoul(value());
+        } else if (arg == "--distribution") {
+            std::string name = value();
+            auto type = KeyDistribution::parse(name);
+            if (!type) {
+                throw std::invalid_argument("Unknown distribution: " + name);
+            }
+            options.load.distribution = *type;
+        } else if (arg == "--zipf-exponent") {
+            options.load.zipfExponent = std::stod(value());
+        } else if (arg == "--warmup") {
+            options.load.warmup = std::chrono::milliseconds(static_cast<int64_t>(std::stod(value()) * 1000));
+        } else if (arg == "--duration") {
+            options.load.duration = std::chrono::milliseconds(static_cast<int64_t>(std::stod(value()) * 1000));
+        } else if (arg == "--seed") {
+            options.load.seed = std::stoull(value());
+        } else if (arg == "--opc-port") {
+            options.opcPort = static_cast<uint16_t>(std::stoul(value()));
+        } else if (arg == "--http-port") {
+            options.httpPort = static_cast<uint16_t>(std::stoul(value()));
+        } else if (arg == "--json") {
+            options.json = true;
+        } else {
+            throw std::invalid_argument("Unknown option: " + arg);
+        }
+    }
+
+    if (options.variables == 0 || options.load.connections == 0 || options.load.idsPerRequest == 0) {
+        throw std::invalid_argument("--variables, --connections and --ids-per-request must be positive");
+    }
+    return true;
+}
+
+void setEnvironment(const char* name, const std::string& value) {
+#ifdef _WIN32
+    _putenv_s(name, value.c_str());
+#else
+    setenv(name, value.c_str(), 1);
+#endif
+}
+
+void configureBridge(const LoadTestOptions& options) {
+    setEnvironment("OPC_ENDPOINT", "opc.tcp://localhost:" + std::to_string(options.opcPort));
+    setEnvironment("SERVER_PORT", std::to_string(options.httpPort));
+    setEnvironment("LOG_LEVEL", "warn");
+
+    // No authentication, unless the caller configured it for the run
+#ifdef _WIN32
+    _putenv_s("API_KEY", "");
+    _putenv_s("AUTH_USERNAME", "");
+    _putenv_s("AUTH_PASSWORD", "");
+#else
+    unsetenv("API_KEY");
+    unsetenv("AUTH_USERNAME");
+    unsetenv("AUTH_PASSWORD");
+#endif
+}
+
+bool waitForBridge(HttpConnection& connection, std::chrono::milliseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    int status = 0;
+    std::string body;
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (connection.get("/health", status, body) && status == 200) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    return false;
+}
+
+void printReport(std::ostream& out,
+                 const LoadTestOptions& options,
+                 const LoadGenerator::Report& report,
+                 const std::map<std::string, double>& before,
+                 const std::map<std::string, double>& after) {
+    double seconds = report.elapsedSeconds > 0.0 ? report.elapsedSeconds : 1.0;
+    double opcReads = metricDelta(before, after, "opcua2http_opc_read_duration_seconds_count");
+    double hits = metricDelta(before, after, "opcua2http_cache_hits_total");
+    double misses = metricDelta(before, after, "opcua2http_cache_misses_total");
+    double hitRatio = hits + misses > 0.0 ? hits / (hits + misses) : 0.0;
+
+    static constexpr const char* paths[] = {"fresh", "stale", "expired", "miss", "fallback"};
+    std::map<std::string, double> pathCounts;
+    double pathTotal = 0.0;
+    for (const char* path : paths) {
+        double count = metricDelta(before, after,
+                                   std::string("opcua2http_read_path_duration_seconds_count{path=\"") + path + "\"}");
+        pathCounts[path] = count;
+        pathTotal += count;
+    }
+
+    const auto& latency = report.latency;
+
+    if (options.json) {
+        nlohmann::json json = {
+            {"config", {
+                {"variables", options.variables},
+                {"update_rate", options.updatesPerSecond},
+                {"mixed_types", options.mixedTypes},
+                {"string_ids", options.stringIds},
+                {"opc_latency_ms", options.faults.latency.count() / 1000.0},
+                {"opc_jitter_ms", options.faults.jitter.count() / 1000.0},
+                {"opc_failure_rate", options.faults.failureRate},
+                {"connections", options.load.connections},
+                {"ids_per_request", options.load.idsPerRequest},
+                {"distribution", KeyDistribution::name(options.load.distribution)},
+                {"zipf_exponent", options.load.zipfExponent},
+                {"duration_seconds", report.elapsedSeconds}
+            }},
+            {"requests", report.requests},
+            {"requests_per_second", report.requestsPerSecond()},
+            {"errors", report.errors},
+            {"non_2xx", report.non2xx},
+            {"connections_opened", report.connects},
+            {"latency", latency.toJSON()},
+            {"opc_reads", opcReads},
+            {"opc_reads_per_second", opcReads / seconds},
+            {"cache_hits", hits},
+            {"cache_misses", misses},
+            {"cache_hit_ratio", hitRatio}
+        };
+        for (const auto& [path, count] : pathCounts) {
+            json["read_paths"][path] = pathTotal > 0.0 ? count / pathTotal : 0.0;
+        }
+        out << json.dump(2) << std::endl;
+        return;
+    }
+
+    out << std::fixed;
+    out << "Load test: " << options.load.connections << " connections, "
+        << options.load.idsPerRequest << " ids/request, "
+        << KeyDistribution::name(options.load.distribution);
+    if (options.load.distribution == KeyDistribution::Type::ZIPF) {
+        out << "(s=" << std::setprecision(2) << options.load.zipfExponent << ")";
+    }
+    out << " over " << options.variables << " variables, "
+        << std::setprecision(0) << options.updatesPerSecond << " updates/s\n";
+    if (options.faults.latency.count() > 0 || options.faults.jitter.count() > 0 || options.faults.failureRate > 0.0) {
+        out << std::setprecision(1) << "OPC faults:  latency " << options.faults.latency.count() / 1000.0
+            << "ms + jitter " << options.faults.jitter.count() / 1000.0 << "ms, failure rate "
+            << std::setprecision(3) << options.faults.failureRate << "\n";
+    }
+
+    out << "Requests:    " << report.requests << " in " << std::setprecision(1) << report.elapsedSeconds << "s ("
+        << report.requestsPerSecond() << " req/s), "
+        << report.errors << " errors, " << report.non2xx << " non-2xx, "
+        << report.connects << " connections opened\n";
+
+    out << std::setprecision(3)
+        << "Latency ms:  p50 " << latency.percentileMs(50.0)
+        << "  p90 " << latency.percentileMs(90.0)
+        << "  p99 " << latency.percentileMs(99.0)
+        << "  p99.9 " << latency.percentileMs(99.9)
+        << "  max " << latency.maxMs()
+        << "  mean " << latency.meanMs() << "\n";
+
+    out << std::setprecision(1)
+        << "OPC reads:   " << opcReads << " (" << opcReads / seconds << "/s)\n";
+
+    out << std::setprecision(4)
+        << "Cache:       hit ratio " << hitRatio
+        << std::setprecision(0) << " (" << hits << " hits, " << misses << " misses)\n";
+
+    out << "Read paths:  " << std::setprecision(4);
+    for (const char* path : paths) {
+        out << path << " " << (pathTotal > 0.0 ? pathCounts[path] / pathTotal : 0.0) << "  ";
+    }
+    out << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    LoadTestOptions options;
+    try {
+        parseArguments(argc, argv, options);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n\n";
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    // Components log through std::cout; the report goes through its own stream on the same buffer
+    std::ostream report(std::cout.rdbuf());
+    std::cout.setstate(std::ios::badbit);
+    spdlog::set_level(spdlog::level::warn);
+
+    // Mock server with one generated variable per key; values start changing
+    // once the bridge is up so that startup does not count against the rate
+    test::GeneratedVariableSpec spec;
+    spec.count = options.variables;
+    spec.namePrefix = "LoadVar";
+    spec.stringNodeIds = options.stringIds;
+    if (!options.mixedTypes) {
+        spec.types = {test::GeneratedValueType::DOUBLE};
+    }
+
+    test::MockOPCUAServer server(options.opcPort, "http://opcua2http.loadtest");
+    server.setStartupTimeout(10000);
+    server.setVerboseLogging(false);
+    size_t variableSet = server.addGeneratedVariables(spec);
+    if (!server.start()) {
+        std::cerr << "Failed to start mock OPC UA server on port " << options.opcPort << std::endl;
+        return 1;
+    }
+
+    options.load.port = options.httpPort;
+    options.load.nodeIds = server.getGeneratedNodeIds(variableSet);
+
+    configureBridge(options);
+    OPCUAHTTPBridge bridge;
+    if (!bridge.initialize() || !bridge.startAsync()) {
+        std::cerr << "Failed to start the bridge" << std::endl;
+        return 1;
+    }
+    spdlog::set_level(spdlog::level::warn);
+
+    HttpConnection control(options.load.host, options.httpPort);
+    if (!waitForBridge(control, std::chrono::seconds(10))) {
+        std::cerr << "Bridge did not become healthy on port " << options.httpPort << std::endl;
+        bridge.stop();
+        return 1;
+    }
+
+    server.setChangesPerSecond(variableSet, options.updatesPerSecond);
+    server.setReadFaultInjection(options.faults);
+
+    // Warmup traffic is counted by the bridge too, so scrape around the measured window only
+    LoadGenerator generator(options.load);
+    auto warmupEnd = std::chrono::steady_clock::now() + options.load.warmup;
+    std::map<std::string, double> before;
+    std::thread scraper([&]() {
+        std::this_thread::sleep_until(warmupEnd);
+        HttpConnection connection(options.load.host, options.httpPort);
+        before = scrapeMetrics(connection);
+    });
+
+    auto result = generator.run();
+    scraper.join();
+    auto after = scrapeMetrics(control);
+
+    bridge.stop();
+    server.stop();
+
+    printReport(report, options, result, before, after);
+    return result.requests > 0 ? 0 : 1;
+}
@@ -0,0 +1,331 @@
+/**
+ * @file replay_main.cpp
+ * @brief Replays a recorded request trace (REQUEST_TRACE_FILE) against a running bridge
+ *
+ * Re-issues the recorded /iotgateway/read requests at their original pace or
+ * scaled, and reports latency, cache hit ratio and upstream OPC UA reads
+ * taken from /metrics. Reports can be saved as JSON and compared against a
+ * run of another build.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "LoadGenerator.h"
+#include "TraceReplayer.h"
+#include "http/RequestTrace.h"
+
+using namespace opcua2http;
+using namespace opcua2http::bench;
+
+namespace {
+
+struct ReplayOptions {
+    std::string tracePath;
+    std::string label;
+    size_t limit{0};                    // Replay only the first N records (0 = all)
+    bool summaryOnly{false};
+    bool json{false};
+    std::string savePath;
+    std::string comparePath;
+    TraceReplayer::Options replay;
+};
+
+void printUsage(const char* programName) {
+    std::cout << "Usage: " << programName << " --trace FILE [OPTIONS]\n\n";
+    std::cout << "Options:\n";
+    std::cout << "  --trace FILE            Request trace recorded with REQUEST_TRACE_FILE\n";
+    std::cout << "  --host ADDRESS          Bridge address (default: 127.0.0.1)\n";
+    std::cout << "  --port PORT             Bridge port (default: 3000)\n";
+    std::cout << "  --speed X               Replay speed; 0 sends back to back (default: 1)\n";
+    std::cout << "  --connections N         Concurrent keep-alive connections (default: 16)\n";
+    std::cout << "  --limit N               Replay only the first N requests\n";
+    std::cout << "  --label NAME            Name of this run in reports, e.g. the build\n";
+    std::cout << "  --save FILE             Write the report as JSON to FILE\n";
+    std::cout << "  --compare FILE          Compare with a report saved by an earlier run\n";
+    std::cout << "  --summary               Describe the trace without replaying it\n";
+    std::cout << "  --json                  Print the report as JSON\n";
+    std::cout << "  -h, --help              Show this help message and exit\n";
+    std::cout << std::endl;
+}
+
+void parseArguments(int argc, char* argv[], ReplayOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> const char* {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument(arg + " requires a value");
+            }
+            return argv[++i];
+        };
+
+        if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            std::exit(0);
+        } else if (arg == "--trace") {
+            options.tracePath = value();
+        } else if (arg == "--host") {
+            options.replay.host = value();
+        } else if (arg == "--port") {
+            options.replay.port = static_cast<uint16_t>(std::stoul(value()));
+        } else if (arg == "--speed") {
+            options.replay.speed = std::stod(value());
+        } else if (arg == "--connections") {
+            options.replay.connections = std::stoul(value());
+        } else if (arg == "--limit") {
+            options.limit = std::stoul(value());
+        } else if (arg == "--label") {
+            options.label = value();
+        } else if (arg == "--save") {
+            options.savePath = value();
+        } else if (arg == "--compare") {
+            options.comparePath = value();
+        } else if (arg == "--summary") {
+            options.summaryOnly = true;
+        } else if (arg == "--json") {
+            options.json = true;
+        } else {
+            throw std::invalid_argument("Unknown option: " + arg);
+        }
+    }
+
+    if (options.tracePath.empty()) {
+        throw std::invalid_argument("--trace is required");
+    }
+    if (options.replay.connections == 0 || options.replay.speed < 0.0) {
+        throw std::invalid_argument("--connections must be positive and --speed non-negative");
+    }
+}
+
+void printSummary(std::ostream& out, const std::string& path, const std::vector<RequestTraceRecord>& records) {
+    if (records.empty()) {
+        out << path << ": no requests\n";
+        return;
+    }
+
+    auto [first, last] = std::minmax_element(records.begin(), records.end(),
+        [](const auto& a, const auto& b) { return a.timestampUs < b.timestampUs; });
+    double seconds = static_cast<double>(last->timestampUs - first->timestampUs) / 1e6;
+
+    std::map<std::string, uint64_t> clients;
+    std::set<std::string> nodeIds;
+    size_t totalIds = 0;
+    size_t maxIds = 0;
+    for (const auto& record : records) {
+        clients[record.client]++;
+        nodeIds.insert(record.nodeIds.begin(), record.nodeIds.end());
+        totalIds += record.nodeIds.size();
+        maxIds = std::max(maxIds, record.nodeIds.size());
+    }
+
+    out << std::fixed << std::setprecision(1);
+    out << path << ": " << records.size() << " requests over " << seconds << "s";
+    if (seconds > 0.0) {
+        out << " (" << static_cast<double>(records.size()) / seconds << " req/s)";
+    }
+    out << "\n";
+    out << "Node IDs:    " << nodeIds.size() << " distinct, "
+        << static_cast<double>(totalIds) / static_cast<double>(records.size()) << " per request, max " << maxIds << "\n";
+
+    std::vector<std::pair<std::string, uint64_t>> byCount(clients.begin(), clients.end());
+    std::sort(byCount.begin(), byCount.end(), [](const auto& a, const auto& b) { return a.second > b.second; });
+    out << "Clients:     " << clients.size() << " distinct";
+    for (size_t i = 0; i < std::min<size_t>(byCount.size(), 5); ++i) {
+        out << (i == 0 ? "; top: " : ", ") << byCount[i].first << " (" << byCount[i].second << ")";
+    }
+    out << std::endl;
+}
+
+nlohmann::json buildReport(const ReplayOptions& options,
+                           size_t records,
+                           const TraceReplayer::Report& report,
+                           const std::map<std::string, double>& before,
+                           const std::map<std::string, double>& after) {
+    double opcReads = metricDelta(before, after, "opcua2http_opc_read_duration_seconds_count");
+    double hits = metricDelta(before, after, "opcua2http_cache_hits_total");
+    double misses = metricDelta(before, after, "opcua2http_cache_misses_total");
+
+    return {
+        {"label", options.label},
+        {"trace", options.tracePath},
+        {"records", records},
+        {"speed", options.replay.speed},
+        {"connections", options.replay.connections},
+        {"requests", report.requests},
+        {"errors", report.errors},
+        {"non_2xx", report.non2xx},
+        {"late_requests", report.late},
+        {"elapsed_seconds", report.elapsedSeconds},
+        {"requests_per_second", report.requestsPerSecond()},
+        {"latency", report.latency.toJSON()},
+        {"response_time", report.responseTime.toJSON()},
+        {"opc_reads", opcReads},
+        {"opc_reads_per_request", report.requests > 0 ? opcReads / static_cast<double>(report.requests) : 0.0},
+        {"cache_hits", hits},
+        {"cache_misses", misses},
+        {"cache_hit_ratio", hits + misses > 0.0 ? hits / (hits + misses) : 0.0}
+    };
+}
+
+void printReport(std::ostream& out, const nlohmann::json& report) {
+    out << std::fixed;
+    out << "Replay:      " << report["records"].get<size_t>() << " requests from " << report["trace"].get<std::string>()
+        << std::setprecision(2) << " at speed " << report["speed"].get<double>()
+        << " over " << report["connections"].get<size_t>() << " connections";
+    if (!report["label"].get<std::string>().empty()) {
+        out << " [" << report["label"].get<std::string>() << "]";
+    }
+    out << "\n";
+
+    out << std::setprecision(1)
+        << "Requests:    " << report["requests"].get<uint64_t>() << " in " << report["elapsed_seconds"].get<double>()
+        << "s (" << report["requests_per_second"].get<double>() << " req/s), "
+        << report["errors"].get<uint64_t>() << " errors, " << report["non_2xx"].get<uint64_t>() << " non-2xx, "
+        << report["late_requests"].get<uint64_t>() << " sent late\n";
+
+    for (const char* key : {"latency", "response_time"}) {
+        const auto& histogram = report[key];
+        out << std::setprecision(3)
+            << (std::string(key) == "latency" ? "Latency ms:  " : "Response ms: ")
+            << "p50 " << histogram["p50_ms"].get<double>()
+            << "  p90 " << histogram["p90_ms"].get<double>()
+            << "  p99 " << histogram["p99_ms"].get<double>()
+            << "  p99.9 " << histogram["p999_ms"].get<double>()
+            << "  max " << histogram["max_ms"].get<double>() << "\n";
+    }
+
+    out << std::setprecision(1)
+        << "OPC reads:   " << report["opc_reads"].get<double>()
+        << std::setprecision(3) << " (" << report["opc_reads_per_request"].get<double>() << " per request)\n";
+    out << std::setprecision(4)
+        << "Cache:       hit ratio " << report["cache_hit_ratio"].get<double>() << std::endl;
+}
+
+// Side-by-side view of the metrics that matter when comparing builds
+void printComparison(std::ostream& out, const nlohmann::json& baseline, const nlohmann::json& current) {
+    struct Row {
+        const char* name;
+        nlohmann::json::json_pointer pointer;
+    };
+    const Row rows[] = {
+        {"req/s", nlohmann::json::json_pointer("/requests_per_second")},
+        {"latency p50 ms", nlohmann::json::json_pointer("/latency/p50_ms")},
+        {"latency p99 ms", nlohmann::json::json_pointer("/latency/p99_ms")},
+        {"latency p99.9 ms", nlohmann::json::json_pointer("/latency/p999_ms")},
+        {"response p99 ms", nlohmann::json::json_pointer("/response_time/p99_ms")},
+        {"cache hit ratio", nlohmann::json::json_pointer("/cache_hit_ratio")},
+        {"OPC reads", nlohmann::json::json_pointer("/opc_reads")},
+        {"OPC reads/request", nlohmann::json::json_pointer("/opc_reads_per_request")},
+        {"errors", nlohmann::json::json_pointer("/errors")},
+        {"late requests", nlohmann::json::json_pointer("/late_requests")}
+    };
+
+    auto label = [](const nlohmann::json& report, const char* fallback) {
+        std::string name = report.value("label", "");
+        return name.empty() ? std::string(fallback) : name;
+    };
+
+    out << "\n" << std::left << std::setw(20) << "Metric"
+        << std::right << std::setw(14) << label(baseline, "baseline")
+        << std::setw(14) << label(current, "current") << std::setw(10) << "change" << "\n";
+
+    out << std::fixed;
+    for (const auto& row : rows) {
+        if (!baseline.contains(row.pointer) || !current.contains(row.pointer)) {
+            continue;
+        }
+        double before = baseline.at(row.pointer).get<double>();
+        double after = current.at(row.pointer).get<double>();
+
+        out << std::left << std::setw(20) << row.name << std::right << std::setprecision(3)
+            << std::setw(14) << before << std::setw(14) << after;
+        if (before != 0.0) {
+            out << std::setw(9) << std::setprecision(1) << (after - before) / before * 100.0 << "%";
+        }
+        out << "\n";
+    }
+    out << std::flush;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    ReplayOptions options;
+    try {
+        parseArguments(argc, argv, options);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n\n";
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::vector<RequestTraceRecord> records;
+    std::string error;
+    if (!RequestTraceReader::readAll(options.tracePath, records, error)) {
+        std::cerr << "Error: " << error << std::endl;
+        return 1;
+    }
+    if (options.limit > 0 && records.size() > options.limit) {
+        records.resize(options.limit);
+    }
+
+    if (options.summaryOnly) {
+        printSummary(std::cout, options.tracePath, records);
+        return 0;
+    }
+    if (records.empty()) {
+        std::cerr << "Error: " << options.tracePath << " contains no requests" << std::endl;
+        return 1;
+    }
+
+    nlohmann::json baseline;
+    if (!options.comparePath.empty()) {
+        std::ifstream baselineFile(options.comparePath);
+        if (baselineFile) {
+            baseline = nlohmann::json::parse(baselineFile, nullptr, false);
+        }
+        if (!baseline.is_object()) {
+            std::cerr << "Error: cannot read report " << options.comparePath << std::endl;
+            return 1;
+        }
+    }
+
+    TraceReplayer replayer(options.replay, records);
+    HttpConnection control(options.replay.host, options.replay.port);
+    auto before = scrapeMetrics(control);
+    if (before.empty()) {
+        std::cerr << "Warning: no /metrics from " << options.replay.host << ":" << options.replay.port
+                  << "; OPC reads and hit ratio will read as 0" << std::endl;
+    }
+
+    auto result = replayer.run();
+    auto after = scrapeMetrics(control);
+
+    auto report = buildReport(options, records.size(), result, before, after);
+    if (options.json) {
+        std::cout << report.dump(2) << std::endl;
+    } else {
+        printReport(std::cout, report);
+    }
+    if (!baseline.is_null()) {
+        printComparison(std::cout, baseline, report);
+    }
+
+    if (!options.savePath.empty()) {
+        std::ofstream saveFile(options.savePath);
+        saveFile << report.dump(2) << std::endl;
+        if (!saveFile) {
+            std::cerr << "Error: cannot write report " << options.savePath << std::endl;
+            return 1;
+        }
+    }
+    return result.requests > 0 ? 0 : 1;
+}
@@ -6,11 +6,14 @@
 #include <vector>
 #include <chrono>
 #include <shared_mutex>
+#include <mutex>
 #include <atomic>
 #include <cstdint>
 #include <memory>
 #include "core/ReadResult.h"
 #include "cache/CacheMemoryManager.h"
+#include "cache/PerformanceMonitor.h"
+#include "cache/LockProfiler.h"
 
 namespace opcua2http {
 
@@ -32,9 +35,10 @@ public:
         std::string status;                                    // Status code (e.g., "Good", "Bad")
         std::string reason;                                    // Status description
         uint64_t timestamp;                                    // Unix timestamp in milliseconds
-        std::chrono::steady_clock::time_point creationTime;   // Cache entry creation time
+        std::chrono::steady_clock::time_point creationTime;   // Time the current value was stored (drives FRESH/STALE/EXPIRED)
         mutable std::atomic<std::chrono::steady_clock::time_point> lastAccessed; // Last access time (atomic for lock-free updates)
         std::atomic<bool> hasSubscription;                    // Whether this node has an active subscription (atomic)
+        std::shared_ptr<const std::string> json;              // Serialized ReadResult JSON for the current value (rebuilt on each write)
 
         // Custom constructors and assignment operators for atomic members
         CacheEntry() = default;
@@ -47,7 +51,8 @@ public:
             , timestamp(other.timestamp)
             , creationTime(other.creationTime)
             , lastAccessed(other.lastAccessed.load())
-            , hasSubscription(other.hasSubscription.load()) {}
+            , hasSubscription(other.hasSubscription.load())
+            , json(other.json) {}
 
         CacheEntry(CacheEntry&& other) noexcept
             : nodeId(std::move(other.nodeId))
@@ -57,7 +62,8 @@ public:
             , timestamp(other.timestamp)
             , creationTime(other.creationTime)
             , lastAccessed(other.lastAccessed.load())
-            , hasSubscription(other.hasSubscription.load()) {}
+            , hasSubscription(other.hasSubscription.load())
+            , json(std::move(other.json)) {}
 
         CacheEntry& operator=(const CacheEntry& other) {
             if (this != &other) {
@@ -69,6 +75,7 @@ public:
                 creationTime = other.creationTime;
                 lastAccessed.store(other.lastAccessed.load());
                 hasSubscription.store(other.hasSubscription.load());
+                json = other.json;
             }
             return *this;
         }
@@ -83,13 +90,14 @@ public:
                 creationTime = other.creationTime;
                 lastAccessed.store(other.lastAccessed.load());
                 hasSubscription.store(other.hasSubscription.load());
+                json = std::move(other.json);
             }
             return *this;
         }
 
         /**
          * @brief Convert cache entry to ReadResult
-         * @return ReadResult structure for API response
+         * @return ReadResult structure for API response, sharing the serialized JSON
          */
         ReadResult toReadResult() const {
             return ReadResult{
@@ -97,7 +105,8 @@ public:
                 status == "Good",
                 reason,
                 value,
-                timestamp
+                timestamp,
+                json
             };
         }
 
@@ -197,6 +206,15 @@ public:
         CacheStatus status;
     };
 
+    /**
+     * @brief Recently read entry considered for refresh-ahead
+     */
+    struct HotEntry {
+        std::string nodeId;                                   // OPC UA node identifier
+        std::chrono::milliseconds timeUntilStale;             // Time until STALE, negative once STALE
+        std::chrono::steady_clock::time_point lastAccessed;   // Last read of the cached value
+    };
+
     /**
      * @brief Access control levels for cache operations
      */
@@ -248,6 +266,18 @@ public:
      */
     std::vector<CacheResult> getCachedValuesWithStatus(const std::vector<std::string>& nodeIds);
 
+    /**
+     * @brief Check that entries are still FRESH and hold the values a response was built from
+     * @param nodeIds OPC UA node identifiers
+     * @param versions CacheEntry::json of each entry when it was read; every write replaces it
+     * @return True if every entry exists, is FRESH and still holds the same serialized JSON
+     *
+     * A successful check counts as a FRESH hit for every entry, as if each had
+     * been read again.
+     */
+    bool isFreshAndUnchanged(const std::vector<std::string>& nodeIds,
+                             const std::vector<std::shared_ptr<const std::string>>& versions);
+
     /**
      * @brief Update cache with new data (typically from subscription callback)
      * @param nodeId OPC UA node identifier
@@ -326,6 +356,13 @@ public:
      */
     CacheStats getStats() const;
 
+    /**
+     * @brief Get cache counters without taking the cache lock or walking entries
+     * @return CacheStats with entry count and memory as of the last write;
+     *         subscribedEntries and lastCleanup are not filled in
+     */
+    CacheStats getCounters() const;
+
     /**
      * @brief Clear all cache entries
      */
@@ -404,6 +441,20 @@ public:
      */
     uint64_t getExpiredReads() const;
 
+    /**
+     * @brief Get time remaining until a cache entry becomes EXPIRED
+     * @param nodeId OPC UA node identifier
+     * @return Remaining time, zero if the entry is missing or already expired
+     */
+    std::chrono::milliseconds getTimeUntilExpiry(const std::string& nodeId) const;
+
+    /**
+     * @brief Get unsubscribed, unexpired entries read since their value was stored
+     * @param hotWindow Only entries read within this window are returned
+     * @return Hot entries in no particular order
+     */
+    std::vector<HotEntry> getHotEntries(std::chrono::milliseconds hotWindow) const;
+
     /**
      * @brief Set cache access level for operations
      * @param level Access level to set
@@ -446,10 +497,24 @@ public:
      */
     void setCleanupInterval(std::chrono::seconds interval);
 
+    /**
+     * @brief Set the monitor that times cache operations and cacheMutex_ waits
+     * @param monitor Performance monitor (optional, may be null; set before use)
+     */
+    void setPerformanceMonitor(PerformanceMonitor* monitor);
+
+    /**
+     * @brief Set the profiler that records cacheMutex_ wait and hold times per call site
+     * @param profiler Lock profiler (optional, may be null; set before use)
+     */
+    void setLockProfiler(LockProfiler* profiler);
+
 private:
     // Cache storage
     mutable std::shared_mutex cacheMutex_;                    // Reader-writer lock for thread safety
     std::unordered_map<std::string, CacheEntry> cache_;      // Main cache storage
+    PerformanceMonitor* performanceMonitor_{nullptr};        // Operation and lock timing (optional)
+    LockProfiler* lockProfiler_{nullptr};                    // Lock wait/hold profiling (optional)
 
     // Memory management
     std::unique_ptr<CacheMemoryManager> memoryManager_;      // Memory manager for LRU eviction
@@ -539,6 +604,22 @@ private:
      * @brief Record cache miss statistics (lock-free)
      */
     void recordCacheMiss() const;
+
+    /**
+     * @brief Acquire cacheMutex_ shared, recording contention
+     * @param site Acquiring call site, for the lock profiler
+     * @return Held shared lock
+     */
+    ProfiledLock<std::shared_lock<std::shared_mutex>> readLock(
+        std::source_location site = std::source_location::current()) const;
+
+    /**
+     * @brief Acquire cacheMutex_ exclusively, recording contention
+     * @param site Acquiring call site, for the lock profiler
+     * @return Held exclusive lock
+     */
+    ProfiledLock<std::unique_lock<std::shared_mutex>> writeLock(
+        std::source_location site = std::source_location::current()) const;
 };
 
 } // namespace opcua2http
@@ -1,10 +1,12 @@
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <mutex>
 #include <nlohmann/json.hpp>
 #include "cache/CacheStatistics.h"
+#include "cache/LatencyHistogram.h"
 
 namespace opcua2http {
 
@@ -17,11 +19,26 @@ class BackgroundUpdater;
  *
  * This class provides thread-safe methods for recording cache operations
  * and generating comprehensive statistics for monitoring and API endpoints.
+ * Each read path also keeps a latency histogram, so tail latencies are
+ * reported next to the averages.
  *
  * Requirements: 6.1, 6.2, 6.3, 6.4
  */
 class CacheMetrics {
 public:
+    /**
+     * @brief Read paths with their own latency histogram
+     */
+    enum class ReadPath {
+        FRESH,      // Served from fresh cache
+        STALE,      // Served from stale cache, refreshed in the background
+        EXPIRED,    // Expired entry read synchronously from the server
+        MISS,       // Uncached node read synchronously from the server
+        FALLBACK    // Server read failed, answered from cache
+    };
+
+    static constexpr size_t READ_PATH_COUNT = 5;
+
     /**
      * @brief Constructor
      * @param cacheManager Pointer to cache manager for accessing cache state
@@ -73,6 +90,26 @@ public:
      */
     void recordFreshHit(const std::string& nodeId, double responseTimeMs = 0.0);
 
+    /**
+     * @brief Record how long a request spent on one read path
+     * @param path Read path
+     * @param latency Time from the start of the path to its results
+     */
+    void recordPathLatency(ReadPath path, std::chrono::nanoseconds latency);
+
+    /**
+     * @brief Get the latency distribution of a read path
+     * @param path Read path
+     * @return Histogram snapshot
+     */
+    LatencyHistogram::Snapshot getPathLatency(ReadPath path) const;
+
+    /**
+     * @brief Get path latency percentiles as JSON
+     * @return JSON object keyed by path name
+     */
+    nlohmann::json getLatencyJSON() const;
+
     /**
      * @brief Record a batch operation
      * @param batchSize Number of items in the batch
@@ -144,31 +181,40 @@ private:
     mutable std::atomic<uint64_t> totalCleanups_{0};
     mutable std::atomic<uint64_t> entriesRemoved_{0};
 
-    // Timing metrics (protected by mutex for complex updates)
-    mutable std::mutex timingMutex_;
-    double totalResponseTime_{0.0};
-    double totalHitResponseTime_{0.0};
-    double totalMissResponseTime_{0.0};
-    double totalFreshHitResponseTime_{0.0};
-    double totalStaleHitResponseTime_{0.0};
-    double totalExpiredReadResponseTime_{0.0};
-    uint64_t hitResponseCount_{0};
-    uint64_t missResponseCount_{0};
-    uint64_t freshHitResponseCount_{0};
-    uint64_t staleHitResponseCount_{0};
-    uint64_t expiredReadResponseCount_{0};
+    // Timing metrics (integer nanosecond totals so concurrent adds never race)
+    mutable std::atomic<uint64_t> totalHitResponseTimeNs_{0};
+    mutable std::atomic<uint64_t> totalMissResponseTimeNs_{0};
+    mutable std::atomic<uint64_t> totalFreshHitResponseTimeNs_{0};
+    mutable std::atomic<uint64_t> totalStaleHitResponseTimeNs_{0};
+    mutable std::atomic<uint64_t> totalExpiredReadResponseTimeNs_{0};
+    mutable std::atomic<uint64_t> hitResponseCount_{0};
+    mutable std::atomic<uint64_t> missResponseCount_{0};
+    mutable std::atomic<uint64_t> freshHitResponseCount_{0};
+    mutable std::atomic<uint64_t> staleHitResponseCount_{0};
+    mutable std::atomic<uint64_t> expiredReadResponseCount_{0};
+
+    // Latency distribution per read path
+    std::array<LatencyHistogram, READ_PATH_COUNT> pathLatency_;
 
     // Timestamps
     std::chrono::steady_clock::time_point creationTime_;
     mutable std::atomic<std::chrono::steady_clock::time_point> lastUpdate_;
 
     /**
-     * @brief Update average response time for a category
-     * @param totalTime Reference to total time accumulator
-     * @param count Reference to count accumulator
-     * @param newTime New response time to add
+     * @brief Add a response time to a category
+     * @param totalTimeNs Total time accumulator in nanoseconds
+     * @param count Count accumulator
+     * @param newTime New response time to add in milliseconds
+     */
+    void updateAverageTime(std::atomic<uint64_t>& totalTimeNs, std::atomic<uint64_t>& count, double newTime);
+
+    /**
+     * @brief Average of a category in milliseconds
+     * @param totalTimeNs Total time accumulator in nanoseconds
+     * @param count Count accumulator
+     * @return Average response time in milliseconds (0 if empty)
      */
-    void updateAverageTime(double& totalTime, uint64_t& count, double newTime);
+    static double averageTime(const std::atomic<uint64_t>& totalTimeNs, const std::atomic<uint64_t>& count);
 
     /**
      * @brief Get cache health metrics from cache manager
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <nlohmann/json.hpp>
+
+namespace opcua2http {
+
+/**
+ * @brief Lock-free log-linear latency histogram (HDR-style)
+ *
+ * Values are recorded in nanoseconds. Below 2^SUB_BUCKET_BITS each value has
+ * its own bucket; above, every power of two is split into 2^SUB_BUCKET_BITS
+ * equal buckets, so a bucket is never wider than 1/16 of the values it holds
+ * and percentiles are reported within about 6%. Values above 2^MAX_MAGNITUDE
+ * (about 18 minutes) land in the last bucket.
+ *
+ * Each thread records into one of STRIPES cache-line aligned bucket arrays
+ * with relaxed fetch_add, so concurrent recorders rarely share a line.
+ * snapshot() merges the stripes; snapshots of different histograms merge the
+ * same way, e.g. to combine paths.
+ */
+class LatencyHistogram {
+public:
+    static constexpr unsigned SUB_BUCKET_BITS = 4;
+    static constexpr unsigned MAX_MAGNITUDE = 40;
+    static constexpr size_t SUB_BUCKETS = size_t{1} << SUB_BUCKET_BITS;
+    static constexpr size_t BUCKET_COUNT = SUB_BUCKETS * (MAX_MAGNITUDE - SUB_BUCKET_BITS + 2);
+    static constexpr uint64_t MAX_VALUE = (uint64_t{1} << (MAX_MAGNITUDE + 1)) - 1;
+    static constexpr size_t STRIPES = 4;
+
+    /**
+     * @brief Plain copy of a histogram for reporting and merging
+     */
+    struct Snapshot {
+        std::array<uint64_t, BUCKET_COUNT> buckets{};   // Samples per bucket
+        uint64_t count{0};                              // Total samples
+        uint64_t totalNanos{0};                         // Sum of recorded values
+        uint64_t maxNanos{0};                           // Largest recorded value
+
+        /**
+         * @brief Add another snapshot's samples to this one
+         * @param other Snapshot to merge
+         */
+        void merge(const Snapshot& other);
+
+        /**
+         * @brief Value at a percentile
+         * @param percentile Percentile from 0 to 100 (e.g. 99.9)
+         * @return Upper bound of the bucket holding that rank in ms (0 if empty)
+         */
+        double percentileMs(double percentile) const;
+
+        /**
+         * @brief Mean of the recorded values
+         * @return Mean in ms (0 if empty)
+         */
+        double meanMs() const;
+
+        /**
+         * @brief Largest recorded value
+         * @return Maximum in ms
+         */
+        double maxMs() const;
+
+        /**
+         * @brief Summary for API endpoints
+         * @return JSON with count, mean, p50, p90, p99, p999 and max in ms
+         */
+        nlohmann::json toJSON() const;
+    };
+
+    LatencyHistogram() = default;
+
+    // Disable copy constructor and assignment operator
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    /**
+     * @brief Record one latency sample
+     * @param latency Measured latency (negative values count as 0)
+     */
+    void record(std::chrono::nanoseconds latency) {
+        uint64_t nanos = latency.count() > 0 ? static_cast<uint64_t>(latency.count()) : 0;
+        Stripe& stripe = stripes_[threadStripe()];
+
+        stripe.buckets[bucketIndex(nanos)].fetch_add(1, std::memory_order_relaxed);
+        stripe.totalNanos.fetch_add(nanos, std::memory_order_relaxed);
+
+        uint64_t max = stripe.maxNanos.load(std::memory_order_relaxed);
+        while (nanos > max &&
+               !stripe.maxNanos.compare_exchange_weak(max, nanos, std::memory_order_relaxed)) {
+        }
+    }
+
+    /**
+     * @brief Record one latency sample given in milliseconds
+     * @param latencyMs Measured latency in milliseconds
+     */
+    void recordMs(double latencyMs) {
+        record(std::chrono::nanoseconds(static_cast<int64_t>(latencyMs * 1e6)));
+    }
+
+    /**
+     * @brief Merge all stripes into a snapshot
+     * @return Current contents
+     */
+    Snapshot snapshot() const;
+
+    /**
+     * @brief Clear all samples
+     */
+    void reset();
+
+    /**
+     * @brief Bucket that holds a value
+     * @param nanos Value in nanoseconds
+     * @return Bucket index
+     */
+    static constexpr size_t bucketIndex(uint64_t nanos) {
+        if (nanos > MAX_VALUE) {
+            nanos = MAX_VALUE;
+        }
+        if (nanos < SUB_BUCKETS) {
+            return static_cast<size_t>(nanos);
+        }
+        unsigned shift = static_cast<unsigned>(std::bit_width(nanos)) - 1 - SUB_BUCKET_BITS;
+        return SUB_BUCKETS * (shift + 1) + static_cast<size_t>((nanos >> shift) - SUB_BUCKETS);
+    }
+
+    /**
+     * @brief Largest value a bucket holds
+     * @param index Bucket index
+     * @return Upper bound in nanoseconds
+     */
+    static constexpr uint64_t bucketUpperBound(size_t index) {
+        if (index < SUB_BUCKETS) {
+            return index;
+        }
+        unsigned shift = static_cast<unsigned>(index / SUB_BUCKETS) - 1;
+        uint64_t lower = static_cast<uint64_t>(SUB_BUCKETS + index % SUB_BUCKETS) << shift;
+        return lower + (uint64_t{1} << shift) - 1;
+    }
+
+private:
+    struct alignas(64) Stripe {
+        std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets{};
+        std::atomic<uint64_t> totalNanos{0};
+        std::atomic<uint64_t> maxNanos{0};
+    };
+
+    std::array<Stripe, STRIPES> stripes_;
+
+    /**
+     * @brief Stripe of the calling thread, assigned round-robin on first use
+     * @return Stripe index
+     */
+    static size_t threadStripe() {
+        static std::atomic<size_t> nextStripe{0};
+        thread_local size_t stripe = nextStripe.fetch_add(1, std::memory_order_relaxed) % STRIPES;
+        return stripe;
+    }
+};
+
+} // namespace opcua2http
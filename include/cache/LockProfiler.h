@@ -0,0 +1,323 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <source_location>
+#include <string>
+#include <utility>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+#include "cache/LatencyHistogram.h"
+#include "cache/PerformanceMonitor.h"
+
+namespace opcua2http {
+
+template <typename Lock>
+class ProfiledLock;
+
+/**
+ * @brief Contention profiler for the bridge's major mutexes
+ *
+ * Components that own a profiled mutex take it through LockProfiler::acquire,
+ * which returns a ProfiledLock. With a profiler set, every acquisition records
+ * its wait into the lock's wait histogram and, on release, its hold time into
+ * the hold histogram; both are also attributed to the acquiring call site,
+ * taken from std::source_location. Without a profiler the mutex is locked as
+ * before and the guard is a plain lock.
+ *
+ * Uncontended acquisitions try the lock first and record a wait of zero, so
+ * the wait percentiles are over all acquisitions and a convoy shows up as a
+ * long tail. Profiling reads the clock two or three times per acquisition;
+ * it is meant to be switched on (LOCK_PROFILING_ENABLED) while investigating.
+ *
+ * Call sites live in a fixed open-addressed table. Lookups are lock-free;
+ * a new site is added under a mutex once. Sites beyond the table's capacity
+ * are pooled into one "(other)" entry.
+ */
+class LockProfiler {
+public:
+    /**
+     * @brief Profiled mutexes
+     */
+    enum class LockId {
+        CACHE_MUTEX,            // CacheManager::cacheMutex_
+        CLIENT_MUTEX,           // OPCUAClient::clientMutex_
+        SUBSCRIPTION_MUTEX      // SubscriptionManager::subscriptionMutex_
+    };
+
+    static constexpr size_t LOCK_COUNT = 3;
+    static constexpr size_t CALL_SITE_SLOTS = 256;
+    static constexpr size_t DEFAULT_TOP_CALL_SITES = 20;
+
+    /**
+     * @brief Statistics of one lock
+     */
+    struct LockReport {
+        uint64_t acquisitions{0};               // Total acquisitions
+        uint64_t contentions{0};                // Acquisitions that had to wait
+        LatencyHistogram::Snapshot wait;        // Wait per acquisition (0 when uncontended)
+        LatencyHistogram::Snapshot hold;        // Time held per acquisition
+    };
+
+    /**
+     * @brief Statistics of one call site acquiring one lock
+     */
+    struct CallSiteReport {
+        LockId lock{LockId::CACHE_MUTEX};
+        std::string function;                   // Acquiring function
+        std::string file;                       // Source file, relative to src/ or include/ when possible
+        uint32_t line{0};
+        uint64_t acquisitions{0};
+        uint64_t contentions{0};
+        double totalWaitMs{0.0};
+        double maxWaitMs{0.0};
+        double totalHoldMs{0.0};
+        double maxHoldMs{0.0};
+    };
+
+    LockProfiler();
+
+    // Disable copy constructor and assignment operator
+    LockProfiler(const LockProfiler&) = delete;
+    LockProfiler& operator=(const LockProfiler&) = delete;
+
+    /**
+     * @brief Acquire a lock, profiling it if a profiler is set
+     * @param profiler Profiler to record to (may be null)
+     * @param id Lock being acquired
+     * @param lock Unlocked std::unique_lock or std::shared_lock
+     * @param site Acquiring call site
+     * @return Guard owning the locked lock
+     */
+    template <typename Lock>
+    static ProfiledLock<Lock> acquire(LockProfiler* profiler, LockId id, Lock lock,
+                                      std::source_location site) {
+        if (!profiler) {
+            lock.lock();
+            return ProfiledLock<Lock>(std::move(lock));
+        }
+        auto wait = timedLock(lock);
+        return profiler->adopt(id, std::move(lock), wait, site);
+    }
+
+    /**
+     * @brief Acquire a lock, recording to the PerformanceMonitor lock counters as well
+     * @param profiler Profiler to record to (may be null)
+     * @param id Lock being acquired
+     * @param lock Unlocked std::unique_lock or std::shared_lock
+     * @param monitor Monitor whose lock counters to update (may be null)
+     * @param type Monitor lock type
+     * @param site Acquiring call site
+     * @return Guard owning the locked lock
+     */
+    template <typename Lock>
+    static ProfiledLock<Lock> acquire(LockProfiler* profiler, LockId id, Lock lock,
+                                      PerformanceMonitor* monitor, PerformanceMonitor::LockType type,
+                                      std::source_location site) {
+        if (!profiler) {
+            PerformanceMonitor::acquireLock(monitor, type, lock);
+            return ProfiledLock<Lock>(std::move(lock));
+        }
+
+        auto wait = timedLock(lock);
+        if (monitor) {
+            if (wait) {
+                monitor->recordLockWait(type, *wait);
+            } else {
+                monitor->recordLockAcquisition(type);
+            }
+        }
+        return profiler->adopt(id, std::move(lock), wait, site);
+    }
+
+    /**
+     * @brief Wrap a lock the caller acquired itself (e.g. with a deadline)
+     * @param profiler Profiler to record to (may be null)
+     * @param id Lock that was acquired
+     * @param lock Locked lock
+     * @param wait Time spent waiting, or nullopt if the first try succeeded
+     * @param site Acquiring call site
+     * @return Guard owning the lock
+     */
+    template <typename Lock>
+    static ProfiledLock<Lock> adopt(LockProfiler* profiler, LockId id, Lock lock,
+                                    std::optional<std::chrono::nanoseconds> wait,
+                                    std::source_location site) {
+        if (!profiler) {
+            return ProfiledLock<Lock>(std::move(lock));
+        }
+        return profiler->adopt(id, std::move(lock), wait, site);
+    }
+
+    /**
+     * @brief Get the statistics of one lock
+     * @param id Lock
+     * @return Acquisition counts and histogram snapshots
+     */
+    LockReport getLockReport(LockId id) const;
+
+    /**
+     * @brief Get the call sites that waited longest
+     * @param limit Maximum number of sites
+     * @return Sites sorted by total wait, longest first
+     */
+    std::vector<CallSiteReport> getTopCallSites(size_t limit = DEFAULT_TOP_CALL_SITES) const;
+
+    /**
+     * @brief Build the /debug/locks report
+     * @param limit Maximum number of call sites
+     * @return JSON with per-lock histograms and the top call sites by wait
+     */
+    nlohmann::json toJSON(size_t limit = DEFAULT_TOP_CALL_SITES) const;
+
+    /**
+     * @brief Clear all statistics; known call sites keep their slots
+     */
+    void reset();
+
+    /**
+     * @brief Get the report name of a lock
+     * @param id Lock
+     * @return e.g. "cache_mutex"
+     */
+    static const char* lockName(LockId id);
+
+private:
+    template <typename Lock>
+    friend class ProfiledLock;
+
+    struct LockStats {
+        std::atomic<uint64_t> acquisitions{0};
+        std::atomic<uint64_t> contentions{0};
+        LatencyHistogram wait;
+        LatencyHistogram hold;
+    };
+
+    // Identity fields are written once before key is published and never change
+    struct CallSite {
+        std::atomic<uint64_t> key{0};           // 0 = free
+        LockId lock{LockId::CACHE_MUTEX};
+        const char* file{nullptr};
+        const char* function{nullptr};
+        uint32_t line{0};
+
+        std::atomic<uint64_t> acquisitions{0};
+        std::atomic<uint64_t> contentions{0};
+        std::atomic<uint64_t> waitNanos{0};
+        std::atomic<uint64_t> maxWaitNanos{0};
+        std::atomic<uint64_t> holdNanos{0};
+        std::atomic<uint64_t> maxHoldNanos{0};
+    };
+
+    std::array<LockStats, LOCK_COUNT> locks_;
+    std::array<CallSite, CALL_SITE_SLOTS> sites_;
+    CallSite otherSites_;                       // Sites that found the table full
+    std::mutex siteInsertMutex_;
+
+    /**
+     * @brief Lock, timing the wait only if the first try fails
+     * @return Wait time, or nullopt if uncontended
+     */
+    template <typename Lock>
+    static std::optional<std::chrono::nanoseconds> timedLock(Lock& lock) {
+        if (lock.try_lock()) {
+            return std::nullopt;
+        }
+        auto start = std::chrono::steady_clock::now();
+        lock.lock();
+        return std::chrono::steady_clock::now() - start;
+    }
+
+    template <typename Lock>
+    ProfiledLock<Lock> adopt(LockId id, Lock lock, std::optional<std::chrono::nanoseconds> wait,
+                             std::source_location site) {
+        CallSite* callSite = recordAcquisition(id, wait, site);
+        return ProfiledLock<Lock>(std::move(lock), this, id, callSite);
+    }
+
+    CallSite* recordAcquisition(LockId id, std::optional<std::chrono::nanoseconds> wait,
+                                const std::source_location& site);
+    void recordRelease(LockId id, CallSite* site, std::chrono::nanoseconds held);
+    CallSite* findOrInsertSite(LockId id, const std::source_location& site);
+};
+
+/**
+ * @brief Lock guard returned by LockProfiler::acquire
+ *
+ * Owns a std::unique_lock or std::shared_lock and reports the hold time to
+ * the profiler when unlocked or destroyed. Movable, like the lock it wraps.
+ */
+template <typename Lock>
+class ProfiledLock {
+public:
+    ProfiledLock() = default;
+
+    explicit ProfiledLock(Lock lock)
+        : lock_(std::move(lock)) {
+    }
+
+    ProfiledLock(Lock lock, LockProfiler* profiler, LockProfiler::LockId id, LockProfiler::CallSite* site)
+        : lock_(std::move(lock))
+        , profiler_(profiler)
+        , id_(id)
+        , site_(site)
+        , acquiredAt_(std::chrono::steady_clock::now()) {
+    }
+
+    ProfiledLock(ProfiledLock&& other) noexcept
+        : lock_(std::move(other.lock_))
+        , profiler_(std::exchange(other.profiler_, nullptr))
+        , id_(other.id_)
+        , site_(other.site_)
+        , acquiredAt_(other.acquiredAt_) {
+    }
+
+    ProfiledLock& operator=(ProfiledLock&& other) noexcept {
+        if (this != &other) {
+            release();
+            lock_ = std::move(other.lock_);
+            profiler_ = std::exchange(other.profiler_, nullptr);
+            id_ = other.id_;
+            site_ = other.site_;
+            acquiredAt_ = other.acquiredAt_;
+        }
+        return *this;
+    }
+
+    ProfiledLock(const ProfiledLock&) = delete;
+    ProfiledLock& operator=(const ProfiledLock&) = delete;
+
+    ~ProfiledLock() {
+        release();
+    }
+
+    void unlock() {
+        release();
+        lock_.unlock();
+    }
+
+    bool owns_lock() const noexcept { return lock_.owns_lock(); }
+    explicit operator bool() const noexcept { return lock_.owns_lock(); }
+
+private:
+    Lock lock_;
+    LockProfiler* profiler_{nullptr};
+    LockProfiler::LockId id_{LockProfiler::LockId::CACHE_MUTEX};
+    LockProfiler::CallSite* site_{nullptr};
+    std::chrono::steady_clock::time_point acquiredAt_;
+
+    void release() {
+        if (profiler_ && lock_.owns_lock()) {
+            profiler_->recordRelease(id_, site_, std::chrono::steady_clock::now() - acquiredAt_);
+        }
+        profiler_ = nullptr;
+    }
+};
+
+} // namespace opcua2http
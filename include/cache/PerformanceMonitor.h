@@ -2,10 +2,12 @@
 
 #include <chrono>
 #include <atomic>
+#include <array>
 #include <string>
 #include <vector>
 #include <mutex>
-#include <unordered_map>
+#include <cstdint>
+#include "cache/LatencyHistogram.h"
 
 namespace opcua2http {
 
@@ -14,6 +16,17 @@ namespace opcua2http {
  *
  * This class tracks performance metrics including response times, lock contention,
  * wait times, and provides performance tuning recommendations.
+ *
+ * Hot paths record through ScopedTimer and acquireLock(). Each thread claims
+ * one of THREAD_SLOTS cache-line aligned counter slots and is its only writer,
+ * so recording is a plain relaxed load and store with no locked instruction;
+ * threads beyond THREAD_SLOTS share an overflow slot updated with fetch_add.
+ * Readers sum the slots. Cache operations are timed on one call in
+ * CACHE_SAMPLE_INTERVAL (all calls are counted) so clock reads stay small next
+ * to a sub-microsecond lookup. Uncontended lock acquisitions never read the clock.
+ *
+ * OPC UA reads additionally go into one latency histogram per batch size
+ * class (see OPC_BATCH_SIZE_LIMITS), so percentiles compare like with like.
  */
 class PerformanceMonitor {
 public:
@@ -30,6 +43,54 @@ public:
         BACKGROUND_UPDATE
     };
 
+    /**
+     * @brief Instrumented locks
+     */
+    enum class LockType {
+        CACHE_MUTEX,    // CacheManager::cacheMutex_
+        CLIENT_MUTEX    // OPCUAClient::clientMutex_
+    };
+
+    static constexpr size_t OPERATION_TYPE_COUNT = 7;
+    static constexpr size_t LOCK_TYPE_COUNT = 2;
+
+    /**
+     * @brief Cache operations are timed once per this many calls on each thread
+     */
+    static constexpr uint64_t CACHE_SAMPLE_INTERVAL = 64;
+
+    /**
+     * @brief Threads that get an exclusive counter slot; later threads share one
+     */
+    static constexpr size_t THREAD_SLOTS = 64;
+
+    /**
+     * @brief Upper bounds of the OPC read batch size classes; larger batches form the last class
+     */
+    static constexpr std::array<size_t, 4> OPC_BATCH_SIZE_LIMITS{1, 8, 32, 128};
+    static constexpr size_t OPC_BATCH_CLASS_COUNT = OPC_BATCH_SIZE_LIMITS.size() + 1;
+    static constexpr std::array<const char*, OPC_BATCH_CLASS_COUNT> OPC_BATCH_LABELS{
+        "1", "2-8", "9-32", "33-128", "129+"
+    };
+
+    /**
+     * @brief OPC UA read latency of one batch size class
+     */
+    struct BatchLatency {
+        std::string label;                  // Node count range, e.g. "2-8"
+        LatencyHistogram::Snapshot latency; // Read latency distribution
+    };
+
+    /**
+     * @brief Acquisition statistics for one lock
+     */
+    struct LockMetrics {
+        uint64_t acquisitions{0};       // Total acquisitions
+        uint64_t contentions{0};        // Acquisitions that had to wait
+        double avgWaitTime{0.0};        // Average wait of contended acquisitions (ms)
+        double contentionRatio{0.0};    // contentions / acquisitions
+    };
+
     /**
      * @brief Performance metrics structure
      */
@@ -41,11 +102,20 @@ public:
         double avgBatchReadTime;        // Average batch read time (ms)
         double avgBackgroundUpdateTime; // Average background update time (ms)
 
+        // Operation counts
+        uint64_t cacheReads;            // Single and batch cache reads
+        uint64_t cacheWrites;           // Single and batch cache writes
+        uint64_t opcReads;              // Single-node OPC UA reads
+        uint64_t opcBatchReads;         // Batch OPC UA reads
+        uint64_t backgroundUpdates;     // Background updates
+
         // Concurrency metrics
         uint64_t totalLockWaits;        // Total lock wait events
         double avgLockWaitTime;         // Average lock wait time (ms)
         uint64_t lockContentions;       // Number of lock contentions
         double lockContentionRatio;     // Lock contention ratio (0.0 to 1.0)
+        LockMetrics cacheLock;          // cacheMutex_ breakdown
+        LockMetrics clientLock;         // clientMutex_ breakdown
 
         // Throughput metrics
         uint64_t operationsPerSecond;   // Operations per second
@@ -57,14 +127,49 @@ public:
     };
 
     /**
-     * @brief Operation timing structure for tracking individual operations
+     * @brief RAII timer that records one operation when it goes out of scope
+     *
+     * A null monitor makes the timer a no-op, so components work unmonitored.
+     * A non-zero batch size also records the duration as an OPC read latency.
+     * Defined inline: it runs on every cache access.
      */
-    struct OperationTiming {
-        OperationType type;
-        std::chrono::steady_clock::time_point startTime;
-        std::chrono::steady_clock::time_point endTime;
-        double durationMs;
-        bool completed;
+    class ScopedTimer {
+    public:
+        ScopedTimer(PerformanceMonitor* monitor, OperationType type, size_t batchSize = 0)
+            : monitor_(monitor && monitor->isEnabled() ? monitor : nullptr)
+            , type_(type)
+            , batchSize_(batchSize) {
+            if (monitor_ && shouldTime(type_)) {
+                timed_ = true;
+                start_ = std::chrono::steady_clock::now();
+            }
+        }
+
+        ~ScopedTimer() {
+            if (!monitor_) {
+                return;
+            }
+
+            int64_t nanos = -1;
+            if (timed_) {
+                nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start_).count();
+            }
+            monitor_->record(type_, nanos);
+            if (batchSize_ > 0 && nanos >= 0) {
+                monitor_->recordOpcReadLatency(batchSize_, std::chrono::nanoseconds(nanos));
+            }
+        }
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+        PerformanceMonitor* monitor_;
+        OperationType type_;
+        size_t batchSize_;
+        bool timed_{false};
+        std::chrono::steady_clock::time_point start_;
     };
 
     /**
@@ -82,17 +187,28 @@ public:
     PerformanceMonitor& operator=(const PerformanceMonitor&) = delete;
 
     /**
-     * @brief Start timing an operation
-     * @param type Operation type
-     * @return Operation ID for later completion
+     * @brief Acquire a lock, recording contention and wait time
+     * @param monitor Monitor to record to (may be null)
+     * @param type Lock being acquired
+     * @param lock Unlocked std::unique_lock or std::shared_lock
+     *
+     * Tries the lock first; only a failed try reads the clock.
      */
-    uint64_t startOperation(OperationType type);
+    template <typename Lock>
+    static void acquireLock(PerformanceMonitor* monitor, LockType type, Lock& lock) {
+        if (!monitor || !monitor->isEnabled()) {
+            lock.lock();
+            return;
+        }
+        if (lock.try_lock()) {
+            monitor->recordLockAcquisition(type);
+            return;
+        }
 
-    /**
-     * @brief Complete timing an operation
-     * @param operationId Operation ID from startOperation
-     */
-    void completeOperation(uint64_t operationId);
+        auto start = std::chrono::steady_clock::now();
+        lock.lock();
+        monitor->recordLockWait(type, std::chrono::steady_clock::now() - start);
+    }
 
     /**
      * @brief Record operation time directly
@@ -102,15 +218,50 @@ public:
     void recordOperationTime(OperationType type, double durationMs);
 
     /**
-     * @brief Record lock wait event
-     * @param waitTimeMs Wait time in milliseconds
+     * @brief Record an operation that was counted but not timed
+     * @param type Operation type
+     */
+    void recordOperation(OperationType type);
+
+    /**
+     * @brief Record the latency of one OPC UA read
+     * @param batchSize Nodes in the read
+     * @param latency Read duration
      */
-    void recordLockWait(double waitTimeMs);
+    void recordOpcReadLatency(size_t batchSize, std::chrono::nanoseconds latency);
 
     /**
-     * @brief Record lock contention event
+     * @brief Get OPC UA read latency per batch size class
+     * @return One entry per class, smallest batches first
      */
-    void recordLockContention();
+    std::vector<BatchLatency> getOpcReadLatencies() const;
+
+    /**
+     * @brief Get OPC UA read latency of one batch size class
+     * @param batchClass Index into OPC_BATCH_LABELS
+     * @return Histogram snapshot (empty for an invalid index)
+     */
+    LatencyHistogram::Snapshot getOpcReadLatency(size_t batchClass) const;
+
+    /**
+     * @brief Record an uncontended lock acquisition
+     * @param type Lock type
+     */
+    void recordLockAcquisition(LockType type) {
+        if (!enabled_.load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        size_t slot = threadSlot();
+        add(slots_[slot].locks[static_cast<size_t>(type)].acquisitions, 1, slot != OVERFLOW_SLOT);
+    }
+
+    /**
+     * @brief Record a contended lock acquisition
+     * @param type Lock type
+     * @param wait Time spent waiting for the lock
+     */
+    void recordLockWait(LockType type, std::chrono::steady_clock::duration wait);
 
     /**
      * @brief Get performance metrics
@@ -139,7 +290,9 @@ public:
      * @brief Check if performance monitoring is enabled
      * @return True if monitoring is enabled
      */
-    bool isEnabled() const;
+    bool isEnabled() const {
+        return enabled_.load(std::memory_order_relaxed);
+    }
 
     /**
      * @brief Set performance threshold for "good" performance
@@ -149,52 +302,120 @@ public:
     void setPerformanceThresholds(double cacheReadThresholdMs, double opcReadThresholdMs);
 
 private:
+    static constexpr size_t OVERFLOW_SLOT = THREAD_SLOTS;
+    static constexpr size_t UNASSIGNED_SLOT = ~size_t{0};
+
+    struct OperationCounter {
+        std::atomic<uint64_t> count{0};         // All operations
+        std::atomic<uint64_t> timed{0};         // Operations with a measured duration
+        std::atomic<uint64_t> totalNanos{0};    // Sum of measured durations
+    };
+
+    struct LockCounter {
+        std::atomic<uint64_t> acquisitions{0};
+        std::atomic<uint64_t> contentions{0};
+        std::atomic<uint64_t> waitNanos{0};
+    };
+
+    struct alignas(64) Slot {
+        std::array<OperationCounter, OPERATION_TYPE_COUNT> operations;
+        std::array<LockCounter, LOCK_TYPE_COUNT> locks;
+    };
+
+    /**
+     * @brief Plain copy of all counters, summed over slots
+     */
+    struct Totals {
+        std::array<std::array<uint64_t, 3>, OPERATION_TYPE_COUNT> operations{};  // count, timed, nanos
+        std::array<std::array<uint64_t, 3>, LOCK_TYPE_COUNT> locks{};            // acquisitions, contentions, nanos
+    };
+
     // Configuration
     std::atomic<bool> enabled_{true};
     std::atomic<double> cacheReadThreshold_{1.0};   // 1ms threshold for cache reads
     std::atomic<double> opcReadThreshold_{100.0};   // 100ms threshold for OPC reads
 
-    // Operation tracking
-    std::atomic<uint64_t> nextOperationId_{0};
-    mutable std::mutex operationsMutex_;
-    std::unordered_map<uint64_t, OperationTiming> activeOperations_;
-
-    // Timing statistics (atomic for lock-free updates)
-    std::atomic<uint64_t> cacheReadCount_{0};
-    std::atomic<double> cacheReadTotalTime_{0.0};
-    std::atomic<uint64_t> cacheWriteCount_{0};
-    std::atomic<double> cacheWriteTotalTime_{0.0};
-    std::atomic<uint64_t> opcReadCount_{0};
-    std::atomic<double> opcReadTotalTime_{0.0};
-    std::atomic<uint64_t> batchReadCount_{0};
-    std::atomic<double> batchReadTotalTime_{0.0};
-    std::atomic<uint64_t> backgroundUpdateCount_{0};
-    std::atomic<double> backgroundUpdateTotalTime_{0.0};
-
-    // Concurrency statistics
-    std::atomic<uint64_t> lockWaitCount_{0};
-    std::atomic<double> lockWaitTotalTime_{0.0};
-    std::atomic<uint64_t> lockContentionCount_{0};
-    std::atomic<uint64_t> lockAcquireAttempts_{0};
-
-    // Throughput tracking
+    // Per-thread counters; the last slot is shared by threads without one of their own
+    std::array<Slot, THREAD_SLOTS + 1> slots_;
+
+    // OPC read latency per batch size class
+    std::array<LatencyHistogram, OPC_BATCH_CLASS_COUNT> opcReadLatency_;
+
+    // reset() records a baseline instead of zeroing slots other threads write
+    mutable std::mutex baselineMutex_;
+    Totals baseline_;
     std::chrono::steady_clock::time_point startTime_;
-    std::atomic<uint64_t> totalOperations_{0};
 
     /**
-     * @brief Update operation statistics
+     * @brief Get the calling thread's counter slot
+     * @return Slot index, OVERFLOW_SLOT if all exclusive slots are taken
+     */
+    static size_t threadSlot() {
+        thread_local size_t cached = UNASSIGNED_SLOT;
+        if (cached == UNASSIGNED_SLOT) {
+            cached = claimThreadSlot();
+        }
+        return cached;
+    }
+
+    /**
+     * @brief Claim a free slot for the calling thread, released when it exits
+     * @return Slot index, OVERFLOW_SLOT if none is free
+     */
+    static size_t claimThreadSlot();
+
+    /**
+     * @brief Add to a counter
+     * @param counter Counter in a slot
+     * @param value Amount to add
+     * @param exclusive Whether the calling thread owns the slot
+     *
+     * An owned slot has a single writer, so a relaxed load and store cannot
+     * lose updates and avoids the locked read-modify-write of fetch_add.
+     */
+    static void add(std::atomic<uint64_t>& counter, uint64_t value, bool exclusive) {
+        if (exclusive) {
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        } else {
+            counter.fetch_add(value, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Decide whether this call of an operation should read the clock
      * @param type Operation type
-     * @param durationMs Duration in milliseconds
+     * @return True for every OPC/background operation and sampled cache operations
+     */
+    static bool shouldTime(OperationType type) {
+        if (type >= OperationType::OPC_READ) {
+            // OPC and background work take milliseconds; the clock is free by comparison
+            return true;
+        }
+        thread_local uint64_t calls = 0;
+        return calls++ % CACHE_SAMPLE_INTERVAL == 0;
+    }
+
+    /**
+     * @brief Add one operation to the calling thread's slot
+     * @param type Operation type
+     * @param nanos Measured duration, or -1 if not timed
      */
-    void updateStatistics(OperationType type, double durationMs);
+    void record(OperationType type, int64_t nanos) {
+        size_t slot = threadSlot();
+        bool exclusive = slot != OVERFLOW_SLOT;
+        auto& counter = slots_[slot].operations[static_cast<size_t>(type)];
+        add(counter.count, 1, exclusive);
+        if (nanos >= 0) {
+            add(counter.timed, 1, exclusive);
+            add(counter.totalNanos, static_cast<uint64_t>(nanos), exclusive);
+        }
+    }
 
     /**
-     * @brief Calculate average time for operation type
-     * @param totalTime Total time accumulated
-     * @param count Number of operations
-     * @return Average time in milliseconds
+     * @brief Sum all slots
+     * @return Totals since construction
      */
-    double calculateAverage(double totalTime, uint64_t count) const;
+    Totals collect() const;
 
     /**
      * @brief Analyze performance and generate recommendations
@@ -2,6 +2,7 @@
 
 #include <string>
 #include <vector>
+#include <map>
 #include <cstdint>
 
 namespace opcua2http {
@@ -21,6 +22,11 @@ struct Configuration {
     int defaultNamespace;                 // OPC_NAMESPACE
     std::string applicationUri;           // OPC_APPLICATION_URI
 
+    // Redundancy Configuration
+    // (initialized so configurations built field by field have no standby)
+    std::vector<std::string> opcBackupEndpoints;  // OPC_BACKUP_ENDPOINTS (comma-separated)
+    int opcFailoverMinServiceLevel{200};          // OPC_FAILOVER_MIN_SERVICE_LEVEL (0 = drops only)
+
     // Connection Configuration
     int connectionRetryMax;               // CONNECTION_RETRY_MAX
     int connectionInitialDelay;           // CONNECTION_INITIAL_DELAY
@@ -37,6 +43,15 @@ struct Configuration {
     std::string authPassword;             // AUTH_PASSWORD
     std::vector<std::string> allowedOrigins; // ALLOWED_ORIGINS (comma-separated)
 
+    // Client Rate Limiting Configuration
+    // (initialized so configurations built field by field keep the defaults)
+    int rateLimitRequestsPerSecond{0};    // RATE_LIMIT_REQUESTS_PER_SECOND (per client, 0 = unlimited)
+    int rateLimitBurst{0};                // RATE_LIMIT_BURST (0 = one second of rate)
+    int rateLimitMaxClients{10000};       // RATE_LIMIT_MAX_CLIENTS
+    int authMaxFailures{5};               // AUTH_MAX_FAILURES (0 = never block)
+    int authBlockSeconds{900};            // AUTH_BLOCK_SECONDS
+    bool trustProxyHeaders{false};        // TRUST_PROXY_HEADERS (1 = key clients on X-Forwarded-For)
+
     // Cache Configuration (Legacy - for backward compatibility)
     int cacheExpireMinutes;               // CACHE_EXPIRE_MINUTES
     int subscriptionCleanupMinutes;       // SUBSCRIPTION_CLEANUP_MINUTES
@@ -48,9 +63,15 @@ struct Configuration {
 
     // Background Update Configuration
     int backgroundUpdateThreads;         // BACKGROUND_UPDATE_THREADS
+    int backgroundUpdateMinThreads;      // BACKGROUND_UPDATE_MIN_THREADS
     int backgroundUpdateQueueSize;       // BACKGROUND_UPDATE_QUEUE_SIZE
     int backgroundUpdateTimeoutMs;       // BACKGROUND_UPDATE_TIMEOUT_MS
 
+    // Refresh-Ahead Configuration
+    int refreshAheadReadsPerSecond;      // REFRESH_AHEAD_READS_PER_SECOND (0 = disabled)
+    int refreshAheadLeadMs;              // REFRESH_AHEAD_LEAD_MS
+    int refreshAheadHotWindowSeconds;    // REFRESH_AHEAD_HOT_WINDOW_SECONDS
+
     // Performance Tuning Configuration
     int cacheMaxEntries;                 // CACHE_MAX_ENTRIES
     int cacheMaxMemoryMb;                // CACHE_MAX_MEMORY_MB
@@ -62,6 +83,40 @@ struct Configuration {
     int opcBatchSize;                    // OPC_BATCH_SIZE
     int opcConnectionPoolSize;           // OPC_CONNECTION_POOL_SIZE
 
+    // OPC UA Read Budget Configuration
+    // (initialized so configurations built field by field stay unlimited)
+    int opcReadBudgetNodesPerSecond{0};      // OPC_READ_BUDGET_NODES_PER_SECOND (0 = unlimited)
+    int opcReadBudgetRequestsPerSecond{0};   // OPC_READ_BUDGET_REQUESTS_PER_SECOND (0 = unlimited)
+    int opcReadBudgetSyncReservePercent{30}; // OPC_READ_BUDGET_SYNC_RESERVE_PERCENT
+
+    // OPC UA Circuit Breaker Configuration
+    int opcCircuitBreakerFailureThreshold{5};     // OPC_CIRCUIT_BREAKER_FAILURE_THRESHOLD (0 = disabled)
+    int opcCircuitBreakerOpenMs{5000};            // OPC_CIRCUIT_BREAKER_OPEN_MS
+    int opcCircuitBreakerProbeIntervalMs{1000};   // OPC_CIRCUIT_BREAKER_PROBE_INTERVAL_MS
+
+    // Request Trace Configuration
+    // (initialized so configurations built field by field record nothing)
+    std::string requestTraceFile;             // REQUEST_TRACE_FILE (empty = disabled)
+    int requestTraceBufferKb{4096};           // REQUEST_TRACE_BUFFER_KB
+
+    // Server-Timing Configuration
+    // (initialized so configurations built field by field add no header)
+    bool serverTimingEnabled{false};          // SERVER_TIMING_ENABLED (1 = header on every read)
+
+    // Lock Profiling Configuration
+    // (initialized so configurations built field by field do not profile)
+    bool lockProfilingEnabled{false};         // LOCK_PROFILING_ENABLED (1 = serve /debug/locks)
+
+    // Tag Group Configuration
+    // (initialized so configurations built field by field define no groups)
+    std::map<std::string, std::vector<std::string>> tagGroups; // TAG_GROUPS (name:id,id|name:id,...)
+    int tagGroupMaxCount{64};                 // TAG_GROUP_MAX_COUNT (configured and client-defined)
+    int tagGroupMaxSize{1000};                // TAG_GROUP_MAX_SIZE (node IDs per group)
+
+    // Response Cache Configuration
+    // (initialized so configurations built field by field cache no responses)
+    int responseCacheSize{0};                 // RESPONSE_CACHE_SIZE (ids lists kept, 0 = disabled)
+
     // Logging Configuration
     std::string logLevel;                 // LOG_LEVEL
 
@@ -100,6 +155,13 @@ struct Configuration {
      */
     std::string toString() const;
 
+    /**
+     * @brief Parse TAG_GROUPS: groups separated by '|', each a name, ':' and comma-separated node IDs
+     * @param value TAG_GROUPS value, e.g. "line1:ns=2;s=A,ns=2;s=B|line2:ns=2;i=7"
+     * @return Node IDs by group name; entries without a ':' are skipped with a warning
+     */
+    static std::map<std::string, std::vector<std::string>> parseTagGroups(const std::string& value);
+
 private:
     /**
      * @brief Get environment variable as string with default value
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <nlohmann/json.hpp>
+
+namespace opcua2http {
+
+/**
+ * @brief Heap allocation accounting per thread and per tag
+ *
+ * Counting needs the global operator new replacement in
+ * src/core/AllocationHooks.cpp, which is linked into the application only when
+ * built with -DENABLE_ALLOCATION_TRACKING=ON (the tests and benchmarks always
+ * link it). Without it nothing is ever recorded and isEnabled() is false.
+ *
+ * Every allocation is added to its thread's running totals and to the global
+ * totals of the thread's current tag. A TagScope sets the tag for its
+ * lifetime; RequestTiming::StageTimer sets the tag of its stage, so request
+ * stages are tagged without further instrumentation. Differences of thread()
+ * snapshots give the allocations of any stretch of code on one thread.
+ *
+ * Only allocations are counted; frees are not. The per-thread counters are
+ * plain thread-locals, the per-tag totals relaxed atomics.
+ */
+class AllocationTracker {
+public:
+    /**
+     * @brief Subsystem or request stage an allocation is attributed to
+     */
+    enum class Tag {
+        UNTAGGED,       // Outside any tagged scope (Crow, logging, startup, ...)
+        AUTH,           // Request stages, as in RequestTiming::Stage
+        PARSE,
+        CACHE,
+        OPC,
+        SERIALIZE,
+        BACKGROUND,     // Background cache updates
+        SUBSCRIPTION    // Subscription management and data change notifications
+    };
+
+    static constexpr size_t TAG_COUNT = 8;
+
+    /**
+     * @brief Allocation count and requested bytes
+     */
+    struct Counts {
+        uint64_t allocations{0};
+        uint64_t bytes{0};
+
+        Counts operator-(const Counts& other) const {
+            return {allocations - other.allocations, bytes - other.bytes};
+        }
+        Counts& operator+=(const Counts& other) {
+            allocations += other.allocations;
+            bytes += other.bytes;
+            return *this;
+        }
+    };
+
+    /**
+     * @brief Sets the tag of this thread for its lifetime
+     */
+    class TagScope {
+    public:
+        explicit TagScope(Tag tag) noexcept;
+        ~TagScope();
+
+        TagScope(const TagScope&) = delete;
+        TagScope& operator=(const TagScope&) = delete;
+
+    private:
+        Tag previous_;
+    };
+
+    /**
+     * @brief Check whether the allocation hooks are linked in
+     * @return true if allocations are being counted
+     */
+    static bool isEnabled() noexcept;
+
+    /**
+     * @brief Get the allocations made on this thread since it started
+     * @return Running totals; subtract two snapshots to measure a section
+     */
+    static Counts thread() noexcept;
+
+    /**
+     * @brief Get the current tag of this thread
+     */
+    static Tag currentTag() noexcept;
+
+    /**
+     * @brief Get the allocations attributed to a tag, over all threads
+     * @param tag Tag
+     * @return Totals since start or the last reset()
+     */
+    static Counts total(Tag tag) noexcept;
+
+    /**
+     * @brief Clear the per-tag totals; per-thread totals keep running
+     */
+    static void reset() noexcept;
+
+    /**
+     * @brief Build the /debug/alloc report
+     * @return JSON with allocations and bytes per tag
+     */
+    static nlohmann::json toJSON();
+
+    /**
+     * @brief Get the report name of a tag
+     * @param tag Tag
+     * @return Lower-case tag name
+     */
+    static const char* tagName(Tag tag);
+
+    /**
+     * @brief Record one allocation; called by the operator new replacement only
+     * @param bytes Requested size
+     */
+    static void recordAllocation(size_t bytes) noexcept;
+
+    /**
+     * @brief Mark the hooks as linked; called once by AllocationHooks.cpp
+     */
+    static void markHooksInstalled() noexcept;
+};
+
+} // namespace opcua2http
@@ -8,9 +8,11 @@
 #include <condition_variable>
 #include <atomic>
 #include <unordered_set>
+#include <unordered_map>
 #include <chrono>
 #include <memory>
 #include "core/IBackgroundUpdater.h"
+#include "cache/PerformanceMonitor.h"
 
 namespace opcua2http {
 
@@ -23,6 +25,20 @@ class OPCUAClient;
  * 
  * This component manages background updates for stale cache entries using
  * a worker thread pool and update queue with deduplication logic.
+ *
+ * The queue is ordered by an effective deadline rather than arrival order:
+ * the time at which the cached entry crosses the expire threshold, pulled
+ * forward by the node's recent request rate. Hot nodes that are about to
+ * expire are refreshed first, which minimizes synchronous EXPIRED reads.
+ *
+ * With a refresh-ahead budget configured, a scheduler thread also refreshes
+ * recently read, unsubscribed entries shortly before they turn STALE, so
+ * clients of hot nodes keep seeing FRESH data.
+ *
+ * The worker pool is elastic: up to maxConcurrentUpdates threads exist, but
+ * only as many are active as needed to drain the queue within about a second
+ * at the observed upstream read latency. When that latency climbs well above
+ * its baseline the server is treated as saturated and fewer workers are used.
  */
 class BackgroundUpdater : public IBackgroundUpdater {
 public:
@@ -35,6 +51,15 @@ public:
         uint64_t failedUpdates{0};          // Number of failed updates
         uint64_t queuedUpdates{0};          // Current number of queued updates
         uint64_t duplicateUpdates{0};       // Number of duplicate updates filtered
+        uint64_t reprioritizedUpdates{0};   // Number of queued updates raised by repeat requests
+        uint64_t refreshAheadReads{0};      // OPC reads spent on refresh-ahead
+        uint64_t refreshAheadAvoided{0};    // Refresh-ahead reads followed by a read that would have seen STALE
+        uint64_t refreshAheadSkipped{0};    // Refresh-ahead candidates skipped for lack of budget
+        uint64_t budgetShedUpdates{0};      // Updates dropped because the OPC read budget was exhausted
+        uint64_t timedOutUpdates{0};        // Updates abandoned after exceeding the update timeout
+        uint64_t activeWorkers{0};          // Workers currently allowed to take updates
+        uint64_t workerThreads{0};          // Worker threads in the pool
+        double upstreamLatency{0.0};        // Smoothed OPC read latency in milliseconds
         double averageUpdateTime{0.0};      // Average update time in milliseconds
         std::chrono::steady_clock::time_point lastUpdate; // Last update timestamp
     };
@@ -85,10 +110,20 @@ public:
 
     /**
      * @brief Set maximum number of concurrent update threads
+     *
+     * Takes effect immediately while running: threads are added, or surplus
+     * threads finish their current update and exit.
+     *
      * @param maxUpdates Maximum concurrent updates (default: 3)
      */
     void setMaxConcurrentUpdates(size_t maxUpdates);
 
+    /**
+     * @brief Set minimum number of active update workers
+     * @param minUpdates Minimum active workers, capped at the maximum (default: 1)
+     */
+    void setMinConcurrentUpdates(size_t minUpdates);
+
     /**
      * @brief Set maximum update queue size
      * @param maxQueueSize Maximum queue size (default: 1000)
@@ -97,41 +132,203 @@ public:
 
     /**
      * @brief Set update timeout for OPC UA operations
+     *
+     * Each background read is abandoned once it exceeds this timeout, freeing
+     * its worker; stop() abandons in-flight reads immediately.
+     *
      * @param timeout Timeout duration (default: 5000ms)
      */
     void setUpdateTimeout(std::chrono::milliseconds timeout);
 
+    /**
+     * @brief Set the OPC read budget for refresh-ahead
+     * @param readsPerSecond Maximum refresh-ahead reads per second (0 disables refresh-ahead)
+     */
+    void setRefreshAheadBudget(double readsPerSecond);
+
+    /**
+     * @brief Set how long before turning STALE an entry is refreshed ahead
+     * @param lead Lead time (default: 1000ms)
+     */
+    void setRefreshAheadLead(std::chrono::milliseconds lead);
+
+    /**
+     * @brief Set how recently an entry must have been read to be refreshed ahead
+     * @param window Hot window (default: 30s)
+     */
+    void setRefreshAheadHotWindow(std::chrono::milliseconds window);
+
+    /**
+     * @brief Set the monitor that times background updates
+     * @param monitor Performance monitor (optional, may be null; set before start())
+     */
+    void setPerformanceMonitor(PerformanceMonitor* monitor);
+
     /**
      * @brief Get current update statistics
      * @return UpdateStats structure with current statistics
      */
     UpdateStats getStats() const;
 
+    /**
+     * @brief Get update counters without taking the queue or stats locks
+     * @return UpdateStats without upstreamLatency and lastUpdate
+     */
+    UpdateStats getCounters() const;
+
     /**
      * @brief Clear all statistics counters
      */
     void clearStats();
 
+protected:
+    /**
+     * @brief Outcome of an enqueue attempt
+     */
+    enum class EnqueueResult {
+        QUEUED,          // Node added to the queue
+        REPRIORITIZED,   // Node already queued, deadline moved earlier
+        DUPLICATE,       // Node already queued or in flight, nothing changed
+        DROPPED          // Queue full
+    };
+
+    /**
+     * @brief Queue a node for update or raise its priority if already queued
+     * @param nodeId Node identifier to update
+     * @param recordRequest Count this call as client demand (false for refresh-ahead)
+     * @return EnqueueResult describing what happened
+     */
+    EnqueueResult enqueueUpdate(const std::string& nodeId, bool recordRequest = true);
+
+    /**
+     * @brief Queue refresh-ahead reads for hot entries within the read budget
+     * @return Number of refresh-ahead reads queued
+     */
+    size_t runRefreshAheadCycle();
+
+    /**
+     * @brief Get next update from queue (blocking)
+     * @param workerIndex Index of the calling worker; workers beyond the active count stay parked
+     * @return Node identifier with the earliest effective deadline, empty string if the worker should exit
+     */
+    std::string getNextUpdate(size_t workerIndex = 0);
+
+    /**
+     * @brief Calculate how many workers should be active
+     * @param queueDepth Number of queued updates
+     * @param latencyMs Smoothed upstream read latency in milliseconds
+     * @param baselineLatencyMs Lowest recently observed latency (0 if unknown)
+     * @param minWorkers Minimum active workers
+     * @param maxWorkers Maximum active workers
+     * @return Active worker count between minWorkers and maxWorkers
+     */
+    static size_t calculateTargetWorkers(size_t queueDepth,
+                                         double latencyMs,
+                                         double baselineLatencyMs,
+                                         size_t minWorkers,
+                                         size_t maxWorkers);
+
+    /**
+     * @brief Calculate the effective refresh deadline for a node
+     * @param timeUntilExpiry Time until the cached entry becomes EXPIRED
+     * @param requestRate Recent request rate for the node (requests per second)
+     * @param now Current time
+     * @return Deadline shortened in proportion to demand
+     */
+    static std::chrono::steady_clock::time_point calculateEffectiveDeadline(
+        std::chrono::milliseconds timeUntilExpiry,
+        double requestRate,
+        std::chrono::steady_clock::time_point now);
+
 private:
+    /**
+     * @brief Queued update ordered by effective deadline
+     */
+    struct QueuedUpdate {
+        std::chrono::steady_clock::time_point deadline;   // Effective refresh deadline
+        uint64_t sequence;                                // Insertion order, breaks ties and detects superseded entries
+        std::string nodeId;                               // Node identifier to update
+    };
+
+    /**
+     * @brief Heap comparator placing the earliest deadline on top
+     */
+    struct LaterDeadline {
+        bool operator()(const QueuedUpdate& a, const QueuedUpdate& b) const {
+            if (a.deadline != b.deadline) {
+                return a.deadline > b.deadline;
+            }
+            return a.sequence > b.sequence;
+        }
+    };
+
+    /**
+     * @brief Exponentially decayed request rate for a node
+     */
+    struct DemandInfo {
+        double rate{0.0};                                 // Requests per second
+        std::chrono::steady_clock::time_point lastRequest; // Time of the last request
+    };
+
     // Dependencies
     CacheManager* cacheManager_;
     OPCUAClient* opcClient_;
+    PerformanceMonitor* performanceMonitor_{nullptr};
 
-    // Thread management
+    // Thread management. Worker i only takes updates while i < targetWorkers_
+    // and exits once i >= maxConcurrentUpdates_.
     std::vector<std::thread> workerThreads_;
+    std::mutex workersMutex_;
     std::atomic<bool> running_{false};
     std::atomic<bool> stopRequested_{false};
 
-    // Update queue with thread safety
-    std::queue<std::string> updateQueue_;
+    // Update queue with thread safety. Re-prioritizing pushes a new heap entry;
+    // queuedUpdates_ holds the live entry per node so superseded ones are skipped.
+    std::priority_queue<QueuedUpdate, std::vector<QueuedUpdate>, LaterDeadline> updateQueue_;
+    std::unordered_map<std::string, QueuedUpdate> queuedUpdates_;
+    std::atomic<size_t> queueDepth_{0};     // queuedUpdates_.size(), readable without queueMutex_
+    std::unordered_map<std::string, DemandInfo> demand_;
+    std::chrono::steady_clock::time_point lastDemandPrune_;
+    uint64_t nextSequence_{0};
     mutable std::mutex queueMutex_;
     std::condition_variable queueCondition_;
 
     // Configuration parameters
     std::atomic<size_t> maxConcurrentUpdates_{3};
+    std::atomic<size_t> minConcurrentUpdates_{1};
+    std::atomic<size_t> targetWorkers_{1};
     std::atomic<size_t> maxQueueSize_{1000};
     std::atomic<std::chrono::milliseconds> updateTimeout_{std::chrono::milliseconds(5000)};
 
+    // Demand is averaged over this window when weighting deadlines
+    static constexpr double DEMAND_WINDOW_SECONDS = 10.0;
+
+    // Upstream latency tracking for pool sizing (guarded by queueMutex_)
+    double upstreamLatencyMs_{0.0};
+    double baselineLatencyMs_{0.0};
+
+    // Active workers should clear the queue within this time
+    static constexpr double WORKER_DRAIN_TARGET_MS = 1000.0;
+    // Latency this many times the baseline means the server is saturated
+    static constexpr double UPSTREAM_SATURATION_FACTOR = 3.0;
+    // Weight of a new sample in the smoothed latency
+    static constexpr double LATENCY_SMOOTHING = 0.2;
+
+    // Refresh-ahead scheduling. refreshedAhead_ maps a refreshed node to the time
+    // its previous value would have turned STALE, to count avoided STALE reads.
+    std::thread refreshAheadThread_;
+    std::atomic<double> refreshAheadBudget_{0.0};
+    std::atomic<std::chrono::milliseconds> refreshAheadLead_{std::chrono::milliseconds(1000)};
+    std::atomic<std::chrono::milliseconds> refreshAheadHotWindow_{std::chrono::milliseconds(30000)};
+    std::unordered_map<std::string, std::chrono::steady_clock::time_point> refreshedAhead_;
+    double refreshAheadTokens_{0.0};
+    std::chrono::steady_clock::time_point lastTokenRefill_;
+    std::mutex refreshAheadMutex_;
+    std::condition_variable refreshAheadCondition_;
+
+    // Interval between refresh-ahead scans
+    static constexpr std::chrono::milliseconds REFRESH_AHEAD_INTERVAL{250};
+
     // Deduplication mechanism
     std::unordered_set<std::string> pendingUpdates_;
     mutable std::mutex pendingMutex_;
@@ -141,14 +338,33 @@ private:
     mutable std::atomic<uint64_t> successfulUpdates_{0};
     mutable std::atomic<uint64_t> failedUpdates_{0};
     mutable std::atomic<uint64_t> duplicateUpdates_{0};
-    mutable std::atomic<double> totalUpdateTime_{0.0};
+    mutable std::atomic<uint64_t> reprioritizedUpdates_{0};
+    mutable std::atomic<uint64_t> refreshAheadReads_{0};
+    mutable std::atomic<uint64_t> refreshAheadAvoided_{0};
+    mutable std::atomic<uint64_t> refreshAheadSkipped_{0};
+    mutable std::atomic<uint64_t> budgetShedUpdates_{0};
+    mutable std::atomic<uint64_t> timedOutUpdates_{0};
+    mutable std::atomic<uint64_t> totalUpdateTimeUs_{0};
     std::chrono::steady_clock::time_point lastUpdate_;
     mutable std::mutex statsMutex_;
 
     /**
      * @brief Worker thread main loop
+     * @param workerIndex Position of the worker in the pool
      */
-    void workerLoop();
+    void workerLoop(size_t workerIndex);
+
+    /**
+     * @brief Recalculate the active worker count from queue depth and latency
+     * @return True if more workers became active (call with queueMutex_ held)
+     */
+    bool updateWorkerTarget();
+
+    /**
+     * @brief Fold a successful read's latency into the smoothed upstream latency
+     * @param latencyMs Read latency in milliseconds
+     */
+    void recordUpstreamLatency(double latencyMs);
 
     /**
      * @brief Process a single update request
@@ -170,10 +386,36 @@ private:
     void removeFromPendingUpdates(const std::string& nodeId);
 
     /**
-     * @brief Get next update from queue (blocking)
-     * @return Node identifier to update, empty string if should stop
+     * @brief Record a request for a node and return its decayed request rate
+     * @param nodeId Node identifier
+     * @param now Current time
+     * @return Requests per second (call with queueMutex_ held)
+     */
+    double recordDemand(const std::string& nodeId, std::chrono::steady_clock::time_point now);
+
+    /**
+     * @brief Get a node's decayed request rate without recording a request
+     * @param nodeId Node identifier
+     * @param now Current time
+     * @return Requests per second (call with queueMutex_ held)
+     */
+    double currentDemand(const std::string& nodeId, std::chrono::steady_clock::time_point now) const;
+
+    /**
+     * @brief Refresh-ahead scheduler thread function
+     */
+    void refreshAheadLoop();
+
+    /**
+     * @brief Drop demand history for nodes that have not been requested recently
+     * @param now Current time (call with queueMutex_ held)
+     */
+    void pruneDemand(std::chrono::steady_clock::time_point now);
+
+    /**
+     * @brief Rebuild the heap without superseded entries (call with queueMutex_ held)
      */
-    std::string getNextUpdate();
+    void compactQueue();
 
     /**
      * @brief Record update statistics
@@ -190,7 +432,7 @@ private:
 
     /**
      * @brief Get current queue size
-     * @return Number of items in update queue
+     * @return Number of distinct nodes in update queue
      */
     size_t getQueueSize() const;
 };
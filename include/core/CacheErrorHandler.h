@@ -5,6 +5,10 @@
 #include <chrono>
 #include <atomic>
 #include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <map>
+#include <random>
 #include <unordered_map>
 
 #include "cache/CacheManager.h"
@@ -22,6 +26,12 @@ class OPCUAClient;
  * for OPC UA connection failures and other error scenarios. It determines
  * the appropriate action based on error type, cache availability, and
  * system state.
+ *
+ * Retries never run on the calling thread. A failed read is handed to a
+ * timer-driven retry queue served by one background thread, with exponential
+ * backoff and jitter between attempts. Retries for the same node are
+ * coalesced, and the caller is answered from cache (or with an error)
+ * immediately; a successful retry refreshes the cache for later requests.
  */
 class CacheErrorHandler {
 public:
@@ -47,8 +57,18 @@ public:
         uint64_t failedRetries{0};                  // Failed retries
         std::chrono::steady_clock::time_point lastError;  // Last error timestamp
         double errorRate{0.0};                      // Current error rate (errors/minute)
+        uint64_t budgetExhausted{0};                // Reads shed by the OPC read budget
+        uint64_t circuitOpen{0};                    // Reads failed fast by the open circuit breaker
+        uint64_t retriesScheduled{0};               // Nodes queued for a background retry
+        uint64_t retriesCoalesced{0};               // Retry requests merged into a queued retry
+        uint64_t pendingRetries{0};                 // Nodes currently queued or being retried
     };
 
+    /**
+     * @brief Text in the reason of every result served from cache after a failed read
+     */
+    static constexpr const char* CACHED_FALLBACK_MARKER = "Using Cached Data";
+
     /**
      * @brief Constructor
      * @param cacheManager Pointer to cache manager instance
@@ -57,9 +77,9 @@ public:
     CacheErrorHandler(CacheManager* cacheManager, OPCUAClient* opcClient);
 
     /**
-     * @brief Destructor
+     * @brief Destructor - stops the retry thread
      */
-    ~CacheErrorHandler() = default;
+    ~CacheErrorHandler();
 
     // Disable copy constructor and assignment operator
     CacheErrorHandler(const CacheErrorHandler&) = delete;
@@ -85,6 +105,57 @@ public:
     ReadResult handleConnectionError(const std::string& nodeId,
                                    const std::optional<CacheManager::CacheEntry>& cachedData);
 
+    /**
+     * @brief Handle a read shed by the OPC read budget
+     *
+     * Serves cached data of any age without retrying, since a retry would
+     * only spend more of the exhausted budget.
+     *
+     * @param nodeId Node identifier that was not read
+     * @param cachedData Optional cached data for fallback
+     * @return ReadResult with cached data or error response
+     */
+    ReadResult handleBudgetExhausted(const std::string& nodeId,
+                                     const std::optional<CacheManager::CacheEntry>& cachedData);
+
+    /**
+     * @brief Handle a read failed fast by the open circuit breaker
+     *
+     * Serves cached data of any age without retrying; the server is known to
+     * be down until a probe read or a reconnect closes the circuit.
+     *
+     * @param nodeId Node identifier that was not read
+     * @param cachedData Optional cached data for fallback
+     * @return ReadResult with cached data or error response
+     */
+    ReadResult handleCircuitOpen(const std::string& nodeId,
+                                 const std::optional<CacheManager::CacheEntry>& cachedData);
+
+    /**
+     * @brief Queue a background retry for a node
+     *
+     * Does not block. If a retry for the node is already queued or running the
+     * request is coalesced into it. Nothing is queued while the circuit
+     * breaker is open or the retry queue is full.
+     *
+     * @param nodeId Node identifier to re-read
+     * @return True if a retry is queued for the node
+     */
+    bool scheduleRetry(const std::string& nodeId);
+
+    /**
+     * @brief Get the number of nodes queued or being retried
+     * @return Pending retry count
+     */
+    size_t getPendingRetryCount() const;
+
+    /**
+     * @brief Stop the retry thread and drop queued retries
+     *
+     * Waits for a retry read in progress to finish. Called by the destructor.
+     */
+    void stop();
+
     /**
      * @brief Handle partial batch failure (some nodes succeed, some fail)
      * @param nodeIds Vector of node identifiers in the batch
@@ -116,6 +187,13 @@ public:
      */
     bool isRecoverableError(const std::string& error) const;
 
+    /**
+     * @brief Check if a result was served from cache after a failed read
+     * @param reason Reason of a read result
+     * @return True if the reason carries CACHED_FALLBACK_MARKER
+     */
+    static bool isCachedFallback(const std::string& reason);
+
     /**
      * @brief Get error statistics
      * @return ErrorStats structure with current statistics
@@ -181,6 +259,13 @@ public:
      */
     bool isErrorRateExceeded() const;
 
+    /**
+     * @brief Drop error timestamps that fell out of the 1-minute rate window
+     *
+     * Called periodically by the timer service so recording an error stays O(1).
+     */
+    void pruneErrorHistory();
+
 private:
     // Dependencies
     CacheManager* cacheManager_;                              // Cache manager instance
@@ -189,7 +274,7 @@ private:
     // Configuration
     std::atomic<int> maxRetryAttempts_{3};                   // Maximum retry attempts
     std::atomic<bool> autoRetryEnabled_{true};               // Automatic retry enabled
-    std::chrono::milliseconds retryDelay_{1000};             // Delay between retries
+    std::atomic<std::chrono::milliseconds> retryDelay_{std::chrono::milliseconds(1000)}; // Base delay between retries
     std::atomic<double> errorRateThreshold_{10.0};           // Error rate threshold (errors/min)
 
     // Statistics (atomic for thread-safe access)
@@ -200,6 +285,10 @@ private:
     mutable std::atomic<uint64_t> retryAttempts_{0};
     mutable std::atomic<uint64_t> successfulRetries_{0};
     mutable std::atomic<uint64_t> failedRetries_{0};
+    mutable std::atomic<uint64_t> budgetExhausted_{0};
+    mutable std::atomic<uint64_t> circuitOpen_{0};
+    mutable std::atomic<uint64_t> retriesScheduled_{0};
+    mutable std::atomic<uint64_t> retriesCoalesced_{0};
     mutable std::atomic<std::chrono::steady_clock::time_point> lastError_;
 
     // Error rate tracking
@@ -207,6 +296,26 @@ private:
     std::vector<std::chrono::steady_clock::time_point> recentErrors_;
     static constexpr size_t MAX_RECENT_ERRORS = 100;
 
+    /**
+     * @brief Result of one retry attempt
+     */
+    enum class RetryOutcome {
+        SUCCEEDED,      // Read succeeded and the cache was updated
+        FAILED,         // Read failed; retry again if attempts remain
+        ABANDONED       // Read was shed by the budget or circuit breaker; stop retrying
+    };
+
+    // Async retry queue
+    std::multimap<std::chrono::steady_clock::time_point, std::string> retryQueue_;  // Due time -> node
+    std::unordered_map<std::string, int> pendingRetries_;   // Node -> attempts made so far
+    mutable std::mutex retryMutex_;                          // Guards the queue, pending set and RNG
+    std::condition_variable retryCondition_;
+    std::thread retryThread_;
+    bool retryRunning_{true};
+    std::mt19937 retryJitter_{std::random_device{}()};
+    static constexpr size_t MAX_PENDING_RETRIES = 10000;
+    static constexpr std::chrono::milliseconds MAX_RETRY_BACKOFF{30000};
+
     /**
      * @brief Record error occurrence for statistics
      * @param isConnectionError Whether error is connection-related
@@ -226,11 +335,24 @@ private:
     double calculateErrorRate() const;
 
     /**
-     * @brief Attempt to retry connection and read operation
+     * @brief Serve due retries until stop() is called
+     */
+    void retryLoop();
+
+    /**
+     * @brief Perform one retry read (runs on the retry thread)
      * @param nodeId Node identifier to read
-     * @return ReadResult from retry attempt
+     * @param attempt Attempt number, starting at 1
+     * @return Outcome of the attempt
+     */
+    RetryOutcome attemptRetry(const std::string& nodeId, int attempt);
+
+    /**
+     * @brief Calculate the jittered backoff before an attempt (call with retryMutex_ held)
+     * @param attempt Attempt number, starting at 1
+     * @return Base delay doubled per attempt, capped, with up to half of it randomized
      */
-    ReadResult attemptRetry(const std::string& nodeId);
+    std::chrono::milliseconds nextBackoff(int attempt);
 
     /**
      * @brief Create error result with appropriate message
@@ -20,6 +20,11 @@ class BackgroundUpdater;
 class CacheErrorHandler;
 class ReconnectionManager;
 class SubscriptionManager;
+class TimerService;
+class PerformanceMonitor;
+class MetricsExporter;
+class RequestTraceRecorder;
+class LockProfiler;
 
 /**
  * @brief Main application class for the OPC UA HTTP Bridge
@@ -84,6 +89,8 @@ private:
     std::unique_ptr<Configuration> config_;
 
     // Core components
+    std::unique_ptr<PerformanceMonitor> performanceMonitor_;   // Outlives every component it times
+    std::unique_ptr<LockProfiler> lockProfiler_;               // Only when LOCK_PROFILING_ENABLED is set
     std::unique_ptr<OPCUAClient> opcClient_;
     std::unique_ptr<CacheManager> cacheManager_;
     std::unique_ptr<CacheMetrics> cacheMetrics_;
@@ -93,6 +100,9 @@ private:
     std::unique_ptr<APIHandler> apiHandler_;
     std::unique_ptr<SubscriptionManager> subscriptionManager_;
     std::unique_ptr<ReconnectionManager> reconnectionManager_;
+    std::unique_ptr<TimerService> timerService_;
+    std::unique_ptr<MetricsExporter> metricsExporter_;
+    std::unique_ptr<RequestTraceRecorder> traceRecorder_;     // Only when REQUEST_TRACE_FILE is set
 
     // Crow HTTP application with CORS middleware
     crow::App<crow::CORSHandler> app_;
@@ -100,13 +110,18 @@ private:
     // Runtime state
     std::atomic<bool> running_;
     std::thread serverThread_;
-    std::thread cleanupThread_;
     std::chrono::steady_clock::time_point startTime_;
 
+    // Periodic maintenance intervals (cache cleanup uses its configured interval)
+    static constexpr std::chrono::seconds SUBSCRIPTION_CLEANUP_INTERVAL{60};
+    static constexpr std::chrono::milliseconds RECONNECTION_CHECK_INTERVAL{1000};
+    static constexpr std::chrono::seconds ERROR_HISTORY_PRUNE_INTERVAL{10};
+
     // Initialization methods
     bool initializeConfiguration();
     bool initializeOPCClient();
     bool initializeComponents();
+    void scheduleMaintenanceTasks();
     bool setupHTTPServer();
 
     // Signal handling
@@ -3,6 +3,8 @@
 #include <string>
 #include <cstdint>
 #include <chrono>
+#include <memory>
+#include <utility>
 #include <iomanip>
 #include <sstream>
 #include <nlohmann/json.hpp>
@@ -22,6 +24,21 @@ struct ReadResult {
     std::string value;        // Read value as string
     uint64_t timestamp;       // Unix timestamp in milliseconds
 
+    // dumpJson() of these fields, shared with the cache entry that produced them
+    // (may be null). Change fields of a copy through withReason(), or reset it.
+    std::shared_ptr<const std::string> json{};
+
+    /**
+     * @brief Replace the status description, dropping the now outdated json
+     * @param newReason New status description
+     * @return This result
+     */
+    ReadResult& withReason(std::string newReason) {
+        reason = std::move(newReason);
+        json.reset();
+        return *this;
+    }
+
     /**
      * @brief Convert ReadResult to JSON format with full field names
      * @return nlohmann::json object with standard API response format
@@ -53,6 +70,39 @@ struct ReadResult {
         };
     }
 
+    /**
+     * @brief Append the serialized JSON object to a response body
+     * @param out Buffer to append to
+     *
+     * Copies the pre-serialized object when there is one, so a cached result
+     * is formatted once per value rather than once per request.
+     */
+    void appendJson(std::string& out) const {
+        if (json) {
+            out += *json;
+        } else {
+            out += dumpJson();
+        }
+    }
+
+    /**
+     * @brief Serialize this result for sharing through the json member
+     * @return dumpJson(), built once
+     */
+    std::shared_ptr<const std::string> serializeJson() const {
+        return std::make_shared<const std::string>(dumpJson());
+    }
+
+    /**
+     * @brief Serialize toJson() as compact text
+     * @return JSON text; bytes that are not valid UTF-8 are written as U+FFFD
+     *
+     * Values come from the server as-is, so a plain dump() could throw.
+     */
+    std::string dumpJson() const {
+        return toJson().dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+    }
+
     /**
      * @brief Create ReadResult from JSON (supports both old and new formats)
      * @param j JSON object containing ReadResult data
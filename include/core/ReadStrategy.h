@@ -7,12 +7,16 @@
 #include <condition_variable>
 #include <unordered_set>
 #include <atomic>
+#include <chrono>
 
 #include "cache/CacheManager.h"
 #include "opcua/OPCUAClient.h"
 #include "core/ReadResult.h"
 #include "core/IBackgroundUpdater.h"
 #include "core/CacheErrorHandler.h"
+#include "core/RequestTiming.h"
+#include "core/TagGroup.h"
+#include "cache/CacheMetrics.h"
 
 namespace opcua2http {
 
@@ -32,6 +36,7 @@ public:
         std::vector<std::string> freshNodes;      // Return from cache (< refreshThreshold)
         std::vector<std::string> staleNodes;      // Return cache + background update (refreshThreshold < age < expireTime)
         std::vector<std::string> expiredNodes;    // Must read synchronously (> expireTime)
+        size_t missingNodes{0};                   // Expired nodes that have no cache entry at all
 
         /**
          * @brief Get total number of nodes in the plan
@@ -82,6 +87,43 @@ public:
      */
     ReadResult processNodeRequest(const std::string& nodeId);
 
+    /**
+     * @brief Read every member of a tag group with intelligent caching
+     *
+     * Same FRESH/STALE/EXPIRED handling as processNodeRequests(), but cached
+     * results come straight from the status lookup and expired members are read
+     * from the group's prepared read, without parsing their node IDs.
+     *
+     * @param group Tag group to read
+     * @return ReadResults in the group's member order
+     */
+    std::vector<ReadResult> processGroupRequest(const TagGroup& group);
+
+    /**
+     * @brief Record nodes served from an already serialized response as FRESH hits
+     *
+     * Keeps the metrics of a reused response body the same as if the request had
+     * gone through processNodeRequests() and found every node FRESH.
+     *
+     * @param nodeIds Nodes in the response, in request order
+     * @param startTime When serving the response began
+     */
+    void recordFreshResponse(const std::vector<std::string>& nodeIds,
+                             std::chrono::steady_clock::time_point startTime);
+
+    /**
+     * @brief Record a response built by another request as that build's read paths
+     *
+     * For requests that waited on a shared build: each path gets the nodes the
+     * build served through it, so the waiter is counted like the read it shared.
+     *
+     * @param nodeCount Nodes in the response
+     * @param paths Nodes per read path, as counted for the build
+     * @param startTime When serving the response began
+     */
+    void recordSharedResponse(size_t nodeCount, const RequestTiming::NodeCounts& paths,
+                              std::chrono::steady_clock::time_point startTime);
+
     /**
      * @brief Create batch read plan by categorizing nodes based on cache status
      * @param nodeIds Vector of node identifiers to categorize
@@ -144,6 +186,12 @@ public:
      */
     void setErrorHandler(CacheErrorHandler* errorHandler);
 
+    /**
+     * @brief Set cache metrics that record per-path hits and response times
+     * @param cacheMetrics Pointer to cache metrics instance (optional)
+     */
+    void setCacheMetrics(CacheMetrics* cacheMetrics);
+
     /**
      * @brief Set optimal batch size for OPC UA reads
      * @param batchSize Optimal batch size (default: 50)
@@ -174,6 +222,7 @@ private:
     OPCUAClient* opcClient_;                                  // OPC UA client instance
     IBackgroundUpdater* backgroundUpdater_;                   // Background updater instance (optional)
     CacheErrorHandler* errorHandler_;                         // Error handler instance (optional)
+    CacheMetrics* cacheMetrics_{nullptr};                     // Per-path metrics (optional)
 
     // Concurrency control
     mutable std::mutex readMutex_;                           // Mutex for protecting activeReads_
@@ -199,6 +248,35 @@ private:
      */
     void releaseReadLock(const std::string& nodeId);
 
+    /**
+     * @brief Record the cache path and response time of served nodes
+     * @param nodeIds Nodes served by the path
+     * @param status Cache status that selected the path
+     * @param path Path for the latency histogram, which gets one sample per call
+     * @param startTime When serving the nodes began; the per-node averages split the elapsed time evenly
+     */
+    void recordPathMetrics(const std::vector<std::string>& nodeIds,
+                           CacheManager::CacheStatus status,
+                           CacheMetrics::ReadPath path,
+                           std::chrono::steady_clock::time_point startTime);
+
+    /**
+     * @brief Count the nodes a batch plan served per path for the request's Server-Timing
+     * @param plan Executed plan
+     * @param results Results of the plan, expired nodes last
+     * @param counts Counts to add to
+     */
+    static void countPathNodes(const BatchReadPlan& plan, const std::vector<ReadResult>& results,
+                               RequestTiming::NodeCounts& counts);
+
+    /**
+     * @brief Classify a synchronous server read for the latency histograms
+     * @param results Results returned to the client
+     * @param missingNodes How many of the nodes had no cache entry
+     * @return FALLBACK if any result came from cache, MISS if no node was cached, else EXPIRED
+     */
+    static CacheMetrics::ReadPath syncReadPath(const std::vector<ReadResult>& results, size_t missingNodes);
+
     /**
      * @brief Handle concurrent read scenario (wait for existing read to complete)
      * @param nodeId Node identifier being read concurrently
@@ -234,6 +312,14 @@ private:
      */
     std::vector<ReadResult> readAndUpdateCache(const std::vector<std::string>& nodeIds);
 
+    /**
+     * @brief Read expired group members from the server and update the cache
+     * @param group Group being read
+     * @param members Indices of the expired members
+     * @return ReadResults for the members, in members' order, with cache fallbacks applied
+     */
+    std::vector<ReadResult> readGroupMembers(const TagGroup& group, const std::vector<size_t>& members);
+
     /**
      * @brief Create error result for a node
      * @param nodeId Node identifier
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <nlohmann/json.hpp>
+
+#include "core/AllocationTracker.h"
+
+namespace opcua2http {
+
+/**
+ * @brief Per-request stage timings for the Server-Timing header
+ *
+ * The read route creates one RequestTiming per request and installs it as the
+ * current timing of its thread with a Scope. Code further down the read path
+ * (ReadStrategy, OPCUAClient) adds to it through StageTimer and the static
+ * helpers without any change to its signatures; on threads without a current
+ * timing, such as the background updater, those calls cost one thread-local
+ * load and do nothing else.
+ *
+ * Within a timed request StageTimer also tags the thread's allocations with its
+ * stage and, when the allocation hooks are linked in, counts the allocations
+ * made during the stage. Elsewhere the thread keeps its own tag, so a
+ * background update's OPC UA read stays attributed to the background updater.
+ *
+ * A request is handled on a single thread, so nothing here is synchronized.
+ */
+class RequestTiming {
+public:
+    /**
+     * @brief Stages of a read request
+     */
+    enum class Stage {
+        AUTH,       // Authentication and rate limiting
+        PARSE,      // Query parameter extraction, node ID parsing and validation
+        CACHE,      // Batch planning and serving fresh and stale entries from cache
+        OPC,        // Synchronous OPC UA reads, including the wait for the client
+        SERIALIZE   // Building and dumping the JSON response
+    };
+
+    static constexpr size_t STAGE_COUNT = 5;
+
+    /**
+     * @brief Nodes served per read path (same paths as the CacheMetrics histograms)
+     */
+    struct NodeCounts {
+        size_t fresh{0};      // Served from fresh cache
+        size_t stale{0};      // Served from stale cache, refreshed in the background
+        size_t expired{0};    // Expired entry read synchronously from the server
+        size_t miss{0};       // Uncached node read synchronously from the server
+        size_t fallback{0};   // Server read failed, answered from cache
+    };
+
+    /**
+     * @brief Installs a timing as the current one of this thread for its lifetime
+     */
+    class Scope {
+    public:
+        explicit Scope(RequestTiming* timing);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        RequestTiming* previous_;
+    };
+
+    /**
+     * @brief Adds the time and allocations until destruction to a stage of the current timing
+     */
+    class StageTimer {
+    public:
+        explicit StageTimer(Stage stage);
+        ~StageTimer();
+
+        StageTimer(const StageTimer&) = delete;
+        StageTimer& operator=(const StageTimer&) = delete;
+
+    private:
+        RequestTiming* timing_;
+        Stage stage_;
+        std::chrono::steady_clock::time_point start_;
+        std::optional<AllocationTracker::TagScope> tagScope_;
+        AllocationTracker::Counts startAllocations_;
+    };
+
+    /**
+     * @brief Constructor; the request's total time starts here
+     */
+    RequestTiming();
+
+    /**
+     * @brief Get the timing of the request handled on this thread
+     * @return Current timing, or nullptr outside a timed request
+     */
+    static RequestTiming* current();
+
+    /**
+     * @brief Count one OPC UA read service call against the current timing
+     */
+    static void countOpcRequest();
+
+    /**
+     * @brief Add time to a stage
+     * @param stage Stage to add to
+     * @param elapsed Time spent
+     */
+    void add(Stage stage, std::chrono::nanoseconds elapsed);
+
+    /**
+     * @brief Get the time spent in a stage so far
+     * @param stage Stage
+     * @return Accumulated time
+     */
+    std::chrono::nanoseconds getStage(Stage stage) const;
+
+    /**
+     * @brief Get the allocations made in a stage so far
+     * @param stage Stage
+     * @return Accumulated counts; zero unless allocation tracking is enabled
+     */
+    AllocationTracker::Counts getAllocations(Stage stage) const;
+
+    /**
+     * @brief Get the time since the request started
+     * @return Elapsed time
+     */
+    std::chrono::nanoseconds getElapsed() const;
+
+    /**
+     * @brief Get the number of OPC UA read service calls made for the request
+     */
+    size_t getOpcRequests() const { return opcRequests_; }
+
+    /**
+     * @brief Nodes served per path; filled in by ReadStrategy
+     */
+    NodeCounts& nodes() { return nodes_; }
+    const NodeCounts& nodes() const { return nodes_; }
+
+    /**
+     * @brief Format the timings as a Server-Timing header value
+     * @return e.g. `auth;dur=0.004, parse;dur=0.011, cache;dur=0.052, opc;dur=12.310;desc="1 request", ...`
+     *
+     * Durations are in milliseconds. Stages that were never entered are left
+     * out; total and the node counts per path are always present.
+     */
+    std::string toServerTimingHeader() const;
+
+    /**
+     * @brief Format the timings for the `?debug=timing` response field
+     * @return JSON with stage durations in ms, total_ms, opc_requests and nodes per path,
+     *         plus allocations per stage when allocation tracking is enabled
+     */
+    nlohmann::json toJSON() const;
+
+    /**
+     * @brief Get the Server-Timing metric name of a stage
+     * @param stage Stage
+     * @return Lower-case stage name
+     */
+    static const char* stageName(Stage stage);
+
+    /**
+     * @brief Get the allocation tag of a stage
+     * @param stage Stage
+     * @return Tag the stage's allocations are attributed to
+     */
+    static AllocationTracker::Tag allocationTag(Stage stage);
+
+private:
+    std::chrono::steady_clock::time_point start_;
+    std::array<std::chrono::nanoseconds, STAGE_COUNT> stages_{};
+    std::array<bool, STAGE_COUNT> entered_{};
+    std::array<AllocationTracker::Counts, STAGE_COUNT> allocations_{};
+    size_t opcRequests_{0};
+    NodeCounts nodes_;
+};
+
+} // namespace opcua2http
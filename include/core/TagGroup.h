@@ -0,0 +1,128 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include "opcua/OPCUAClient.h"
+
+namespace opcua2http {
+
+/**
+ * @brief Named, fixed list of node IDs read together
+ *
+ * Clients that poll the same node list send its name instead of the list. The
+ * IDs were validated when the group was defined, and their OPC UA read value
+ * IDs were parsed then too, so a group read skips parsing and validation and
+ * sends expired members from the prepared read.
+ *
+ * Immutable; redefining a group replaces the whole object, so readers holding
+ * the old one finish with it undisturbed.
+ */
+class TagGroup {
+public:
+    /**
+     * @brief Constructor
+     * @param name Group name
+     * @param nodeIds Member node IDs, in response order
+     * @param preparedRead Parsed members for batch reads (may be null)
+     */
+    TagGroup(std::string name, std::vector<std::string> nodeIds,
+             std::shared_ptr<const OPCUAClient::PreparedRead> preparedRead);
+
+    const std::string& getName() const { return name_; }
+    const std::vector<std::string>& getNodeIds() const { return nodeIds_; }
+    size_t size() const { return nodeIds_.size(); }
+
+    /**
+     * @brief Get the members parsed for OPCUAClient::readPrepared()
+     * @return Prepared read with the members in getNodeIds() order, or null
+     */
+    const OPCUAClient::PreparedRead* getPreparedRead() const { return preparedRead_.get(); }
+
+private:
+    std::string name_;
+    std::vector<std::string> nodeIds_;
+    std::shared_ptr<const OPCUAClient::PreparedRead> preparedRead_;
+};
+
+/**
+ * @brief Thread-safe set of tag groups by name
+ *
+ * Groups come from the configuration at startup and from clients at run time.
+ * Lookups take a shared lock and hand out shared ownership, so a group can be
+ * replaced or removed while requests are still reading it. The number of
+ * groups and their size are bounded, since clients can define them.
+ */
+class TagGroupRegistry {
+public:
+    /**
+     * @brief Constructor
+     * @param opcClient Client that prepares group reads (may be null: groups then read by node ID)
+     * @param maxGroups Maximum number of groups
+     * @param maxGroupSize Maximum members per group
+     */
+    TagGroupRegistry(OPCUAClient* opcClient, size_t maxGroups, size_t maxGroupSize);
+
+    // Disable copy constructor and assignment operator
+    TagGroupRegistry(const TagGroupRegistry&) = delete;
+    TagGroupRegistry& operator=(const TagGroupRegistry&) = delete;
+
+    /**
+     * @brief Define a group, replacing any group of the same name
+     * @param name Group name (see isValidName)
+     * @param nodeIds Member node IDs, already validated by the caller
+     * @return The new group
+     * @throws std::invalid_argument if the name, the members or the limits do not allow it
+     */
+    std::shared_ptr<const TagGroup> define(const std::string& name, const std::vector<std::string>& nodeIds);
+
+    /**
+     * @brief Look up a group
+     * @param name Group name
+     * @return Group, or null if there is none of that name
+     */
+    std::shared_ptr<const TagGroup> find(const std::string& name) const;
+
+    /**
+     * @brief Remove a group
+     * @param name Group name
+     * @return True if the group existed
+     */
+    bool remove(const std::string& name);
+
+    /**
+     * @brief Get all groups
+     * @return Groups ordered by name
+     */
+    std::vector<std::shared_ptr<const TagGroup>> list() const;
+
+    /**
+     * @brief Get the number of groups
+     */
+    size_t size() const;
+
+    size_t getMaxGroups() const { return maxGroups_; }
+    size_t getMaxGroupSize() const { return maxGroupSize_; }
+
+    /**
+     * @brief Check a group name: 1-64 letters, digits, '_', '-' or '.'
+     * @param name Group name
+     * @return True if the name can be used in /iotgateway/group/{name}
+     */
+    static bool isValidName(const std::string& name);
+
+    static constexpr size_t MAX_NAME_LENGTH = 64;
+
+private:
+    OPCUAClient* opcClient_;                  // Prepares group reads (optional)
+    size_t maxGroups_;                        // Upper bound on groups
+    size_t maxGroupSize_;                     // Upper bound on members per group
+
+    mutable std::shared_mutex mutex_;         // Guards groups_
+    std::unordered_map<std::string, std::shared_ptr<const TagGroup>> groups_;
+};
+
+} // namespace opcua2http
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <cstdint>
+
+namespace opcua2http {
+
+/**
+ * @brief Single thread that runs all periodic background tasks
+ *
+ * Tasks are kept in a queue ordered by deadline. The thread sleeps until the
+ * earliest deadline and never wakes while no task is due, so an idle bridge
+ * costs no wakeups. Tasks due within COALESCE_WINDOW of each other run in the
+ * same wakeup.
+ *
+ * Deadlines advance by the interval from the previous deadline, so they do
+ * not drift with run time. If a task falls more than one interval behind,
+ * the missed periods are skipped and counted. A run that takes longer than
+ * its interval counts as an overrun and is logged.
+ *
+ * Tasks must not block; they delay every other task while they run.
+ */
+class TimerService {
+public:
+    using TaskId = uint64_t;
+    using Task = std::function<void()>;
+
+    /**
+     * @brief Per-task run-time accounting
+     */
+    struct TaskStats {
+        std::string name;                                   // Task name
+        std::chrono::milliseconds interval{0};              // Configured period
+        uint64_t runs{0};                                   // Completed runs
+        uint64_t overruns{0};                               // Runs that took longer than the interval
+        uint64_t missedPeriods{0};                          // Periods skipped because the task fell behind
+        uint64_t failures{0};                               // Runs that threw
+        std::chrono::microseconds totalRunTime{0};          // Sum of run times
+        std::chrono::microseconds maxRunTime{0};            // Longest run
+        std::chrono::microseconds lastRunTime{0};           // Most recent run
+        std::chrono::microseconds maxLateness{0};           // Largest delay past the deadline
+
+        double getAverageRunTimeMs() const {
+            return runs > 0 ? totalRunTime.count() / 1000.0 / static_cast<double>(runs) : 0.0;
+        }
+    };
+
+    /**
+     * @brief Scheduler statistics for monitoring
+     */
+    struct ServiceStats {
+        size_t tasks{0};                // Registered tasks
+        uint64_t wakeups{0};            // Times the thread woke up
+        uint64_t idleWakeups{0};        // Wakeups that ran no task
+        uint64_t coalescedRuns{0};      // Runs that shared a wakeup with another task
+    };
+
+    /**
+     * @brief Tasks due within this window of a wakeup run in that wakeup
+     */
+    static constexpr std::chrono::milliseconds COALESCE_WINDOW{20};
+
+    /**
+     * @brief Constructor - the thread starts with start()
+     */
+    TimerService();
+
+    /**
+     * @brief Destructor - stops the thread
+     */
+    ~TimerService();
+
+    // Disable copy constructor and assignment operator
+    TimerService(const TimerService&) = delete;
+    TimerService& operator=(const TimerService&) = delete;
+
+    /**
+     * @brief Start the scheduler thread
+     * @return True if started, false if already running
+     */
+    bool start();
+
+    /**
+     * @brief Stop the scheduler thread, waiting for a running task to finish
+     *
+     * Registered tasks are kept and resume on the next start().
+     */
+    void stop();
+
+    /**
+     * @brief Check if the scheduler thread is running
+     * @return True if running
+     */
+    bool isRunning() const;
+
+    /**
+     * @brief Register a periodic task
+     * @param name Name used in logs and statistics
+     * @param interval Period between runs (must be positive)
+     * @param task Callback to run
+     * @param runImmediately Run the first time now instead of after one interval
+     * @return Task id for cancel(), or 0 if the interval is invalid
+     */
+    TaskId schedulePeriodic(const std::string& name,
+                            std::chrono::milliseconds interval,
+                            Task task,
+                            bool runImmediately = false);
+
+    /**
+     * @brief Remove a task
+     * @param id Task id returned by schedulePeriodic()
+     * @return True if the task existed
+     *
+     * When called from another thread while the task runs, waits for that run
+     * to finish, so the callback's captures may be destroyed afterwards.
+     */
+    bool cancel(TaskId id);
+
+    /**
+     * @brief Get run-time accounting for all tasks
+     * @return Statistics per task, ordered by id
+     */
+    std::vector<TaskStats> getTaskStats() const;
+
+    /**
+     * @brief Get scheduler statistics
+     * @return ServiceStats structure with current statistics
+     */
+    ServiceStats getStats() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry {
+        Task task;
+        Clock::time_point deadline;
+        TaskStats stats;
+    };
+
+    std::map<TaskId, Entry> tasks_;                          // Registered tasks
+    std::multimap<Clock::time_point, TaskId> deadlines_;     // Deadline -> task, earliest first
+    TaskId nextId_{1};
+    TaskId runningTask_{0};                                  // Task currently executing (0 = none)
+
+    mutable std::mutex timerMutex_;                          // Guards all of the above
+    std::condition_variable timerCondition_;                 // Wakes the thread on changes
+    std::condition_variable runFinished_;                    // Signals the end of a task run
+    std::thread timerThread_;
+    bool running_{false};
+
+    // Statistics (atomic for thread-safe access)
+    std::atomic<uint64_t> wakeups_{0};
+    std::atomic<uint64_t> idleWakeups_{0};
+    std::atomic<uint64_t> coalescedRuns_{0};
+
+    /**
+     * @brief Scheduler thread main loop
+     */
+    void timerLoop();
+
+    /**
+     * @brief Run one task and account for it
+     * @param id Task id
+     * @param lock Held lock, released while the task runs
+     */
+    void runTask(TaskId id, std::unique_lock<std::mutex>& lock);
+
+    /**
+     * @brief Remove the queued deadline of a task (call with timerMutex_ held)
+     * @param id Task id
+     * @param deadline Deadline the task is queued under
+     */
+    void removeDeadline(TaskId id, Clock::time_point deadline);
+};
+
+} // namespace opcua2http
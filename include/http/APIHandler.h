@@ -12,8 +12,20 @@
 #include "config/Configuration.h"
 #include "cache/CacheManager.h"
 #include "cache/CacheMetrics.h"
+#include "cache/LatencyHistogram.h"
+#include "cache/LockProfiler.h"
 #include "core/ReadStrategy.h"
 #include "core/CacheErrorHandler.h"
+#include "core/RequestTiming.h"
+#include "core/AllocationTracker.h"
+#include "core/TimerService.h"
+#include "cache/PerformanceMonitor.h"
+#include "http/MetricsExporter.h"
+#include "http/RequestTrace.h"
+#include "http/RateLimiter.h"
+#include "http/CredentialVerifier.h"
+#include "http/ResponseCache.h"
+#include "core/TagGroup.h"
 #include "opcua/OPCUAClient.h"
 #include "core/ReadResult.h"
 
@@ -24,7 +36,9 @@ namespace opcua2http {
  *
  * This class implements the REST API endpoints using the Crow framework.
  * It handles authentication, CORS, request parsing, and response formatting.
- * The main endpoint is /iotgateway/read for reading OPC UA node values.
+ * The main endpoint is /iotgateway/read for reading OPC UA node values;
+ * /iotgateway/group/{name} reads a named tag group defined in the configuration
+ * or through /iotgateway/groups.
  */
 class APIHandler {
 public:
@@ -35,6 +49,7 @@ public:
         bool success;           // Whether authentication succeeded
         std::string reason;     // Reason for failure (if any)
         std::string method;     // Authentication method used
+        bool rateLimited{false}; // Rejected by the rate limiter (429 rather than 401)
 
         static AuthResult createSuccess(const std::string& method) {
             return AuthResult{true, "", method};
@@ -43,6 +58,10 @@ public:
         static AuthResult createFailure(const std::string& reason) {
             return AuthResult{false, reason, ""};
         }
+
+        static AuthResult createRateLimited(const std::string& reason) {
+            return AuthResult{false, reason, "", true};
+        }
     };
 
     /**
@@ -59,6 +78,7 @@ public:
         std::chrono::steady_clock::time_point startTime; // Handler start time
         std::chrono::steady_clock::time_point lastRequest; // Last request time
         double averageResponseTimeMs;   // Average response time in milliseconds
+        LatencyHistogram::Snapshot responseTime; // Response time distribution
     };
 
     /**
@@ -99,6 +119,34 @@ public:
      */
     crow::response handleReadRequest(const crow::request& req);
 
+    /**
+     * @brief Handle GET /iotgateway/group/{name}: read every member of a tag group
+     * @param req HTTP request object
+     * @param name Group name
+     * @return HTTP response with the members' values in group order, 404 for an unknown group
+     */
+    crow::response handleGroupReadRequest(const crow::request& req, const std::string& name);
+
+    /**
+     * @brief Handle POST /iotgateway/groups: define or replace a tag group
+     * @param req HTTP request with a {"name": ..., "ids": [...]} body
+     * @return 201 with the group, or 400 for an invalid definition
+     */
+    crow::response handleGroupDefineRequest(const crow::request& req);
+
+    /**
+     * @brief Handle GET /iotgateway/groups: list tag groups
+     * @return HTTP response with every group's name and node IDs
+     */
+    crow::response handleGroupListRequest();
+
+    /**
+     * @brief Handle DELETE /iotgateway/group/{name}
+     * @param name Group name
+     * @return 200 if the group was removed, 404 if there was none
+     */
+    crow::response handleGroupDeleteRequest(const std::string& name);
+
     /**
      * @brief Handle health check endpoint
      * @return HTTP response with system health information
@@ -126,11 +174,62 @@ public:
      */
     RequestStats getStats() const;
 
+    /**
+     * @brief Get the per-client rate limiter
+     */
+    const RateLimiter& getRateLimiter() const { return rateLimiter_; }
+
+    /**
+     * @brief Get the tag groups served by /iotgateway/group/{name}
+     */
+    const TagGroupRegistry& getTagGroups() const { return tagGroups_; }
+
+    /**
+     * @brief Get the cache of whole /iotgateway/read response bodies
+     */
+    const ResponseCache& getResponseCache() const { return responseCache_; }
+
     /**
      * @brief Reset request statistics
      */
     void resetStats();
 
+    /**
+     * @brief Set the timer service whose task accounting /status reports
+     * @param timerService Timer service (optional, may be null)
+     */
+    void setTimerService(const TimerService* timerService);
+
+    /**
+     * @brief Set the performance monitor whose timings /status reports
+     * @param performanceMonitor Performance monitor (optional, may be null)
+     */
+    void setPerformanceMonitor(const PerformanceMonitor* performanceMonitor);
+
+    /**
+     * @brief Set the exporter that serves /metrics
+     * @param metricsExporter Metrics exporter (optional; /metrics is 404 without it)
+     */
+    void setMetricsExporter(MetricsExporter* metricsExporter);
+
+    /**
+     * @brief Set the recorder that traces incoming read requests
+     * @param recorder Request trace recorder (optional; nothing is recorded without it)
+     */
+    void setRequestTraceRecorder(RequestTraceRecorder* recorder);
+
+    /**
+     * @brief Set the lock profiler reported by /debug/locks
+     * @param profiler Lock profiler (optional; /debug/locks is 404 without it)
+     */
+    void setLockProfiler(LockProfiler* profiler);
+
+    /**
+     * @brief Get the end-to-end /iotgateway/read latency histogram
+     * @return Histogram updated on every read request
+     */
+    const LatencyHistogram& getRequestLatency() const;
+
     /**
      * @brief Enable or disable detailed request logging
      * @param enabled Whether detailed logging should be enabled
@@ -161,11 +260,13 @@ protected:
     bool validateBasicAuth(const std::string& authHeader);
 
     /**
-     * @brief Rate limiting for authentication attempts
-     * @param clientIP Client IP address
-     * @return True if request is allowed, false if rate limited
+     * @brief Validate node IDs and define a tag group
+     * @param name Group name
+     * @param nodeIds Member node IDs
+     * @return The new group
+     * @throws std::invalid_argument for an invalid node ID or a definition TagGroupRegistry refuses
      */
-    bool checkRateLimit(const std::string& clientIP);
+    std::shared_ptr<const TagGroup> defineTagGroup(const std::string& name, const std::vector<std::string>& nodeIds);
 
     /**
      * @brief Record failed authentication attempt
@@ -173,13 +274,6 @@ protected:
      */
     void recordFailedAuth(const std::string& clientIP);
 
-    /**
-     * @brief Check if IP is temporarily blocked due to failed attempts
-     * @param clientIP Client IP address
-     * @return True if IP is blocked, false otherwise
-     */
-    bool isIPBlocked(const std::string& clientIP);
-
 
 
     /**
@@ -190,6 +284,30 @@ protected:
      */
     crow::response buildJSONResponse(const nlohmann::json& data, int statusCode = 200);
 
+    /**
+     * @brief Build JSON response from an already serialized body
+     * @param body Serialized JSON document
+     * @param statusCode HTTP status code (default: 200)
+     * @return HTTP response with the same headers as buildJSONResponse
+     */
+    crow::response buildRawJSONResponse(std::string body, int statusCode = 200);
+
+    /**
+     * @brief Check whether a read asks for its stage timings (`?debug=timing`)
+     * @param req HTTP request
+     * @return True if the response should carry a timing field and header
+     */
+    static bool isTimingDebugRequested(const crow::request& req);
+
+    /**
+     * @brief Add the Server-Timing header if enabled or requested
+     * @param req HTTP request
+     * @param response Response to add the header to
+     * @param timing Stage timings of the request
+     */
+    void addServerTiming(const crow::request& req, crow::response& response,
+                         const RequestTiming& timing) const;
+
     /**
      * @brief Build error response
      * @param statusCode HTTP status code
@@ -212,6 +330,25 @@ protected:
      */
     nlohmann::json buildReadResponse(const std::vector<ReadResult>& results);
 
+    /**
+     * @brief Serialize a read response straight into a string
+     * @param results Vector of ReadResult structures
+     * @param extraFields Object with fields to add next to readResults (null for none)
+     * @return Same text as dumping buildReadResponse(results) with extraFields merged in
+     *
+     * Results served from the cache carry their JSON already serialized, so for
+     * fresh hits this is mostly copying bytes rather than formatting each value.
+     */
+    std::string buildReadResponseBody(const std::vector<ReadResult>& results,
+                                      const nlohmann::json& extraFields = nullptr);
+
+    /**
+     * @brief Read nodes and serialize the response for the response cache
+     * @param nodeIds Validated node IDs
+     * @return Body with the node and serialized cache entry behind each result
+     */
+    std::shared_ptr<const ResponseCache::Response> buildCachedReadResponse(const std::vector<std::string>& nodeIds);
+
     /**
      * @brief Build paginated response for large result sets
      * @param results Vector of ReadResult structures
@@ -231,6 +368,12 @@ protected:
     nlohmann::json buildResponseWithMetadata(const std::vector<ReadResult>& results,
                                            bool includeMetadata = true);
 
+    /**
+     * @brief Build the circuit breaker section of /health and /status
+     * @return JSON object with breaker state and counters
+     */
+    nlohmann::json buildCircuitBreakerStatus() const;
+
     /**
      * @brief Format timestamp as ISO 8601 string
      * @param timestamp Unix timestamp in milliseconds
@@ -238,6 +381,22 @@ protected:
      */
     std::string formatTimestamp(uint64_t timestamp);
 
+    // Request parsing (protected for tests and benchmarks)
+
+    /**
+     * @brief Parse node IDs from query parameter
+     * @param idsParam Comma-separated node IDs parameter
+     * @return Vector of individual node ID strings
+     */
+    std::vector<std::string> parseNodeIds(const std::string& idsParam);
+
+    /**
+     * @brief Validate node ID format
+     * @param nodeId Node ID to validate
+     * @return True if format is valid, false otherwise
+     */
+    bool validateNodeId(const std::string& nodeId);
+
 private:
     // Core components
     CacheManager* cacheManager_;                    // Cache manager reference
@@ -245,6 +404,11 @@ private:
     OPCUAClient* opcClient_;                       // OPC UA client reference
     CacheMetrics* cacheMetrics_;                   // Cache metrics reference (optional)
     CacheErrorHandler* errorHandler_;              // Error handler reference (optional)
+    const TimerService* timerService_{nullptr};    // Periodic task scheduler (optional)
+    const PerformanceMonitor* performanceMonitor_{nullptr}; // Hot-path timings (optional)
+    MetricsExporter* metricsExporter_{nullptr};    // Prometheus /metrics renderer (optional)
+    RequestTraceRecorder* traceRecorder_{nullptr}; // Read request trace (optional)
+    LockProfiler* lockProfiler_{nullptr};          // Mutex wait/hold profiling (optional)
     Configuration config_;                         // Configuration settings
 
     // Statistics (atomic for thread-safe access)
@@ -257,20 +421,13 @@ private:
     mutable std::atomic<uint64_t> cacheMisses_{0};
     std::chrono::steady_clock::time_point startTime_;
     mutable std::atomic<std::chrono::steady_clock::time_point> lastRequest_;
-    mutable std::atomic<double> averageResponseTimeMs_{0.0};
+    LatencyHistogram requestLatency_;              // End-to-end /iotgateway/read latency
 
     // Configuration
     std::atomic<bool> detailedLoggingEnabled_{false};
 
     // Private helper methods
 
-    /**
-     * @brief Parse node IDs from query parameter
-     * @param idsParam Comma-separated node IDs parameter
-     * @return Vector of individual node ID strings
-     */
-    std::vector<std::string> parseNodeIds(const std::string& idsParam);
-
     /**
      * @brief Process a single node ID request
      * @param nodeId Node ID to process
@@ -292,21 +449,14 @@ private:
      * @param req HTTP request
      * @return API key string, empty if not found
      */
-    std::string extractAPIKey(const crow::request& req);
+    const std::string& extractAPIKey(const crow::request& req);
 
     /**
      * @brief Extract Authorization header from request
      * @param req HTTP request
      * @return Authorization header value, empty if not found
      */
-    std::string extractAuthHeader(const crow::request& req);
-
-    /**
-     * @brief Decode Base64 string (for Basic Auth)
-     * @param encoded Base64 encoded string
-     * @return Decoded string
-     */
-    std::string decodeBase64(const std::string& encoded);
+    const std::string& extractAuthHeader(const crow::request& req);
 
     // Request validation methods
 
@@ -317,13 +467,6 @@ private:
      */
     bool validateRequest(const crow::request& req);
 
-    /**
-     * @brief Validate node ID format
-     * @param nodeId Node ID to validate
-     * @return True if format is valid, false otherwise
-     */
-    bool validateNodeId(const std::string& nodeId);
-
     /**
      * @brief Check if request origin is allowed (CORS)
      * @param origin Origin header value
@@ -358,7 +501,8 @@ private:
     /**
      * @brief Get client IP address from request
      * @param req HTTP request
-     * @return Client IP address string
+     * @return Peer address, or the first X-Forwarded-For / X-Real-IP address
+     *         when TRUST_PROXY_HEADERS is set
      */
     std::string getClientIP(const crow::request& req);
 
@@ -432,15 +576,25 @@ private:
 
 
 private:
-    // Rate limiting data structures
-    struct RateLimitInfo {
-        std::chrono::steady_clock::time_point lastAttempt;
-        int failedAttempts;
-        std::chrono::steady_clock::time_point blockUntil;
-    };
+    // Per-client request rate and failed authentication limits
+    RateLimiter rateLimiter_;
 
-    mutable std::mutex rateLimitMutex_;
-    std::unordered_map<std::string, RateLimitInfo> rateLimitMap_;
+    // Expected API key and Basic credentials, encoded once from config_
+    CredentialVerifier credentials_;
+
+    // Named node lists read by /iotgateway/group/{name}
+    TagGroupRegistry tagGroups_;
+
+    // Bodies of repeated /iotgateway/read requests, reused while their entries are unchanged
+    ResponseCache responseCache_;
+
+    /**
+     * @brief Authenticate, time and account a request served by handler
+     * @param req HTTP request
+     * @param handler Produces the response once the request is authenticated
+     * @return Handler response, or 401/429 if authentication fails
+     */
+    crow::response serveAuthenticated(const crow::request& req, const std::function<crow::response()>& handler);
 };
 
 } // namespace opcua2http
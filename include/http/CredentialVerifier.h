@@ -0,0 +1,77 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace opcua2http {
+
+/**
+ * @brief Checks request credentials against the configured API key and Basic auth user
+ *
+ * The expected X-API-Key value and the expected Basic credentials (the Base64
+ * of "user:password") are built once at construction. Verifying a request is
+ * then a single comparison against the header as received, with no decoding
+ * or allocation.
+ *
+ * Comparisons take time that depends only on the expected value's length,
+ * never on how much of the supplied value matches, so response timing does
+ * not reveal the secret byte by byte.
+ *
+ * The Basic scheme name is matched case-insensitively. The credentials must be
+ * in standard padded Base64, which is what HTTP clients send.
+ */
+class CredentialVerifier {
+public:
+    /**
+     * @brief Constructor
+     * @param apiKey Expected API key (empty = API key authentication off)
+     * @param username Basic auth user (empty = Basic auth off)
+     * @param password Basic auth password (empty = Basic auth off)
+     */
+    CredentialVerifier(const std::string& apiKey, const std::string& username, const std::string& password);
+
+    /**
+     * @brief Check if API key authentication is configured
+     */
+    bool hasAPIKey() const { return !apiKey_.empty(); }
+
+    /**
+     * @brief Check if Basic authentication is configured
+     */
+    bool hasBasicAuth() const { return !basicCredentials_.empty(); }
+
+    /**
+     * @brief Verify an X-API-Key header value
+     * @param apiKey Header value
+     * @return True if API key authentication is configured and the key matches
+     */
+    bool verifyAPIKey(std::string_view apiKey) const noexcept;
+
+    /**
+     * @brief Verify an Authorization header value
+     * @param header Header value, e.g. "Basic dXNlcjpwYXNz"
+     * @return True if Basic authentication is configured and the credentials match
+     */
+    bool verifyAuthorizationHeader(std::string_view header) const noexcept;
+
+    /**
+     * @brief Compare a supplied secret with the expected one in constant time
+     * @param expected Expected value; its length alone determines the running time
+     * @param actual Supplied value
+     * @return True if both are equal
+     */
+    static bool constantTimeEquals(std::string_view expected, std::string_view actual) noexcept;
+
+    /**
+     * @brief Encode bytes as standard padded Base64
+     * @param data Bytes to encode
+     * @return Base64 text
+     */
+    static std::string encodeBase64(std::string_view data);
+
+private:
+    std::string apiKey_;               // Expected X-API-Key value
+    std::string basicCredentials_;     // Expected Base64 of "user:password", without the scheme
+};
+
+} // namespace opcua2http
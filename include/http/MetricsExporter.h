@@ -0,0 +1,170 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#include "cache/LatencyHistogram.h"
+
+namespace opcua2http {
+
+class CacheManager;
+class CacheMetrics;
+class BackgroundUpdater;
+class SubscriptionManager;
+class ReconnectionManager;
+class CacheErrorHandler;
+class PerformanceMonitor;
+
+/**
+ * @brief Renders component metrics in the Prometheus text exposition format
+ *
+ * Served on /metrics as a cheap alternative to /status for frequent
+ * scraping. Only lock-free counters and histogram snapshots are read: no
+ * cache walk, no OPC UA health read and no lock taken on a hot path. Output
+ * is formatted straight into a buffer that is reused across scrapes, so once
+ * it has grown to size a scrape allocates nothing but the response copy.
+ *
+ * Every source is optional and set before the HTTP server starts.
+ */
+class MetricsExporter {
+public:
+    /**
+     * @brief Content-Type of the rendered text
+     */
+    static constexpr const char* CONTENT_TYPE = "text/plain; version=0.0.4; charset=utf-8";
+
+    /**
+     * @brief Histogram bucket bounds in nanoseconds (le labels, in seconds)
+     */
+    static constexpr std::array<uint64_t, 16> HISTOGRAM_BOUNDS_NS{
+        100000, 250000, 500000,
+        1000000, 2500000, 5000000,
+        10000000, 25000000, 50000000,
+        100000000, 250000000, 500000000,
+        1000000000, 2500000000, 5000000000, 10000000000
+    };
+
+    MetricsExporter() = default;
+
+    // Disable copy constructor and assignment operator
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    /**
+     * @brief Set the cache manager whose counters are exported
+     * @param cacheManager Cache manager (optional, may be null)
+     */
+    void setCacheManager(const CacheManager* cacheManager);
+
+    /**
+     * @brief Set the cache metrics whose read path latencies are exported
+     * @param cacheMetrics Cache metrics (optional, may be null)
+     */
+    void setCacheMetrics(const CacheMetrics* cacheMetrics);
+
+    /**
+     * @brief Set the background updater whose counters are exported
+     * @param backgroundUpdater Background updater (optional, may be null)
+     */
+    void setBackgroundUpdater(const BackgroundUpdater* backgroundUpdater);
+
+    /**
+     * @brief Set the subscription manager whose counters are exported
+     * @param subscriptionManager Subscription manager (optional, may be null)
+     */
+    void setSubscriptionManager(const SubscriptionManager* subscriptionManager);
+
+    /**
+     * @brief Set the reconnection manager whose counters are exported
+     * @param reconnectionManager Reconnection manager (optional, may be null)
+     */
+    void setReconnectionManager(const ReconnectionManager* reconnectionManager);
+
+    /**
+     * @brief Set the error handler whose counters are exported
+     * @param errorHandler Error handler (optional, may be null)
+     */
+    void setErrorHandler(const CacheErrorHandler* errorHandler);
+
+    /**
+     * @brief Set the performance monitor whose OPC read latencies are exported
+     * @param performanceMonitor Performance monitor (optional, may be null)
+     */
+    void setPerformanceMonitor(const PerformanceMonitor* performanceMonitor);
+
+    /**
+     * @brief Set the end-to-end HTTP request latency histogram
+     * @param requestLatency Histogram owned by the API handler (optional)
+     */
+    void setRequestLatency(const LatencyHistogram* requestLatency);
+
+    /**
+     * @brief Render all metrics
+     * @param out Receives the exposition text (replaced, not appended)
+     *
+     * Concurrent scrapes are serialized on the shared buffer.
+     */
+    void render(std::string& out);
+
+    /**
+     * @brief Get the number of completed renders
+     * @return Scrape count
+     */
+    uint64_t getScrapeCount() const;
+
+private:
+    const CacheManager* cacheManager_{nullptr};
+    const CacheMetrics* cacheMetrics_{nullptr};
+    const BackgroundUpdater* backgroundUpdater_{nullptr};
+    const SubscriptionManager* subscriptionManager_{nullptr};
+    const ReconnectionManager* reconnectionManager_{nullptr};
+    const CacheErrorHandler* errorHandler_{nullptr};
+    const PerformanceMonitor* performanceMonitor_{nullptr};
+    const LatencyHistogram* requestLatency_{nullptr};
+
+    std::mutex renderMutex_;            // Guards buffer_; only scrapes take it
+    std::string buffer_;                // Reused exposition buffer
+    std::atomic<uint64_t> scrapes_{0};
+    std::chrono::steady_clock::time_point startTime_{std::chrono::steady_clock::now()};
+
+    // One section per source; each is skipped while its source is unset
+    void renderCache();
+    void renderBackgroundUpdater();
+    void renderSubscriptions();
+    void renderReconnection();
+    void renderErrorHandling();
+    void renderLatency();
+
+    /**
+     * @brief Write the HELP and TYPE lines of a metric family
+     */
+    void writeHeader(const char* name, const char* type, const char* help);
+
+    /**
+     * @brief Write a complete counter or gauge family with a single sample
+     *
+     * The double counter is for accumulated durations in seconds.
+     */
+    void writeCounter(const char* name, const char* help, uint64_t value);
+    void writeCounter(const char* name, const char* help, double value);
+    void writeGauge(const char* name, const char* help, double value);
+
+    /**
+     * @brief Write one histogram series with cumulative buckets
+     * @param name Metric family name
+     * @param labelName Label that distinguishes series, or nullptr for none
+     * @param labelValue Value of that label
+     * @param snapshot Histogram contents
+     *
+     * A source bucket counts toward the first bound at or above its upper
+     * edge, so bucket counts are accurate to the source resolution (~6%).
+     */
+    void writeHistogram(const char* name, const char* labelName, const char* labelValue,
+                        const LatencyHistogram::Snapshot& snapshot);
+};
+
+} // namespace opcua2http
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace opcua2http {
+
+/**
+ * @brief Per-client request rate limiter and failed authentication blocker
+ *
+ * Each client (keyed by peer address) has a token bucket refilled at
+ * requestsPerSecond up to burst tokens, a count of recent failed
+ * authentications and, after maxFailedAuth failures, a block deadline. A
+ * request is admitted with a single lookup: check() tests the block and takes
+ * a token in one critical section.
+ *
+ * Clients are spread over SHARD_COUNT independently locked maps, so requests
+ * from different clients rarely contend. Memory is bounded by maxClients. An
+ * entry whose bucket has refilled, whose failures have expired and which is
+ * not blocked carries no state and is dropped when its shard needs room; only
+ * when a shard is full of live entries is the least recently seen one
+ * evicted, blocked clients last.
+ *
+ * A rate of 0 leaves requests unlimited; clients are then tracked only once
+ * they fail authentication.
+ */
+class RateLimiter {
+public:
+    /**
+     * @brief Outcome of check()
+     */
+    enum class Decision {
+        ALLOWED,
+        RATE_LIMITED,   // Bucket empty
+        BLOCKED         // Too many failed authentications
+    };
+
+    /**
+     * @brief Limits, normally taken from the configuration
+     */
+    struct Settings {
+        double requestsPerSecond{0.0};                      // Per client (0 = unlimited)
+        double burst{0.0};                                  // Bucket size (0 = one second of rate)
+        int maxFailedAuth{5};                               // Failures within FAILURE_WINDOW before blocking (0 = never)
+        std::chrono::seconds blockDuration{std::chrono::minutes(15)};
+        size_t maxClients{10000};                           // Upper bound on tracked clients
+    };
+
+    /**
+     * @brief Limiter statistics for monitoring
+     */
+    struct Stats {
+        uint64_t allowed{0};            // Requests admitted
+        uint64_t rateLimited{0};        // Requests rejected for an empty bucket
+        uint64_t blockedRequests{0};    // Requests rejected while blocked
+        uint64_t blocks{0};             // Clients blocked after failed authentications
+        uint64_t evictions{0};          // Live entries evicted for room
+        size_t trackedClients{0};       // Entries currently held
+    };
+
+    static constexpr size_t SHARD_COUNT = 64;
+
+    /**
+     * @brief Failures further apart than this do not add up
+     */
+    static constexpr std::chrono::seconds FAILURE_WINDOW{60};
+
+    /**
+     * @brief Constructor - creates a limiter with default Settings
+     */
+    RateLimiter();
+
+    // Disable copy constructor and assignment operator
+    RateLimiter(const RateLimiter&) = delete;
+    RateLimiter& operator=(const RateLimiter&) = delete;
+
+    /**
+     * @brief Apply new limits and forget all clients; call before serving requests
+     * @param settings Limits
+     */
+    void configure(const Settings& settings);
+
+    /**
+     * @brief Admit or reject a request
+     * @param client Client key (peer address)
+     * @param now Current time
+     * @return Decision; ALLOWED consumes one token
+     */
+    Decision check(const std::string& client,
+                   std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+
+    /**
+     * @brief Record a failed authentication, blocking the client once maxFailedAuth is reached
+     * @param client Client key (peer address)
+     * @param now Current time
+     * @return True if this failure blocked the client
+     */
+    bool recordFailure(const std::string& client,
+                       std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+
+    /**
+     * @brief Get current limiter statistics
+     * @return Stats structure with current statistics
+     */
+    Stats getStats() const;
+
+    /**
+     * @brief Get the limits in effect
+     */
+    Settings getSettings() const { return settings_; }
+
+private:
+    struct Entry {
+        double tokens{0.0};
+        std::chrono::steady_clock::time_point lastSeen;     // Last check or failure; tokens are current as of here
+        std::chrono::steady_clock::time_point lastFailure;
+        std::chrono::steady_clock::time_point blockUntil;
+        int failures{0};
+    };
+
+    struct alignas(64) Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<std::string, Entry> entries;
+    };
+
+    Settings settings_;
+    double burst_{0.0};
+    size_t shardCapacity_{1};
+    std::array<Shard, SHARD_COUNT> shards_;
+
+    // Statistics (atomic for thread-safe access)
+    std::atomic<uint64_t> allowed_{0};
+    std::atomic<uint64_t> rateLimited_{0};
+    std::atomic<uint64_t> blockedRequests_{0};
+    std::atomic<uint64_t> blocks_{0};
+    std::atomic<uint64_t> evictions_{0};
+
+    Shard& shardFor(const std::string& client);
+
+    /**
+     * @brief Find or create a client's entry (call with the shard mutex held)
+     * @return Entry; new entries start with a full bucket
+     */
+    Entry& entryFor(Shard& shard, const std::string& client, std::chrono::steady_clock::time_point now);
+
+    /**
+     * @brief Make room in a full shard (call with the shard mutex held)
+     */
+    void makeRoom(Shard& shard, std::chrono::steady_clock::time_point now);
+
+    /**
+     * @brief Add tokens accrued since the entry was last seen
+     */
+    void refill(Entry& entry, std::chrono::steady_clock::time_point now) const;
+
+    /**
+     * @brief Check if dropping an entry would lose nothing
+     * @return True if the bucket is full, failures expired and no block is active
+     */
+    bool isForgettable(const Entry& entry, std::chrono::steady_clock::time_point now) const;
+};
+
+} // namespace opcua2http
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace opcua2http {
+
+/**
+ * @brief One recorded /iotgateway/read request
+ */
+struct RequestTraceRecord {
+    uint64_t timestampUs{0};           // Arrival time, microseconds since the Unix epoch
+    std::string client;                // Client address as seen by the API handler
+    std::vector<std::string> nodeIds;  // Requested node IDs, in request order
+};
+
+/**
+ * @brief Binary request trace file format
+ *
+ * A file starts with an 8-byte magic and a 2-byte version followed by 2
+ * reserved bytes. Each record is a 4-byte payload length followed by the
+ * payload: 8-byte timestamp, 2-byte client length and client bytes, 4-byte
+ * node ID count and, per node ID, a 2-byte length and the ID bytes. All
+ * integers are little-endian. Records are only ever appended, so a trace cut
+ * short by a crash loses at most its last record.
+ */
+struct RequestTraceFormat {
+    static constexpr char MAGIC[8] = {'O', '2', 'H', 'T', 'R', 'A', 'C', 'E'};
+    static constexpr uint16_t VERSION = 1;
+    static constexpr size_t HEADER_SIZE = 12;
+    static constexpr uint32_t MAX_RECORD_SIZE = 16 * 1024 * 1024;   // Sanity limit for readers
+};
+
+/**
+ * @brief Opt-in recorder of incoming read requests (REQUEST_TRACE_FILE)
+ *
+ * record() only encodes the request into an in-memory buffer under a short
+ * lock; a writer thread appends the buffer to the file every FLUSH_INTERVAL
+ * or as soon as it holds FLUSH_THRESHOLD bytes. If the disk cannot keep up
+ * and the buffer reaches its limit, records are dropped and counted instead
+ * of slowing down requests.
+ */
+class RequestTraceRecorder {
+public:
+    /**
+     * @brief Recorder statistics for monitoring
+     */
+    struct Stats {
+        uint64_t recorded{0};       // Records accepted into the buffer
+        uint64_t dropped{0};        // Records dropped because the buffer was full
+        uint64_t bytesWritten{0};   // Bytes appended to the file, header excluded
+        uint64_t writeErrors{0};    // Failed file writes (their records are lost)
+    };
+
+    static constexpr std::chrono::milliseconds FLUSH_INTERVAL{200};
+    static constexpr size_t FLUSH_THRESHOLD = 256 * 1024;
+
+    /**
+     * @brief Constructor
+     * @param path Trace file; created if missing, appended to otherwise
+     * @param maxBufferBytes Limit of unwritten data held in memory
+     */
+    RequestTraceRecorder(std::string path, size_t maxBufferBytes);
+
+    /**
+     * @brief Destructor - writes out buffered records and closes the file
+     */
+    ~RequestTraceRecorder();
+
+    // Disable copy constructor and assignment operator
+    RequestTraceRecorder(const RequestTraceRecorder&) = delete;
+    RequestTraceRecorder& operator=(const RequestTraceRecorder&) = delete;
+
+    /**
+     * @brief Open the file and start the writer thread
+     * @return False if the file cannot be opened or is not a trace file
+     */
+    bool start();
+
+    /**
+     * @brief Write out buffered records and stop the writer thread
+     */
+    void stop();
+
+    /**
+     * @brief Record one read request
+     * @param timestampUs Arrival time, microseconds since the Unix epoch
+     * @param client Client address
+     * @param nodeIds Requested node IDs
+     */
+    void record(uint64_t timestampUs, const std::string& client, const std::vector<std::string>& nodeIds);
+
+    /**
+     * @brief Get the trace file path
+     */
+    const std::string& getPath() const { return path_; }
+
+    /**
+     * @brief Check if the recorder is running
+     */
+    bool isRunning() const { return running_; }
+
+    /**
+     * @brief Get recorder statistics
+     */
+    Stats getStats() const;
+
+    /**
+     * @brief Encode one record (length prefix included) and append it to out
+     */
+    static void encodeRecord(uint64_t timestampUs, const std::string& client,
+                             const std::vector<std::string>& nodeIds, std::string& out);
+
+private:
+    std::string path_;
+    size_t maxBufferBytes_;
+    std::ofstream file_;
+
+    mutable std::mutex bufferMutex_;
+    std::condition_variable flushCondition_;
+    std::string buffer_;                 // Encoded records not yet handed to the writer
+    std::atomic<bool> running_{false};
+    std::thread writerThread_;
+
+    std::atomic<uint64_t> recorded_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> bytesWritten_{0};
+    std::atomic<uint64_t> writeErrors_{0};
+
+    void writerLoop();
+    void writeOut(const std::string& data);
+};
+
+/**
+ * @brief Sequential reader of a request trace file
+ */
+class RequestTraceReader {
+public:
+    /**
+     * @brief Open a trace file and check its header
+     * @param path Trace file
+     * @return False if the file cannot be opened or is not a trace file
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Read the next record
+     * @param record Receives the record
+     * @return False at the end of the trace or on a damaged record (see isTruncated)
+     */
+    bool next(RequestTraceRecord& record);
+
+    /**
+     * @brief Check whether reading stopped at an incomplete or damaged record
+     */
+    bool isTruncated() const { return truncated_; }
+
+    /**
+     * @brief Get the reason open() failed
+     */
+    const std::string& getError() const { return error_; }
+
+    /**
+     * @brief Read a whole trace file
+     * @param path Trace file
+     * @param records Receives the records
+     * @param error Receives the reason on failure
+     * @return False if the file cannot be opened or is not a trace file
+     */
+    static bool readAll(const std::string& path, std::vector<RequestTraceRecord>& records, std::string& error);
+
+private:
+    std::ifstream file_;
+    std::string payload_;                // Reused record buffer
+    bool truncated_{false};
+    std::string error_;
+};
+
+} // namespace opcua2http
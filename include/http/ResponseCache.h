@@ -0,0 +1,148 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/RequestTiming.h"
+
+namespace opcua2http {
+
+class CacheManager;
+
+/**
+ * @brief Cache of whole read response bodies keyed by the requested node list
+ *
+ * Wallboards and similar clients poll with the same ids list over and over.
+ * Each stored body keeps the serialized JSON of every cache entry it was built
+ * from (CacheEntry::json). A write to an entry replaces that buffer, so the
+ * buffer's identity is the entry's version. A stored body is reused while every
+ * entry is FRESH and still holds the same buffer; anything else rebuilds it
+ * through the normal read path, which then also schedules refreshes.
+ *
+ * Only bodies whose results all came from the cache are stored. Results read
+ * from the server or rewritten by a fallback carry no serialized buffer and
+ * so make the body uncacheable.
+ *
+ * Concurrent requests for the same list while no valid body exists share one
+ * build: the first one runs it and the others wait for its result, or its
+ * exception.
+ */
+class ResponseCache {
+public:
+    /**
+     * @brief A serialized read response and the entry versions it reflects
+     */
+    struct Response {
+        std::string body;                                           // Serialized response
+        std::vector<std::string> nodeIds;                           // Node of each result, in order
+        std::vector<std::shared_ptr<const std::string>> versions;   // CacheEntry::json of each result (null = not from the cache)
+        size_t failures{0};                                         // Results with success == false
+        RequestTiming::NodeCounts paths;                            // Nodes per read path taken by the build
+
+        /**
+         * @brief Check whether every result came from a cache entry
+         */
+        bool isCacheable() const;
+    };
+
+    using Builder = std::function<std::shared_ptr<const Response>()>;
+
+    /**
+     * @brief How getOrBuild() came by the response it returned
+     */
+    enum class Source {
+        BUILT,      // This call ran the builder
+        STORED,     // Stored body still valid: every entry FRESH and unchanged
+        SHARED      // Waited for a build started by another call
+    };
+
+    /**
+     * @brief Response cache statistics for monitoring
+     */
+    struct Stats {
+        uint64_t hits{0};               // Stored bodies reused
+        uint64_t builds{0};             // Bodies built through the read path
+        uint64_t sharedBuilds{0};       // Requests that waited for a build already running
+        uint64_t invalidated{0};        // Stored bodies dropped for a changed or aged entry
+        uint64_t evictions{0};          // Stored bodies dropped for room
+        size_t entries{0};              // Bodies currently held
+    };
+
+    /**
+     * @brief Constructor
+     * @param cacheManager Cache the stored bodies are validated against
+     * @param maxEntries Node lists kept at most (0 = cache off, every request builds)
+     */
+    ResponseCache(CacheManager* cacheManager, size_t maxEntries);
+
+    // Disable copy constructor and assignment operator
+    ResponseCache(const ResponseCache&) = delete;
+    ResponseCache& operator=(const ResponseCache&) = delete;
+
+    /**
+     * @brief Return the stored body for a node list, or build it once
+     * @param nodeIds Parsed node IDs in request order
+     * @param build Runs the read and serializes it; called at most once for concurrent callers
+     * @param source Set to where the response came from (optional)
+     * @return Response to send
+     * @throws Whatever build throws, also to callers that waited for it
+     */
+    std::shared_ptr<const Response> getOrBuild(const std::vector<std::string>& nodeIds, const Builder& build,
+                                               Source* source = nullptr);
+
+    /**
+     * @brief Drop every stored body
+     */
+    void clear();
+
+    /**
+     * @brief Get current response cache statistics
+     * @return Stats structure with current statistics
+     */
+    Stats getStats() const;
+
+    /**
+     * @brief Check if responses are cached at all
+     */
+    bool isEnabled() const { return maxEntries_ > 0; }
+
+    /**
+     * @brief Build the key for a node list
+     * @param nodeIds Parsed node IDs in request order
+     * @return IDs joined with ','; order is kept since it is the response order
+     */
+    static std::string makeKey(const std::vector<std::string>& nodeIds);
+
+private:
+    struct Slot {
+        std::shared_ptr<const Response> response;                    // Last stored body (may be null)
+        std::shared_future<std::shared_ptr<const Response>> pending; // Build in progress (invalid when none)
+    };
+
+    /**
+     * @brief Make room for one more slot; caller holds mutex_
+     */
+    void evictOneLocked();
+
+    CacheManager* cacheManager_;
+    size_t maxEntries_;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Slot> slots_;
+
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> builds_{0};
+    std::atomic<uint64_t> sharedBuilds_{0};
+    std::atomic<uint64_t> invalidated_{0};
+    std::atomic<uint64_t> evictions_{0};
+};
+
+} // namespace opcua2http
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <string>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace opcua2http {
+
+/**
+ * @brief Circuit breaker in front of the OPC UA read path
+ *
+ * Counts consecutive server-level read failures (lost connection, timeouts,
+ * closed sessions). Once the failure threshold is reached the circuit opens
+ * and reads are rejected immediately, without waiting on the client, so
+ * callers can answer from cache instead of queueing behind a dead server.
+ *
+ * After the open timeout the circuit becomes half-open and lets a trickle of
+ * probe reads through, at most one per probe interval. A successful probe
+ * closes the circuit; a failed one opens it again for another open timeout.
+ * Reconnecting the client closes the circuit as well.
+ *
+ * A failure threshold of 0 disables the breaker.
+ */
+class CircuitBreaker {
+public:
+    /**
+     * @brief Circuit state
+     */
+    enum class State {
+        CLOSED,     // Reads pass through
+        OPEN,       // Reads are rejected
+        HALF_OPEN   // Probe reads are let through to test recovery
+    };
+
+    /**
+     * @brief Circuit breaker statistics for monitoring
+     */
+    struct BreakerStats {
+        State state{State::CLOSED};                 // Current state
+        int failureThreshold{0};                    // Consecutive failures that open the circuit (0 = disabled)
+        uint32_t consecutiveFailures{0};            // Failures since the last success
+        uint64_t trips{0};                          // Times the circuit opened
+        uint64_t rejectedReads{0};                  // Reads rejected while open
+        uint64_t probes{0};                         // Probe reads let through while half-open
+        std::chrono::milliseconds openFor{0};       // Time since the circuit last opened (0 when closed)
+        std::chrono::milliseconds retryIn{0};       // Time until the next probe is allowed (0 when closed)
+    };
+
+    /**
+     * @brief Error reason attached to reads rejected by an open circuit
+     */
+    static constexpr const char* OPEN_ERROR = "Circuit breaker open";
+
+    /**
+     * @brief Constructor - creates a disabled breaker
+     */
+    CircuitBreaker();
+
+    // Disable copy constructor and assignment operator
+    CircuitBreaker(const CircuitBreaker&) = delete;
+    CircuitBreaker& operator=(const CircuitBreaker&) = delete;
+
+    /**
+     * @brief Configure the breaker and close the circuit
+     * @param failureThreshold Consecutive failures that open the circuit (0 = disabled)
+     * @param openTimeout Time the circuit stays open before probing
+     * @param probeInterval Minimum time between probe reads while half-open
+     */
+    void configure(int failureThreshold,
+                   std::chrono::milliseconds openTimeout,
+                   std::chrono::milliseconds probeInterval);
+
+    /**
+     * @brief Check if the breaker is configured
+     * @return True if a failure threshold is set
+     */
+    bool isEnabled() const;
+
+    /**
+     * @brief Decide whether a read may be sent to the server
+     * @return True if the read may proceed, false if it must fail fast
+     *
+     * Moves an open circuit to half-open once the open timeout has passed and
+     * admits at most one probe per probe interval while half-open.
+     */
+    bool allowRequest();
+
+    /**
+     * @brief Check if reads are currently being rejected
+     * @return True while open and before the next probe is due
+     *
+     * Unlike allowRequest() this does not admit a probe.
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Record a read the server answered
+     */
+    void recordSuccess();
+
+    /**
+     * @brief Record a read that failed because the server was unreachable
+     */
+    void recordFailure();
+
+    /**
+     * @brief Close the circuit, e.g. after the client reconnected
+     */
+    void reset();
+
+    /**
+     * @brief Get the current state
+     * @return Circuit state
+     */
+    State getState() const;
+
+    /**
+     * @brief Convert a state to its display name
+     * @param state Circuit state
+     * @return "closed", "open" or "half_open"
+     */
+    static const char* stateToString(State state);
+
+    /**
+     * @brief Check if an error reason was produced by an open circuit
+     * @param error Error reason of a read result
+     * @return True if the read was rejected by the breaker
+     */
+    static bool isOpenError(const std::string& error);
+
+    /**
+     * @brief Get current breaker statistics
+     * @return BreakerStats structure with current statistics
+     */
+    BreakerStats getStats() const;
+
+    /**
+     * @brief Clear all statistics counters
+     */
+    void clearStats();
+
+private:
+    int failureThreshold_{0};
+    std::chrono::milliseconds openTimeout_{5000};
+    std::chrono::milliseconds probeInterval_{1000};
+
+    State state_{State::CLOSED};
+    uint32_t consecutiveFailures_{0};
+    std::chrono::steady_clock::time_point openedAt_;     // When the circuit last opened
+    std::chrono::steady_clock::time_point nextProbe_;    // Earliest time for the next probe
+    mutable std::mutex breakerMutex_;
+
+    // Statistics (atomic for thread-safe access)
+    std::atomic<uint64_t> trips_{0};
+    std::atomic<uint64_t> rejectedReads_{0};
+    std::atomic<uint64_t> probes_{0};
+
+    /**
+     * @brief Open the circuit (call with breakerMutex_ held)
+     * @param now Current time
+     */
+    void open(std::chrono::steady_clock::time_point now);
+};
+
+} // namespace opcua2http
@@ -2,10 +2,13 @@
 
 #include <string>
 #include <vector>
+#include <memory>
 #include <atomic>
 #include <mutex>
 #include <functional>
 #include <chrono>
+#include <thread>
+#include <condition_variable>
 
 #include <open62541/client.h>
 #include <open62541/client_config_default.h>
@@ -13,6 +16,11 @@
 
 #include "config/Configuration.h"
 #include "core/ReadResult.h"
+#include "opcua/ReadBudget.h"
+#include "opcua/CircuitBreaker.h"
+#include "opcua/StandbySession.h"
+#include "cache/PerformanceMonitor.h"
+#include "cache/LockProfiler.h"
 
 namespace opcua2http {
 
@@ -28,6 +36,17 @@ public:
 
     using StateChangeCallback = std::function<void(ConnectionState state, UA_StatusCode statusCode)>;
 
+    // Redundant endpoint failover state for monitoring
+    struct FailoverStats {
+        uint64_t failovers{0};              // Sessions promoted from standby
+        std::string activeEndpoint;         // Endpoint of the active session
+        std::string standbyEndpoint;        // Endpoint of the standby session (empty if none)
+        bool standbyReady{false};           // Whether a standby session is connected
+        int activeServiceLevel{StandbySession::SERVICE_LEVEL_UNKNOWN};
+        int standbyServiceLevel{StandbySession::SERVICE_LEVEL_UNKNOWN};
+        std::chrono::milliseconds lastSwitchDuration{0}; // Time taken by the last session swap
+    };
+
     OPCUAClient();
     ~OPCUAClient();
 
@@ -40,11 +59,70 @@ public:
     bool isConnected() const;
     ConnectionState getConnectionState() const;
     UA_Client* getClient() const;
-    ReadResult readNode(const std::string& nodeId);
-    std::vector<ReadResult> readNodes(const std::vector<std::string>& nodeIds);
+    ReadResult readNode(const std::string& nodeId,
+                        ReadBudget::Priority priority = ReadBudget::Priority::SYNCHRONOUS);
+    std::vector<ReadResult> readNodes(const std::vector<std::string>& nodeIds,
+                                      ReadBudget::Priority priority = ReadBudget::Priority::SYNCHRONOUS);
 
     // NEW: Batch reading capabilities for efficient multi-node reads
-    std::vector<ReadResult> readNodesBatch(const std::vector<std::string>& nodeIds);
+    std::vector<ReadResult> readNodesBatch(const std::vector<std::string>& nodeIds,
+                                           ReadBudget::Priority priority = ReadBudget::Priority::SYNCHRONOUS);
+
+    // Asynchronous single-node read bounded by a deadline. The request is abandoned
+    // (its late response discarded) on timeout or once *cancel becomes true.
+    ReadResult readNodeWithDeadline(const std::string& nodeId,
+                                    std::chrono::milliseconds timeout,
+                                    const std::atomic<bool>* cancel = nullptr,
+                                    ReadBudget::Priority priority = ReadBudget::Priority::SYNCHRONOUS);
+    static constexpr const char* READ_TIMEOUT_ERROR = "Read deadline exceeded";
+    static constexpr const char* READ_CANCELLED_ERROR = "Read cancelled";
+
+    // Node list parsed once into read value IDs, for node sets read over and over
+    // (tag groups). readPrepared() sends any subset of it as batch reads without
+    // validating or parsing the node IDs again. Immutable, so it is shared freely.
+    class PreparedRead {
+    public:
+        ~PreparedRead();
+        PreparedRead(const PreparedRead&) = delete;
+        PreparedRead& operator=(const PreparedRead&) = delete;
+
+        size_t size() const { return nodeIds_.size(); }
+        const std::string& nodeId(size_t index) const { return nodeIds_[index]; }
+        bool isValid(size_t index) const { return valid_[index]; }
+
+    private:
+        friend class OPCUAClient;
+        PreparedRead() = default;
+
+        std::vector<std::string> nodeIds_;
+        std::vector<UA_ReadValueId> readValueIds_;   // Owns the parsed node IDs
+        std::vector<bool> valid_;                    // False if the node ID did not parse
+    };
+    std::shared_ptr<const PreparedRead> prepareRead(const std::vector<std::string>& nodeIds);
+
+    // Batch read of prepared members (indices into the PreparedRead); results follow
+    // members' order. Admitted, failed over and rejected like readNodesBatch().
+    std::vector<ReadResult> readPrepared(const PreparedRead& prepared, const std::vector<size_t>& members,
+                                         ReadBudget::Priority priority = ReadBudget::Priority::SYNCHRONOUS);
+
+    // Global read-rate budget; rejected reads fail with ReadBudget::EXHAUSTED_ERROR
+    ReadBudget& getReadBudget();
+    const ReadBudget& getReadBudget() const;
+
+    // Circuit breaker; reads fail fast with CircuitBreaker::OPEN_ERROR while the server is down
+    CircuitBreaker& getCircuitBreaker();
+    const CircuitBreaker& getCircuitBreaker() const;
+    static bool isServerUnreachable(UA_StatusCode statusCode);
+
+    // Text form of a scalar value as served in ReadResult::value
+    static std::string variantToString(const UA_Variant& variant);
+
+    // Optional monitor timing OPC reads and clientMutex_ waits; set before initialize(),
+    // which may start the standby monitor thread
+    void setPerformanceMonitor(PerformanceMonitor* monitor);
+
+    // Optional profiler recording clientMutex_ wait and hold times per call site; set before initialize()
+    void setLockProfiler(LockProfiler* profiler);
 
     // NEW: Enhanced connection state management for cache fallback
     std::string getLastError() const;
@@ -62,18 +140,31 @@ public:
 
     void setStateChangeCallback(StateChangeCallback callback);
     UA_StatusCode runIterate(uint16_t timeoutMs = 0);
-    const std::string& getEndpoint() const;
+    // Deletes monitored items holding the client lock; never call with a SubscriptionManager
+    // lock held, since notifications delivered by runIterate take those locks the other way round
+    std::vector<bool> deleteMonitoredItems(UA_UInt32 subscriptionId, const std::vector<UA_UInt32>& monitoredItemIds);
+    std::string getEndpoint() const;
     std::string getConnectionInfo() const;
 
+    // Redundancy: swap to the pre-established standby session, if one is connected.
+    // Reads also fail over on their own when they find the active session lost.
+    bool failover();
+    FailoverStats getFailoverStats() const;
+    static bool shouldFailOver(int activeServiceLevel, int standbyServiceLevel, int minServiceLevel);
+
 private:
-    UA_Client* client_;
+    std::atomic<UA_Client*> client_;
     UA_ClientConfig* config_;
     Configuration appConfig_;
     std::string endpoint_;
+    mutable std::mutex endpointMutex_;
     std::atomic<ConnectionState> connectionState_;
     std::atomic<bool> initialized_;
-    mutable std::mutex clientMutex_;
+    mutable std::timed_mutex clientMutex_;
+    PerformanceMonitor* performanceMonitor_{nullptr};
+    LockProfiler* lockProfiler_{nullptr};
     StateChangeCallback stateChangeCallback_;
+    mutable std::mutex callbackMutex_;
     std::chrono::steady_clock::time_point lastConnectionAttempt_;
 
     // NEW: Enhanced connection and error management
@@ -84,7 +175,34 @@ private:
     size_t batchSize_;
     std::atomic<bool> connectionHealthy_;
     mutable std::mutex errorMutex_;
+    ReadBudget readBudget_;
+    CircuitBreaker circuitBreaker_;
+
+    // Redundancy: hot-standby session kept alive by the standby monitor thread
+    StandbySession standby_;
+    std::thread standbyThread_;
+    std::atomic<bool> standbyRunning_;
+    std::mutex standbyWaitMutex_;
+    std::condition_variable standbyCondition_;
+    std::atomic<bool> sessionWanted_;       // Set by connect(), cleared by disconnect()
+    std::atomic<uint64_t> failovers_;
+    std::atomic<int> activeServiceLevel_;
+    std::atomic<std::chrono::milliseconds> lastSwitchDuration_;
+    static constexpr std::chrono::milliseconds STANDBY_CHECK_INTERVAL{500};
+
+    // State of an in-flight readNodeWithDeadline, owned by the caller's stack frame
+    struct PendingRead {
+        OPCUAClient* client;
+        std::string nodeId;
+        bool completed;
+        ReadResult result;
+    };
+    static constexpr std::chrono::milliseconds ASYNC_POLL_INTERVAL{10};
 
+    static void asyncReadCallback(UA_Client* client, void* userdata,
+                                  UA_UInt32 requestId, UA_ReadResponse* response);
+    static void discardAsyncResponse(UA_Client* client, void* userdata,
+                                     UA_UInt32 requestId, void* response);
     static void stateCallback(UA_Client *client,
                             UA_SecureChannelState channelState,
                             UA_SessionState sessionState,
@@ -92,10 +210,14 @@ private:
     UA_NodeId parseNodeId(const std::string& nodeIdStr);
     ReadResult convertDataValue(const std::string& nodeId, const UA_DataValue& dataValue);
     std::string statusCodeToString(UA_StatusCode statusCode) const;
-    std::string variantToString(const UA_Variant& variant);
     uint64_t getCurrentTimestamp();
-    uint64_t dateTimeToTimestamp(UA_DateTime dateTime);
-    bool configureClientSecurity();
+    static uint64_t dateTimeToTimestamp(UA_DateTime dateTime);
+    UA_Client* createClient();
+    bool configureClientSecurity(UA_ClientConfig* clientConfig);
+    void setEndpoint(const std::string& endpoint);
+    void standbyMonitorLoop();
+    void stopStandbyMonitor();
+    bool failoverLocked(const char* reason);
     void updateConnectionState(ConnectionState newState, UA_StatusCode statusCode = UA_STATUSCODE_GOOD);
     bool validateNodeIdFormat(const std::string& nodeIdStr);
 
@@ -105,6 +227,12 @@ private:
     std::vector<ReadResult> processReadResponse(const std::vector<std::string>& nodeIds,
                                                const UA_ReadResponse& response);
     void setLastError(const std::string& error);
+    std::vector<ReadResult> createBudgetRejection(const std::vector<std::string>& nodeIds);
+    std::vector<ReadResult> createCircuitRejection(const std::vector<std::string>& nodeIds);
+    std::vector<ReadResult> createNotConnectedErrors(const std::vector<std::string>& nodeIds);
+    void recordReadOutcome(UA_StatusCode statusCode);
+    ProfiledLock<std::unique_lock<std::timed_mutex>> lockClient(
+        std::source_location site = std::source_location::current()) const;
 };
 
 } // namespace opcua2http
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <string>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace opcua2http {
+
+/**
+ * @brief Global rate budget for reads sent to the OPC UA server
+ *
+ * Two token buckets cap the read load the bridge places on the server: one in
+ * nodes per second and one in read requests (service calls) per second. Each
+ * bucket holds at most one second of budget, so bursts are bounded as well.
+ *
+ * A share of each bucket is reserved for synchronous client reads. Background
+ * refreshes and retries may only draw tokens above that reserve, so they are
+ * the first to be shed under load while client reads keep being served.
+ *
+ * A rate of 0 leaves the corresponding dimension unlimited.
+ */
+class ReadBudget {
+public:
+    /**
+     * @brief Origin of a read, used to decide who may use the reserve
+     */
+    enum class Priority {
+        SYNCHRONOUS,    // Client request waiting on the result
+        BACKGROUND,     // Background or refresh-ahead update
+        RETRY           // Retry after a failed read
+    };
+
+    /**
+     * @brief Budget statistics for monitoring
+     */
+    struct BudgetStats {
+        double nodesPerSecond{0.0};         // Configured node rate (0 = unlimited)
+        double requestsPerSecond{0.0};      // Configured request rate (0 = unlimited)
+        double synchronousReserve{0.0};     // Share of each bucket reserved for synchronous reads
+        double nodeUtilization{0.0};        // Share of the node bucket currently in use (0.0 to 1.0)
+        double requestUtilization{0.0};     // Share of the request bucket currently in use (0.0 to 1.0)
+        uint64_t grantedRequests{0};        // Reads admitted
+        uint64_t grantedNodes{0};           // Nodes admitted
+        uint64_t rejectedRequests{0};       // Reads rejected for lack of budget
+        uint64_t rejectedNodes{0};          // Nodes rejected for lack of budget
+        uint64_t rejectedSynchronous{0};    // Synchronous reads rejected
+        uint64_t rejectedBackground{0};     // Background reads rejected
+        uint64_t rejectedRetries{0};        // Retries rejected
+    };
+
+    /**
+     * @brief Error reason attached to reads rejected by the budget
+     */
+    static constexpr const char* EXHAUSTED_ERROR = "Read budget exhausted";
+
+    /**
+     * @brief Constructor - creates an unlimited budget
+     */
+    ReadBudget();
+
+    // Disable copy constructor and assignment operator
+    ReadBudget(const ReadBudget&) = delete;
+    ReadBudget& operator=(const ReadBudget&) = delete;
+
+    /**
+     * @brief Configure the budget rates and refill both buckets
+     * @param nodesPerSecond Maximum nodes read per second (0 = unlimited)
+     * @param requestsPerSecond Maximum read requests per second (0 = unlimited)
+     * @param synchronousReserve Share of each bucket reserved for synchronous reads (0.0 to 1.0)
+     */
+    void configure(double nodesPerSecond, double requestsPerSecond, double synchronousReserve);
+
+    /**
+     * @brief Check if any rate limit is configured
+     * @return True if at least one dimension is limited
+     */
+    bool isEnabled() const;
+
+    /**
+     * @brief Try to take budget for a read without blocking
+     * @param nodeCount Number of nodes in the read
+     * @param requestCount Number of read requests the read is split into
+     * @param priority Origin of the read
+     * @return True if the read may proceed, false if it must be shed
+     */
+    bool tryAcquire(size_t nodeCount, size_t requestCount, Priority priority);
+
+    /**
+     * @brief Check if an error reason was produced by budget rejection
+     * @param error Error reason of a read result
+     * @return True if the read was rejected by the budget
+     */
+    static bool isExhaustedError(const std::string& error);
+
+    /**
+     * @brief Get current budget statistics
+     * @return BudgetStats structure with current statistics
+     */
+    BudgetStats getStats() const;
+
+    /**
+     * @brief Clear all statistics counters
+     */
+    void clearStats();
+
+private:
+    /**
+     * @brief Token bucket holding at most one second of rate
+     */
+    struct Bucket {
+        double rate{0.0};       // Tokens per second (0 = unlimited)
+        double tokens{0.0};     // Currently available tokens
+    };
+
+    Bucket nodeBucket_;
+    Bucket requestBucket_;
+    double synchronousReserve_{0.0};
+    std::chrono::steady_clock::time_point lastRefill_;
+    mutable std::mutex budgetMutex_;
+
+    // Statistics (atomic for thread-safe access)
+    std::atomic<uint64_t> grantedRequests_{0};
+    std::atomic<uint64_t> grantedNodes_{0};
+    std::atomic<uint64_t> rejectedRequests_{0};
+    std::atomic<uint64_t> rejectedNodes_{0};
+    std::atomic<uint64_t> rejectedSynchronous_{0};
+    std::atomic<uint64_t> rejectedBackground_{0};
+    std::atomic<uint64_t> rejectedRetries_{0};
+
+    /**
+     * @brief Add tokens accrued since the last refill (call with budgetMutex_ held)
+     * @param now Current time
+     */
+    void refill(std::chrono::steady_clock::time_point now);
+
+    /**
+     * @brief Check if a bucket can cover a cost for the given priority
+     * @param bucket Bucket to check
+     * @param cost Tokens required
+     * @param priority Origin of the read
+     * @return True if the cost fits above the applicable floor
+     */
+    bool canAfford(const Bucket& bucket, double cost, Priority priority) const;
+
+    /**
+     * @brief Calculate the share of a bucket currently in use
+     * @param bucket Bucket to inspect
+     * @return Utilization between 0.0 and 1.0 (0.0 when unlimited)
+     */
+    static double utilization(const Bucket& bucket);
+};
+
+} // namespace opcua2http
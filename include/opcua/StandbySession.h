@@ -0,0 +1,139 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <functional>
+
+#include <open62541/client.h>
+
+namespace opcua2http {
+
+/**
+ * @brief Pre-established session to a redundant OPC UA server
+ *
+ * Keeps a second client connected to one of the redundant endpoints so a
+ * failover only has to swap sessions instead of connecting from scratch. The
+ * owning OPCUAClient drives maintain() from its standby monitor thread, which
+ * keeps the session alive, samples the server's ServiceLevel and reconnects
+ * the standby after it was lost or promoted.
+ *
+ * Promotion hands over the connected client and takes the demoted active
+ * client in exchange; that client is later reconnected to the next endpoint.
+ */
+class StandbySession {
+public:
+    /**
+     * @brief Creates a configured, unconnected client
+     */
+    using ClientFactory = std::function<UA_Client*()>;
+
+    /**
+     * @brief ServiceLevel reported when it could not be read
+     */
+    static constexpr int SERVICE_LEVEL_UNKNOWN = -1;
+
+    /**
+     * @brief Constructor
+     * @param factory Creates the standby client on first use
+     */
+    explicit StandbySession(ClientFactory factory);
+
+    /**
+     * @brief Destructor - disconnects and deletes the standby client
+     */
+    ~StandbySession();
+
+    // Disable copy constructor and assignment operator
+    StandbySession(const StandbySession&) = delete;
+    StandbySession& operator=(const StandbySession&) = delete;
+
+    /**
+     * @brief Set all redundant endpoints, including the primary
+     * @param endpoints Endpoints in order of preference
+     */
+    void setEndpoints(const std::vector<std::string>& endpoints);
+
+    /**
+     * @brief Check if more than one endpoint is configured
+     * @return True if a standby can exist
+     */
+    bool isEnabled() const;
+
+    /**
+     * @brief Keep the standby connected and refresh its ServiceLevel
+     * @param activeEndpoint Endpoint of the active session (never used for the standby)
+     * @param retryDelay Minimum delay between connection attempts
+     *
+     * May block for the connection timeout while (re)connecting; promote()
+     * does not wait for it.
+     */
+    void maintain(const std::string& activeEndpoint, std::chrono::milliseconds retryDelay);
+
+    /**
+     * @brief Check if a connected standby session is available
+     * @return True if promote() would succeed
+     */
+    bool isReady() const;
+
+    /**
+     * @brief Get the last ServiceLevel sampled from the standby server
+     * @return ServiceLevel (0-255) or SERVICE_LEVEL_UNKNOWN
+     */
+    int getServiceLevel() const;
+
+    /**
+     * @brief Get the endpoint of the standby session
+     * @return Endpoint, or an empty string if no standby is connected
+     */
+    std::string getEndpoint() const;
+
+    /**
+     * @brief Promote the standby session in exchange for the demoted active client
+     * @param demoted Active client being replaced (ownership transfers to the session)
+     * @param promotedEndpoint Receives the endpoint of the promoted session
+     * @return Connected client to use as the active session, or nullptr if none is ready
+     *
+     * Never blocks: if the standby is busy connecting nullptr is returned and
+     * the demoted client stays with the caller.
+     */
+    UA_Client* promote(UA_Client* demoted, std::string& promotedEndpoint);
+
+    /**
+     * @brief Read the Server.ServiceLevel variable
+     * @param client Connected client
+     * @return ServiceLevel (0-255) or SERVICE_LEVEL_UNKNOWN if the read failed
+     */
+    static int readServiceLevel(UA_Client* client);
+
+private:
+    ClientFactory factory_;
+    std::vector<std::string> endpoints_;
+    UA_Client* client_;                                  // Standby (or demoted) client
+    size_t nextCandidate_;                               // Next endpoint index to try
+    std::chrono::steady_clock::time_point lastAttempt_;  // Last connection attempt
+    std::mutex sessionMutex_;                            // Guards the client and endpoints
+
+    std::string endpoint_;                               // Endpoint of the ready session
+    mutable std::mutex endpointMutex_;                   // Guards endpoint_ only, never held while blocking
+
+    std::atomic<bool> ready_;
+    std::atomic<int> serviceLevel_;
+
+    /**
+     * @brief Check if the session of a client is activated
+     * @param client Client to inspect
+     * @return True if the session is usable
+     */
+    static bool isSessionActive(UA_Client* client);
+
+    /**
+     * @brief Set the endpoint reported for the ready session
+     * @param endpoint Endpoint, or an empty string when not ready
+     */
+    void setEndpoint(const std::string& endpoint);
+};
+
+} // namespace opcua2http
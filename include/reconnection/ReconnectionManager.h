@@ -6,6 +6,7 @@
 #include <chrono>
 #include <functional>
 #include <mutex>
+#include <condition_variable>
 
 #include "config/Configuration.h"
 
@@ -23,7 +24,8 @@ class SubscriptionManager;
  * SubscriptionManager to restore all active subscriptions after successful reconnection.
  * 
  * Key features:
- * - Background thread monitoring connection status
+ * - Background thread monitoring connection status, woken by client state changes
+ * - Immediate failover to a hot-standby session when redundant endpoints are configured
  * - Exponential backoff retry strategy
  * - Automatic subscription recovery after reconnection
  * - Configurable retry parameters via environment variables
@@ -57,6 +59,9 @@ public:
         bool isMonitoring;                       // Whether monitoring is active
         int currentRetryAttempt;                 // Current retry attempt number
         std::chrono::milliseconds nextRetryDelay; // Next retry delay
+        std::chrono::milliseconds lastReconnectLatency;    // Drop detection to reconnect, last outage
+        std::chrono::milliseconds averageReconnectLatency; // Drop detection to reconnect, average
+        std::chrono::milliseconds maxReconnectLatency;     // Drop detection to reconnect, worst case
     };
     
     /**
@@ -147,6 +152,28 @@ public:
      * @return True if detailed logging is enabled
      */
     bool isDetailedLoggingEnabled() const;
+
+    /**
+     * @brief Let an external timer pace the connected-state check
+     * @param enabled Whether requestCheck() replaces the loop's own 1 s poll
+     *
+     * While enabled and connected, the monitoring thread sleeps until a client
+     * state change or requestCheck(). Reconnection backoff is unaffected.
+     */
+    void setExternalPolling(bool enabled);
+
+    /**
+     * @brief Wake the monitoring thread for one connection check
+     */
+    void requestCheck();
+
+    /**
+     * @brief Have the monitoring thread clean up unused monitored items
+     *
+     * The cleanup runs on the monitoring thread between its runIterate() calls
+     * once the client is connected, so the caller never waits on the server.
+     */
+    void requestSubscriptionCleanup();
     
     /**
      * @brief Reset reconnection statistics
@@ -190,6 +217,15 @@ private:
     std::chrono::steady_clock::time_point disconnectionTime_; // When disconnection was detected
     std::chrono::steady_clock::time_point nextAttemptTime_; // When next attempt is scheduled
     
+    // Client state events (set from OPCUAClient's state change callback)
+    std::mutex eventMutex_;                              // Guards event state below
+    std::condition_variable eventCondition_;             // Wakes the monitoring thread
+    bool stateEventPending_{false};                      // State change not yet seen by the loop
+    std::atomic<bool> externalPolling_{false};           // Connected-state checks driven by requestCheck()
+    std::atomic<bool> subscriptionCleanupPending_{false}; // Set by requestSubscriptionCleanup()
+    std::chrono::steady_clock::time_point dropDetectedTime_; // When the client first reported the drop
+    std::atomic<uint64_t> seenFailovers_{0};             // Client failovers already handled
+    
     // Statistics (atomic for thread-safe access)
     mutable std::atomic<uint64_t> totalReconnectionAttempts_{0};
     mutable std::atomic<uint64_t> successfulReconnections_{0};
@@ -197,6 +233,10 @@ private:
     mutable std::atomic<uint64_t> subscriptionRecoveries_{0};
     mutable std::atomic<uint64_t> successfulSubscriptionRecoveries_{0};
     mutable std::atomic<std::chrono::milliseconds> totalDowntime_{std::chrono::milliseconds::zero()};
+    std::atomic<uint64_t> measuredReconnects_{0};       // Reconnects with a known detection time
+    std::atomic<std::chrono::milliseconds> lastReconnectLatency_{std::chrono::milliseconds::zero()};
+    std::atomic<std::chrono::milliseconds> totalReconnectLatency_{std::chrono::milliseconds::zero()};
+    std::atomic<std::chrono::milliseconds> maxReconnectLatency_{std::chrono::milliseconds::zero()};
     
     // Configuration
     std::atomic<bool> detailedLoggingEnabled_;          // Whether detailed logging is enabled
@@ -221,6 +261,12 @@ private:
      */
     bool attemptReconnection();
     
+    /**
+     * @brief Finish a failover performed by the client (reads or its standby monitor)
+     * @return True if a new failover was handled, false otherwise
+     */
+    bool handleClientFailover();
+    
     /**
      * @brief Recover all subscriptions after successful reconnection
      * @return True if subscription recovery successful, false otherwise
@@ -255,7 +301,22 @@ private:
     void logActivity(const std::string& message, bool isError = false) const;
     
     /**
-     * @brief Update downtime statistics
+     * @brief Handle a state change reported by the OPC UA client
+     * @param connected Whether the client reports an established connection
+     *
+     * Called from whichever thread drove the client into the new state, so it
+     * only records the event and wakes the monitoring thread.
+     */
+    void onClientStateChange(bool connected);
+    
+    /**
+     * @brief Take the drop detection time reported by the client, if any
+     * @return Detection time, or a default time point if none was reported
+     */
+    std::chrono::steady_clock::time_point takeDropDetectedTime();
+    
+    /**
+     * @brief Update downtime and reconnect latency statistics
      */
     void updateDowntimeStats();
     
@@ -271,11 +332,17 @@ private:
     bool hasReachedMaxRetries() const;
     
     /**
-     * @brief Wait for the specified duration or until monitoring is stopped
-     * @param duration Duration to wait
-     * @return True if wait completed normally, false if interrupted
+     * @brief Wait for the specified duration, a client state change, or stop
+     * @param duration Maximum duration to wait
+     * @return True if monitoring is still active, false if stopped
      */
     bool waitOrStop(std::chrono::milliseconds duration);
+
+    /**
+     * @brief Wait for a client state change, a requested check, or stop
+     * @return True if monitoring is still active, false if stopped
+     */
+    bool waitForEventOrStop();
     
     /**
      * @brief Validate configuration parameters
@@ -13,6 +13,7 @@
 #include <open62541/client_subscriptions.h>
 
 #include "cache/CacheManager.h"
+#include "cache/LockProfiler.h"
 #include "core/ReadResult.h"
 
 namespace opcua2http {
@@ -146,6 +147,12 @@ public:
      * @return SubscriptionStats structure with current statistics
      */
     SubscriptionStats getStats() const;
+
+    /**
+     * @brief Get subscription counters without taking the subscription lock
+     * @return SubscriptionStats without subscriptionId and lastActivity
+     */
+    SubscriptionStats getCounters() const;
     
     /**
      * @brief Clear all monitored items and reset subscription
@@ -206,6 +213,12 @@ public:
      * @param enabled Whether detailed logging should be enabled
      */
     void setDetailedLoggingEnabled(bool enabled);
+
+    /**
+     * @brief Set the profiler that records subscriptionMutex_ wait and hold times per call site
+     * @param profiler Lock profiler (optional, may be null; set before use)
+     */
+    void setLockProfiler(LockProfiler* profiler);
     
     /**
      * @brief Check if detailed logging is enabled
@@ -254,12 +267,14 @@ private:
     
     // Subscription management
     mutable std::mutex subscriptionMutex_;                   // Mutex for thread safety
+    LockProfiler* lockProfiler_{nullptr};                    // Lock wait/hold profiling (optional)
     UA_UInt32 subscriptionId_;                               // Main subscription ID
     std::atomic<bool> subscriptionActive_;                   // Whether subscription is active
     
     // Monitored items management
     std::unordered_map<std::string, MonitoredItemInfo> monitoredItems_; // Node ID -> MonitoredItemInfo
     std::unordered_map<UA_UInt32, std::string> handleToNodeId_;         // Client handle -> Node ID
+    std::atomic<size_t> monitoredItemCount_{0};                         // monitoredItems_.size(), readable without the lock
     std::atomic<UA_UInt32> nextClientHandle_;                           // Next client handle to assign
     
     // Configuration
@@ -288,6 +303,26 @@ private:
      */
     UA_MonitoredItemCreateResult createMonitoredItem(const std::string& nodeId);
     
+    /**
+     * @brief Create and register monitored items with one CreateMonitoredItems call per batch
+     * @param nodeIds OPC UA node identifiers (call with subscriptionMutex_ held)
+     * @return Number of monitored items created
+     */
+    size_t createMonitoredItemsBatch(const std::vector<std::string>& nodeIds);
+    
+    /**
+     * @brief Parse a node ID string in "ns=X;i=Y" or "ns=X;s=Y" form
+     * @param nodeId OPC UA node identifier
+     * @param result Receives the parsed node ID (caller clears it)
+     * @return True if the node ID was parsed
+     */
+    static bool parseMonitoredNodeId(const std::string& nodeId, UA_NodeId& result);
+    
+    /**
+     * @brief Maximum monitored items per CreateMonitoredItems request
+     */
+    static constexpr size_t MONITORED_ITEM_BATCH_SIZE = 500;
+    
     /**
      * @brief Delete a monitored item by its ID
      * @param monitoredItemId Monitored item ID to delete
@@ -358,6 +393,14 @@ private:
      * @param nodeId Node ID to update
      */
     void updateLastAccessedUnsafe(const std::string& nodeId);
+
+    /**
+     * @brief Acquire subscriptionMutex_, recording it in the lock profiler if set
+     * @param site Acquiring call site, for the lock profiler
+     * @return Held lock
+     */
+    ProfiledLock<std::unique_lock<std::mutex>> lockSubscriptions(
+        std::source_location site = std::source_location::current()) const;
 };
 
 } // namespace opcua2http
\ No newline at end of file
@@ -23,6 +23,8 @@ CacheManager::CacheManager(int cacheExpireMinutes, size_t maxCacheSize,
 }
 
 std::optional<CacheManager::CacheEntry> CacheManager::getCachedValue(const std::string& nodeId) {
+    PerformanceMonitor::ScopedTimer timer(performanceMonitor_, PerformanceMonitor::OperationType::CACHE_READ);
+
     // Check access level (lock-free)
     if (!checkAccessLevel(AccessLevel::READ_ONLY)) {
         std::cout << "Access denied: insufficient permissions for read operation" << std::endl;
@@ -32,7 +34,7 @@ std::optional<CacheManager::CacheEntry> CacheManager::getCachedValue(const std::
     // Lock-free statistics update
     totalReads_.fetch_add(1, std::memory_order_relaxed);
 
-    std::shared_lock<std::shared_mutex> lock(cacheMutex_);
+    auto lock = readLock();
 
     auto it = cache_.find(nodeId);
     if (it != cache_.end()) {
@@ -51,24 +53,32 @@ void CacheManager::updateCache(const std::string& nodeId,
                               const std::string& status,
                               const std::string& reason,
                               uint64_t timestamp) {
+    PerformanceMonitor::ScopedTimer timer(performanceMonitor_, PerformanceMonitor::OperationType::CACHE_WRITE);
+
     // Check access level
     if (!checkAccessLevel(AccessLevel::READ_WRITE)) {
         std::cout << "Access denied: insufficient permissions for write operation" << std::endl;
         return;
     }
 
-    std::unique_lock<std::shared_mutex> lock(cacheMutex_);
+    // Serialized once per write, outside the lock, so fresh hits only copy it
+    auto json = ReadResult{nodeId, status == "Good", reason, value, timestamp}.serializeJson();
+
+    auto lock = writeLock();
 
     totalWrites_.fetch_add(1, std::memory_order_relaxed);
 
+    auto now = std::chrono::steady_clock::now();
     auto it = cache_.find(nodeId);
     if (it != cache_.end()) {
-        // Update existing entry (preserve creationTime)
+        // Update existing entry; a new value restarts the freshness window
         it->second.value = value;
         it->second.status = status;
         it->second.reason = reason;
         it->second.timestamp = timestamp;
-        it->second.updateLastAccessed(); // Use atomic method
+        it->second.json = std::move(json);
+        it->second.creationTime = now;
+        it->second.lastAccessed.store(now, std::memory_order_relaxed); // Equal to creationTime until read
 
         std::cout << "Cache updated for node " << nodeId << " with value: " << value << std::endl;
     } else {
@@ -85,8 +95,9 @@ void CacheManager::updateCache(const std::string& nodeId,
         entry.status = status;
         entry.reason = reason;
         entry.timestamp = timestamp;
-        entry.creationTime = std::chrono::steady_clock::now();
-        entry.lastAccessed.store(std::chrono::steady_clock::now());
+        entry.json = std::move(json);
+        entry.creationTime = now;
+        entry.lastAccessed.store(now);
         entry.hasSubscription.store(false);
 
         cache_[nodeId] = entry;
@@ -110,7 +121,10 @@ void CacheManager::addCacheEntry(const std::string& nodeId, const CacheEntry& en
         needsEviction = memoryManager_->hasMemoryPressure() || memoryManager_->hasEntryPressure();
     }
 
-    std::unique_lock<std::shared_mutex> lock(cacheMutex_);
+    // Rebuilt rather than trusted, since the caller may have edited a copied entry
+    auto json = entry.toReadResult().serializeJson();
+
+    auto lock = writeLock();
 
     // Handle memory pressure if needed
     if (needsEviction) {
@@ -118,8 +132,10 @@ void CacheManager::addCacheEntry(const std::string& nodeId, const CacheEntry& en
         std::cout << "Memory pressure detected, evicted " << evicted << " entries" << std::endl;
     }
 
-    cache_[nodeId] = entry;
-    cache_[nodeId].updateLastAccessed(); // Use atomic method
+    auto& stored = cache_[nodeId];
+    stored = entry;
+    stored.json = std::move(json);
+    stored.updateLastAccessed(); // Use atomic method
 
     std::cout << "Cache entry added for node " << nodeId << std::endl;
 
@@ -150,7 +166,7 @@ void CacheManager::addCacheEntry(const ReadResult& result, bool hasSubscription)
 }
 
 bool CacheManager::removeCacheEntry(const std::string& nodeId) {
-    std::unique_lock<std::shared_mutex> lock(cacheMutex_);
+    auto lock = writeLock();
 
     auto it = cache_.find(nodeId);
     if (it != cache_.end()) {
@@ -168,7 +184,7 @@ size_t CacheManager::cleanupExpiredEntries() {
         return 0;
     }
 
-    std::unique_lock<std::shared_mutex> lock(cacheMutex_);
+    auto lock = writeLock();
 
     size_t removedCount = 0;
     auto now = std::chrono::steady_clock::now();
@@ -198,7 +214,7 @@ size_t CacheManager::cleanupUnusedEntries() {
         return 0;
     }
 
-    std::unique_lock<std::shared_mutex> lock(cacheMutex_);
+    auto lock = writeLock();
 
     size_t removedCount = 0;
     auto now = std::chrono::steady_clock::now();
@@ -223,7 +239,7 @@ size_t CacheManager::cleanupUnusedEntries() {
 }
 
 std::vector<std::string> CacheManager::getCachedNodeIds() const {
-    std::shared_lock<std::shared_mutex> lock(cacheMutex_);
+    auto lock = readLock();
 
     std::vector<std::string> nodeIds;
     nodeIds.reserve(cache_.size());
@@ -236,7 +252,7 @@ std::vector<std::string> CacheManager::getCachedNodeIds() const {
 }
 
 std::vector<std::string> CacheManager::getSubscribedNodeIds() const {
-    std::shared_lock<std::shared_mutex> lock(cacheMutex_);
+    auto lock = readLock();
 
     std::vector<std::string> nodeIds;
 
@@ -250,7 +266,7 @@ std::vector<std::string> CacheManager::getSubscribedNodeIds() const {
 }
 
 void CacheManager::setSubscriptionStatus(const std::string& nodeId, bool hasSubscription) {
-    std::shared_lock<std::shared_mutex> lock(cacheMutex_); // Use shared lock for atomic operations
+    auto lock = readLock(); // Use shared lock for atomic operations
 
     auto it = cache_.find(nodeId);
     if (it != cache_.end()) {
@@ -263,7 +279,7 @@ void CacheManager::setSubscriptionStatus(const std::string& nodeId, bool hasSubs
 }
 
 CacheManager::CacheStats CacheManager::getStats() const {
-    std::shared_lock<std::shared_mutex> lock(cacheMutex_);
+    auto lock = readLock();
 
     size_t subscribedCount = 0;
     size_t memoryUsage = 0;
@@ -294,6 +310,22 @@ CacheManager::CacheStats CacheManager::getStats() const {
     };
 }
 
+CacheManager::CacheStats CacheManager::getCounters() const {
+    uint64_t hits = totalHits_.load(std::memory_order_relaxed);
+    uint64_t misses = totalMisses_.load(std::memory_order_relaxed);
+
+    CacheStats stats{};
+    stats.totalEntries = memoryManager_->getCurrentEntryCount();
+    stats.totalHits = hits;
+    stats.totalMisses = misses;
+    stats.totalReads = totalReads_.load(std::memory_order_relaxed);
+    stats.totalWrites = totalWrites_.load(std::memory_order_relaxed);
+    stats.memoryUsageBytes = memoryManager_->getCurrentMemoryUsage();
+    stats.hitRatio = (hits + misses > 0) ? static_cast<double>(hits) / (hits + misses) : 0.0;
+    stats.creationTime = creationTime_;
+    return stats;
+}
+
 void CacheManager::clear() {
     // Check access level
     if (!checkAccessLevel(AccessLevel::ADMIN)) {
@@ -301,7 +333,7 @@ void CacheManager::clear() {
         return;
     }
 
-    std::unique_lock<std::shared_mutex> lock(cacheMutex_);
+    auto lock = writeLock();
 
     size_t count = cache_.size();
     cache_.clear();
@@ -310,17 +342,17 @@ void CacheManager::clear() {
 }
 
 size_t CacheManager::size() const {
-    std::shared_lock<std::shared_mutex> lock(cacheMutex_);
+    auto lock = readLock();
     return cache_.size();
 }
 
 bool CacheManager::empty() const {
-    std::shared_lock<std::shared_mutex> lock(cacheMutex_);
+    auto lock = readLock();
     return cache_.empty();
 }
 
 bool CacheManager::isFull() const {
-    std::shared_lock<std::shared_mutex> lock(cacheMutex_);
+    auto lock = readLock();
     return cache_.size() >= maxCacheSize_;
 }
 
@@ -373,7 +405,7 @@ size_t CacheManager::enforceSizeLimit() {
 
 
 size_t CacheManager::getMemoryUsage() const {
-    std::shared_lock<std::shared_mutex> lock(cacheMutex_);
+    auto lock = readLock();
     return getMemoryUsageNoLock();
 }
 
@@ -428,18 +460,23 @@ size_t CacheManager::calculateEntrySize(const CacheEntry& entry) const {
     size += entry.value.capacity();
     size += entry.status.capacity();
     size += entry.reason.capacity();
+    if (entry.json) {
+        size += entry.json->capacity();
+    }
 
     return size;
 }
 
 CacheManager::CacheResult CacheManager::getCachedValueWithStatus(const std::string& nodeId) {
+    PerformanceMonitor::ScopedTimer timer(performanceMonitor_, PerformanceMonitor::OperationType::CACHE_READ);
+
     // Check access level
     if (!checkAccessLevel(AccessLevel::READ_ONLY)) {
         std::cout << "Access denied: insufficient permissions for read operation" << std::endl;
         return CacheResult{std::nullopt, CacheStatus::EXPIRED};
     }
 
-    std::shared_lock<std::shared_mutex> lock(cacheMutex_);
+    auto lock = readLock();
 
     totalReads_.fetch_add(1, std::memory_order_relaxed);
 
@@ -459,13 +496,15 @@ CacheManager::CacheResult CacheManager::getCachedValueWithStatus(const std::stri
 }
 
 std::vector<CacheManager::CacheResult> CacheManager::getCachedValuesWithStatus(const std::vector<std::string>& nodeIds) {
+    PerformanceMonitor::ScopedTimer timer(performanceMonitor_, PerformanceMonitor::OperationType::CACHE_BATCH_READ);
+
     // Check access level
     if (!checkAccessLevel(AccessLevel::READ_ONLY)) {
         std::cout << "Access denied: insufficient permissions for read operation" << std::endl;
         return std::vector<CacheResult>(nodeIds.size(), CacheResult{std::nullopt, CacheStatus::EXPIRED});
     }
 
-    std::shared_lock<std::shared_mutex> lock(cacheMutex_);
+    auto lock = readLock();
 
     std::vector<CacheResult> results;
     results.reserve(nodeIds.size());
@@ -491,7 +530,38 @@ std::vector<CacheManager::CacheResult> CacheManager::getCachedValuesWithStatus(c
     return results;
 }
 
+bool CacheManager::isFreshAndUnchanged(const std::vector<std::string>& nodeIds,
+                                       const std::vector<std::shared_ptr<const std::string>>& versions) {
+    PerformanceMonitor::ScopedTimer timer(performanceMonitor_, PerformanceMonitor::OperationType::CACHE_BATCH_READ);
+
+    if (nodeIds.size() != versions.size() || !checkAccessLevel(AccessLevel::READ_ONLY)) {
+        return false;
+    }
+
+    auto lock = readLock();
+
+    // One clock read for the whole list; the same test as evaluateCacheStatus
+    auto now = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < nodeIds.size(); ++i) {
+        auto it = cache_.find(nodeIds[i]);
+        if (it == cache_.end() || !versions[i] || it->second.json != versions[i] ||
+            now - it->second.creationTime >= refreshThreshold_) {
+            return false;
+        }
+        it->second.lastAccessed.store(now, std::memory_order_relaxed);
+    }
+
+    // Counted only once the whole list is known to be served
+    totalReads_.fetch_add(nodeIds.size(), std::memory_order_relaxed);
+    totalHits_.fetch_add(nodeIds.size(), std::memory_order_relaxed);
+    freshHits_.fetch_add(nodeIds.size(), std::memory_order_relaxed);
+
+    return true;
+}
+
 void CacheManager::updateCacheBatch(const std::vector<ReadResult>& results) {
+    PerformanceMonitor::ScopedTimer timer(performanceMonitor_, PerformanceMonitor::OperationType::CACHE_BATCH_WRITE);
+
     // Check access level (lock-free)
     if (!checkAccessLevel(AccessLevel::READ_WRITE)) {
         std::cout << "Access denied: insufficient permissions for write operation" << std::endl;
@@ -505,6 +575,13 @@ void CacheManager::updateCacheBatch(const std::vector<ReadResult>& results) {
     // Increment batch operations counter (lock-free)
     batchOperations_.fetch_add(1, std::memory_order_relaxed);
 
+    // Serialize every result before taking the lock; fresh hits then only copy the bytes
+    std::vector<std::shared_ptr<const std::string>> serialized;
+    serialized.reserve(results.size());
+    for (const auto& result : results) {
+        serialized.push_back(result.serializeJson());
+    }
+
     // Batch update statistics (lock-free, before acquiring lock)
     totalWrites_.fetch_add(results.size(), std::memory_order_relaxed);
 
@@ -514,7 +591,7 @@ void CacheManager::updateCacheBatch(const std::vector<ReadResult>& results) {
         needsEviction = memoryManager_->hasMemoryPressure() || memoryManager_->hasEntryPressure();
     }
 
-    std::unique_lock<std::shared_mutex> lock(cacheMutex_);
+    auto lock = writeLock();
 
     // Handle memory pressure if needed
     if (needsEviction) {
@@ -525,15 +602,18 @@ void CacheManager::updateCacheBatch(const std::vector<ReadResult>& results) {
     // Prepare current time once for all new entries
     auto now = std::chrono::steady_clock::now();
 
-    for (const auto& result : results) {
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& result = results[i];
         auto it = cache_.find(result.id);
         if (it != cache_.end()) {
-            // Update existing entry (preserve creationTime)
+            // Update existing entry; a new value restarts the freshness window
             it->second.value = result.value;
             it->second.status = result.success ? "Good" : "Bad";
             it->second.reason = result.reason;
             it->second.timestamp = result.timestamp;
-            it->second.updateLastAccessed(); // Use atomic method
+            it->second.json = std::move(serialized[i]);
+            it->second.creationTime = now;
+            it->second.lastAccessed.store(now, std::memory_order_relaxed); // Equal to creationTime until read
         } else {
             // Create new entry
             CacheEntry entry;
@@ -542,6 +622,7 @@ void CacheManager::updateCacheBatch(const std::vector<ReadResult>& results) {
             entry.status = result.success ? "Good" : "Bad";
             entry.reason = result.reason;
             entry.timestamp = result.timestamp;
+            entry.json = std::move(serialized[i]);
             entry.creationTime = now;
             entry.lastAccessed.store(now);
             entry.hasSubscription.store(false);
@@ -564,6 +645,26 @@ void CacheManager::updateCacheBatch(const std::vector<ReadResult>& results) {
     std::cout << "Batch cache update completed for " << results.size() << " entries" << std::endl;
 }
 
+void CacheManager::setPerformanceMonitor(PerformanceMonitor* monitor) {
+    performanceMonitor_ = monitor;
+}
+
+void CacheManager::setLockProfiler(LockProfiler* profiler) {
+    lockProfiler_ = profiler;
+}
+
+ProfiledLock<std::shared_lock<std::shared_mutex>> CacheManager::readLock(std::source_location site) const {
+    return LockProfiler::acquire(lockProfiler_, LockProfiler::LockId::CACHE_MUTEX,
+                                 std::shared_lock<std::shared_mutex>(cacheMutex_, std::defer_lock),
+                                 performanceMonitor_, PerformanceMonitor::LockType::CACHE_MUTEX, site);
+}
+
+ProfiledLock<std::unique_lock<std::shared_mutex>> CacheManager::writeLock(std::source_location site) const {
+    return LockProfiler::acquire(lockProfiler_, LockProfiler::LockId::CACHE_MUTEX,
+                                 std::unique_lock<std::shared_mutex>(cacheMutex_, std::defer_lock),
+                                 performanceMonitor_, PerformanceMonitor::LockType::CACHE_MUTEX, site);
+}
+
 CacheManager::CacheStatus CacheManager::evaluateCacheStatus(const CacheEntry& entry) const {
     auto age = entry.getAge();
 
@@ -577,13 +678,13 @@ CacheManager::CacheStatus CacheManager::evaluateCacheStatus(const CacheEntry& en
 }
 
 void CacheManager::setRefreshThreshold(std::chrono::seconds threshold) {
-    std::unique_lock<std::shared_mutex> lock(cacheMutex_);
+    auto lock = writeLock();
     refreshThreshold_ = threshold;
     std::cout << "Cache refresh threshold set to " << threshold.count() << " seconds" << std::endl;
 }
 
 void CacheManager::setExpireTime(std::chrono::seconds expireTime) {
-    std::unique_lock<std::shared_mutex> lock(cacheMutex_);
+    auto lock = writeLock();
     expireTime_ = expireTime;
     std::cout << "Cache expire time set to " << expireTime.count() << " seconds" << std::endl;
 }
@@ -626,6 +727,52 @@ uint64_t CacheManager::getExpiredReads() const {
     return expiredReads_.load(std::memory_order_relaxed);
 }
 
+std::chrono::milliseconds CacheManager::getTimeUntilExpiry(const std::string& nodeId) const {
+    auto lock = readLock();
+
+    auto it = cache_.find(nodeId);
+    if (it == cache_.end()) {
+        return std::chrono::milliseconds::zero();
+    }
+
+    auto age = std::chrono::steady_clock::now() - it->second.creationTime;
+    auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(expireTime_ - age);
+    return std::max(remaining, std::chrono::milliseconds::zero());
+}
+
+std::vector<CacheManager::HotEntry> CacheManager::getHotEntries(std::chrono::milliseconds hotWindow) const {
+    auto lock = readLock();
+
+    std::vector<HotEntry> entries;
+    auto now = std::chrono::steady_clock::now();
+
+    for (const auto& pair : cache_) {
+        const auto& entry = pair.second;
+        if (entry.getSubscriptionStatus()) {
+            continue; // Subscriptions keep these entries fresh
+        }
+
+        // Stores set lastAccessed to creationTime, so only real reads make an entry hot
+        auto lastAccessed = entry.getLastAccessed();
+        if (lastAccessed <= entry.creationTime || now - lastAccessed > hotWindow) {
+            continue;
+        }
+
+        auto age = now - entry.creationTime;
+        if (age >= expireTime_) {
+            continue; // Expired entries are refreshed synchronously on the next read
+        }
+
+        entries.push_back(HotEntry{
+            pair.first,
+            std::chrono::duration_cast<std::chrono::milliseconds>(refreshThreshold_ - age),
+            lastAccessed
+        });
+    }
+
+    return entries;
+}
+
 uint64_t CacheManager::getBatchOperations() const {
     return batchOperations_.load(std::memory_order_relaxed);
 }
@@ -643,7 +790,7 @@ const CacheMemoryManager* CacheManager::getMemoryManager() const {
 }
 
 size_t CacheManager::evictLRUEntries(size_t targetCount) {
-    std::unique_lock<std::shared_mutex> lock(cacheMutex_);
+    auto lock = writeLock();
 
     if (targetCount == 0 || cache_.empty()) {
         return 0;
@@ -26,9 +26,7 @@ void CacheMetrics::recordCacheHit(const std::string& /* nodeId */, double respon
     cacheHits_.fetch_add(1, std::memory_order_relaxed);
 
     if (responseTimeMs > 0.0) {
-        std::lock_guard<std::mutex> lock(timingMutex_);
-        updateAverageTime(totalResponseTime_, hitResponseCount_, responseTimeMs);
-        updateAverageTime(totalHitResponseTime_, hitResponseCount_, responseTimeMs);
+        updateAverageTime(totalHitResponseTimeNs_, hitResponseCount_, responseTimeMs);
     }
 
     lastUpdate_.store(std::chrono::steady_clock::now(), std::memory_order_relaxed);
@@ -39,9 +37,7 @@ void CacheMetrics::recordCacheMiss(const std::string& /* nodeId */, double respo
     cacheMisses_.fetch_add(1, std::memory_order_relaxed);
 
     if (responseTimeMs > 0.0) {
-        std::lock_guard<std::mutex> lock(timingMutex_);
-        updateAverageTime(totalResponseTime_, missResponseCount_, responseTimeMs);
-        updateAverageTime(totalMissResponseTime_, missResponseCount_, responseTimeMs);
+        updateAverageTime(totalMissResponseTimeNs_, missResponseCount_, responseTimeMs);
     }
 
     lastUpdate_.store(std::chrono::steady_clock::now(), std::memory_order_relaxed);
@@ -51,8 +47,7 @@ void CacheMetrics::recordStaleRefresh(const std::string& /* nodeId */, double re
     staleRefreshes_.fetch_add(1, std::memory_order_relaxed);
 
     if (responseTimeMs > 0.0) {
-        std::lock_guard<std::mutex> lock(timingMutex_);
-        updateAverageTime(totalStaleHitResponseTime_, staleHitResponseCount_, responseTimeMs);
+        updateAverageTime(totalStaleHitResponseTimeNs_, staleHitResponseCount_, responseTimeMs);
     }
 
     lastUpdate_.store(std::chrono::steady_clock::now(), std::memory_order_relaxed);
@@ -62,8 +57,7 @@ void CacheMetrics::recordExpiredRead(const std::string& /* nodeId */, double res
     expiredReads_.fetch_add(1, std::memory_order_relaxed);
 
     if (responseTimeMs > 0.0) {
-        std::lock_guard<std::mutex> lock(timingMutex_);
-        updateAverageTime(totalExpiredReadResponseTime_, expiredReadResponseCount_, responseTimeMs);
+        updateAverageTime(totalExpiredReadResponseTimeNs_, expiredReadResponseCount_, responseTimeMs);
     }
 
     lastUpdate_.store(std::chrono::steady_clock::now(), std::memory_order_relaxed);
@@ -73,13 +67,30 @@ void CacheMetrics::recordFreshHit(const std::string& /* nodeId */, double respon
     freshHits_.fetch_add(1, std::memory_order_relaxed);
 
     if (responseTimeMs > 0.0) {
-        std::lock_guard<std::mutex> lock(timingMutex_);
-        updateAverageTime(totalFreshHitResponseTime_, freshHitResponseCount_, responseTimeMs);
+        updateAverageTime(totalFreshHitResponseTimeNs_, freshHitResponseCount_, responseTimeMs);
     }
 
     lastUpdate_.store(std::chrono::steady_clock::now(), std::memory_order_relaxed);
 }
 
+void CacheMetrics::recordPathLatency(ReadPath path, std::chrono::nanoseconds latency) {
+    pathLatency_[static_cast<size_t>(path)].record(latency);
+}
+
+LatencyHistogram::Snapshot CacheMetrics::getPathLatency(ReadPath path) const {
+    return pathLatency_[static_cast<size_t>(path)].snapshot();
+}
+
+nlohmann::json CacheMetrics::getLatencyJSON() const {
+    return {
+        {"fresh", getPathLatency(ReadPath::FRESH).toJSON()},
+        {"stale", getPathLatency(ReadPath::STALE).toJSON()},
+        {"expired", getPathLatency(ReadPath::EXPIRED).toJSON()},
+        {"miss", getPathLatency(ReadPath::MISS).toJSON()},
+        {"fallback", getPathLatency(ReadPath::FALLBACK).toJSON()}
+    };
+}
+
 void CacheMetrics::recordBatchOperation(size_t /* batchSize */) {
     batchOperations_.fetch_add(1, std::memory_order_relaxed);
     lastUpdate_.store(std::chrono::steady_clock::now(), std::memory_order_relaxed);
@@ -110,27 +121,18 @@ CacheStatistics CacheMetrics::getStatistics() const {
     stats.concurrentReadBlocks = concurrentReadBlocks_.load(std::memory_order_relaxed);
 
     // Timing metrics
-    {
-        std::lock_guard<std::mutex> lock(timingMutex_);
-
-        stats.averageResponseTime = hitResponseCount_ + missResponseCount_ > 0 ?
-            totalResponseTime_ / (hitResponseCount_ + missResponseCount_) : 0.0;
-
-        stats.cacheHitResponseTime = hitResponseCount_ > 0 ?
-            totalHitResponseTime_ / hitResponseCount_ : 0.0;
-
-        stats.cacheMissResponseTime = missResponseCount_ > 0 ?
-            totalMissResponseTime_ / missResponseCount_ : 0.0;
-
-        stats.freshHitResponseTime = freshHitResponseCount_ > 0 ?
-            totalFreshHitResponseTime_ / freshHitResponseCount_ : 0.0;
-
-        stats.staleHitResponseTime = staleHitResponseCount_ > 0 ?
-            totalStaleHitResponseTime_ / staleHitResponseCount_ : 0.0;
-
-        stats.expiredReadResponseTime = expiredReadResponseCount_ > 0 ?
-            totalExpiredReadResponseTime_ / expiredReadResponseCount_ : 0.0;
-    }
+    uint64_t hitCount = hitResponseCount_.load(std::memory_order_relaxed);
+    uint64_t missCount = missResponseCount_.load(std::memory_order_relaxed);
+    uint64_t responseTimeNs = totalHitResponseTimeNs_.load(std::memory_order_relaxed) +
+                              totalMissResponseTimeNs_.load(std::memory_order_relaxed);
+    stats.averageResponseTime = hitCount + missCount > 0 ?
+        responseTimeNs / 1e6 / static_cast<double>(hitCount + missCount) : 0.0;
+
+    stats.cacheHitResponseTime = averageTime(totalHitResponseTimeNs_, hitResponseCount_);
+    stats.cacheMissResponseTime = averageTime(totalMissResponseTimeNs_, missResponseCount_);
+    stats.freshHitResponseTime = averageTime(totalFreshHitResponseTimeNs_, freshHitResponseCount_);
+    stats.staleHitResponseTime = averageTime(totalStaleHitResponseTimeNs_, staleHitResponseCount_);
+    stats.expiredReadResponseTime = averageTime(totalExpiredReadResponseTimeNs_, expiredReadResponseCount_);
 
     // Get cache health metrics from cache manager
     size_t freshCount = 0, staleCount = 0, expiredCount = 0;
@@ -185,6 +187,7 @@ nlohmann::json CacheMetrics::getMetricsJSON(bool includeTimestamps) const {
             {"stale_hit_response_time_ms", stats.staleHitResponseTime},
             {"expired_read_response_time_ms", stats.expiredReadResponseTime}
         }},
+        {"latency", getLatencyJSON()},
         {"cache_health", {
             {"total_entries", stats.totalEntries},
             {"fresh_entries", stats.freshEntries},
@@ -223,7 +226,18 @@ nlohmann::json CacheMetrics::getMetricsJSON(bool includeTimestamps) const {
             {"failed_updates", bgStats.failedUpdates},
             {"queued_updates", bgStats.queuedUpdates},
             {"duplicate_updates", bgStats.duplicateUpdates},
-            {"average_update_time_ms", bgStats.averageUpdateTime}
+            {"reprioritized_updates", bgStats.reprioritizedUpdates},
+            {"budget_shed_updates", bgStats.budgetShedUpdates},
+            {"timed_out_updates", bgStats.timedOutUpdates},
+            {"active_workers", bgStats.activeWorkers},
+            {"worker_threads", bgStats.workerThreads},
+            {"upstream_latency_ms", bgStats.upstreamLatency},
+            {"average_update_time_ms", bgStats.averageUpdateTime},
+            {"refresh_ahead", {
+                {"reads", bgStats.refreshAheadReads},
+                {"avoided_stale_reads", bgStats.refreshAheadAvoided},
+                {"skipped_over_budget", bgStats.refreshAheadSkipped}
+            }}
         };
     }
 
@@ -262,19 +276,19 @@ void CacheMetrics::reset() {
     totalCleanups_.store(0, std::memory_order_relaxed);
     entriesRemoved_.store(0, std::memory_order_relaxed);
 
-    {
-        std::lock_guard<std::mutex> lock(timingMutex_);
-        totalResponseTime_ = 0.0;
-        totalHitResponseTime_ = 0.0;
-        totalMissResponseTime_ = 0.0;
-        totalFreshHitResponseTime_ = 0.0;
-        totalStaleHitResponseTime_ = 0.0;
-        totalExpiredReadResponseTime_ = 0.0;
-        hitResponseCount_ = 0;
-        missResponseCount_ = 0;
-        freshHitResponseCount_ = 0;
-        staleHitResponseCount_ = 0;
-        expiredReadResponseCount_ = 0;
+    totalHitResponseTimeNs_.store(0, std::memory_order_relaxed);
+    totalMissResponseTimeNs_.store(0, std::memory_order_relaxed);
+    totalFreshHitResponseTimeNs_.store(0, std::memory_order_relaxed);
+    totalStaleHitResponseTimeNs_.store(0, std::memory_order_relaxed);
+    totalExpiredReadResponseTimeNs_.store(0, std::memory_order_relaxed);
+    hitResponseCount_.store(0, std::memory_order_relaxed);
+    missResponseCount_.store(0, std::memory_order_relaxed);
+    freshHitResponseCount_.store(0, std::memory_order_relaxed);
+    staleHitResponseCount_.store(0, std::memory_order_relaxed);
+    expiredReadResponseCount_.store(0, std::memory_order_relaxed);
+
+    for (auto& histogram : pathLatency_) {
+        histogram.reset();
     }
 
     lastUpdate_.store(std::chrono::steady_clock::now(), std::memory_order_relaxed);
@@ -286,10 +300,15 @@ void CacheMetrics::setBackgroundUpdater(BackgroundUpdater* backgroundUpdater) {
     backgroundUpdater_ = backgroundUpdater;
 }
 
-void CacheMetrics::updateAverageTime(double& totalTime, uint64_t& count, double newTime) {
-    // This method assumes the mutex is already locked
-    totalTime += newTime;
-    count++;
+void CacheMetrics::updateAverageTime(std::atomic<uint64_t>& totalTimeNs, std::atomic<uint64_t>& count,
+                                     double newTime) {
+    totalTimeNs.fetch_add(static_cast<uint64_t>(newTime * 1e6), std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+}
+
+double CacheMetrics::averageTime(const std::atomic<uint64_t>& totalTimeNs, const std::atomic<uint64_t>& count) {
+    uint64_t n = count.load(std::memory_order_relaxed);
+    return n > 0 ? totalTimeNs.load(std::memory_order_relaxed) / 1e6 / static_cast<double>(n) : 0.0;
 }
 
 void CacheMetrics::getCacheHealthMetrics(size_t& freshCount, size_t& staleCount, size_t& expiredCount) const {
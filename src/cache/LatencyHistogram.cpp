@@ -0,0 +1,82 @@
+#include "cache/LatencyHistogram.h"
+#include <algorithm>
+#include <cmath>
+
+namespace opcua2http {
+
+void LatencyHistogram::Snapshot::merge(const Snapshot& other) {
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        buckets[i] += other.buckets[i];
+    }
+    count += other.count;
+    totalNanos += other.totalNanos;
+    maxNanos = std::max(maxNanos, other.maxNanos);
+}
+
+double LatencyHistogram::Snapshot::percentileMs(double percentile) const {
+    if (count == 0) {
+        return 0.0;
+    }
+
+    double fraction = std::clamp(percentile, 0.0, 100.0) / 100.0;
+    uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(fraction * static_cast<double>(count))));
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            // Never report more than was actually recorded
+            return static_cast<double>(std::min(bucketUpperBound(i), maxNanos)) / 1e6;
+        }
+    }
+    return maxMs();
+}
+
+double LatencyHistogram::Snapshot::meanMs() const {
+    return count > 0 ? static_cast<double>(totalNanos) / 1e6 / static_cast<double>(count) : 0.0;
+}
+
+double LatencyHistogram::Snapshot::maxMs() const {
+    return static_cast<double>(maxNanos) / 1e6;
+}
+
+nlohmann::json LatencyHistogram::Snapshot::toJSON() const {
+    return {
+        {"count", count},
+        {"mean_ms", meanMs()},
+        {"p50_ms", percentileMs(50.0)},
+        {"p90_ms", percentileMs(90.0)},
+        {"p99_ms", percentileMs(99.0)},
+        {"p999_ms", percentileMs(99.9)},
+        {"max_ms", maxMs()}
+    };
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const {
+    Snapshot snapshot;
+
+    for (const auto& stripe : stripes_) {
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            uint64_t samples = stripe.buckets[i].load(std::memory_order_relaxed);
+            snapshot.buckets[i] += samples;
+            // Count from the buckets so percentiles stay consistent with a concurrent record()
+            snapshot.count += samples;
+        }
+        snapshot.totalNanos += stripe.totalNanos.load(std::memory_order_relaxed);
+        snapshot.maxNanos = std::max(snapshot.maxNanos, stripe.maxNanos.load(std::memory_order_relaxed));
+    }
+
+    return snapshot;
+}
+
+void LatencyHistogram::reset() {
+    for (auto& stripe : stripes_) {
+        for (auto& bucket : stripe.buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        stripe.totalNanos.store(0, std::memory_order_relaxed);
+        stripe.maxNanos.store(0, std::memory_order_relaxed);
+    }
+}
+
+} // namespace opcua2http
@@ -0,0 +1,231 @@
+#include "cache/LockProfiler.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace opcua2http {
+
+namespace {
+
+uint64_t toNanos(std::chrono::nanoseconds duration) {
+    return duration.count() > 0 ? static_cast<uint64_t>(duration.count()) : 0;
+}
+
+double nanosToMs(uint64_t nanos) {
+    return static_cast<double>(nanos) / 1e6;
+}
+
+void updateMax(std::atomic<uint64_t>& max, uint64_t value) {
+    uint64_t current = max.load(std::memory_order_relaxed);
+    while (value > current && !max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+// Build paths are absolute; the part from src/ or include/ on is what a reader needs
+std::string shortenPath(const char* file) {
+    std::string path(file ? file : "");
+    for (const char* marker : {"/src/", "/include/", "/tests/"}) {
+        auto pos = path.rfind(marker);
+        if (pos != std::string::npos) {
+            return path.substr(pos + 1);
+        }
+    }
+    return path;
+}
+
+} // namespace
+
+LockProfiler::LockProfiler() {
+    otherSites_.file = "(other)";
+    otherSites_.function = "(call site table full)";
+}
+
+LockProfiler::CallSite* LockProfiler::recordAcquisition(LockId id, std::optional<std::chrono::nanoseconds> wait,
+                                                        const std::source_location& site) {
+    auto& stats = locks_[static_cast<size_t>(id)];
+    uint64_t waitNanos = wait ? toNanos(*wait) : 0;
+
+    stats.acquisitions.fetch_add(1, std::memory_order_relaxed);
+    stats.wait.record(std::chrono::nanoseconds(waitNanos));
+
+    CallSite* callSite = findOrInsertSite(id, site);
+    callSite->acquisitions.fetch_add(1, std::memory_order_relaxed);
+
+    if (wait) {
+        stats.contentions.fetch_add(1, std::memory_order_relaxed);
+        callSite->contentions.fetch_add(1, std::memory_order_relaxed);
+        callSite->waitNanos.fetch_add(waitNanos, std::memory_order_relaxed);
+        updateMax(callSite->maxWaitNanos, waitNanos);
+    }
+    return callSite;
+}
+
+void LockProfiler::recordRelease(LockId id, CallSite* site, std::chrono::nanoseconds held) {
+    uint64_t heldNanos = toNanos(held);
+    locks_[static_cast<size_t>(id)].hold.record(std::chrono::nanoseconds(heldNanos));
+    if (site) {
+        site->holdNanos.fetch_add(heldNanos, std::memory_order_relaxed);
+        updateMax(site->maxHoldNanos, heldNanos);
+    }
+}
+
+LockProfiler::CallSite* LockProfiler::findOrInsertSite(LockId id, const std::source_location& site) {
+    // file_name() and function_name() point at static strings, so identity is by pointer
+    size_t hash = std::hash<const void*>{}(site.file_name());
+    hash = hash * 31 + site.line();
+    hash = hash * 31 + static_cast<size_t>(id);
+    uint64_t key = (static_cast<uint64_t>(hash) << 1) | 1;   // Never 0, the free marker
+
+    auto matches = [&](const CallSite& slot) {
+        return slot.lock == id && slot.line == site.line() && slot.file == site.file_name();
+    };
+
+    size_t start = hash % CALL_SITE_SLOTS;
+    for (size_t probe = 0; probe < CALL_SITE_SLOTS; ++probe) {
+        CallSite& slot = sites_[(start + probe) % CALL_SITE_SLOTS];
+        uint64_t slotKey = slot.key.load(std::memory_order_acquire);
+        if (slotKey == key && matches(slot)) {
+            return &slot;
+        }
+        if (slotKey != 0) {
+            continue;
+        }
+
+        // Free slot: claim it under the insert mutex, unless another thread just did
+        std::lock_guard<std::mutex> lock(siteInsertMutex_);
+        slotKey = slot.key.load(std::memory_order_acquire);
+        if (slotKey == 0) {
+            slot.lock = id;
+            slot.file = site.file_name();
+            slot.function = site.function_name();
+            slot.line = site.line();
+            slot.key.store(key, std::memory_order_release);
+            return &slot;
+        }
+        if (slotKey == key && matches(slot)) {
+            return &slot;
+        }
+    }
+    return &otherSites_;
+}
+
+LockProfiler::LockReport LockProfiler::getLockReport(LockId id) const {
+    const auto& stats = locks_[static_cast<size_t>(id)];
+    LockReport report;
+    report.acquisitions = stats.acquisitions.load(std::memory_order_relaxed);
+    report.contentions = stats.contentions.load(std::memory_order_relaxed);
+    report.wait = stats.wait.snapshot();
+    report.hold = stats.hold.snapshot();
+    return report;
+}
+
+std::vector<LockProfiler::CallSiteReport> LockProfiler::getTopCallSites(size_t limit) const {
+    std::vector<CallSiteReport> reports;
+
+    auto add = [&reports](const CallSite& slot) {
+        uint64_t acquisitions = slot.acquisitions.load(std::memory_order_relaxed);
+        if (acquisitions == 0) {
+            return;
+        }
+        CallSiteReport report;
+        report.lock = slot.lock;
+        report.function = slot.function ? slot.function : "";
+        report.file = shortenPath(slot.file);
+        report.line = slot.line;
+        report.acquisitions = acquisitions;
+        report.contentions = slot.contentions.load(std::memory_order_relaxed);
+        report.totalWaitMs = nanosToMs(slot.waitNanos.load(std::memory_order_relaxed));
+        report.maxWaitMs = nanosToMs(slot.maxWaitNanos.load(std::memory_order_relaxed));
+        report.totalHoldMs = nanosToMs(slot.holdNanos.load(std::memory_order_relaxed));
+        report.maxHoldMs = nanosToMs(slot.maxHoldNanos.load(std::memory_order_relaxed));
+        reports.push_back(std::move(report));
+    };
+
+    for (const auto& slot : sites_) {
+        if (slot.key.load(std::memory_order_acquire) != 0) {
+            add(slot);
+        }
+    }
+    add(otherSites_);
+
+    std::sort(reports.begin(), reports.end(), [](const CallSiteReport& a, const CallSiteReport& b) {
+        if (a.totalWaitMs != b.totalWaitMs) {
+            return a.totalWaitMs > b.totalWaitMs;
+        }
+        return a.totalHoldMs > b.totalHoldMs;
+    });
+    if (reports.size() > limit) {
+        reports.resize(limit);
+    }
+    return reports;
+}
+
+nlohmann::json LockProfiler::toJSON(size_t limit) const {
+    nlohmann::json locks = nlohmann::json::object();
+    for (size_t i = 0; i < LOCK_COUNT; ++i) {
+        auto id = static_cast<LockId>(i);
+        auto report = getLockReport(id);
+        locks[lockName(id)] = {
+            {"acquisitions", report.acquisitions},
+            {"contentions", report.contentions},
+            {"contention_ratio", report.acquisitions > 0
+                ? static_cast<double>(report.contentions) / static_cast<double>(report.acquisitions) : 0.0},
+            {"wait", report.wait.toJSON()},
+            {"hold", report.hold.toJSON()}
+        };
+    }
+
+    nlohmann::json sites = nlohmann::json::array();
+    for (const auto& site : getTopCallSites(limit)) {
+        sites.push_back({
+            {"lock", lockName(site.lock)},
+            {"function", site.function},
+            {"file", site.file},
+            {"line", site.line},
+            {"acquisitions", site.acquisitions},
+            {"contentions", site.contentions},
+            {"total_wait_ms", site.totalWaitMs},
+            {"max_wait_ms", site.maxWaitMs},
+            {"avg_hold_ms", site.acquisitions > 0 ? site.totalHoldMs / static_cast<double>(site.acquisitions) : 0.0},
+            {"max_hold_ms", site.maxHoldMs}
+        });
+    }
+
+    return {
+        {"locks", locks},
+        {"top_call_sites", sites}
+    };
+}
+
+void LockProfiler::reset() {
+    for (auto& stats : locks_) {
+        stats.acquisitions.store(0, std::memory_order_relaxed);
+        stats.contentions.store(0, std::memory_order_relaxed);
+        stats.wait.reset();
+        stats.hold.reset();
+    }
+
+    auto clear = [](CallSite& slot) {
+        slot.acquisitions.store(0, std::memory_order_relaxed);
+        slot.contentions.store(0, std::memory_order_relaxed);
+        slot.waitNanos.store(0, std::memory_order_relaxed);
+        slot.maxWaitNanos.store(0, std::memory_order_relaxed);
+        slot.holdNanos.store(0, std::memory_order_relaxed);
+        slot.maxHoldNanos.store(0, std::memory_order_relaxed);
+    };
+    for (auto& slot : sites_) {
+        clear(slot);
+    }
+    clear(otherSites_);
+}
+
+const char* LockProfiler::lockName(LockId id) {
+    switch (id) {
+        case LockId::CACHE_MUTEX: return "cache_mutex";
+        case LockId::CLIENT_MUTEX: return "client_mutex";
+        case LockId::SUBSCRIPTION_MUTEX: return "subscription_mutex";
+    }
+    return "unknown";
+}
+
+} // namespace opcua2http
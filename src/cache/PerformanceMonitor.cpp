@@ -4,128 +4,188 @@
 
 namespace opcua2http {
 
-PerformanceMonitor::PerformanceMonitor()
-    : startTime_(std::chrono::steady_clock::now()) {
-    spdlog::debug("PerformanceMonitor initialized");
-}
-
-uint64_t PerformanceMonitor::startOperation(OperationType type) {
-    if (!enabled_.load(std::memory_order_relaxed)) {
-        return 0;
-    }
+namespace {
 
-    uint64_t operationId = nextOperationId_.fetch_add(1, std::memory_order_relaxed);
-
-    OperationTiming timing;
-    timing.type = type;
-    timing.startTime = std::chrono::steady_clock::now();
-    timing.completed = false;
+constexpr size_t index(PerformanceMonitor::OperationType type) {
+    return static_cast<size_t>(type);
+}
 
-    std::lock_guard<std::mutex> lock(operationsMutex_);
-    activeOperations_[operationId] = timing;
+constexpr size_t index(PerformanceMonitor::LockType type) {
+    return static_cast<size_t>(type);
+}
 
-    return operationId;
+double nanosToMs(uint64_t nanos) {
+    return static_cast<double>(nanos) / 1e6;
 }
 
-void PerformanceMonitor::completeOperation(uint64_t operationId) {
-    if (!enabled_.load(std::memory_order_relaxed) || operationId == 0) {
-        return;
-    }
+// Slot ownership is per thread and shared by all monitors; a slot is freed
+// when its thread exits and the next thread continues its counters
+std::array<std::atomic<bool>, PerformanceMonitor::THREAD_SLOTS> slotsTaken{};
 
-    auto endTime = std::chrono::steady_clock::now();
+struct ThreadSlot {
+    size_t index;
 
-    std::lock_guard<std::mutex> lock(operationsMutex_);
+    explicit ThreadSlot(size_t overflow) : index(overflow) {
+        for (size_t i = 0; i < slotsTaken.size(); ++i) {
+            bool expected = false;
+            if (slotsTaken[i].compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                index = i;
+                break;
+            }
+        }
+    }
 
-    auto it = activeOperations_.find(operationId);
-    if (it != activeOperations_.end()) {
-        auto& timing = it->second;
-        timing.endTime = endTime;
-        timing.completed = true;
+    ~ThreadSlot() {
+        if (index < slotsTaken.size()) {
+            slotsTaken[index].store(false, std::memory_order_release);
+        }
+    }
+};
 
-        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
-            timing.endTime - timing.startTime);
-        timing.durationMs = duration.count() / 1000.0;
+} // namespace
 
-        // Update statistics
-        updateStatistics(timing.type, timing.durationMs);
+PerformanceMonitor::PerformanceMonitor()
+    : startTime_(std::chrono::steady_clock::now()) {
+    spdlog::debug("PerformanceMonitor initialized");
+}
 
-        // Remove from active operations
-        activeOperations_.erase(it);
+void PerformanceMonitor::recordOperationTime(OperationType type, double durationMs) {
+    if (!enabled_.load(std::memory_order_relaxed)) {
+        return;
     }
+
+    record(type, static_cast<int64_t>(std::max(durationMs, 0.0) * 1e6));
 }
 
-void PerformanceMonitor::recordOperationTime(OperationType type, double durationMs) {
+void PerformanceMonitor::recordOperation(OperationType type) {
     if (!enabled_.load(std::memory_order_relaxed)) {
         return;
     }
 
-    updateStatistics(type, durationMs);
+    record(type, -1);
 }
 
-void PerformanceMonitor::recordLockWait(double waitTimeMs) {
+void PerformanceMonitor::recordOpcReadLatency(size_t batchSize, std::chrono::nanoseconds latency) {
     if (!enabled_.load(std::memory_order_relaxed)) {
         return;
     }
 
-    lockWaitCount_.fetch_add(1, std::memory_order_relaxed);
+    auto limit = std::lower_bound(OPC_BATCH_SIZE_LIMITS.begin(), OPC_BATCH_SIZE_LIMITS.end(), batchSize);
+    opcReadLatency_[static_cast<size_t>(limit - OPC_BATCH_SIZE_LIMITS.begin())].record(latency);
+}
 
-    double currentTotal = lockWaitTotalTime_.load(std::memory_order_relaxed);
-    lockWaitTotalTime_.store(currentTotal + waitTimeMs, std::memory_order_relaxed);
+std::vector<PerformanceMonitor::BatchLatency> PerformanceMonitor::getOpcReadLatencies() const {
+    std::vector<BatchLatency> latencies;
+    latencies.reserve(OPC_BATCH_CLASS_COUNT);
 
-    spdlog::debug("Lock wait recorded: {:.3f} ms", waitTimeMs);
+    for (size_t i = 0; i < OPC_BATCH_CLASS_COUNT; ++i) {
+        latencies.push_back({OPC_BATCH_LABELS[i], opcReadLatency_[i].snapshot()});
+    }
+
+    return latencies;
+}
+
+LatencyHistogram::Snapshot PerformanceMonitor::getOpcReadLatency(size_t batchClass) const {
+    if (batchClass >= OPC_BATCH_CLASS_COUNT) {
+        return {};
+    }
+    return opcReadLatency_[batchClass].snapshot();
 }
 
-void PerformanceMonitor::recordLockContention() {
+void PerformanceMonitor::recordLockWait(LockType type, std::chrono::steady_clock::duration wait) {
     if (!enabled_.load(std::memory_order_relaxed)) {
         return;
     }
 
-    lockContentionCount_.fetch_add(1, std::memory_order_relaxed);
-    lockAcquireAttempts_.fetch_add(1, std::memory_order_relaxed);
+    size_t slot = threadSlot();
+    bool exclusive = slot != OVERFLOW_SLOT;
+    auto& counter = slots_[slot].locks[index(type)];
+    add(counter.acquisitions, 1, exclusive);
+    add(counter.contentions, 1, exclusive);
+    add(counter.waitNanos,
+        static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(wait).count()),
+        exclusive);
 }
 
 PerformanceMonitor::PerformanceMetrics PerformanceMonitor::getMetrics() const {
     PerformanceMetrics metrics;
 
-    // Calculate average response times
-    metrics.avgCacheReadTime = calculateAverage(
-        cacheReadTotalTime_.load(std::memory_order_relaxed),
-        cacheReadCount_.load(std::memory_order_relaxed));
-
-    metrics.avgCacheWriteTime = calculateAverage(
-        cacheWriteTotalTime_.load(std::memory_order_relaxed),
-        cacheWriteCount_.load(std::memory_order_relaxed));
-
-    metrics.avgOPCReadTime = calculateAverage(
-        opcReadTotalTime_.load(std::memory_order_relaxed),
-        opcReadCount_.load(std::memory_order_relaxed));
+    Totals totals = collect();
+    std::chrono::steady_clock::time_point startTime;
+    {
+        std::lock_guard<std::mutex> lock(baselineMutex_);
+        for (size_t i = 0; i < OPERATION_TYPE_COUNT; ++i) {
+            for (size_t j = 0; j < 3; ++j) {
+                totals.operations[i][j] -= baseline_.operations[i][j];
+            }
+        }
+        for (size_t i = 0; i < LOCK_TYPE_COUNT; ++i) {
+            for (size_t j = 0; j < 3; ++j) {
+                totals.locks[i][j] -= baseline_.locks[i][j];
+            }
+        }
+        startTime = startTime_;
+    }
 
-    metrics.avgBatchReadTime = calculateAverage(
-        batchReadTotalTime_.load(std::memory_order_relaxed),
-        batchReadCount_.load(std::memory_order_relaxed));
+    auto count = [&totals](OperationType type) {
+        return totals.operations[index(type)][0];
+    };
+    // Batch cache operations count as cache reads/writes
+    auto average = [&totals](std::initializer_list<OperationType> types) {
+        uint64_t timed = 0, nanos = 0;
+        for (auto type : types) {
+            timed += totals.operations[index(type)][1];
+            nanos += totals.operations[index(type)][2];
+        }
+        return timed > 0 ? nanosToMs(nanos) / static_cast<double>(timed) : 0.0;
+    };
+    auto lockMetrics = [&totals](LockType type) {
+        const auto& counter = totals.locks[index(type)];
+        LockMetrics lock;
+        lock.acquisitions = counter[0];
+        lock.contentions = counter[1];
+        lock.avgWaitTime = lock.contentions > 0 ? nanosToMs(counter[2]) / lock.contentions : 0.0;
+        lock.contentionRatio = lock.acquisitions > 0
+            ? static_cast<double>(lock.contentions) / lock.acquisitions
+            : 0.0;
+        return lock;
+    };
 
-    metrics.avgBackgroundUpdateTime = calculateAverage(
-        backgroundUpdateTotalTime_.load(std::memory_order_relaxed),
-        backgroundUpdateCount_.load(std::memory_order_relaxed));
+    // Calculate average response times
+    metrics.cacheReads = count(OperationType::CACHE_READ) + count(OperationType::CACHE_BATCH_READ);
+    metrics.cacheWrites = count(OperationType::CACHE_WRITE) + count(OperationType::CACHE_BATCH_WRITE);
+    metrics.opcReads = count(OperationType::OPC_READ);
+    metrics.opcBatchReads = count(OperationType::OPC_BATCH_READ);
+    metrics.backgroundUpdates = count(OperationType::BACKGROUND_UPDATE);
+
+    metrics.avgCacheReadTime = average({OperationType::CACHE_READ, OperationType::CACHE_BATCH_READ});
+    metrics.avgCacheWriteTime = average({OperationType::CACHE_WRITE, OperationType::CACHE_BATCH_WRITE});
+    metrics.avgOPCReadTime = average({OperationType::OPC_READ});
+    metrics.avgBatchReadTime = average({OperationType::OPC_BATCH_READ});
+    metrics.avgBackgroundUpdateTime = average({OperationType::BACKGROUND_UPDATE});
 
     // Calculate concurrency metrics
-    metrics.totalLockWaits = lockWaitCount_.load(std::memory_order_relaxed);
-    metrics.avgLockWaitTime = calculateAverage(
-        lockWaitTotalTime_.load(std::memory_order_relaxed),
-        lockWaitCount_.load(std::memory_order_relaxed));
-
-    metrics.lockContentions = lockContentionCount_.load(std::memory_order_relaxed);
-
-    uint64_t attempts = lockAcquireAttempts_.load(std::memory_order_relaxed);
-    metrics.lockContentionRatio = (attempts > 0)
-        ? static_cast<double>(metrics.lockContentions) / attempts
+    metrics.cacheLock = lockMetrics(LockType::CACHE_MUTEX);
+    metrics.clientLock = lockMetrics(LockType::CLIENT_MUTEX);
+
+    uint64_t acquisitions = metrics.cacheLock.acquisitions + metrics.clientLock.acquisitions;
+    uint64_t waitNanos = totals.locks[index(LockType::CACHE_MUTEX)][2] +
+                         totals.locks[index(LockType::CLIENT_MUTEX)][2];
+    metrics.lockContentions = metrics.cacheLock.contentions + metrics.clientLock.contentions;
+    metrics.totalLockWaits = metrics.lockContentions;
+    metrics.avgLockWaitTime = metrics.lockContentions > 0
+        ? nanosToMs(waitNanos) / metrics.lockContentions
+        : 0.0;
+    metrics.lockContentionRatio = (acquisitions > 0)
+        ? static_cast<double>(metrics.lockContentions) / acquisitions
         : 0.0;
 
     // Calculate throughput
-    metrics.totalOperations = totalOperations_.load(std::memory_order_relaxed);
+    metrics.totalOperations = metrics.cacheReads + metrics.cacheWrites + metrics.opcReads +
+                              metrics.opcBatchReads + metrics.backgroundUpdates;
 
     auto now = std::chrono::steady_clock::now();
-    auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - startTime_);
+    auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - startTime);
     metrics.operationsPerSecond = (elapsed.count() > 0)
         ? metrics.totalOperations / elapsed.count()
         : 0;
@@ -151,27 +211,14 @@ std::vector<std::string> PerformanceMonitor::getRecommendations() const {
 }
 
 void PerformanceMonitor::reset() {
-    std::lock_guard<std::mutex> lock(operationsMutex_);
-
-    // Clear active operations
-    activeOperations_.clear();
-
-    // Reset all counters
-    cacheReadCount_.store(0, std::memory_order_relaxed);
-    cacheReadTotalTime_.store(0.0, std::memory_order_relaxed);
-    cacheWriteCount_.store(0, std::memory_order_relaxed);
-    cacheWriteTotalTime_.store(0.0, std::memory_order_relaxed);
-    opcReadCount_.store(0, std::memory_order_relaxed);
-    opcReadTotalTime_.store(0.0, std::memory_order_relaxed);
-    batchReadCount_.store(0, std::memory_order_relaxed);
-    batchReadTotalTime_.store(0.0, std::memory_order_relaxed);
-    backgroundUpdateCount_.store(0, std::memory_order_relaxed);
-    backgroundUpdateTotalTime_.store(0.0, std::memory_order_relaxed);
-    lockWaitCount_.store(0, std::memory_order_relaxed);
-    lockWaitTotalTime_.store(0.0, std::memory_order_relaxed);
-    lockContentionCount_.store(0, std::memory_order_relaxed);
-    lockAcquireAttempts_.store(0, std::memory_order_relaxed);
-    totalOperations_.store(0, std::memory_order_relaxed);
+    Totals totals = collect();
+
+    std::lock_guard<std::mutex> lock(baselineMutex_);
+    baseline_ = totals;
+
+    for (auto& histogram : opcReadLatency_) {
+        histogram.reset();
+    }
 
     // Reset start time
     startTime_ = std::chrono::steady_clock::now();
@@ -184,10 +231,6 @@ void PerformanceMonitor::setEnabled(bool enabled) {
     spdlog::info("Performance monitoring {}", enabled ? "enabled" : "disabled");
 }
 
-bool PerformanceMonitor::isEnabled() const {
-    return enabled_.load(std::memory_order_relaxed);
-}
-
 void PerformanceMonitor::setPerformanceThresholds(double cacheReadThresholdMs,
                                                   double opcReadThresholdMs) {
     cacheReadThreshold_.store(cacheReadThresholdMs, std::memory_order_relaxed);
@@ -197,47 +240,28 @@ void PerformanceMonitor::setPerformanceThresholds(double cacheReadThresholdMs,
                  cacheReadThresholdMs, opcReadThresholdMs);
 }
 
-void PerformanceMonitor::updateStatistics(OperationType type, double durationMs) {
-    totalOperations_.fetch_add(1, std::memory_order_relaxed);
+size_t PerformanceMonitor::claimThreadSlot() {
+    thread_local ThreadSlot slot(OVERFLOW_SLOT);
+    return slot.index;
+}
 
-    switch (type) {
-        case OperationType::CACHE_READ:
-        case OperationType::CACHE_BATCH_READ: {
-            cacheReadCount_.fetch_add(1, std::memory_order_relaxed);
-            double currentTotal = cacheReadTotalTime_.load(std::memory_order_relaxed);
-            cacheReadTotalTime_.store(currentTotal + durationMs, std::memory_order_relaxed);
-            break;
-        }
-        case OperationType::CACHE_WRITE:
-        case OperationType::CACHE_BATCH_WRITE: {
-            cacheWriteCount_.fetch_add(1, std::memory_order_relaxed);
-            double currentTotal = cacheWriteTotalTime_.load(std::memory_order_relaxed);
-            cacheWriteTotalTime_.store(currentTotal + durationMs, std::memory_order_relaxed);
-            break;
-        }
-        case OperationType::OPC_READ: {
-            opcReadCount_.fetch_add(1, std::memory_order_relaxed);
-            double currentTotal = opcReadTotalTime_.load(std::memory_order_relaxed);
-            opcReadTotalTime_.store(currentTotal + durationMs, std::memory_order_relaxed);
-            break;
+PerformanceMonitor::Totals PerformanceMonitor::collect() const {
+    Totals totals;
+    for (const auto& slot : slots_) {
+        for (size_t i = 0; i < OPERATION_TYPE_COUNT; ++i) {
+            const auto& counter = slot.operations[i];
+            totals.operations[i][0] += counter.count.load(std::memory_order_relaxed);
+            totals.operations[i][1] += counter.timed.load(std::memory_order_relaxed);
+            totals.operations[i][2] += counter.totalNanos.load(std::memory_order_relaxed);
         }
-        case OperationType::OPC_BATCH_READ: {
-            batchReadCount_.fetch_add(1, std::memory_order_relaxed);
-            double currentTotal = batchReadTotalTime_.load(std::memory_order_relaxed);
-            batchReadTotalTime_.store(currentTotal + durationMs, std::memory_order_relaxed);
-            break;
-        }
-        case OperationType::BACKGROUND_UPDATE: {
-            backgroundUpdateCount_.fetch_add(1, std::memory_order_relaxed);
-            double currentTotal = backgroundUpdateTotalTime_.load(std::memory_order_relaxed);
-            backgroundUpdateTotalTime_.store(currentTotal + durationMs, std::memory_order_relaxed);
-            break;
+        for (size_t i = 0; i < LOCK_TYPE_COUNT; ++i) {
+            const auto& counter = slot.locks[i];
+            totals.locks[i][0] += counter.acquisitions.load(std::memory_order_relaxed);
+            totals.locks[i][1] += counter.contentions.load(std::memory_order_relaxed);
+            totals.locks[i][2] += counter.waitNanos.load(std::memory_order_relaxed);
         }
     }
-}
-
-double PerformanceMonitor::calculateAverage(double totalTime, uint64_t count) const {
-    return (count > 0) ? (totalTime / count) : 0.0;
+    return totals;
 }
 
 std::vector<std::string> PerformanceMonitor::analyzePerformance(
@@ -16,6 +16,13 @@ Configuration Configuration::loadFromEnvironment() {
     config.defaultNamespace = getEnvInt("OPC_NAMESPACE", 2);
     config.applicationUri = getEnvString("OPC_APPLICATION_URI", "urn:opcua2http:client");
     
+    // Redundancy Configuration
+    std::string backupEndpointsStr = getEnvString("OPC_BACKUP_ENDPOINTS");
+    if (!backupEndpointsStr.empty()) {
+        config.opcBackupEndpoints = parseCommaSeparated(backupEndpointsStr);
+    }
+    config.opcFailoverMinServiceLevel = getEnvInt("OPC_FAILOVER_MIN_SERVICE_LEVEL", 200);
+    
     // Connection Configuration
     config.connectionRetryMax = getEnvInt("CONNECTION_RETRY_MAX", 5);
     config.connectionInitialDelay = getEnvInt("CONNECTION_INITIAL_DELAY", 1000);
@@ -35,6 +42,14 @@ Configuration Configuration::loadFromEnvironment() {
     if (!allowedOriginsStr.empty()) {
         config.allowedOrigins = parseCommaSeparated(allowedOriginsStr);
     }
+
+    // Client Rate Limiting Configuration
+    config.rateLimitRequestsPerSecond = getEnvInt("RATE_LIMIT_REQUESTS_PER_SECOND", 0);
+    config.rateLimitBurst = getEnvInt("RATE_LIMIT_BURST", 0);
+    config.rateLimitMaxClients = getEnvInt("RATE_LIMIT_MAX_CLIENTS", 10000);
+    config.authMaxFailures = getEnvInt("AUTH_MAX_FAILURES", 5);
+    config.authBlockSeconds = getEnvInt("AUTH_BLOCK_SECONDS", 900);
+    config.trustProxyHeaders = getEnvInt("TRUST_PROXY_HEADERS", 0) != 0;
     
     // Cache Configuration (Legacy - for backward compatibility)
     config.cacheExpireMinutes = getEnvInt("CACHE_EXPIRE_MINUTES", 60);
@@ -42,6 +57,24 @@ Configuration Configuration::loadFromEnvironment() {
     
     // Load new cache settings
     config.loadCacheSettings();
+
+    // Request Trace Configuration
+    config.requestTraceFile = getEnvString("REQUEST_TRACE_FILE");
+    config.requestTraceBufferKb = getEnvInt("REQUEST_TRACE_BUFFER_KB", 4096);
+
+    // Server-Timing Configuration
+    config.serverTimingEnabled = getEnvInt("SERVER_TIMING_ENABLED", 0) != 0;
+
+    // Lock Profiling Configuration
+    config.lockProfilingEnabled = getEnvInt("LOCK_PROFILING_ENABLED", 0) != 0;
+
+    // Tag Group Configuration
+    config.tagGroups = parseTagGroups(getEnvString("TAG_GROUPS"));
+    config.tagGroupMaxCount = getEnvInt("TAG_GROUP_MAX_COUNT", 64);
+    config.tagGroupMaxSize = getEnvInt("TAG_GROUP_MAX_SIZE", 1000);
+
+    // Response Cache Configuration
+    config.responseCacheSize = getEnvInt("RESPONSE_CACHE_SIZE", 128);
     
     // Logging Configuration
     config.logLevel = getEnvString("LOG_LEVEL", "INFO");
@@ -66,6 +99,18 @@ bool Configuration::validate() const {
         return false;
     }
     
+    if (opcFailoverMinServiceLevel < 0 || opcFailoverMinServiceLevel > 255) {
+        std::cerr << "Error: OPC_FAILOVER_MIN_SERVICE_LEVEL must be between 0 and 255" << std::endl;
+        return false;
+    }
+    
+    for (const auto& endpoint : opcBackupEndpoints) {
+        if (endpoint == opcEndpoint) {
+            std::cerr << "Error: OPC_BACKUP_ENDPOINTS must not repeat OPC_ENDPOINT" << std::endl;
+            return false;
+        }
+    }
+    
     if (connectionRetryMax < 0) {
         std::cerr << "Error: CONNECTION_RETRY_MAX must be non-negative" << std::endl;
         return false;
@@ -86,6 +131,50 @@ bool Configuration::validate() const {
         return false;
     }
     
+    if (!requestTraceFile.empty() && (requestTraceBufferKb < 64 || requestTraceBufferKb > 1048576)) {
+        std::cerr << "Error: REQUEST_TRACE_BUFFER_KB must be between 64 and 1048576" << std::endl;
+        return false;
+    }
+    
+    if (rateLimitRequestsPerSecond < 0 || rateLimitBurst < 0) {
+        std::cerr << "Error: RATE_LIMIT_REQUESTS_PER_SECOND and RATE_LIMIT_BURST must be non-negative" << std::endl;
+        return false;
+    }
+    
+    if (rateLimitMaxClients < 1) {
+        std::cerr << "Error: RATE_LIMIT_MAX_CLIENTS must be positive" << std::endl;
+        return false;
+    }
+    
+    if (authMaxFailures < 0 || authBlockSeconds < 0) {
+        std::cerr << "Error: AUTH_MAX_FAILURES and AUTH_BLOCK_SECONDS must be non-negative" << std::endl;
+        return false;
+    }
+    
+    if (tagGroupMaxCount < 0 || tagGroupMaxSize < 1) {
+        std::cerr << "Error: TAG_GROUP_MAX_COUNT must be non-negative and TAG_GROUP_MAX_SIZE positive" << std::endl;
+        return false;
+    }
+    
+    if (tagGroups.size() > static_cast<size_t>(tagGroupMaxCount)) {
+        std::cerr << "Error: TAG_GROUPS defines " << tagGroups.size() << " groups, more than TAG_GROUP_MAX_COUNT ("
+                  << tagGroupMaxCount << ")" << std::endl;
+        return false;
+    }
+    
+    for (const auto& [name, nodeIds] : tagGroups) {
+        if (nodeIds.empty() || nodeIds.size() > static_cast<size_t>(tagGroupMaxSize)) {
+            std::cerr << "Error: Tag group '" << name << "' must have between 1 and TAG_GROUP_MAX_SIZE ("
+                      << tagGroupMaxSize << ") node IDs" << std::endl;
+            return false;
+        }
+    }
+    
+    if (responseCacheSize < 0) {
+        std::cerr << "Error: RESPONSE_CACHE_SIZE must be non-negative" << std::endl;
+        return false;
+    }
+    
     // Validate authentication configuration
     if (!authUsername.empty() && authPassword.empty()) {
         std::cerr << "Warning: AUTH_USERNAME provided but AUTH_PASSWORD is empty" << std::endl;
@@ -112,6 +201,15 @@ std::string Configuration::toString() const {
     oss << "  Security Policy: " << securityPolicy << "\n";
     oss << "  Default Namespace: " << defaultNamespace << "\n";
     oss << "  Application URI: " << applicationUri << "\n";
+    if (!opcBackupEndpoints.empty()) {
+        oss << "  Backup Endpoints: ";
+        for (size_t i = 0; i < opcBackupEndpoints.size(); ++i) {
+            if (i > 0) oss << ", ";
+            oss << opcBackupEndpoints[i];
+        }
+        oss << "\n";
+        oss << "  Failover Min Service Level: " << opcFailoverMinServiceLevel << "\n";
+    }
     oss << "  Server Port: " << serverPort << "\n";
     oss << "  Connection Retry Max: " << connectionRetryMax << "\n";
     oss << "  Connection Initial Delay: " << connectionInitialDelay << "ms\n";
@@ -128,8 +226,14 @@ std::string Configuration::toString() const {
     
     // Background Update Configuration
     oss << "  Background Update Threads: " << backgroundUpdateThreads << "\n";
+    oss << "  Background Update Min Threads: " << backgroundUpdateMinThreads << "\n";
     oss << "  Background Update Queue Size: " << backgroundUpdateQueueSize << "\n";
     oss << "  Background Update Timeout: " << backgroundUpdateTimeoutMs << "ms\n";
+
+    // Refresh-Ahead Configuration
+    oss << "  Refresh-Ahead Budget: " << refreshAheadReadsPerSecond << " reads/s\n";
+    oss << "  Refresh-Ahead Lead: " << refreshAheadLeadMs << "ms\n";
+    oss << "  Refresh-Ahead Hot Window: " << refreshAheadHotWindowSeconds << "s\n";
     
     // Performance Tuning Configuration
     oss << "  Cache Max Entries: " << cacheMaxEntries << "\n";
@@ -140,13 +244,29 @@ std::string Configuration::toString() const {
     oss << "  OPC Read Timeout: " << opcReadTimeoutMs << "ms\n";
     oss << "  OPC Batch Size: " << opcBatchSize << "\n";
     oss << "  OPC Connection Pool Size: " << opcConnectionPoolSize << "\n";
-    
+    oss << "  OPC Read Budget: " << opcReadBudgetNodesPerSecond << " nodes/s, "
+        << opcReadBudgetRequestsPerSecond << " requests/s (0 = unlimited)\n";
+    oss << "  OPC Read Budget Sync Reserve: " << opcReadBudgetSyncReservePercent << "%\n";
+    oss << "  OPC Circuit Breaker: " << opcCircuitBreakerFailureThreshold << " failures (0 = disabled), open "
+        << opcCircuitBreakerOpenMs << "ms, probe every " << opcCircuitBreakerProbeIntervalMs << "ms\n";
+    
+    oss << "  Request Trace: " << (requestTraceFile.empty() ? "disabled" : requestTraceFile) << "\n";
+    oss << "  Server-Timing Header: " << (serverTimingEnabled ? "enabled" : "on ?debug=timing only") << "\n";
+    oss << "  Lock Profiling: " << (lockProfilingEnabled ? "enabled" : "disabled") << "\n";
+    oss << "  Tag Groups: " << tagGroups.size() << " configured, max " << tagGroupMaxCount
+        << " groups of " << tagGroupMaxSize << " node IDs\n";
+    oss << "  Response Cache: " << responseCacheSize << " ids lists (0 = disabled)\n";
     oss << "  Log Level: " << logLevel << "\n";
     
     // Security info (masked)
     oss << "  API Key: " << (apiKey.empty() ? "not set" : "***") << "\n";
     oss << "  Auth Username: " << (authUsername.empty() ? "not set" : authUsername) << "\n";
     oss << "  Auth Password: " << (authPassword.empty() ? "not set" : "***") << "\n";
+    oss << "  Rate Limit: " << rateLimitRequestsPerSecond << " requests/s per client (0 = unlimited), burst "
+        << rateLimitBurst << ", max " << rateLimitMaxClients << " clients\n";
+    oss << "  Auth Blocking: " << authMaxFailures << " failures (0 = disabled), blocked "
+        << authBlockSeconds << "s\n";
+    oss << "  Trust Proxy Headers: " << (trustProxyHeaders ? "yes" : "no") << "\n";
     
     if (!allowedOrigins.empty()) {
         oss << "  Allowed Origins: ";
@@ -202,6 +322,34 @@ std::vector<std::string> Configuration::parseCommaSeparated(const std::string& v
     return result;
 }
 
+std::map<std::string, std::vector<std::string>> Configuration::parseTagGroups(const std::string& value) {
+    std::map<std::string, std::vector<std::string>> groups;
+    std::stringstream ss(value);
+    std::string entry;
+    
+    while (std::getline(ss, entry, '|')) {
+        if (entry.find_first_not_of(" \t\r\n") == std::string::npos) {
+            continue;
+        }
+        
+        // Node IDs contain ':' only after "ns=N;", so the first ':' ends the name
+        size_t colon = entry.find(':');
+        if (colon == std::string::npos) {
+            std::cerr << "Warning: Ignoring TAG_GROUPS entry without ':': " << entry << std::endl;
+            continue;
+        }
+        
+        auto name = parseCommaSeparated(entry.substr(0, colon));
+        if (name.size() != 1) {
+            std::cerr << "Warning: Ignoring TAG_GROUPS entry with invalid name: " << entry << std::endl;
+            continue;
+        }
+        groups[name[0]] = parseCommaSeparated(entry.substr(colon + 1));
+    }
+    
+    return groups;
+}
+
 void Configuration::loadCacheSettings() {
     // New Cache Timing Configuration
     cacheRefreshThresholdSeconds = getEnvInt("CACHE_REFRESH_THRESHOLD_SECONDS", 3);
@@ -210,8 +358,14 @@ void Configuration::loadCacheSettings() {
     
     // Background Update Configuration
     backgroundUpdateThreads = getEnvInt("BACKGROUND_UPDATE_THREADS", 3);
+    backgroundUpdateMinThreads = getEnvInt("BACKGROUND_UPDATE_MIN_THREADS", 1);
     backgroundUpdateQueueSize = getEnvInt("BACKGROUND_UPDATE_QUEUE_SIZE", 1000);
     backgroundUpdateTimeoutMs = getEnvInt("BACKGROUND_UPDATE_TIMEOUT_MS", 5000);
+
+    // Refresh-Ahead Configuration
+    refreshAheadReadsPerSecond = getEnvInt("REFRESH_AHEAD_READS_PER_SECOND", 0);
+    refreshAheadLeadMs = getEnvInt("REFRESH_AHEAD_LEAD_MS", 1000);
+    refreshAheadHotWindowSeconds = getEnvInt("REFRESH_AHEAD_HOT_WINDOW_SECONDS", 30);
     
     // Performance Tuning Configuration
     cacheMaxEntries = getEnvInt("CACHE_MAX_ENTRIES", 10000);
@@ -223,6 +377,16 @@ void Configuration::loadCacheSettings() {
     opcConnectionTimeoutMs = getEnvInt("OPC_CONNECTION_TIMEOUT_MS", 10000);
     opcBatchSize = getEnvInt("OPC_BATCH_SIZE", 50);
     opcConnectionPoolSize = getEnvInt("OPC_CONNECTION_POOL_SIZE", 5);
+
+    // OPC UA Read Budget Configuration
+    opcReadBudgetNodesPerSecond = getEnvInt("OPC_READ_BUDGET_NODES_PER_SECOND", 0);
+    opcReadBudgetRequestsPerSecond = getEnvInt("OPC_READ_BUDGET_REQUESTS_PER_SECOND", 0);
+    opcReadBudgetSyncReservePercent = getEnvInt("OPC_READ_BUDGET_SYNC_RESERVE_PERCENT", 30);
+
+    // OPC UA Circuit Breaker Configuration
+    opcCircuitBreakerFailureThreshold = getEnvInt("OPC_CIRCUIT_BREAKER_FAILURE_THRESHOLD", 5);
+    opcCircuitBreakerOpenMs = getEnvInt("OPC_CIRCUIT_BREAKER_OPEN_MS", 5000);
+    opcCircuitBreakerProbeIntervalMs = getEnvInt("OPC_CIRCUIT_BREAKER_PROBE_INTERVAL_MS", 1000);
 }
 
 bool Configuration::validateCacheTimingConfig() const {
@@ -257,6 +421,11 @@ bool Configuration::validateCacheTimingConfig() const {
         return false;
     }
     
+    if (backgroundUpdateMinThreads <= 0 || backgroundUpdateMinThreads > backgroundUpdateThreads) {
+        std::cerr << "Error: BACKGROUND_UPDATE_MIN_THREADS must be between 1 and BACKGROUND_UPDATE_THREADS" << std::endl;
+        return false;
+    }
+    
     if (backgroundUpdateQueueSize <= 0 || backgroundUpdateQueueSize > 100000) {
         std::cerr << "Error: BACKGROUND_UPDATE_QUEUE_SIZE must be between 1 and 100000" << std::endl;
         return false;
@@ -266,6 +435,22 @@ bool Configuration::validateCacheTimingConfig() const {
         std::cerr << "Error: BACKGROUND_UPDATE_TIMEOUT_MS must be between 1 and 300000 (5 minutes)" << std::endl;
         return false;
     }
+
+    // Validate refresh-ahead configuration
+    if (refreshAheadReadsPerSecond < 0 || refreshAheadReadsPerSecond > 100000) {
+        std::cerr << "Error: REFRESH_AHEAD_READS_PER_SECOND must be between 0 and 100000" << std::endl;
+        return false;
+    }
+
+    if (refreshAheadLeadMs <= 0 || refreshAheadLeadMs > cacheRefreshThresholdSeconds * 1000) {
+        std::cerr << "Error: REFRESH_AHEAD_LEAD_MS must be between 1 and CACHE_REFRESH_THRESHOLD_SECONDS in milliseconds" << std::endl;
+        return false;
+    }
+
+    if (refreshAheadHotWindowSeconds <= 0) {
+        std::cerr << "Error: REFRESH_AHEAD_HOT_WINDOW_SECONDS must be positive" << std::endl;
+        return false;
+    }
     
     return true;
 }
@@ -305,6 +490,38 @@ bool Configuration::validatePerformanceConfig() const {
         return false;
     }
     
+    // Validate OPC UA read budget
+    if (opcReadBudgetNodesPerSecond < 0 || opcReadBudgetNodesPerSecond > 1000000) {
+        std::cerr << "Error: OPC_READ_BUDGET_NODES_PER_SECOND must be between 0 and 1000000" << std::endl;
+        return false;
+    }
+    
+    if (opcReadBudgetRequestsPerSecond < 0 || opcReadBudgetRequestsPerSecond > 100000) {
+        std::cerr << "Error: OPC_READ_BUDGET_REQUESTS_PER_SECOND must be between 0 and 100000" << std::endl;
+        return false;
+    }
+    
+    if (opcReadBudgetSyncReservePercent < 0 || opcReadBudgetSyncReservePercent > 100) {
+        std::cerr << "Error: OPC_READ_BUDGET_SYNC_RESERVE_PERCENT must be between 0 and 100" << std::endl;
+        return false;
+    }
+    
+    // Validate OPC UA circuit breaker
+    if (opcCircuitBreakerFailureThreshold < 0 || opcCircuitBreakerFailureThreshold > 10000) {
+        std::cerr << "Error: OPC_CIRCUIT_BREAKER_FAILURE_THRESHOLD must be between 0 and 10000" << std::endl;
+        return false;
+    }
+    
+    if (opcCircuitBreakerOpenMs < 100 || opcCircuitBreakerOpenMs > 600000) {
+        std::cerr << "Error: OPC_CIRCUIT_BREAKER_OPEN_MS must be between 100 and 600000" << std::endl;
+        return false;
+    }
+    
+    if (opcCircuitBreakerProbeIntervalMs < 10 || opcCircuitBreakerProbeIntervalMs > 60000) {
+        std::cerr << "Error: OPC_CIRCUIT_BREAKER_PROBE_INTERVAL_MS must be between 10 and 60000" << std::endl;
+        return false;
+    }
+    
     return true;
 }
 
@@ -0,0 +1,165 @@
+// Global operator new/delete replacement feeding AllocationTracker.
+//
+// Linked into opcua2http only with -DENABLE_ALLOCATION_TRACKING=ON, and always
+// into the tests and benchmarks. Allocation itself is left to malloc; the
+// hooks only count.
+
+#include "core/AllocationTracker.h"
+
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace {
+
+[[maybe_unused]] const bool hooksInstalled = (opcua2http::AllocationTracker::markHooksInstalled(), true);
+
+void* allocate(std::size_t size) {
+    opcua2http::AllocationTracker::recordAllocation(size);
+    if (size == 0) {
+        size = 1;
+    }
+    for (;;) {
+        if (void* p = std::malloc(size)) {
+            return p;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void* allocateAligned(std::size_t size, std::align_val_t alignment) {
+    opcua2http::AllocationTracker::recordAllocation(size);
+    auto align = static_cast<std::size_t>(alignment);
+    if (size == 0) {
+        size = 1;
+    }
+    for (;;) {
+#ifdef _WIN32
+        void* p = _aligned_malloc(size, align);
+#else
+        // aligned_alloc wants a multiple of the alignment
+        void* p = std::aligned_alloc(align, (size + align - 1) / align * align);
+#endif
+        if (p) {
+            return p;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void deallocateAligned(void* p) noexcept {
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size) {
+    return allocate(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return allocate(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return allocate(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return allocateAligned(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return allocateAligned(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try {
+        return allocateAligned(size, alignment);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try {
+        return allocateAligned(size, alignment);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept {
+    deallocateAligned(p);
+}
+
+void operator delete[](void* p, std::align_val_t) noexcept {
+    deallocateAligned(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept {
+    deallocateAligned(p);
+}
+
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept {
+    deallocateAligned(p);
+}
+
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept {
+    deallocateAligned(p);
+}
+
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept {
+    deallocateAligned(p);
+}
@@ -0,0 +1,112 @@
+#include "core/AllocationTracker.h"
+
+#include <atomic>
+
+namespace opcua2http {
+
+namespace {
+
+// Everything here is constant-initialized: operator new runs before any
+// dynamic initialization and on threads that never ran a constructor here
+
+struct alignas(64) TagTotals {
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> bytes{0};
+};
+
+std::atomic<bool> hooksInstalled{false};
+std::array<TagTotals, AllocationTracker::TAG_COUNT> tagTotals;
+
+thread_local AllocationTracker::Counts threadCounts;
+thread_local AllocationTracker::Tag threadTag = AllocationTracker::Tag::UNTAGGED;
+
+} // namespace
+
+AllocationTracker::TagScope::TagScope(Tag tag) noexcept
+    : previous_(threadTag) {
+    threadTag = tag;
+}
+
+AllocationTracker::TagScope::~TagScope() {
+    threadTag = previous_;
+}
+
+bool AllocationTracker::isEnabled() noexcept {
+    return hooksInstalled.load(std::memory_order_relaxed);
+}
+
+AllocationTracker::Counts AllocationTracker::thread() noexcept {
+    return threadCounts;
+}
+
+AllocationTracker::Tag AllocationTracker::currentTag() noexcept {
+    return threadTag;
+}
+
+AllocationTracker::Counts AllocationTracker::total(Tag tag) noexcept {
+    const auto& totals = tagTotals[static_cast<size_t>(tag)];
+    return {totals.allocations.load(std::memory_order_relaxed), totals.bytes.load(std::memory_order_relaxed)};
+}
+
+void AllocationTracker::reset() noexcept {
+    for (auto& totals : tagTotals) {
+        totals.allocations.store(0, std::memory_order_relaxed);
+        totals.bytes.store(0, std::memory_order_relaxed);
+    }
+}
+
+nlohmann::json AllocationTracker::toJSON() {
+    // Snapshot first so the report's own allocations are not part of it
+    std::array<Counts, TAG_COUNT> snapshot;
+    for (size_t i = 0; i < TAG_COUNT; ++i) {
+        snapshot[i] = total(static_cast<Tag>(i));
+    }
+
+    Counts sum;
+    nlohmann::json tags = nlohmann::json::object();
+    for (size_t i = 0; i < TAG_COUNT; ++i) {
+        sum += snapshot[i];
+        tags[tagName(static_cast<Tag>(i))] = {
+            {"allocations", snapshot[i].allocations},
+            {"bytes", snapshot[i].bytes}
+        };
+    }
+
+    return {
+        {"enabled", isEnabled()},
+        {"tags", tags},
+        {"total", {
+            {"allocations", sum.allocations},
+            {"bytes", sum.bytes}
+        }}
+    };
+}
+
+const char* AllocationTracker::tagName(Tag tag) {
+    switch (tag) {
+        case Tag::UNTAGGED: return "untagged";
+        case Tag::AUTH: return "auth";
+        case Tag::PARSE: return "parse";
+        case Tag::CACHE: return "cache";
+        case Tag::OPC: return "opc";
+        case Tag::SERIALIZE: return "serialize";
+        case Tag::BACKGROUND: return "background";
+        case Tag::SUBSCRIPTION: return "subscription";
+    }
+    return "unknown";
+}
+
+void AllocationTracker::recordAllocation(size_t bytes) noexcept {
+    threadCounts.allocations++;
+    threadCounts.bytes += bytes;
+
+    auto& totals = tagTotals[static_cast<size_t>(threadTag)];
+    totals.allocations.fetch_add(1, std::memory_order_relaxed);
+    totals.bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void AllocationTracker::markHooksInstalled() noexcept {
+    hooksInstalled.store(true, std::memory_order_relaxed);
+}
+
+} // namespace opcua2http
@@ -1,8 +1,10 @@
 #include "core/BackgroundUpdater.h"
 #include "cache/CacheManager.h"
+#include "core/AllocationTracker.h"
 #include "opcua/OPCUAClient.h"
 #include <spdlog/spdlog.h>
 #include <algorithm>
+#include <cmath>
 
 namespace opcua2http {
 
@@ -37,28 +39,22 @@ void BackgroundUpdater::scheduleUpdate(const std::string& nodeId) {
         return;
     }
 
-    // Check for duplicates first
-    if (!addToPendingUpdates(nodeId)) {
-        duplicateUpdates_.fetch_add(1, std::memory_order_relaxed);
-        spdlog::trace("Duplicate update request filtered for node: {}", nodeId);
-        return;
-    }
-
-    // Add to queue if not full
-    {
-        std::lock_guard<std::mutex> lock(queueMutex_);
-        
-        if (isQueueFull()) {
+    switch (enqueueUpdate(nodeId)) {
+        case EnqueueResult::QUEUED:
+            spdlog::trace("Scheduled background update for node: {}", nodeId);
+            // Wake all: a parked worker beyond the active count would swallow notify_one
+            queueCondition_.notify_all();
+            break;
+        case EnqueueResult::REPRIORITIZED:
+            spdlog::trace("Raised background update priority for node: {}", nodeId);
+            break;
+        case EnqueueResult::DUPLICATE:
+            spdlog::trace("Duplicate update request filtered for node: {}", nodeId);
+            break;
+        case EnqueueResult::DROPPED:
             spdlog::warn("Update queue is full, dropping update request for node: {}", nodeId);
-            removeFromPendingUpdates(nodeId);
-            return;
-        }
-        
-        updateQueue_.push(nodeId);
-        spdlog::trace("Scheduled background update for node: {}", nodeId);
+            break;
     }
-    
-    queueCondition_.notify_one();
 }
 
 void BackgroundUpdater::scheduleBatchUpdate(const std::vector<std::string>& nodeIds) {
@@ -73,6 +69,7 @@ void BackgroundUpdater::scheduleBatchUpdate(const std::vector<std::string>& node
     }
 
     size_t scheduled = 0;
+    size_t reprioritized = 0;
     size_t duplicates = 0;
     size_t dropped = 0;
 
@@ -81,36 +78,20 @@ void BackgroundUpdater::scheduleBatchUpdate(const std::vector<std::string>& node
             continue;
         }
 
-        // Check for duplicates
-        if (!addToPendingUpdates(nodeId)) {
-            duplicates++;
-            continue;
-        }
-
-        // Add to queue if not full
-        {
-            std::lock_guard<std::mutex> lock(queueMutex_);
-            
-            if (isQueueFull()) {
-                dropped++;
-                removeFromPendingUpdates(nodeId);
-                continue;
-            }
-            
-            updateQueue_.push(nodeId);
-            scheduled++;
+        switch (enqueueUpdate(nodeId)) {
+            case EnqueueResult::QUEUED: scheduled++; break;
+            case EnqueueResult::REPRIORITIZED: reprioritized++; break;
+            case EnqueueResult::DUPLICATE: duplicates++; break;
+            case EnqueueResult::DROPPED: dropped++; break;
         }
     }
 
-    // Update statistics
-    duplicateUpdates_.fetch_add(duplicates, std::memory_order_relaxed);
-    
     if (scheduled > 0) {
         queueCondition_.notify_all();
-        spdlog::debug("Scheduled {} background updates, {} duplicates filtered, {} dropped (queue full)", 
-                     scheduled, duplicates, dropped);
+        spdlog::debug("Scheduled {} background updates, {} re-prioritized, {} duplicates filtered, {} dropped (queue full)",
+                     scheduled, reprioritized, duplicates, dropped);
     }
-    
+
     if (dropped > 0) {
         spdlog::warn("Dropped {} update requests due to full queue", dropped);
     }
@@ -125,12 +106,24 @@ void BackgroundUpdater::start() {
     stopRequested_.store(false);
     running_.store(true);
 
-    // Create worker threads
+    // Create worker threads; all exist up front, only the active ones take work
     size_t numThreads = maxConcurrentUpdates_.load();
-    workerThreads_.reserve(numThreads);
-    
-    for (size_t i = 0; i < numThreads; ++i) {
-        workerThreads_.emplace_back(&BackgroundUpdater::workerLoop, this);
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        updateWorkerTarget();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(workersMutex_);
+        workerThreads_.reserve(numThreads);
+        for (size_t i = 0; i < numThreads; ++i) {
+            workerThreads_.emplace_back(&BackgroundUpdater::workerLoop, this, i);
+        }
+    }
+
+    if (refreshAheadBudget_.load() > 0.0) {
+        refreshAheadThread_ = std::thread(&BackgroundUpdater::refreshAheadLoop, this);
+        spdlog::info("Refresh-ahead enabled with a budget of {} reads/s", refreshAheadBudget_.load());
     }
 
     spdlog::info("BackgroundUpdater started with {} worker threads", numThreads);
@@ -149,22 +142,38 @@ void BackgroundUpdater::stop() {
     
     // Wake up all waiting threads
     queueCondition_.notify_all();
-    
+    {
+        std::lock_guard<std::mutex> lock(refreshAheadMutex_);
+    }
+    refreshAheadCondition_.notify_all();
+
     // Wait for all worker threads to finish
-    for (auto& thread : workerThreads_) {
-        if (thread.joinable()) {
-            thread.join();
+    {
+        std::lock_guard<std::mutex> lock(workersMutex_);
+        for (auto& thread : workerThreads_) {
+            if (thread.joinable()) {
+                thread.join();
+            }
         }
+        workerThreads_.clear();
+    }
+
+    if (refreshAheadThread_.joinable()) {
+        refreshAheadThread_.join();
     }
-    
-    workerThreads_.clear();
     
     // Clear remaining queue items
     {
         std::lock_guard<std::mutex> lock(queueMutex_);
-        while (!updateQueue_.empty()) {
-            updateQueue_.pop();
-        }
+        updateQueue_ = {};
+        queuedUpdates_.clear();
+        queueDepth_.store(0, std::memory_order_relaxed);
+        demand_.clear();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(refreshAheadMutex_);
+        refreshedAhead_.clear();
     }
     
     // Clear pending updates
@@ -186,8 +195,50 @@ void BackgroundUpdater::setMaxConcurrentUpdates(size_t maxUpdates) {
         maxUpdates = 3;
     }
     
+    std::lock_guard<std::mutex> workersLock(workersMutex_);
+
     maxConcurrentUpdates_.store(maxUpdates);
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        updateWorkerTarget();
+    }
+    queueCondition_.notify_all();
     spdlog::debug("Set maxConcurrentUpdates to: {}", maxUpdates);
+
+    if (!running_.load()) {
+        return;
+    }
+
+    if (maxUpdates > workerThreads_.size()) {
+        for (size_t i = workerThreads_.size(); i < maxUpdates; ++i) {
+            workerThreads_.emplace_back(&BackgroundUpdater::workerLoop, this, i);
+        }
+    } else if (maxUpdates < workerThreads_.size()) {
+        // Surplus workers exit after their current update, which is bounded by the update timeout
+        for (size_t i = maxUpdates; i < workerThreads_.size(); ++i) {
+            if (workerThreads_[i].joinable()) {
+                workerThreads_[i].join();
+            }
+        }
+        workerThreads_.resize(maxUpdates);
+    }
+
+    spdlog::info("BackgroundUpdater resized to {} worker threads", maxUpdates);
+}
+
+void BackgroundUpdater::setMinConcurrentUpdates(size_t minUpdates) {
+    if (minUpdates == 0) {
+        spdlog::warn("Invalid minConcurrentUpdates value: 0, using default: 1");
+        minUpdates = 1;
+    }
+
+    minConcurrentUpdates_.store(minUpdates);
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        updateWorkerTarget();
+    }
+    queueCondition_.notify_all();
+    spdlog::debug("Set minConcurrentUpdates to: {}", minUpdates);
 }
 
 void BackgroundUpdater::setUpdateQueueSize(size_t maxQueueSize) {
@@ -210,6 +261,47 @@ void BackgroundUpdater::setUpdateTimeout(std::chrono::milliseconds timeout) {
     spdlog::debug("Set updateTimeout to: {}ms", timeout.count());
 }
 
+void BackgroundUpdater::setRefreshAheadBudget(double readsPerSecond) {
+    if (readsPerSecond < 0.0) {
+        spdlog::warn("Invalid refresh-ahead budget: {} reads/s, disabling refresh-ahead", readsPerSecond);
+        readsPerSecond = 0.0;
+    }
+
+    {
+        // Start with a full bucket so the first scan is not starved
+        std::lock_guard<std::mutex> lock(refreshAheadMutex_);
+        refreshAheadTokens_ = readsPerSecond;
+        lastTokenRefill_ = std::chrono::steady_clock::now();
+    }
+
+    refreshAheadBudget_.store(readsPerSecond);
+    spdlog::debug("Set refresh-ahead budget to: {} reads/s", readsPerSecond);
+}
+
+void BackgroundUpdater::setRefreshAheadLead(std::chrono::milliseconds lead) {
+    if (lead.count() <= 0) {
+        spdlog::warn("Invalid refresh-ahead lead: {}ms, using default: 1000ms", lead.count());
+        lead = std::chrono::milliseconds(1000);
+    }
+
+    refreshAheadLead_.store(lead);
+    spdlog::debug("Set refresh-ahead lead to: {}ms", lead.count());
+}
+
+void BackgroundUpdater::setRefreshAheadHotWindow(std::chrono::milliseconds window) {
+    if (window.count() <= 0) {
+        spdlog::warn("Invalid refresh-ahead hot window: {}ms, using default: 30000ms", window.count());
+        window = std::chrono::milliseconds(30000);
+    }
+
+    refreshAheadHotWindow_.store(window);
+    spdlog::debug("Set refresh-ahead hot window to: {}ms", window.count());
+}
+
+void BackgroundUpdater::setPerformanceMonitor(PerformanceMonitor* monitor) {
+    performanceMonitor_ = monitor;
+}
+
 BackgroundUpdater::UpdateStats BackgroundUpdater::getStats() const {
     std::lock_guard<std::mutex> lock(statsMutex_);
     
@@ -218,18 +310,51 @@ BackgroundUpdater::UpdateStats BackgroundUpdater::getStats() const {
     stats.successfulUpdates = successfulUpdates_.load();
     stats.failedUpdates = failedUpdates_.load();
     stats.duplicateUpdates = duplicateUpdates_.load();
+    stats.reprioritizedUpdates = reprioritizedUpdates_.load();
+    stats.refreshAheadReads = refreshAheadReads_.load();
+    stats.refreshAheadAvoided = refreshAheadAvoided_.load();
+    stats.refreshAheadSkipped = refreshAheadSkipped_.load();
+    stats.budgetShedUpdates = budgetShedUpdates_.load();
+    stats.timedOutUpdates = timedOutUpdates_.load();
+    stats.activeWorkers = targetWorkers_.load();
+    stats.workerThreads = running_.load() ? maxConcurrentUpdates_.load() : 0;
+    {
+        std::lock_guard<std::mutex> queueLock(queueMutex_);
+        stats.upstreamLatency = upstreamLatencyMs_;
+    }
     stats.queuedUpdates = getQueueSize();
     stats.lastUpdate = lastUpdate_;
     
     // Calculate average update time
     uint64_t total = stats.totalUpdates;
     if (total > 0) {
-        stats.averageUpdateTime = totalUpdateTime_.load() / total;
+        stats.averageUpdateTime = totalUpdateTimeUs_.load() / 1000.0 / total;
     }
     
     return stats;
 }
 
+BackgroundUpdater::UpdateStats BackgroundUpdater::getCounters() const {
+    UpdateStats stats;
+    stats.totalUpdates = totalUpdates_.load(std::memory_order_relaxed);
+    stats.successfulUpdates = successfulUpdates_.load(std::memory_order_relaxed);
+    stats.failedUpdates = failedUpdates_.load(std::memory_order_relaxed);
+    stats.queuedUpdates = queueDepth_.load(std::memory_order_relaxed);
+    stats.duplicateUpdates = duplicateUpdates_.load(std::memory_order_relaxed);
+    stats.reprioritizedUpdates = reprioritizedUpdates_.load(std::memory_order_relaxed);
+    stats.refreshAheadReads = refreshAheadReads_.load(std::memory_order_relaxed);
+    stats.refreshAheadAvoided = refreshAheadAvoided_.load(std::memory_order_relaxed);
+    stats.refreshAheadSkipped = refreshAheadSkipped_.load(std::memory_order_relaxed);
+    stats.budgetShedUpdates = budgetShedUpdates_.load(std::memory_order_relaxed);
+    stats.timedOutUpdates = timedOutUpdates_.load(std::memory_order_relaxed);
+    stats.activeWorkers = targetWorkers_.load(std::memory_order_relaxed);
+    stats.workerThreads = running_.load() ? maxConcurrentUpdates_.load(std::memory_order_relaxed) : 0;
+    if (stats.totalUpdates > 0) {
+        stats.averageUpdateTime = totalUpdateTimeUs_.load(std::memory_order_relaxed) / 1000.0 / stats.totalUpdates;
+    }
+    return stats;
+}
+
 void BackgroundUpdater::clearStats() {
     std::lock_guard<std::mutex> lock(statsMutex_);
     
@@ -237,17 +362,24 @@ void BackgroundUpdater::clearStats() {
     successfulUpdates_.store(0);
     failedUpdates_.store(0);
     duplicateUpdates_.store(0);
-    totalUpdateTime_.store(0.0);
+    reprioritizedUpdates_.store(0);
+    refreshAheadReads_.store(0);
+    refreshAheadAvoided_.store(0);
+    refreshAheadSkipped_.store(0);
+    budgetShedUpdates_.store(0);
+    timedOutUpdates_.store(0);
+    totalUpdateTimeUs_.store(0);
     lastUpdate_ = std::chrono::steady_clock::now();
     
     spdlog::debug("BackgroundUpdater statistics cleared");
 }
 
-void BackgroundUpdater::workerLoop() {
-    spdlog::debug("BackgroundUpdater worker thread started");
+void BackgroundUpdater::workerLoop(size_t workerIndex) {
+    spdlog::debug("BackgroundUpdater worker thread {} started", workerIndex);
+    AllocationTracker::TagScope allocationTag(AllocationTracker::Tag::BACKGROUND);
     
     while (!stopRequested_.load()) {
-        std::string nodeId = getNextUpdate();
+        std::string nodeId = getNextUpdate(workerIndex);
         
         if (nodeId.empty()) {
             // Empty nodeId means we should stop
@@ -257,24 +389,45 @@ void BackgroundUpdater::workerLoop() {
         processUpdate(nodeId);
     }
     
-    spdlog::debug("BackgroundUpdater worker thread finished");
+    spdlog::debug("BackgroundUpdater worker thread {} finished", workerIndex);
 }
 
 void BackgroundUpdater::processUpdate(const std::string& nodeId) {
     auto startTime = std::chrono::steady_clock::now();
     bool success = false;
+    bool shed = false;
+    bool timedOut = false;
+    bool circuitOpen = false;
     
     try {
         spdlog::trace("Processing background update for node: {}", nodeId);
         
         // Read from OPC UA server
-        ReadResult result = opcClient_->readNode(nodeId);
+        // Bounded by the update timeout and abandoned on stop(), so a hung read
+        // never holds this worker or delays shutdown
+        ReadResult result = opcClient_->readNodeWithDeadline(nodeId, updateTimeout_.load(),
+                                                             &stopRequested_,
+                                                             ReadBudget::Priority::BACKGROUND);
         
         if (result.success) {
             // Update cache with new data
             cacheManager_->updateCache(nodeId, result.value, "Good", result.reason, result.timestamp);
             success = true;
             spdlog::trace("Successfully updated cache for node: {} with value: {}", nodeId, result.value);
+        } else if (ReadBudget::isExhaustedError(result.reason)) {
+            // Not a failure: the entry stays STALE and the next request reschedules it
+            shed = true;
+            spdlog::trace("Read budget exhausted, shedding background update for node: {}", nodeId);
+        } else if (CircuitBreaker::isOpenError(result.reason)) {
+            // The server is known to be down; the entry stays STALE until it recovers
+            circuitOpen = true;
+            spdlog::trace("Circuit breaker open, skipping background update for node: {}", nodeId);
+        } else if (result.reason == OPCUAClient::READ_TIMEOUT_ERROR) {
+            timedOut = true;
+            spdlog::debug("Background update for node {} timed out after {}ms", nodeId, updateTimeout_.load().count());
+        } else if (result.reason == OPCUAClient::READ_CANCELLED_ERROR) {
+            // Cancelled by stop(); not an update outcome
+            shed = true;
         } else {
             spdlog::debug("Failed to read node {} during background update: {}", nodeId, result.reason);
         }
@@ -288,12 +441,35 @@ void BackgroundUpdater::processUpdate(const std::string& nodeId) {
     // Remove from pending updates
     removeFromPendingUpdates(nodeId);
     
+    if (circuitOpen) {
+        return;
+    }
+
+    if (shed) {
+        if (!stopRequested_.load()) {
+            budgetShedUpdates_++;
+        }
+        return;
+    }
+
+    if (timedOut) {
+        timedOutUpdates_++;
+        return;
+    }
+    
     // Record statistics
     auto endTime = std::chrono::steady_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime);
     double updateTimeMs = duration.count() / 1000.0;
     
     recordUpdateStats(success, updateTimeMs);
+    if (performanceMonitor_) {
+        performanceMonitor_->recordOperationTime(PerformanceMonitor::OperationType::BACKGROUND_UPDATE,
+                                                 updateTimeMs);
+    }
+    if (success) {
+        recordUpstreamLatency(updateTimeMs);
+    }
 }
 
 bool BackgroundUpdater::addToPendingUpdates(const std::string& nodeId) {
@@ -309,27 +485,264 @@ void BackgroundUpdater::removeFromPendingUpdates(const std::string& nodeId) {
     pendingUpdates_.erase(nodeId);
 }
 
-std::string BackgroundUpdater::getNextUpdate() {
+BackgroundUpdater::EnqueueResult BackgroundUpdater::enqueueUpdate(const std::string& nodeId, bool recordRequest) {
+    // Look up the remaining lifetime before taking the queue lock
+    auto timeUntilExpiry = cacheManager_->getTimeUntilExpiry(nodeId);
+    auto now = std::chrono::steady_clock::now();
+
+    bool isNew = addToPendingUpdates(nodeId);
+
+    std::lock_guard<std::mutex> lock(queueMutex_);
+
+    double requestRate = recordRequest ? recordDemand(nodeId, now) : currentDemand(nodeId, now);
+    auto deadline = calculateEffectiveDeadline(timeUntilExpiry, requestRate, now);
+
+    if (!isNew) {
+        if (!recordRequest) {
+            return EnqueueResult::DUPLICATE; // Refresh-ahead never re-prioritizes client work
+        }
+
+        duplicateUpdates_.fetch_add(1, std::memory_order_relaxed);
+
+        // Only a queued node can be re-prioritized; an in-flight read is already serving it
+        auto it = queuedUpdates_.find(nodeId);
+        if (it == queuedUpdates_.end() || deadline >= it->second.deadline) {
+            return EnqueueResult::DUPLICATE;
+        }
+
+        it->second.deadline = deadline;
+        it->second.sequence = nextSequence_++;
+        updateQueue_.push(it->second);
+        reprioritizedUpdates_.fetch_add(1, std::memory_order_relaxed);
+
+        if (updateQueue_.size() > 2 * queuedUpdates_.size() + 64) {
+            compactQueue();
+        }
+        return EnqueueResult::REPRIORITIZED;
+    }
+
+    if (isQueueFull()) {
+        removeFromPendingUpdates(nodeId);
+        return EnqueueResult::DROPPED;
+    }
+
+    QueuedUpdate update{deadline, nextSequence_++, nodeId};
+    updateQueue_.push(update);
+    queuedUpdates_.emplace(nodeId, std::move(update));
+    queueDepth_.store(queuedUpdates_.size(), std::memory_order_relaxed);
+    updateWorkerTarget();
+    return EnqueueResult::QUEUED;
+}
+
+std::chrono::steady_clock::time_point BackgroundUpdater::calculateEffectiveDeadline(
+    std::chrono::milliseconds timeUntilExpiry,
+    double requestRate,
+    std::chrono::steady_clock::time_point now) {
+
+    // A node read N times per second loses N times as many requests to the
+    // EXPIRED path per unit of lateness, so its slack is divided by its demand.
+    // Missing or already expired entries have no slack and go first.
+    double weight = 1.0 + std::max(requestRate, 0.0);
+    auto slack = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double, std::milli>(timeUntilExpiry.count() / weight));
+    return now + slack;
+}
+
+std::string BackgroundUpdater::getNextUpdate(size_t workerIndex) {
     std::unique_lock<std::mutex> lock(queueMutex_);
-    
-    // Wait for work or stop signal
-    queueCondition_.wait(lock, [this] {
-        return !updateQueue_.empty() || stopRequested_.load();
+
+    // Wait for work this worker is allowed to take, retirement or stop signal
+    queueCondition_.wait(lock, [this, workerIndex] {
+        return stopRequested_.load() ||
+               workerIndex >= maxConcurrentUpdates_.load() ||
+               (!queuedUpdates_.empty() && workerIndex < targetWorkers_.load());
     });
-    
-    if (stopRequested_.load() && updateQueue_.empty()) {
+
+    // Queued work is dropped by stop(); exiting now keeps shutdown bounded
+    if (stopRequested_.load() || workerIndex >= maxConcurrentUpdates_.load()) {
         return ""; // Signal to stop
     }
-    
-    if (!updateQueue_.empty()) {
-        std::string nodeId = updateQueue_.front();
+
+    while (!updateQueue_.empty()) {
+        QueuedUpdate next = updateQueue_.top();
         updateQueue_.pop();
-        return nodeId;
+
+        // Skip heap entries superseded by a later re-prioritization
+        auto it = queuedUpdates_.find(next.nodeId);
+        if (it == queuedUpdates_.end() || it->second.sequence != next.sequence) {
+            continue;
+        }
+
+        queuedUpdates_.erase(it);
+        queueDepth_.store(queuedUpdates_.size(), std::memory_order_relaxed);
+        updateWorkerTarget();
+        return next.nodeId;
     }
-    
+
     return ""; // Should not reach here, but return empty to be safe
 }
 
+double BackgroundUpdater::recordDemand(const std::string& nodeId, std::chrono::steady_clock::time_point now) {
+    if (demand_.size() > maxQueueSize_.load()) {
+        pruneDemand(now);
+    }
+
+    // Exponentially decayed request count, normalized to requests per second
+    auto& info = demand_[nodeId];
+    if (info.rate > 0.0) {
+        double elapsed = std::chrono::duration<double>(now - info.lastRequest).count();
+        info.rate *= std::exp(-elapsed / DEMAND_WINDOW_SECONDS);
+    }
+    info.rate += 1.0 / DEMAND_WINDOW_SECONDS;
+    info.lastRequest = now;
+
+    return info.rate;
+}
+
+double BackgroundUpdater::currentDemand(const std::string& nodeId, std::chrono::steady_clock::time_point now) const {
+    auto it = demand_.find(nodeId);
+    if (it == demand_.end()) {
+        return 0.0;
+    }
+
+    double elapsed = std::chrono::duration<double>(now - it->second.lastRequest).count();
+    return it->second.rate * std::exp(-elapsed / DEMAND_WINDOW_SECONDS);
+}
+
+void BackgroundUpdater::pruneDemand(std::chrono::steady_clock::time_point now) {
+    // Scanning is O(n), so do it at most once per demand window
+    auto window = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(DEMAND_WINDOW_SECONDS));
+    if (now - lastDemandPrune_ < window) {
+        return;
+    }
+    lastDemandPrune_ = now;
+
+    // After six windows the decayed rate is below 0.25% of a single request
+    auto cutoff = now - 6 * window;
+    for (auto it = demand_.begin(); it != demand_.end();) {
+        if (it->second.lastRequest < cutoff && queuedUpdates_.find(it->first) == queuedUpdates_.end()) {
+            it = demand_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void BackgroundUpdater::refreshAheadLoop() {
+    spdlog::debug("BackgroundUpdater refresh-ahead thread started");
+    AllocationTracker::TagScope allocationTag(AllocationTracker::Tag::BACKGROUND);
+
+    while (!stopRequested_.load()) {
+        {
+            std::unique_lock<std::mutex> lock(refreshAheadMutex_);
+            refreshAheadCondition_.wait_for(lock, REFRESH_AHEAD_INTERVAL, [this] {
+                return stopRequested_.load();
+            });
+        }
+
+        if (stopRequested_.load()) {
+            break;
+        }
+
+        try {
+            runRefreshAheadCycle();
+        } catch (const std::exception& e) {
+            spdlog::error("Exception during refresh-ahead scan: {}", e.what());
+        }
+    }
+
+    spdlog::debug("BackgroundUpdater refresh-ahead thread finished");
+}
+
+size_t BackgroundUpdater::runRefreshAheadCycle() {
+    double budget = refreshAheadBudget_.load();
+    if (budget <= 0.0) {
+        return 0;
+    }
+
+    auto lead = refreshAheadLead_.load();
+    auto hotWindow = refreshAheadHotWindow_.load();
+    auto hotEntries = cacheManager_->getHotEntries(hotWindow);
+    auto now = std::chrono::steady_clock::now();
+
+    std::lock_guard<std::mutex> lock(refreshAheadMutex_);
+
+    // Token bucket holding at most one second of budget
+    double elapsed = std::chrono::duration<double>(now - lastTokenRefill_).count();
+    refreshAheadTokens_ = std::min(budget, refreshAheadTokens_ + elapsed * budget);
+    lastTokenRefill_ = now;
+
+    std::vector<const CacheManager::HotEntry*> candidates;
+    for (const auto& entry : hotEntries) {
+        // A read of the refreshed value after the old value's stale point
+        // would otherwise have taken the STALE path
+        auto tracked = refreshedAhead_.find(entry.nodeId);
+        if (tracked != refreshedAhead_.end() &&
+            now + entry.timeUntilStale > tracked->second &&
+            entry.lastAccessed >= tracked->second) {
+            refreshAheadAvoided_.fetch_add(1, std::memory_order_relaxed);
+            refreshedAhead_.erase(tracked);
+        }
+
+        if (entry.timeUntilStale <= lead) {
+            candidates.push_back(&entry);
+        }
+    }
+
+    // Forget refreshes that nobody read within the hot window
+    for (auto it = refreshedAhead_.begin(); it != refreshedAhead_.end();) {
+        if (now - it->second > hotWindow) {
+            it = refreshedAhead_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [](const auto* a, const auto* b) {
+        return a->timeUntilStale < b->timeUntilStale;
+    });
+
+    size_t scheduled = 0;
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        if (refreshAheadTokens_ < 1.0) {
+            refreshAheadSkipped_.fetch_add(candidates.size() - i, std::memory_order_relaxed);
+            break;
+        }
+
+        const auto& candidate = *candidates[i];
+        auto result = enqueueUpdate(candidate.nodeId, false);
+        if (result == EnqueueResult::DROPPED) {
+            break; // Client-driven updates have filled the queue
+        }
+        if (result != EnqueueResult::QUEUED) {
+            continue; // Already queued or in flight
+        }
+
+        refreshAheadTokens_ -= 1.0;
+        refreshedAhead_[candidate.nodeId] = now + candidate.timeUntilStale;
+        scheduled++;
+    }
+
+    if (scheduled > 0) {
+        refreshAheadReads_.fetch_add(scheduled, std::memory_order_relaxed);
+        queueCondition_.notify_all();
+        spdlog::debug("Scheduled {} refresh-ahead updates from {} hot entries", scheduled, hotEntries.size());
+    }
+
+    return scheduled;
+}
+
+void BackgroundUpdater::compactQueue() {
+    std::vector<QueuedUpdate> live;
+    live.reserve(queuedUpdates_.size());
+    for (const auto& pair : queuedUpdates_) {
+        live.push_back(pair.second);
+    }
+
+    updateQueue_ = decltype(updateQueue_)(LaterDeadline{}, std::move(live));
+}
+
 void BackgroundUpdater::recordUpdateStats(bool success, double updateTime) {
     totalUpdates_.fetch_add(1, std::memory_order_relaxed);
     
@@ -340,8 +753,7 @@ void BackgroundUpdater::recordUpdateStats(bool success, double updateTime) {
     }
     
     // Update average time calculation
-    double currentTotal = totalUpdateTime_.load();
-    totalUpdateTime_.store(currentTotal + updateTime);
+    totalUpdateTimeUs_.fetch_add(static_cast<uint64_t>(updateTime * 1000.0), std::memory_order_relaxed);
     
     // Update last update time
     {
@@ -350,14 +762,69 @@ void BackgroundUpdater::recordUpdateStats(bool success, double updateTime) {
     }
 }
 
+size_t BackgroundUpdater::calculateTargetWorkers(size_t queueDepth,
+                                                 double latencyMs,
+                                                 double baselineLatencyMs,
+                                                 size_t minWorkers,
+                                                 size_t maxWorkers) {
+    minWorkers = std::max<size_t>(1, std::min(minWorkers, maxWorkers));
+    if (queueDepth == 0) {
+        return minWorkers;
+    }
+
+    // Until a latency has been observed, use every worker allowed
+    if (latencyMs <= 0.0) {
+        return maxWorkers;
+    }
+
+    // Workers needed to clear the queue within the drain target
+    double perWorker = std::max(WORKER_DRAIN_TARGET_MS / latencyMs, 1.0);
+    auto needed = static_cast<size_t>(std::ceil(static_cast<double>(queueDepth) / perWorker));
+
+    // A server slowing down under our load gets fewer parallel reads, not more
+    if (baselineLatencyMs > 0.0 && latencyMs > UPSTREAM_SATURATION_FACTOR * baselineLatencyMs) {
+        needed = (needed + 1) / 2;
+    }
+
+    return std::clamp(needed, minWorkers, maxWorkers);
+}
+
+bool BackgroundUpdater::updateWorkerTarget() {
+    size_t target = calculateTargetWorkers(queuedUpdates_.size(), upstreamLatencyMs_, baselineLatencyMs_,
+                                           minConcurrentUpdates_.load(), maxConcurrentUpdates_.load());
+    return targetWorkers_.exchange(target) < target;
+}
+
+void BackgroundUpdater::recordUpstreamLatency(double latencyMs) {
+    bool raised = false;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        upstreamLatencyMs_ = upstreamLatencyMs_ <= 0.0
+            ? latencyMs
+            : upstreamLatencyMs_ + LATENCY_SMOOTHING * (latencyMs - upstreamLatencyMs_);
+
+        // The baseline tracks the lowest latency but drifts up slowly so a
+        // permanently slower server is not considered saturated forever
+        baselineLatencyMs_ = baselineLatencyMs_ <= 0.0
+            ? upstreamLatencyMs_
+            : std::min(upstreamLatencyMs_, baselineLatencyMs_ + 0.01 * (upstreamLatencyMs_ - baselineLatencyMs_));
+
+        raised = updateWorkerTarget();
+    }
+
+    if (raised) {
+        queueCondition_.notify_all();
+    }
+}
+
 bool BackgroundUpdater::isQueueFull() const {
     // This method should be called with queueMutex_ already locked
-    return updateQueue_.size() >= maxQueueSize_.load();
+    return queuedUpdates_.size() >= maxQueueSize_.load();
 }
 
 size_t BackgroundUpdater::getQueueSize() const {
     std::lock_guard<std::mutex> lock(queueMutex_);
-    return updateQueue_.size();
+    return queuedUpdates_.size();
 }
 
 } // namespace opcua2http
\ No newline at end of file
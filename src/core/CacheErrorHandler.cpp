@@ -19,8 +19,36 @@ CacheErrorHandler::CacheErrorHandler(CacheManager* cacheManager, OPCUAClient* op
         throw std::invalid_argument("OPCUAClient cannot be null");
     }
 
+    retryThread_ = std::thread(&CacheErrorHandler::retryLoop, this);
+
     spdlog::info("CacheErrorHandler initialized with max retry attempts: {}, retry delay: {}ms",
-                 maxRetryAttempts_.load(), retryDelay_.count());
+                 maxRetryAttempts_.load(), retryDelay_.load().count());
+}
+
+CacheErrorHandler::~CacheErrorHandler() {
+    stop();
+}
+
+void CacheErrorHandler::stop() {
+    {
+        std::lock_guard<std::mutex> lock(retryMutex_);
+        if (!retryRunning_) {
+            return;
+        }
+        retryRunning_ = false;
+    }
+    retryCondition_.notify_all();
+
+    if (retryThread_.joinable()) {
+        retryThread_.join();
+    }
+
+    std::lock_guard<std::mutex> lock(retryMutex_);
+    if (!pendingRetries_.empty()) {
+        spdlog::debug("Dropped {} queued retries on stop", pendingRetries_.size());
+    }
+    retryQueue_.clear();
+    pendingRetries_.clear();
 }
 
 CacheErrorHandler::ErrorAction CacheErrorHandler::determineAction(
@@ -37,6 +65,18 @@ CacheErrorHandler::ErrorAction CacheErrorHandler::determineAction(
     // Record the error for statistics
     recordError(isConnError, hasCachedData);
 
+    // Budget rejections are never retried; a retry would spend more budget
+    if (ReadBudget::isExhaustedError(error)) {
+        return hasCachedData ? ErrorAction::RETURN_CACHED : ErrorAction::RETURN_ERROR;
+    }
+
+    // Neither are reads failed fast by the circuit breaker, nor any read while
+    // it is open: a retry would sleep on the calling thread for nothing
+    if (CircuitBreaker::isOpenError(error) ||
+        (isConnError && opcClient_->getCircuitBreaker().isOpen())) {
+        return hasCachedData ? ErrorAction::RETURN_CACHED : ErrorAction::RETURN_ERROR;
+    }
+
     // If it's a connection error and we have cached data, return cached
     if (isConnError && hasCachedData) {
         spdlog::info("Connection error for node {}, returning cached data", nodeId);
@@ -74,13 +114,18 @@ ReadResult CacheErrorHandler::handleConnectionError(
             if (cachedData.has_value()) {
                 cacheHitOnError_++;
 
+                // Refresh the entry in the background for later requests
+                if (autoRetryEnabled_.load()) {
+                    scheduleRetry(nodeId);
+                }
+
                 // Create result from cached data
                 ReadResult result = cachedData->toReadResult();
 
                 // Modify reason to indicate cache fallback
                 auto cacheAge = cachedData->getAge();
-                result.reason = "Connection Error - Using Cached Data (age: " +
-                              std::to_string(cacheAge.count()) + "s)";
+                result.withReason("Connection Error - Using Cached Data (age: " +
+                                  std::to_string(cacheAge.count()) + "s)");
 
                 spdlog::info("Returning cached data for node {} (age: {}s)",
                            nodeId, cacheAge.count());
@@ -98,14 +143,78 @@ ReadResult CacheErrorHandler::handleConnectionError(
                 ErrorAction::RETURN_ERROR);
 
         case ErrorAction::RETRY_CONNECTION:
-            spdlog::info("Attempting retry for node {}", nodeId);
-            return attemptRetry(nodeId);
+            // The caller gets an answer now; the retry proceeds in the background
+            cacheMissOnError_++;
+            if (scheduleRetry(nodeId)) {
+                spdlog::info("Scheduled background retry for node {}", nodeId);
+            }
+            return createErrorResult(nodeId,
+                "OPC UA server connection failed and no cached data available",
+                ErrorAction::RETRY_CONNECTION);
     }
 
     // Should never reach here
     return createErrorResult(nodeId, "Unknown error handling path", ErrorAction::RETURN_ERROR);
 }
 
+ReadResult CacheErrorHandler::handleBudgetExhausted(
+    const std::string& nodeId,
+    const std::optional<CacheManager::CacheEntry>& cachedData) {
+
+    budgetExhausted_++;
+
+    ErrorAction action = determineAction(nodeId, ReadBudget::EXHAUSTED_ERROR, cachedData.has_value());
+
+    if (action == ErrorAction::RETURN_CACHED && cachedData.has_value()) {
+        cacheHitOnError_++;
+
+        ReadResult result = cachedData->toReadResult();
+        auto cacheAge = cachedData->getAge();
+        result.withReason("Read Budget Exhausted - Using Cached Data (age: " +
+                          std::to_string(cacheAge.count()) + "s)");
+
+        spdlog::debug("Read budget exhausted, returning cached data for node {} (age: {}s)",
+                    nodeId, cacheAge.count());
+
+        return result;
+    }
+
+    cacheMissOnError_++;
+    spdlog::warn("Read budget exhausted and no cached data available for node {}", nodeId);
+    return createErrorResult(nodeId,
+        "OPC UA read budget exhausted and no cached data available",
+        ErrorAction::RETURN_ERROR);
+}
+
+ReadResult CacheErrorHandler::handleCircuitOpen(
+    const std::string& nodeId,
+    const std::optional<CacheManager::CacheEntry>& cachedData) {
+
+    circuitOpen_++;
+
+    ErrorAction action = determineAction(nodeId, CircuitBreaker::OPEN_ERROR, cachedData.has_value());
+
+    if (action == ErrorAction::RETURN_CACHED && cachedData.has_value()) {
+        cacheHitOnError_++;
+
+        ReadResult result = cachedData->toReadResult();
+        auto cacheAge = cachedData->getAge();
+        result.withReason("Circuit Open - Using Cached Data (age: " +
+                          std::to_string(cacheAge.count()) + "s)");
+
+        spdlog::debug("Circuit breaker open, returning cached data for node {} (age: {}s)",
+                    nodeId, cacheAge.count());
+
+        return result;
+    }
+
+    cacheMissOnError_++;
+    spdlog::debug("Circuit breaker open and no cached data available for node {}", nodeId);
+    return createErrorResult(nodeId,
+        "OPC UA server unavailable (circuit breaker open) and no cached data available",
+        ErrorAction::RETURN_ERROR);
+}
+
 std::vector<ReadResult> CacheErrorHandler::handlePartialBatchFailure(
     const std::vector<std::string>& nodeIds,
     const std::vector<ReadResult>& results) {
@@ -128,17 +237,32 @@ std::vector<ReadResult> CacheErrorHandler::handlePartialBatchFailure(
             continue;
         }
 
+        // Reads shed by the budget are served from cache of any age
+        if (ReadBudget::isExhaustedError(result.reason)) {
+            enhancedResults.push_back(handleBudgetExhausted(nodeId, cacheManager_->getCachedValue(nodeId)));
+            continue;
+        }
+
+        if (CircuitBreaker::isOpenError(result.reason)) {
+            enhancedResults.push_back(handleCircuitOpen(nodeId, cacheManager_->getCachedValue(nodeId)));
+            continue;
+        }
+
         // For failed results, try cache fallback
         spdlog::debug("Handling failure for node {} in batch", nodeId);
 
+        if (autoRetryEnabled_.load() && isRecoverableError(result.reason)) {
+            scheduleRetry(nodeId);
+        }
+
         auto cachedData = cacheManager_->getCachedValue(nodeId);
 
         if (cachedData.has_value()) {
             // Use cached data as fallback
             ReadResult fallbackResult = cachedData->toReadResult();
             auto cacheAge = cachedData->getAge();
-            fallbackResult.reason = "Batch Read Failed - Using Cached Data (age: " +
-                                  std::to_string(cacheAge.count()) + "s)";
+            fallbackResult.withReason("Batch Read Failed - Using Cached Data (age: " +
+                                      std::to_string(cacheAge.count()) + "s)");
 
             spdlog::info("Using cached fallback for failed node {} in batch (age: {}s)",
                        nodeId, cacheAge.count());
@@ -184,6 +308,10 @@ bool CacheErrorHandler::isRecoverableError(const std::string& error) const {
     return isConnectionError(error) || isTimeoutError(error);
 }
 
+bool CacheErrorHandler::isCachedFallback(const std::string& reason) {
+    return reason.find(CACHED_FALLBACK_MARKER) != std::string::npos;
+}
+
 CacheErrorHandler::ErrorStats CacheErrorHandler::getStats() const {
     return ErrorStats{
         totalErrors_.load(),
@@ -194,7 +322,12 @@ CacheErrorHandler::ErrorStats CacheErrorHandler::getStats() const {
         successfulRetries_.load(),
         failedRetries_.load(),
         lastError_.load(),
-        calculateErrorRate()
+        calculateErrorRate(),
+        budgetExhausted_.load(),
+        circuitOpen_.load(),
+        retriesScheduled_.load(),
+        retriesCoalesced_.load(),
+        getPendingRetryCount()
     };
 }
 
@@ -206,6 +339,10 @@ void CacheErrorHandler::resetStats() {
     retryAttempts_.store(0);
     successfulRetries_.store(0);
     failedRetries_.store(0);
+    budgetExhausted_.store(0);
+    circuitOpen_.store(0);
+    retriesScheduled_.store(0);
+    retriesCoalesced_.store(0);
 
     std::lock_guard<std::mutex> lock(errorRateMutex_);
     recentErrors_.clear();
@@ -223,12 +360,12 @@ int CacheErrorHandler::getMaxRetryAttempts() const {
 }
 
 void CacheErrorHandler::setRetryDelay(std::chrono::milliseconds delay) {
-    retryDelay_ = delay;
+    retryDelay_.store(delay);
     spdlog::info("Retry delay set to {}ms", delay.count());
 }
 
 std::chrono::milliseconds CacheErrorHandler::getRetryDelay() const {
-    return retryDelay_;
+    return retryDelay_.load();
 }
 
 void CacheErrorHandler::setAutoRetryEnabled(bool enabled) {
@@ -277,26 +414,25 @@ void CacheErrorHandler::recordError(bool isConnError, bool hasCacheFallback) {
 void CacheErrorHandler::updateErrorRate() {
     std::lock_guard<std::mutex> lock(errorRateMutex_);
 
-    auto now = std::chrono::steady_clock::now();
-    recentErrors_.push_back(now);
+    recentErrors_.push_back(std::chrono::steady_clock::now());
 
-    // Remove errors older than 1 minute
-    auto oneMinuteAgo = now - std::chrono::minutes(1);
-    recentErrors_.erase(
-        std::remove_if(recentErrors_.begin(), recentErrors_.end(),
-                      [oneMinuteAgo](const auto& timestamp) {
-                          return timestamp < oneMinuteAgo;
-                      }),
-        recentErrors_.end()
-    );
-
-    // Keep only the most recent errors to prevent unbounded growth
+    // Keep only the most recent errors to prevent unbounded growth; entries
+    // older than the rate window are dropped by pruneErrorHistory()
     if (recentErrors_.size() > MAX_RECENT_ERRORS) {
         recentErrors_.erase(recentErrors_.begin(),
                           recentErrors_.begin() + (recentErrors_.size() - MAX_RECENT_ERRORS));
     }
 }
 
+void CacheErrorHandler::pruneErrorHistory() {
+    std::lock_guard<std::mutex> lock(errorRateMutex_);
+
+    // Timestamps are appended in order, so the expired ones form a prefix
+    auto oneMinuteAgo = std::chrono::steady_clock::now() - std::chrono::minutes(1);
+    auto firstRecent = std::lower_bound(recentErrors_.begin(), recentErrors_.end(), oneMinuteAgo);
+    recentErrors_.erase(recentErrors_.begin(), firstRecent);
+}
+
 double CacheErrorHandler::calculateErrorRate() const {
     std::lock_guard<std::mutex> lock(errorRateMutex_);
 
@@ -318,66 +454,130 @@ double CacheErrorHandler::calculateErrorRate() const {
     return static_cast<double>(errorsInLastMinute);
 }
 
-ReadResult CacheErrorHandler::attemptRetry(const std::string& nodeId) {
-    int maxRetries = maxRetryAttempts_.load();
+bool CacheErrorHandler::scheduleRetry(const std::string& nodeId) {
+    if (opcClient_->getCircuitBreaker().isOpen()) {
+        return false;
+    }
 
-    for (int attempt = 1; attempt <= maxRetries; ++attempt) {
-        retryAttempts_++;
+    {
+        std::lock_guard<std::mutex> lock(retryMutex_);
 
-        spdlog::info("Retry attempt {}/{} for node {}", attempt, maxRetries, nodeId);
+        if (!retryRunning_ || maxRetryAttempts_.load() <= 0) {
+            return false;
+        }
 
-        // Wait before retry (except for first attempt)
-        if (attempt > 1) {
-            std::this_thread::sleep_for(retryDelay_);
+        if (pendingRetries_.count(nodeId) > 0) {
+            retriesCoalesced_++;
+            return true;
         }
 
-        try {
-            // Attempt to read from OPC UA server
-            ReadResult result = opcClient_->readNode(nodeId);
+        if (pendingRetries_.size() >= MAX_PENDING_RETRIES) {
+            spdlog::warn("Retry queue full ({} nodes), not retrying node {}", MAX_PENDING_RETRIES, nodeId);
+            return false;
+        }
 
-            if (result.success) {
-                successfulRetries_++;
-                spdlog::info("Retry successful for node {} on attempt {}", nodeId, attempt);
+        pendingRetries_.emplace(nodeId, 0);
+        retryQueue_.emplace(std::chrono::steady_clock::now() + nextBackoff(1), nodeId);
+    }
 
-                // Update cache with successful result
-                cacheManager_->updateCache(nodeId, result.value,
-                                         result.success ? "Good" : "Bad",
-                                         result.reason, result.timestamp);
+    retriesScheduled_++;
+    retryCondition_.notify_one();
+    return true;
+}
 
-                return result;
-            }
+size_t CacheErrorHandler::getPendingRetryCount() const {
+    std::lock_guard<std::mutex> lock(retryMutex_);
+    return pendingRetries_.size();
+}
 
-            spdlog::warn("Retry attempt {} failed for node {}: {}",
-                       attempt, nodeId, result.reason);
+void CacheErrorHandler::retryLoop() {
+    std::unique_lock<std::mutex> lock(retryMutex_);
 
-        } catch (const std::exception& e) {
-            spdlog::error("Exception during retry attempt {} for node {}: {}",
-                        attempt, nodeId, e.what());
+    while (retryRunning_) {
+        if (retryQueue_.empty()) {
+            retryCondition_.wait(lock, [this] { return !retryRunning_ || !retryQueue_.empty(); });
+            continue;
         }
+
+        auto due = retryQueue_.begin()->first;
+        if (std::chrono::steady_clock::now() < due) {
+            // Woken early by stop() or by a retry queued ahead of this one
+            retryCondition_.wait_until(lock, due);
+            continue;
+        }
+
+        std::string nodeId = std::move(retryQueue_.begin()->second);
+        retryQueue_.erase(retryQueue_.begin());
+        int attempt = ++pendingRetries_[nodeId];
+
+        // The node stays in pendingRetries_ while its read runs, so new
+        // requests for it are coalesced into this retry
+        lock.unlock();
+        RetryOutcome outcome = attemptRetry(nodeId, attempt);
+        lock.lock();
+
+        if (outcome == RetryOutcome::FAILED && retryRunning_) {
+            if (attempt < maxRetryAttempts_.load()) {
+                retryQueue_.emplace(std::chrono::steady_clock::now() + nextBackoff(attempt + 1), nodeId);
+                continue;
+            }
+            failedRetries_++;
+            spdlog::warn("All {} retry attempts failed for node {}", attempt, nodeId);
+        }
+        pendingRetries_.erase(nodeId);
     }
+}
 
-    // All retries failed
-    failedRetries_++;
-    spdlog::error("All {} retry attempts failed for node {}", maxRetries, nodeId);
+CacheErrorHandler::RetryOutcome CacheErrorHandler::attemptRetry(const std::string& nodeId, int attempt) {
+    retryAttempts_++;
+    spdlog::debug("Retry attempt {}/{} for node {}", attempt, maxRetryAttempts_.load(), nodeId);
 
-    // Try cache fallback as last resort
-    auto cachedData = cacheManager_->getCachedValue(nodeId);
-    if (cachedData.has_value()) {
-        ReadResult result = cachedData->toReadResult();
-        auto cacheAge = cachedData->getAge();
-        result.reason = "All retry attempts failed - Using Cached Data (age: " +
-                      std::to_string(cacheAge.count()) + "s)";
+    try {
+        ReadResult result = opcClient_->readNode(nodeId, ReadBudget::Priority::RETRY);
 
-        spdlog::info("Using cached data after failed retries for node {} (age: {}s)",
-                   nodeId, cacheAge.count());
+        if (result.success) {
+            successfulRetries_++;
+            spdlog::info("Retry successful for node {} on attempt {}", nodeId, attempt);
 
-        return result;
+            // Later requests are served the fresh value from cache
+            cacheManager_->updateCache(nodeId, result.value, "Good", result.reason, result.timestamp);
+            return RetryOutcome::SUCCEEDED;
+        }
+
+        if (ReadBudget::isExhaustedError(result.reason)) {
+            // Retries draw only from the unreserved budget; stop and leave the cache as is
+            spdlog::info("Read budget exhausted, abandoning retries for node {}", nodeId);
+            budgetExhausted_++;
+            return RetryOutcome::ABANDONED;
+        }
+
+        if (CircuitBreaker::isOpenError(result.reason)) {
+            spdlog::info("Circuit breaker open, abandoning retries for node {}", nodeId);
+            circuitOpen_++;
+            return RetryOutcome::ABANDONED;
+        }
+
+        spdlog::debug("Retry attempt {} failed for node {}: {}", attempt, nodeId, result.reason);
+
+    } catch (const std::exception& e) {
+        spdlog::error("Exception during retry attempt {} for node {}: {}",
+                    attempt, nodeId, e.what());
     }
 
-    // No cache available, return error
-    return createErrorResult(nodeId,
-        "Connection failed after " + std::to_string(maxRetries) + " retry attempts",
-        ErrorAction::RETURN_ERROR);
+    return RetryOutcome::FAILED;
+}
+
+std::chrono::milliseconds CacheErrorHandler::nextBackoff(int attempt) {
+    // Base delay doubled per attempt, capped; the shift is bounded so it cannot overflow
+    auto base = retryDelay_.load();
+    int shift = std::min(std::max(attempt - 1, 0), 16);
+    auto backoff = std::min(base * (int64_t{1} << shift), MAX_RETRY_BACKOFF);
+
+    // Equal jitter: keep half of the backoff, randomize the other half so
+    // retries for nodes that failed together do not fire together
+    auto half = backoff.count() / 2;
+    std::uniform_int_distribution<std::chrono::milliseconds::rep> jitter(0, half);
+    return std::chrono::milliseconds(backoff.count() - half + jitter(retryJitter_));
 }
 
 ReadResult CacheErrorHandler::createErrorResult(
@@ -396,7 +596,7 @@ ReadResult CacheErrorHandler::createErrorResult(
             enhancedError += " (no cache available)";
             break;
         case ErrorAction::RETRY_CONNECTION:
-            enhancedError += " (retry attempted)";
+            enhancedError += " (retry scheduled)";
             break;
     }
 
@@ -4,16 +4,22 @@
 #include "opcua/OPCUAClient.h"
 #include "cache/CacheManager.h"
 #include "cache/CacheMetrics.h"
+#include "cache/PerformanceMonitor.h"
+#include "cache/LockProfiler.h"
 #include "core/ReadStrategy.h"
 #include "core/BackgroundUpdater.h"
 #include "core/CacheErrorHandler.h"
+#include "core/TimerService.h"
 #include "http/APIHandler.h"
+#include "http/MetricsExporter.h"
+#include "http/RequestTrace.h"
 #include "subscription/SubscriptionManager.h"
 #include "reconnection/ReconnectionManager.h"
 #include <iostream>
 #include <csignal>
 #include <chrono>
 #include <future>
+#include <stdexcept>
 #include <crow.h>
 
 namespace opcua2http {
@@ -118,40 +124,9 @@ void OPCUAHTTPBridge::run() {
             spdlog::warn("Failed to start reconnection manager");
         }
 
-        // Start cache cleanup thread with enhanced logging
-        cleanupThread_ = std::thread([this]() {
-            spdlog::debug("Cache cleanup thread started");
-
-            while (running_.load()) {
-                // Sleep in small intervals to allow quick shutdown
-                auto cleanupInterval = std::chrono::seconds(config_->cacheCleanupIntervalSeconds);
-                auto checkInterval = std::chrono::milliseconds(500);
-                auto elapsed = std::chrono::milliseconds(0);
-
-                while (running_.load() && elapsed < cleanupInterval) {
-                    std::this_thread::sleep_for(checkInterval);
-                    elapsed += checkInterval;
-                }
-
-                if (running_.load()) {
-                    ErrorHandler::executeWithErrorHandling([this]() {
-                        auto beforeCache = cacheManager_->getCachedNodeIds().size();
-
-                        cacheManager_->cleanupExpiredEntries();
-
-                        auto afterCache = cacheManager_->getCachedNodeIds().size();
-
-                        if (beforeCache != afterCache) {
-                            spdlog::info("Cache cleanup completed - Entries: {}→{}",
-                                       beforeCache, afterCache);
-                        }
-
-                    }, "Cache cleanup");
-                }
-            }
-
-            spdlog::debug("Cache cleanup thread stopped");
-        });
+        // Start the timer thread that runs all periodic maintenance tasks
+        timerService_->start();
+        spdlog::info("✓ Timer service started with {} periodic tasks", timerService_->getStats().tasks);
 
         // Log startup completion
         spdlog::info("✓ All background services started");
@@ -218,16 +193,22 @@ void OPCUAHTTPBridge::stop() {
         app_.stop();
         spdlog::debug("HTTP server stop signal sent");
 
+        // Stop periodic tasks before the components they touch
+        if (timerService_) {
+            timerService_->stop();
+            spdlog::debug("Timer service stopped");
+        }
+
         // Stop background updater
         if (backgroundUpdater_) {
             backgroundUpdater_->stop();
             spdlog::debug("Background updater stopped");
         }
 
-        // Wait for cleanup thread
-        if (cleanupThread_.joinable()) {
-            cleanupThread_.join();
-            spdlog::debug("Cleanup thread joined");
+        // Stop background retries before the client goes away
+        if (errorHandler_) {
+            errorHandler_->stop();
+            spdlog::debug("Cache error handler retries stopped");
         }
 
         // Wait for server thread if it's running (with timeout)
@@ -270,6 +251,19 @@ bool OPCUAHTTPBridge::initializeOPCClient() {
         // Create OPC UA client
         opcClient_ = std::make_unique<OPCUAClient>();
 
+        // PerformanceMonitor shared by the hot paths; handed to the client before
+        // initialize(), which may start the standby monitor thread that reads it
+        performanceMonitor_ = std::make_unique<PerformanceMonitor>();
+        opcClient_->setPerformanceMonitor(performanceMonitor_.get());
+
+        // Lock profiling costs a few clock reads per acquisition, so only on request;
+        // set before initialize() for the same reason
+        if (config_->lockProfilingEnabled) {
+            lockProfiler_ = std::make_unique<LockProfiler>();
+            opcClient_->setLockProfiler(lockProfiler_.get());
+            spdlog::info("Lock profiling enabled; report at /debug/locks");
+        }
+
         // Initialize with configuration
         if (!opcClient_->initialize(*config_)) {
             throw std::runtime_error("Failed to initialize OPC UA client with configuration");
@@ -304,17 +298,24 @@ bool OPCUAHTTPBridge::initializeComponents() {
                      config_->cacheRefreshThresholdSeconds,
                      config_->cacheExpireSeconds,
                      config_->cacheMaxEntries);
+        cacheManager_->setPerformanceMonitor(performanceMonitor_.get());
+        cacheManager_->setLockProfiler(lockProfiler_.get());
 
         // Initialize BackgroundUpdater
         backgroundUpdater_ = std::make_unique<BackgroundUpdater>(
             cacheManager_.get(),
             opcClient_.get()
         );
+        backgroundUpdater_->setPerformanceMonitor(performanceMonitor_.get());
 
         // Configure background updater from configuration
         backgroundUpdater_->setMaxConcurrentUpdates(config_->backgroundUpdateThreads);
+        backgroundUpdater_->setMinConcurrentUpdates(config_->backgroundUpdateMinThreads);
         backgroundUpdater_->setUpdateQueueSize(config_->backgroundUpdateQueueSize);
         backgroundUpdater_->setUpdateTimeout(std::chrono::milliseconds(config_->backgroundUpdateTimeoutMs));
+        backgroundUpdater_->setRefreshAheadLead(std::chrono::milliseconds(config_->refreshAheadLeadMs));
+        backgroundUpdater_->setRefreshAheadHotWindow(std::chrono::seconds(config_->refreshAheadHotWindowSeconds));
+        backgroundUpdater_->setRefreshAheadBudget(config_->refreshAheadReadsPerSecond);
 
         spdlog::debug("Background updater initialized with {} threads, queue size: {}, timeout: {}ms",
                      config_->backgroundUpdateThreads,
@@ -342,8 +343,9 @@ bool OPCUAHTTPBridge::initializeComponents() {
             errorHandler_.get()
         );
 
-        // Set background updater for ReadStrategy
+        // Set background updater and per-path metrics for ReadStrategy
         readStrategy_->setBackgroundUpdater(backgroundUpdater_.get());
+        readStrategy_->setCacheMetrics(cacheMetrics_.get());
 
         // Configure ReadStrategy from configuration
         readStrategy_->setMaxConcurrentReads(config_->cacheConcurrentReads);
@@ -357,6 +359,7 @@ bool OPCUAHTTPBridge::initializeComponents() {
             cacheManager_.get(),
             config_->subscriptionCleanupMinutes
         );
+        subscriptionManager_->setLockProfiler(lockProfiler_.get());
         spdlog::debug("Subscription manager initialized");
 
         // Initialize ReconnectionManager
@@ -378,11 +381,87 @@ bool OPCUAHTTPBridge::initializeComponents() {
         );
         spdlog::debug("API handler initialized");
 
+        // Initialize TimerService; tasks run once run() starts the thread
+        timerService_ = std::make_unique<TimerService>();
+        scheduleMaintenanceTasks();
+        apiHandler_->setTimerService(timerService_.get());
+        apiHandler_->setPerformanceMonitor(performanceMonitor_.get());
+        apiHandler_->setLockProfiler(lockProfiler_.get());
+        spdlog::debug("Timer service initialized with {} periodic tasks", timerService_->getStats().tasks);
+
+        // Initialize MetricsExporter for /metrics
+        metricsExporter_ = std::make_unique<MetricsExporter>();
+        metricsExporter_->setCacheManager(cacheManager_.get());
+        metricsExporter_->setCacheMetrics(cacheMetrics_.get());
+        metricsExporter_->setBackgroundUpdater(backgroundUpdater_.get());
+        metricsExporter_->setSubscriptionManager(subscriptionManager_.get());
+        metricsExporter_->setReconnectionManager(reconnectionManager_.get());
+        metricsExporter_->setErrorHandler(errorHandler_.get());
+        metricsExporter_->setPerformanceMonitor(performanceMonitor_.get());
+        metricsExporter_->setRequestLatency(&apiHandler_->getRequestLatency());
+        apiHandler_->setMetricsExporter(metricsExporter_.get());
+        spdlog::debug("Metrics exporter initialized");
+
+        // Initialize RequestTraceRecorder if requested; a trace that cannot
+        // be written is not worth refusing to serve for
+        if (!config_->requestTraceFile.empty()) {
+            traceRecorder_ = std::make_unique<RequestTraceRecorder>(
+                config_->requestTraceFile, static_cast<size_t>(config_->requestTraceBufferKb) * 1024);
+            if (traceRecorder_->start()) {
+                apiHandler_->setRequestTraceRecorder(traceRecorder_.get());
+            } else {
+                spdlog::warn("Request tracing disabled: cannot record to {}", config_->requestTraceFile);
+                traceRecorder_.reset();
+            }
+        }
+
         spdlog::info("All core components initialized successfully");
 
     }, "Components initialization");
 }
 
+void OPCUAHTTPBridge::scheduleMaintenanceTasks() {
+    // The timer refuses a zero interval; fail start-up rather than silently
+    // never running the task
+    auto schedulePeriodic = [this](const std::string& name, std::chrono::milliseconds interval,
+                                   TimerService::Task task) {
+        if (timerService_->schedulePeriodic(name, interval, std::move(task)) == 0) {
+            throw std::invalid_argument("Periodic task '" + name + "' needs a positive interval");
+        }
+    };
+
+    schedulePeriodic("cache.cleanup",
+        std::chrono::seconds(config_->cacheCleanupIntervalSeconds), [this]() {
+            auto beforeCache = cacheManager_->getCachedNodeIds().size();
+
+            cacheManager_->cleanupExpiredEntries();
+
+            auto afterCache = cacheManager_->getCachedNodeIds().size();
+
+            if (beforeCache != afterCache) {
+                spdlog::info("Cache cleanup completed - Entries: {}→{}",
+                           beforeCache, afterCache);
+            }
+        });
+
+    // Timer tasks must not block, so the deletes are handed to the reconnection
+    // monitor, which talks to the server between its own runIterate() calls
+    schedulePeriodic("subscription.cleanup", SUBSCRIPTION_CLEANUP_INTERVAL, [this]() {
+        reconnectionManager_->requestSubscriptionCleanup();
+    });
+
+    // Paces the reconnection manager's connected-state check; state changes
+    // still wake it immediately
+    reconnectionManager_->setExternalPolling(true);
+    schedulePeriodic("reconnection.check", RECONNECTION_CHECK_INTERVAL, [this]() {
+        reconnectionManager_->requestCheck();
+    });
+
+    schedulePeriodic("errors.prune", ERROR_HISTORY_PRUNE_INTERVAL, [this]() {
+        errorHandler_->pruneErrorHistory();
+    });
+}
+
 bool OPCUAHTTPBridge::setupHTTPServer() {
     return ErrorHandler::executeWithErrorHandling([this]() {
         spdlog::info("Setting up HTTP server...");
@@ -411,6 +490,12 @@ void OPCUAHTTPBridge::cleanup() {
     spdlog::info("Cleaning up resources...");
 
     ErrorHandler::executeWithErrorHandling([this]() {
+        // Stop periodic tasks
+        if (timerService_) {
+            timerService_->stop();
+            spdlog::debug("Timer service stopped");
+        }
+
         // Stop reconnection manager
         if (reconnectionManager_) {
             reconnectionManager_->stopMonitoring();
@@ -423,6 +508,12 @@ void OPCUAHTTPBridge::cleanup() {
             spdlog::debug("Background updater stopped");
         }
 
+        // Stop background retries before the client goes away
+        if (errorHandler_) {
+            errorHandler_->stop();
+            spdlog::debug("Cache error handler retries stopped");
+        }
+
         // Disconnect OPC UA client
         if (opcClient_) {
             opcClient_->disconnect();
@@ -430,6 +521,15 @@ void OPCUAHTTPBridge::cleanup() {
         }
 
         // Clear all components in reverse order of initialization
+        traceRecorder_.reset();
+        spdlog::debug("Request trace recorder stopped");
+
+        metricsExporter_.reset();
+        spdlog::debug("Metrics exporter cleaned up");
+
+        timerService_.reset();
+        spdlog::debug("Timer service cleaned up");
+
         apiHandler_.reset();
         spdlog::debug("API handler cleaned up");
 
@@ -457,6 +557,12 @@ void OPCUAHTTPBridge::cleanup() {
         opcClient_.reset();
         spdlog::debug("OPC UA client cleaned up");
 
+        lockProfiler_.reset();
+        spdlog::debug("Lock profiler cleaned up");
+
+        performanceMonitor_.reset();
+        spdlog::debug("Performance monitor cleaned up");
+
         // HTTP server is now a direct member, no need to reset
         spdlog::debug("HTTP server cleaned up");
 
@@ -1,10 +1,30 @@
 #include "core/ReadStrategy.h"
+#include "core/RequestTiming.h"
 #include <spdlog/spdlog.h>
 #include <chrono>
 #include <algorithm>
+#include <iterator>
 
 namespace opcua2http {
 
+namespace {
+
+// Reads shed by the read budget or failed fast by the circuit breaker carry no
+// new data and must not overwrite the cached value that serves as their fallback
+std::vector<ReadResult> withoutRejections(const std::vector<ReadResult>& results) {
+    std::vector<ReadResult> cacheable;
+    cacheable.reserve(results.size());
+    std::copy_if(results.begin(), results.end(), std::back_inserter(cacheable),
+                 [](const ReadResult& result) {
+                     return result.success ||
+                            (!ReadBudget::isExhaustedError(result.reason) &&
+                             !CircuitBreaker::isOpenError(result.reason));
+                 });
+    return cacheable;
+}
+
+} // namespace
+
 ReadStrategy::ReadStrategy(CacheManager* cacheManager, OPCUAClient* opcClient,
                           CacheErrorHandler* errorHandler)
     : cacheManager_(cacheManager)
@@ -37,8 +57,16 @@ std::vector<ReadResult> ReadStrategy::processNodeRequests(const std::vector<std:
 
     spdlog::debug("Processing {} node requests", nodeIds.size());
 
+    if (cacheMetrics_ && nodeIds.size() > 1) {
+        cacheMetrics_->recordBatchOperation(nodeIds.size());
+    }
+
     // Create batch plan based on cache status
-    BatchReadPlan plan = createBatchPlan(nodeIds);
+    BatchReadPlan plan;
+    {
+        RequestTiming::StageTimer timer(RequestTiming::Stage::CACHE);
+        plan = createBatchPlan(nodeIds);
+    }
 
     spdlog::debug("Batch plan created: {} fresh, {} stale, {} expired nodes",
                   plan.freshNodes.size(), plan.staleNodes.size(), plan.expiredNodes.size());
@@ -47,6 +75,80 @@ std::vector<ReadResult> ReadStrategy::processNodeRequests(const std::vector<std:
     return executeBatchPlan(plan);
 }
 
+void ReadStrategy::recordFreshResponse(const std::vector<std::string>& nodeIds,
+                                       std::chrono::steady_clock::time_point startTime) {
+    if (nodeIds.empty()) {
+        return;
+    }
+
+    // Mirrors what processNodeRequests() records for an all-FRESH plan
+    if (cacheMetrics_ && nodeIds.size() > 1) {
+        cacheMetrics_->recordBatchOperation(nodeIds.size());
+    }
+    recordPathMetrics(nodeIds, CacheManager::CacheStatus::FRESH, CacheMetrics::ReadPath::FRESH, startTime);
+
+    if (auto* timing = RequestTiming::current()) {
+        timing->nodes().fresh += nodeIds.size();
+    }
+}
+
+void ReadStrategy::recordSharedResponse(size_t nodeCount, const RequestTiming::NodeCounts& paths,
+                                        std::chrono::steady_clock::time_point startTime) {
+    if (nodeCount == 0) {
+        return;
+    }
+
+    if (cacheMetrics_) {
+        if (nodeCount > 1) {
+            cacheMetrics_->recordBatchOperation(nodeCount);
+        }
+
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - startTime);
+        double perNodeMs = elapsed.count() / 1e6 / static_cast<double>(nodeCount);
+
+        // CacheMetrics keeps nothing per node, so only the path of each node matters
+        static const std::string sharedNode;
+        size_t syncNodes = paths.expired + paths.miss + paths.fallback;
+        for (size_t i = 0; i < paths.fresh; ++i) {
+            cacheMetrics_->recordFreshHit(sharedNode, perNodeMs);
+            cacheMetrics_->recordCacheHit(sharedNode, perNodeMs);
+        }
+        for (size_t i = 0; i < paths.stale; ++i) {
+            cacheMetrics_->recordStaleRefresh(sharedNode, perNodeMs);
+            cacheMetrics_->recordCacheHit(sharedNode, perNodeMs);
+        }
+        for (size_t i = 0; i < syncNodes; ++i) {
+            cacheMetrics_->recordExpiredRead(sharedNode, perNodeMs);
+            cacheMetrics_->recordCacheMiss(sharedNode, perNodeMs);
+        }
+
+        // One sample per path taken, as executeBatchPlan() records, with the
+        // synchronous path classified the way syncReadPath() does
+        if (paths.fresh > 0) {
+            cacheMetrics_->recordPathLatency(CacheMetrics::ReadPath::FRESH, elapsed);
+        }
+        if (paths.stale > 0) {
+            cacheMetrics_->recordPathLatency(CacheMetrics::ReadPath::STALE, elapsed);
+        }
+        if (syncNodes > 0) {
+            auto syncPath = paths.fallback > 0 ? CacheMetrics::ReadPath::FALLBACK
+                          : paths.miss == syncNodes ? CacheMetrics::ReadPath::MISS
+                          : CacheMetrics::ReadPath::EXPIRED;
+            cacheMetrics_->recordPathLatency(syncPath, elapsed);
+        }
+    }
+
+    if (auto* timing = RequestTiming::current()) {
+        auto& counts = timing->nodes();
+        counts.fresh += paths.fresh;
+        counts.stale += paths.stale;
+        counts.expired += paths.expired;
+        counts.miss += paths.miss;
+        counts.fallback += paths.fallback;
+    }
+}
+
 ReadResult ReadStrategy::processNodeRequest(const std::string& nodeId) {
     if (nodeId.empty()) {
         spdlog::warn("Empty node ID provided to processNodeRequest");
@@ -55,10 +157,15 @@ ReadResult ReadStrategy::processNodeRequest(const std::string& nodeId) {
 
     spdlog::debug("Processing single node request: {}", nodeId);
 
+    auto startTime = std::chrono::steady_clock::now();
+
     // Check for concurrent read if concurrency control is enabled
     if (concurrencyControlEnabled_.load()) {
         if (!acquireReadLock(nodeId)) {
             spdlog::debug("Concurrent read detected for node {}, waiting for completion", nodeId);
+            if (cacheMetrics_) {
+                cacheMetrics_->recordConcurrentReadBlock(nodeId);
+            }
             return handleConcurrentRead(nodeId);
         }
     }
@@ -112,6 +219,14 @@ ReadResult ReadStrategy::processNodeRequest(const std::string& nodeId) {
                                                  "Good",
                                                  result.reason, result.timestamp);
                         spdlog::debug("[CACHE_PATH:EXPIRED/MISS] Successfully read and updated cache for node {}", nodeId);
+                    } else if (ReadBudget::isExhaustedError(result.reason) && errorHandler_) {
+                        // Degrade to the cached value, whatever its age, instead of loading the server
+                        spdlog::debug("[CACHE_PATH:EXPIRED/MISS] Read budget exhausted for node {}, serving cached data", nodeId);
+                        result = errorHandler_->handleBudgetExhausted(nodeId, cacheManager_->getCachedValue(nodeId));
+                    } else if (CircuitBreaker::isOpenError(result.reason) && errorHandler_) {
+                        // The server is known to be down; answer from cache without waiting
+                        spdlog::debug("[CACHE_PATH:EXPIRED/MISS] Circuit breaker open for node {}, serving cached data", nodeId);
+                        result = errorHandler_->handleCircuitOpen(nodeId, cacheManager_->getCachedValue(nodeId));
                     } else {
                         spdlog::warn("[CACHE_PATH:EXPIRED/MISS] OPC UA read failed for node {}: {}", nodeId, result.reason);
                         // If read failed, try cache fallback through error handler
@@ -120,6 +235,10 @@ ReadResult ReadStrategy::processNodeRequest(const std::string& nodeId) {
                             if (cachedData.has_value()) {
                                 result = errorHandler_->handleConnectionError(nodeId, cachedData);
                                 spdlog::info("[CACHE_PATH:EXPIRED/MISS] Using cached fallback data for node {}", nodeId);
+                            } else if (errorHandler_->isAutoRetryEnabled() &&
+                                       errorHandler_->isRecoverableError(result.reason)) {
+                                // Keep the original error; a background retry fills the cache for the next request
+                                errorHandler_->scheduleRetry(nodeId);
                             }
                         }
                     }
@@ -138,6 +257,14 @@ ReadResult ReadStrategy::processNodeRequest(const std::string& nodeId) {
                 break;
         }
 
+        CacheMetrics::ReadPath path = CacheMetrics::ReadPath::FRESH;
+        if (cacheResult.status == CacheManager::CacheStatus::STALE) {
+            path = CacheMetrics::ReadPath::STALE;
+        } else if (cacheResult.status == CacheManager::CacheStatus::EXPIRED) {
+            path = syncReadPath({result}, cacheResult.entry.has_value() ? 0 : 1);
+        }
+        recordPathMetrics({nodeId}, cacheResult.status, path, startTime);
+
         if (concurrencyControlEnabled_.load()) {
             releaseReadLock(nodeId);
         }
@@ -153,6 +280,111 @@ ReadResult ReadStrategy::processNodeRequest(const std::string& nodeId) {
     }
 }
 
+std::vector<ReadResult> ReadStrategy::processGroupRequest(const TagGroup& group) {
+    const auto& nodeIds = group.getNodeIds();
+    if (nodeIds.empty()) {
+        return {};
+    }
+
+    spdlog::debug("Processing tag group '{}' with {} nodes", group.getName(), nodeIds.size());
+
+    if (cacheMetrics_ && nodeIds.size() > 1) {
+        cacheMetrics_->recordBatchOperation(nodeIds.size());
+    }
+
+    std::vector<ReadResult> results(nodeIds.size());
+    std::vector<size_t> staleMembers;
+    std::vector<size_t> expiredMembers;
+    size_t missingNodes = 0;
+
+    // One status lookup per member; FRESH and STALE results are taken from it
+    auto startTime = std::chrono::steady_clock::now();
+    {
+        RequestTiming::StageTimer timer(RequestTiming::Stage::CACHE);
+        auto cacheResults = cacheManager_->getCachedValuesWithStatus(nodeIds);
+
+        for (size_t i = 0; i < nodeIds.size() && i < cacheResults.size(); ++i) {
+            auto& cacheResult = cacheResults[i];
+            if (cacheResult.status == CacheManager::CacheStatus::EXPIRED || !cacheResult.entry.has_value()) {
+                expiredMembers.push_back(i);
+                if (!cacheResult.entry.has_value()) {
+                    missingNodes++;
+                }
+                continue;
+            }
+            results[i] = cacheResult.entry->toReadResult();
+            if (cacheResult.status == CacheManager::CacheStatus::STALE) {
+                staleMembers.push_back(i);
+            }
+        }
+    }
+
+    auto membersToIds = [&nodeIds](const std::vector<size_t>& members) {
+        std::vector<std::string> ids;
+        ids.reserve(members.size());
+        for (size_t member : members) {
+            ids.push_back(nodeIds[member]);
+        }
+        return ids;
+    };
+
+    if (!staleMembers.empty()) {
+        scheduleBackgroundUpdates(membersToIds(staleMembers));
+    }
+
+    // Per-node metrics need the IDs by path; only built when someone records them
+    size_t cachedMembers = nodeIds.size() - expiredMembers.size();
+    if (cacheMetrics_ && cachedMembers > 0) {
+        std::vector<size_t> freshMembers;
+        freshMembers.reserve(cachedMembers - staleMembers.size());
+        for (size_t i = 0, stale = 0, expired = 0; i < nodeIds.size(); ++i) {
+            if (stale < staleMembers.size() && staleMembers[stale] == i) {
+                stale++;
+            } else if (expired < expiredMembers.size() && expiredMembers[expired] == i) {
+                expired++;
+            } else {
+                freshMembers.push_back(i);
+            }
+        }
+        recordPathMetrics(membersToIds(freshMembers), CacheManager::CacheStatus::FRESH,
+                          CacheMetrics::ReadPath::FRESH, startTime);
+        recordPathMetrics(membersToIds(staleMembers), CacheManager::CacheStatus::STALE,
+                          CacheMetrics::ReadPath::STALE, startTime);
+    }
+
+    size_t fallbackNodes = 0;
+    if (!expiredMembers.empty()) {
+        spdlog::info("[CACHE_PATH:EXPIRED_BATCH] Reading {} expired/missing members of tag group '{}' from OPC UA server",
+                     expiredMembers.size(), group.getName());
+
+        auto expiredStart = std::chrono::steady_clock::now();
+        auto expiredResults = readGroupMembers(group, expiredMembers);
+        if (cacheMetrics_) {
+            recordPathMetrics(membersToIds(expiredMembers), CacheManager::CacheStatus::EXPIRED,
+                              syncReadPath(expiredResults, missingNodes), expiredStart);
+        }
+
+        for (size_t i = 0; i < expiredMembers.size() && i < expiredResults.size(); ++i) {
+            if (CacheErrorHandler::isCachedFallback(expiredResults[i].reason)) {
+                fallbackNodes++;
+            }
+            results[expiredMembers[i]] = std::move(expiredResults[i]);
+        }
+    }
+
+    if (auto* timing = RequestTiming::current()) {
+        auto& counts = timing->nodes();
+        size_t cachedExpired = expiredMembers.size() - missingNodes;
+        counts.fresh += cachedMembers - staleMembers.size();
+        counts.stale += staleMembers.size();
+        counts.miss += missingNodes;
+        counts.fallback += std::min(fallbackNodes, cachedExpired);
+        counts.expired += cachedExpired - std::min(fallbackNodes, cachedExpired);
+    }
+
+    return results;
+}
+
 ReadStrategy::BatchReadPlan ReadStrategy::createBatchPlan(const std::vector<std::string>& nodeIds) {
     BatchReadPlan plan;
 
@@ -177,6 +409,9 @@ ReadStrategy::BatchReadPlan ReadStrategy::createBatchPlan(const std::vector<std:
                 break;
             case CacheManager::CacheStatus::EXPIRED:
                 plan.expiredNodes.push_back(nodeId);
+                if (!cacheResult.entry.has_value()) {
+                    plan.missingNodes++;
+                }
                 break;
         }
     }
@@ -200,22 +435,37 @@ std::vector<ReadResult> ReadStrategy::executeBatchPlan(const BatchReadPlan& plan
 
     // Process fresh nodes (return from cache)
     if (!plan.freshNodes.empty()) {
+        RequestTiming::StageTimer timer(RequestTiming::Stage::CACHE);
+        auto startTime = std::chrono::steady_clock::now();
         auto freshResults = processFreshNodes(plan.freshNodes);
         results.insert(results.end(), freshResults.begin(), freshResults.end());
+        recordPathMetrics(plan.freshNodes, CacheManager::CacheStatus::FRESH,
+                          CacheMetrics::ReadPath::FRESH, startTime);
     }
 
     // Process stale nodes (return cache + background update)
     if (!plan.staleNodes.empty()) {
+        RequestTiming::StageTimer timer(RequestTiming::Stage::CACHE);
+        auto startTime = std::chrono::steady_clock::now();
         auto staleResults = processStaleNodes(plan.staleNodes);
         results.insert(results.end(), staleResults.begin(), staleResults.end());
+        recordPathMetrics(plan.staleNodes, CacheManager::CacheStatus::STALE,
+                          CacheMetrics::ReadPath::STALE, startTime);
     }
 
     // Process expired nodes (synchronous OPC UA read)
     if (!plan.expiredNodes.empty()) {
+        auto startTime = std::chrono::steady_clock::now();
         auto expiredResults = processExpiredNodes(plan.expiredNodes);
+        recordPathMetrics(plan.expiredNodes, CacheManager::CacheStatus::EXPIRED,
+                          syncReadPath(expiredResults, plan.missingNodes), startTime);
         results.insert(results.end(), expiredResults.begin(), expiredResults.end());
     }
 
+    if (auto* timing = RequestTiming::current()) {
+        countPathNodes(plan, results, timing->nodes());
+    }
+
     spdlog::debug("Batch plan executed, returning {} results", results.size());
     return results;
 }
@@ -266,6 +516,69 @@ void ReadStrategy::setErrorHandler(CacheErrorHandler* errorHandler) {
     spdlog::debug("Error handler {} set", errorHandler ? "instance" : "null");
 }
 
+void ReadStrategy::setCacheMetrics(CacheMetrics* cacheMetrics) {
+    cacheMetrics_ = cacheMetrics;
+    spdlog::debug("Cache metrics {} set", cacheMetrics ? "instance" : "null");
+}
+
+void ReadStrategy::recordPathMetrics(const std::vector<std::string>& nodeIds,
+                                     CacheManager::CacheStatus status,
+                                     CacheMetrics::ReadPath path,
+                                     std::chrono::steady_clock::time_point startTime) {
+    if (!cacheMetrics_ || nodeIds.empty()) {
+        return;
+    }
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - startTime);
+    cacheMetrics_->recordPathLatency(path, elapsed);
+    double perNodeMs = elapsed.count() / 1e6 / static_cast<double>(nodeIds.size());
+
+    for (const auto& nodeId : nodeIds) {
+        switch (status) {
+            case CacheManager::CacheStatus::FRESH:
+                cacheMetrics_->recordFreshHit(nodeId, perNodeMs);
+                cacheMetrics_->recordCacheHit(nodeId, perNodeMs);
+                break;
+            case CacheManager::CacheStatus::STALE:
+                cacheMetrics_->recordStaleRefresh(nodeId, perNodeMs);
+                cacheMetrics_->recordCacheHit(nodeId, perNodeMs);
+                break;
+            case CacheManager::CacheStatus::EXPIRED:
+                // Expired and missing entries both cost a synchronous server read
+                cacheMetrics_->recordExpiredRead(nodeId, perNodeMs);
+                cacheMetrics_->recordCacheMiss(nodeId, perNodeMs);
+                break;
+        }
+    }
+}
+
+void ReadStrategy::countPathNodes(const BatchReadPlan& plan, const std::vector<ReadResult>& results,
+                                  RequestTiming::NodeCounts& counts) {
+    // Expired results come last; only entries that existed can be a cache fallback
+    auto expiredResults = static_cast<std::ptrdiff_t>(std::min(results.size(), plan.expiredNodes.size()));
+    size_t fallback = static_cast<size_t>(std::count_if(results.end() - expiredResults, results.end(),
+        [](const ReadResult& result) { return CacheErrorHandler::isCachedFallback(result.reason); }));
+    size_t cachedExpired = plan.expiredNodes.size() - plan.missingNodes;
+
+    counts.fresh += plan.freshNodes.size();
+    counts.stale += plan.staleNodes.size();
+    counts.miss += plan.missingNodes;
+    counts.fallback += std::min(fallback, cachedExpired);
+    counts.expired += cachedExpired - std::min(fallback, cachedExpired);
+}
+
+CacheMetrics::ReadPath ReadStrategy::syncReadPath(const std::vector<ReadResult>& results, size_t missingNodes) {
+    bool fallback = std::any_of(results.begin(), results.end(), [](const ReadResult& result) {
+        return CacheErrorHandler::isCachedFallback(result.reason);
+    });
+    if (fallback) {
+        return CacheMetrics::ReadPath::FALLBACK;
+    }
+    bool allMissing = missingNodes > 0 && missingNodes >= results.size();
+    return allMissing ? CacheMetrics::ReadPath::MISS : CacheMetrics::ReadPath::EXPIRED;
+}
+
 bool ReadStrategy::acquireReadLock(const std::string& nodeId) {
     std::lock_guard<std::mutex> lock(readMutex_);
 
@@ -392,7 +705,7 @@ std::vector<ReadResult> ReadStrategy::readAndUpdateCache(const std::vector<std::
 
         // Update cache with results
         if (!results.empty()) {
-            cacheManager_->updateCacheBatch(results);
+            cacheManager_->updateCacheBatch(withoutRejections(results));
             spdlog::debug("[CACHE_PATH:EXPIRED/MISS] Updated cache with {} read results", results.size());
         }
 
@@ -430,6 +743,48 @@ std::vector<ReadResult> ReadStrategy::readAndUpdateCache(const std::vector<std::
     return results;
 }
 
+std::vector<ReadResult> ReadStrategy::readGroupMembers(const TagGroup& group,
+                                                       const std::vector<size_t>& members) {
+    const auto& nodeIds = group.getNodeIds();
+    std::vector<std::string> memberIds;
+    memberIds.reserve(members.size());
+    for (size_t member : members) {
+        memberIds.push_back(nodeIds[member]);
+    }
+
+    // Groups defined without a client have no prepared read; read them like any node list
+    const auto* preparedRead = group.getPreparedRead();
+    if (!preparedRead) {
+        return processExpiredNodes(memberIds);
+    }
+
+    std::vector<ReadResult> results;
+    try {
+        results = opcClient_->readPrepared(*preparedRead, members);
+
+        if (!results.empty()) {
+            cacheManager_->updateCacheBatch(withoutRejections(results));
+        }
+        if (errorHandler_ && !results.empty()) {
+            results = errorHandler_->handlePartialBatchFailure(memberIds, results);
+        }
+    } catch (const std::exception& e) {
+        spdlog::error("[CACHE_PATH:EXPIRED_BATCH] Error reading tag group '{}': {}", group.getName(), e.what());
+
+        results.clear();
+        results.reserve(memberIds.size());
+        for (const auto& nodeId : memberIds) {
+            if (errorHandler_) {
+                results.push_back(errorHandler_->handleConnectionError(nodeId, cacheManager_->getCachedValue(nodeId)));
+            } else {
+                results.push_back(createErrorResult(nodeId, std::string("OPC UA read error: ") + e.what()));
+            }
+        }
+    }
+
+    return results;
+}
+
 ReadResult ReadStrategy::createErrorResult(const std::string& nodeId, const std::string& reason) {
     return ReadResult::createError(nodeId, reason, getCurrentTimestamp());
 }
@@ -522,10 +877,24 @@ std::vector<ReadResult> ReadStrategy::processExpiredNodesWithBatching(
 
             // Update cache with batch results
             if (!batchResults.empty()) {
-                cacheManager_->updateCacheBatch(batchResults);
+                cacheManager_->updateCacheBatch(withoutRejections(batchResults));
                 spdlog::debug("[CACHE_PATH:EXPIRED_BATCH] Updated cache with {} batch results", batchResults.size());
             }
 
+            // Serve cached data for nodes shed by the read budget or the circuit breaker
+            if (errorHandler_) {
+                for (auto& result : batchResults) {
+                    if (result.success) {
+                        continue;
+                    }
+                    if (ReadBudget::isExhaustedError(result.reason)) {
+                        result = errorHandler_->handleBudgetExhausted(result.id, cacheManager_->getCachedValue(result.id));
+                    } else if (CircuitBreaker::isOpenError(result.reason)) {
+                        result = errorHandler_->handleCircuitOpen(result.id, cacheManager_->getCachedValue(result.id));
+                    }
+                }
+            }
+
             // Add to overall results
             allResults.insert(allResults.end(), batchResults.begin(), batchResults.end());
 
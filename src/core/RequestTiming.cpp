@@ -0,0 +1,161 @@
+#include "core/RequestTiming.h"
+
+#include <cstdio>
+
+namespace opcua2http {
+
+namespace {
+
+thread_local RequestTiming* currentTiming = nullptr;
+
+double toMs(std::chrono::nanoseconds duration) {
+    return static_cast<double>(duration.count()) / 1e6;
+}
+
+void appendMetric(std::string& out, const char* name, double durationMs) {
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "%s;dur=%.3f", name, durationMs);
+    if (!out.empty()) {
+        out += ", ";
+    }
+    out += buffer;
+}
+
+} // namespace
+
+RequestTiming::Scope::Scope(RequestTiming* timing)
+    : previous_(currentTiming) {
+    currentTiming = timing;
+}
+
+RequestTiming::Scope::~Scope() {
+    currentTiming = previous_;
+}
+
+RequestTiming::StageTimer::StageTimer(Stage stage)
+    : timing_(currentTiming)
+    , stage_(stage) {
+    if (timing_) {
+        tagScope_.emplace(allocationTag(stage));
+        startAllocations_ = AllocationTracker::thread();
+        start_ = std::chrono::steady_clock::now();
+    }
+}
+
+RequestTiming::StageTimer::~StageTimer() {
+    if (timing_) {
+        timing_->add(stage_, std::chrono::steady_clock::now() - start_);
+        timing_->allocations_[static_cast<size_t>(stage_)] += AllocationTracker::thread() - startAllocations_;
+    }
+}
+
+RequestTiming::RequestTiming()
+    : start_(std::chrono::steady_clock::now()) {
+}
+
+RequestTiming* RequestTiming::current() {
+    return currentTiming;
+}
+
+void RequestTiming::countOpcRequest() {
+    if (currentTiming) {
+        currentTiming->opcRequests_++;
+    }
+}
+
+void RequestTiming::add(Stage stage, std::chrono::nanoseconds elapsed) {
+    auto index = static_cast<size_t>(stage);
+    stages_[index] += elapsed;
+    entered_[index] = true;
+}
+
+std::chrono::nanoseconds RequestTiming::getStage(Stage stage) const {
+    return stages_[static_cast<size_t>(stage)];
+}
+
+AllocationTracker::Counts RequestTiming::getAllocations(Stage stage) const {
+    return allocations_[static_cast<size_t>(stage)];
+}
+
+std::chrono::nanoseconds RequestTiming::getElapsed() const {
+    return std::chrono::steady_clock::now() - start_;
+}
+
+std::string RequestTiming::toServerTimingHeader() const {
+    std::string header;
+    for (size_t i = 0; i < STAGE_COUNT; ++i) {
+        if (!entered_[i]) {
+            continue;
+        }
+        auto stage = static_cast<Stage>(i);
+        appendMetric(header, stageName(stage), toMs(stages_[i]));
+        if (stage == Stage::OPC) {
+            header += ";desc=\"" + std::to_string(opcRequests_) +
+                      (opcRequests_ == 1 ? " request\"" : " requests\"");
+        }
+    }
+    appendMetric(header, "total", toMs(getElapsed()));
+
+    header += ", nodes;desc=\"fresh=" + std::to_string(nodes_.fresh) +
+              " stale=" + std::to_string(nodes_.stale) +
+              " expired=" + std::to_string(nodes_.expired) +
+              " miss=" + std::to_string(nodes_.miss) +
+              " fallback=" + std::to_string(nodes_.fallback) + "\"";
+    return header;
+}
+
+nlohmann::json RequestTiming::toJSON() const {
+    nlohmann::json stages = nlohmann::json::object();
+    for (size_t i = 0; i < STAGE_COUNT; ++i) {
+        stages[std::string(stageName(static_cast<Stage>(i))) + "_ms"] = toMs(stages_[i]);
+    }
+
+    nlohmann::json json = {
+        {"stages", stages},
+        {"total_ms", toMs(getElapsed())},
+        {"opc_requests", opcRequests_},
+        {"nodes", {
+            {"fresh", nodes_.fresh},
+            {"stale", nodes_.stale},
+            {"expired", nodes_.expired},
+            {"miss", nodes_.miss},
+            {"fallback", nodes_.fallback}
+        }}
+    };
+
+    if (AllocationTracker::isEnabled()) {
+        nlohmann::json allocations = nlohmann::json::object();
+        for (size_t i = 0; i < STAGE_COUNT; ++i) {
+            allocations[stageName(static_cast<Stage>(i))] = {
+                {"allocations", allocations_[i].allocations},
+                {"bytes", allocations_[i].bytes}
+            };
+        }
+        json["allocations"] = allocations;
+    }
+    return json;
+}
+
+const char* RequestTiming::stageName(Stage stage) {
+    switch (stage) {
+        case Stage::AUTH: return "auth";
+        case Stage::PARSE: return "parse";
+        case Stage::CACHE: return "cache";
+        case Stage::OPC: return "opc";
+        case Stage::SERIALIZE: return "serialize";
+    }
+    return "unknown";
+}
+
+AllocationTracker::Tag RequestTiming::allocationTag(Stage stage) {
+    switch (stage) {
+        case Stage::AUTH: return AllocationTracker::Tag::AUTH;
+        case Stage::PARSE: return AllocationTracker::Tag::PARSE;
+        case Stage::CACHE: return AllocationTracker::Tag::CACHE;
+        case Stage::OPC: return AllocationTracker::Tag::OPC;
+        case Stage::SERIALIZE: return AllocationTracker::Tag::SERIALIZE;
+    }
+    return AllocationTracker::Tag::UNTAGGED;
+}
+
+} // namespace opcua2http
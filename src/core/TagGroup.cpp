@@ -0,0 +1,111 @@
+#include "core/TagGroup.h"
+
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_set>
+
+#include <spdlog/spdlog.h>
+
+namespace opcua2http {
+
+TagGroup::TagGroup(std::string name, std::vector<std::string> nodeIds,
+                   std::shared_ptr<const OPCUAClient::PreparedRead> preparedRead)
+    : name_(std::move(name))
+    , nodeIds_(std::move(nodeIds))
+    , preparedRead_(std::move(preparedRead)) {
+}
+
+TagGroupRegistry::TagGroupRegistry(OPCUAClient* opcClient, size_t maxGroups, size_t maxGroupSize)
+    : opcClient_(opcClient)
+    , maxGroups_(maxGroups)
+    , maxGroupSize_(maxGroupSize) {
+}
+
+std::shared_ptr<const TagGroup> TagGroupRegistry::define(const std::string& name,
+                                                         const std::vector<std::string>& nodeIds) {
+    if (!isValidName(name)) {
+        throw std::invalid_argument("Invalid group name: '" + name +
+            "' (1-64 letters, digits, '_', '-' or '.')");
+    }
+    if (nodeIds.empty()) {
+        throw std::invalid_argument("Group '" + name + "' has no node IDs");
+    }
+    if (nodeIds.size() > maxGroupSize_) {
+        throw std::invalid_argument("Group '" + name + "' has " + std::to_string(nodeIds.size()) +
+            " node IDs, more than the limit of " + std::to_string(maxGroupSize_));
+    }
+
+    std::unordered_set<std::string> seen;
+    seen.reserve(nodeIds.size());
+    for (const auto& nodeId : nodeIds) {
+        if (!seen.insert(nodeId).second) {
+            throw std::invalid_argument("Group '" + name + "' lists node ID " + nodeId + " twice");
+        }
+    }
+
+    // Parsed outside the lock; readers of the old group are not held up
+    auto preparedRead = opcClient_ ? opcClient_->prepareRead(nodeIds) : nullptr;
+    auto group = std::make_shared<const TagGroup>(name, nodeIds, std::move(preparedRead));
+
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        auto it = groups_.find(name);
+        if (it != groups_.end()) {
+            it->second = group;
+        } else {
+            if (groups_.size() >= maxGroups_) {
+                throw std::invalid_argument("Cannot define group '" + name + "': the limit of " +
+                    std::to_string(maxGroups_) + " groups is reached");
+            }
+            groups_.emplace(name, group);
+        }
+    }
+
+    spdlog::info("Tag group '{}' defined with {} node IDs", name, nodeIds.size());
+    return group;
+}
+
+std::shared_ptr<const TagGroup> TagGroupRegistry::find(const std::string& name) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = groups_.find(name);
+    return it != groups_.end() ? it->second : nullptr;
+}
+
+bool TagGroupRegistry::remove(const std::string& name) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return groups_.erase(name) > 0;
+}
+
+std::vector<std::shared_ptr<const TagGroup>> TagGroupRegistry::list() const {
+    std::vector<std::shared_ptr<const TagGroup>> groups;
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        groups.reserve(groups_.size());
+        for (const auto& [name, group] : groups_) {
+            groups.push_back(group);
+        }
+    }
+
+    std::sort(groups.begin(), groups.end(), [](const auto& a, const auto& b) {
+        return a->getName() < b->getName();
+    });
+    return groups;
+}
+
+size_t TagGroupRegistry::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return groups_.size();
+}
+
+bool TagGroupRegistry::isValidName(const std::string& name) {
+    if (name.empty() || name.size() > MAX_NAME_LENGTH) {
+        return false;
+    }
+    return std::all_of(name.begin(), name.end(), [](char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+               c == '_' || c == '-' || c == '.';
+    });
+}
+
+} // namespace opcua2http
@@ -0,0 +1,239 @@
+#include "core/TimerService.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+
+namespace opcua2http {
+
+TimerService::TimerService() = default;
+
+TimerService::~TimerService() {
+    stop();
+}
+
+bool TimerService::start() {
+    std::lock_guard<std::mutex> lock(timerMutex_);
+    if (running_) {
+        return false;
+    }
+
+    running_ = true;
+    timerThread_ = std::thread(&TimerService::timerLoop, this);
+    spdlog::debug("Timer service started with {} tasks", tasks_.size());
+    return true;
+}
+
+void TimerService::stop() {
+    {
+        std::lock_guard<std::mutex> lock(timerMutex_);
+        if (!running_) {
+            return;
+        }
+        running_ = false;
+    }
+    timerCondition_.notify_all();
+
+    if (timerThread_.joinable()) {
+        timerThread_.join();
+    }
+    spdlog::debug("Timer service stopped");
+}
+
+bool TimerService::isRunning() const {
+    std::lock_guard<std::mutex> lock(timerMutex_);
+    return running_;
+}
+
+TimerService::TaskId TimerService::schedulePeriodic(const std::string& name,
+                                                    std::chrono::milliseconds interval,
+                                                    Task task,
+                                                    bool runImmediately) {
+    if (interval.count() <= 0 || !task) {
+        spdlog::error("Invalid timer task '{}' (interval {}ms)", name, interval.count());
+        return 0;
+    }
+
+    bool earliest = false;
+    TaskId id = 0;
+    {
+        std::lock_guard<std::mutex> lock(timerMutex_);
+        id = nextId_++;
+
+        Entry entry;
+        entry.task = std::move(task);
+        entry.deadline = Clock::now() + (runImmediately ? std::chrono::milliseconds(0) : interval);
+        entry.stats.name = name;
+        entry.stats.interval = interval;
+
+        earliest = deadlines_.empty() || entry.deadline < deadlines_.begin()->first;
+        deadlines_.emplace(entry.deadline, id);
+        tasks_.emplace(id, std::move(entry));
+    }
+
+    // Only a new earliest deadline changes when the thread must wake
+    if (earliest) {
+        timerCondition_.notify_one();
+    }
+
+    spdlog::debug("Scheduled timer task '{}' every {}ms", name, interval.count());
+    return id;
+}
+
+bool TimerService::cancel(TaskId id) {
+    std::unique_lock<std::mutex> lock(timerMutex_);
+
+    auto it = tasks_.find(id);
+    if (it == tasks_.end()) {
+        return false;
+    }
+
+    removeDeadline(id, it->second.deadline);
+    tasks_.erase(it);
+
+    // Let a run in progress finish before the caller tears down its captures
+    if (runningTask_ == id && std::this_thread::get_id() != timerThread_.get_id()) {
+        runFinished_.wait(lock, [this, id] { return runningTask_ != id; });
+    }
+    return true;
+}
+
+std::vector<TimerService::TaskStats> TimerService::getTaskStats() const {
+    std::lock_guard<std::mutex> lock(timerMutex_);
+
+    std::vector<TaskStats> stats;
+    stats.reserve(tasks_.size());
+    for (const auto& [id, entry] : tasks_) {
+        stats.push_back(entry.stats);
+    }
+    return stats;
+}
+
+TimerService::ServiceStats TimerService::getStats() const {
+    ServiceStats stats;
+    {
+        std::lock_guard<std::mutex> lock(timerMutex_);
+        stats.tasks = tasks_.size();
+    }
+    stats.wakeups = wakeups_.load();
+    stats.idleWakeups = idleWakeups_.load();
+    stats.coalescedRuns = coalescedRuns_.load();
+    return stats;
+}
+
+void TimerService::timerLoop() {
+    std::unique_lock<std::mutex> lock(timerMutex_);
+
+    while (running_) {
+        // Sleep until the earliest deadline; with no tasks, until one is added
+        if (deadlines_.empty()) {
+            timerCondition_.wait(lock, [this] { return !running_ || !deadlines_.empty(); });
+        } else {
+            timerCondition_.wait_until(lock, deadlines_.begin()->first);
+        }
+
+        if (!running_) {
+            break;
+        }
+        wakeups_++;
+
+        auto horizon = Clock::now() + COALESCE_WINDOW;
+        std::vector<TaskId> due;
+        for (auto it = deadlines_.begin(); it != deadlines_.end() && it->first <= horizon; ++it) {
+            due.push_back(it->second);
+        }
+
+        if (due.empty()) {
+            // Woken by a schedule or cancel that did not make anything due
+            idleWakeups_++;
+            continue;
+        }
+        coalescedRuns_ += due.size() - 1;
+
+        for (TaskId id : due) {
+            if (!running_) {
+                break;
+            }
+            runTask(id, lock);
+        }
+    }
+}
+
+void TimerService::runTask(TaskId id, std::unique_lock<std::mutex>& lock) {
+    auto it = tasks_.find(id);
+    if (it == tasks_.end()) {
+        // Cancelled by an earlier task in this wakeup
+        return;
+    }
+
+    auto deadline = it->second.deadline;
+    removeDeadline(id, deadline);
+
+    // Copy so cancel() may erase the entry while the task runs
+    Task task = it->second.task;
+    std::string name = it->second.stats.name;
+    runningTask_ = id;
+    lock.unlock();
+
+    auto start = Clock::now();
+    bool failed = false;
+    try {
+        task();
+    } catch (const std::exception& e) {
+        spdlog::error("Timer task '{}' failed: {}", name, e.what());
+        failed = true;
+    } catch (...) {
+        spdlog::error("Timer task '{}' failed with unknown exception", name);
+        failed = true;
+    }
+    auto end = Clock::now();
+
+    lock.lock();
+    runningTask_ = 0;
+    runFinished_.notify_all();
+
+    it = tasks_.find(id);
+    if (it == tasks_.end()) {
+        return;
+    }
+
+    TaskStats& stats = it->second.stats;
+    auto runTime = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+    auto lateness = start > deadline ?
+        std::chrono::duration_cast<std::chrono::microseconds>(start - deadline) : std::chrono::microseconds(0);
+
+    stats.runs++;
+    stats.totalRunTime += runTime;
+    stats.lastRunTime = runTime;
+    stats.maxRunTime = std::max(stats.maxRunTime, runTime);
+    stats.maxLateness = std::max(stats.maxLateness, lateness);
+    if (failed) {
+        stats.failures++;
+    }
+    if (runTime > stats.interval) {
+        stats.overruns++;
+        spdlog::warn("Timer task '{}' overran its {}ms interval ({:.1f}ms)",
+                     stats.name, stats.interval.count(), runTime.count() / 1000.0);
+    }
+
+    // Advance from the previous deadline so periods do not drift with run time
+    auto next = deadline + stats.interval;
+    if (next <= end) {
+        auto missed = (end - deadline) / stats.interval;
+        stats.missedPeriods += static_cast<uint64_t>(missed);
+        next = deadline + stats.interval * (missed + 1);
+    }
+
+    it->second.deadline = next;
+    deadlines_.emplace(next, id);
+}
+
+void TimerService::removeDeadline(TaskId id, Clock::time_point deadline) {
+    auto range = deadlines_.equal_range(deadline);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == id) {
+            deadlines_.erase(it);
+            return;
+        }
+    }
+}
+
+} // namespace opcua2http
@@ -7,6 +7,8 @@
 #include <iomanip>
 #include <regex>
 #include <cstring>
+#include <cstdlib>
+#include <optional>
 
 namespace opcua2http {
 
@@ -23,6 +25,10 @@ APIHandler::APIHandler(CacheManager* cacheManager,
     , errorHandler_(errorHandler)
     , config_(config)
     , startTime_(std::chrono::steady_clock::now())
+    , credentials_(config.apiKey, config.authUsername, config.authPassword)
+    , tagGroups_(opcClient, static_cast<size_t>(std::max(config.tagGroupMaxCount, 0)),
+                 static_cast<size_t>(std::max(config.tagGroupMaxSize, 1)))
+    , responseCache_(cacheManager, static_cast<size_t>(std::max(config.responseCacheSize, 0)))
 {
     if (!cacheManager_) {
         throw std::invalid_argument("CacheManager cannot be null");
@@ -34,6 +40,23 @@ APIHandler::APIHandler(CacheManager* cacheManager,
         throw std::invalid_argument("OPCUAClient cannot be null");
     }
 
+    RateLimiter::Settings limits;
+    limits.requestsPerSecond = config_.rateLimitRequestsPerSecond;
+    limits.burst = config_.rateLimitBurst;
+    limits.maxFailedAuth = config_.authMaxFailures;
+    limits.blockDuration = std::chrono::seconds(config_.authBlockSeconds);
+    limits.maxClients = static_cast<size_t>(std::max(config_.rateLimitMaxClients, 1));
+    rateLimiter_.configure(limits);
+
+    // A bad TAG_GROUPS entry is reported and left out rather than stopping the bridge
+    for (const auto& [name, nodeIds] : config_.tagGroups) {
+        try {
+            defineTagGroup(name, nodeIds);
+        } catch (const std::invalid_argument& e) {
+            std::cerr << "Warning: Tag group not defined: " << e.what() << std::endl;
+        }
+    }
+
     std::cout << "APIHandler initialized with endpoint: " << config_.opcEndpoint
               << ", port: " << config_.serverPort << std::endl;
 }
@@ -45,7 +68,7 @@ void APIHandler::setupRoutes(crow::App<crow::CORSHandler>& app) {
     // Configure CORS based on configuration
     auto& globalCors = cors.global()
         .headers("Content-Type", "Authorization", "X-API-Key", "Accept", "Origin", "X-Requested-With")
-        .methods("GET"_method, "POST"_method, "OPTIONS"_method)
+        .methods("GET"_method, "POST"_method, "DELETE"_method, "OPTIONS"_method)
         .allow_credentials();
 
     if (config_.allowedOrigins.empty()) {
@@ -73,35 +96,24 @@ void APIHandler::setupRoutes(crow::App<crow::CORSHandler>& app) {
     CROW_ROUTE(app, "/iotgateway/read")
     .methods("GET"_method)
     ([this](const crow::request& req) {
-        auto startTime = std::chrono::high_resolution_clock::now();
-
-        // Authenticate request
-        AuthResult authResult = authenticateRequest(req);
-        if (!authResult.success) {
-            authenticationFailures_++;
-            auto response = buildErrorResponse(401, "Unauthorized", authResult.reason);
-
-            auto endTime = std::chrono::high_resolution_clock::now();
-            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime);
-            double responseTimeMs = duration.count() / 1000.0;
-
-            updateStats(false, responseTimeMs);
-            logRequest(req, response, responseTimeMs);
-            return response;
-        }
-
-        // Handle the read request
-        auto response = handleReadRequest(req);
-
-        auto endTime = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime);
-        double responseTimeMs = duration.count() / 1000.0;
+        return serveAuthenticated(req, [this, &req]() { return handleReadRequest(req); });
+    });
 
-        bool success = (response.code >= 200 && response.code < 300);
-        updateStats(success, responseTimeMs);
-        logRequest(req, response, responseTimeMs);
+    // Tag groups: named node lists defined once and read by name
+    CROW_ROUTE(app, "/iotgateway/groups")
+    .methods("GET"_method, "POST"_method)
+    ([this](const crow::request& req) {
+        return serveAuthenticated(req, [this, &req]() {
+            return req.method == "POST"_method ? handleGroupDefineRequest(req) : handleGroupListRequest();
+        });
+    });
 
-        return response;
+    CROW_ROUTE(app, "/iotgateway/group/<string>")
+    .methods("GET"_method, "DELETE"_method)
+    ([this](const crow::request& req, const std::string& name) {
+        return serveAuthenticated(req, [this, &req, &name]() {
+            return req.method == "DELETE"_method ? handleGroupDeleteRequest(name) : handleGroupReadRequest(req, name);
+        });
     });
 
     // Health check endpoint
@@ -116,16 +128,116 @@ void APIHandler::setupRoutes(crow::App<crow::CORSHandler>& app) {
         return handleStatusRequest();
     });
 
+    // Prometheus scrape endpoint; counters only, cheap enough for 1s intervals
+    CROW_ROUTE(app, "/metrics")
+    ([this]() {
+        if (!metricsExporter_) {
+            return buildErrorResponse(404, "Not Found", "Metrics export is not enabled");
+        }
+
+        crow::response response(200);
+        response.set_header("Content-Type", MetricsExporter::CONTENT_TYPE);
+        metricsExporter_->render(response.body);
+        return response;
+    });
+
+    // Lock contention report; DELETE clears it to start a new measurement window
+    // and, since it throws away everyone's data, needs credentials
+    CROW_ROUTE(app, "/debug/locks")
+    .methods("GET"_method, "DELETE"_method)
+    ([this](const crow::request& req) {
+        if (!lockProfiler_) {
+            return buildErrorResponse(404, "Not Found", "Lock profiling is not enabled (LOCK_PROFILING_ENABLED)");
+        }
+
+        if (req.method == "DELETE"_method) {
+            return serveAuthenticated(req, [this]() {
+                lockProfiler_->reset();
+                return buildJSONResponse({{"reset", true}});
+            });
+        }
+
+        size_t top = LockProfiler::DEFAULT_TOP_CALL_SITES;
+        if (const char* topParam = req.url_params.get("top")) {
+            top = static_cast<size_t>(std::clamp(std::atoi(topParam), 1, static_cast<int>(LockProfiler::CALL_SITE_SLOTS)));
+        }
+        return buildJSONResponse(lockProfiler_->toJSON(top));
+    });
+
+    // Heap allocations per request stage and subsystem; DELETE clears the totals
+    // (authenticated, like /debug/locks)
+    CROW_ROUTE(app, "/debug/alloc")
+    .methods("GET"_method, "DELETE"_method)
+    ([this](const crow::request& req) {
+        if (!AllocationTracker::isEnabled()) {
+            return buildErrorResponse(404, "Not Found",
+                "Allocation tracking is not built in (ENABLE_ALLOCATION_TRACKING)");
+        }
+
+        if (req.method == "DELETE"_method) {
+            return serveAuthenticated(req, [this]() {
+                AllocationTracker::reset();
+                return buildJSONResponse({{"reset", true}});
+            });
+        }
+        return buildJSONResponse(AllocationTracker::toJSON());
+    });
+
 
 
     std::cout << "API routes configured successfully" << std::endl;
 }
 
+crow::response APIHandler::serveAuthenticated(const crow::request& req,
+                                              const std::function<crow::response()>& handler) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    // Stage timers further down the read path add to this request's timing
+    RequestTiming timing;
+    RequestTiming::Scope timingScope(&timing);
+
+    // Authenticate request
+    AuthResult authResult{};
+    {
+        RequestTiming::StageTimer authTimer(RequestTiming::Stage::AUTH);
+        authResult = authenticateRequest(req);
+    }
+    if (!authResult.success) {
+        authenticationFailures_++;
+        auto response = authResult.rateLimited
+            ? buildErrorResponse(429, "Too Many Requests", authResult.reason)
+            : buildErrorResponse(401, "Unauthorized", authResult.reason);
+        addServerTiming(req, response, timing);
+
+        auto endTime = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime);
+        double responseTimeMs = duration.count() / 1000.0;
+
+        updateStats(false, responseTimeMs);
+        logRequest(req, response, responseTimeMs);
+        return response;
+    }
+
+    auto response = handler();
+    addServerTiming(req, response, timing);
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime);
+    double responseTimeMs = duration.count() / 1000.0;
+
+    bool success = (response.code >= 200 && response.code < 300);
+    updateStats(success, responseTimeMs);
+    logRequest(req, response, responseTimeMs);
+
+    return response;
+}
+
 crow::response APIHandler::handleReadRequest(const crow::request& req) {
     totalRequests_++;
 
     try {
         // Note: We'll do parameter validation inline to provide specific error messages
+        std::optional<RequestTiming::StageTimer> parseTimer(std::in_place, RequestTiming::Stage::PARSE);
 
         // Extract node IDs from query parameter
         const char* idsParamPtr = req.url_params.get("ids");
@@ -147,6 +259,13 @@ crow::response APIHandler::handleReadRequest(const crow::request& req) {
             return buildErrorResponse(400, "Bad Request", "No valid node IDs provided");
         }
 
+        // Traced before validation so a replay sees the same mix, bad IDs included
+        if (traceRecorder_) {
+            auto now = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::system_clock::now().time_since_epoch());
+            traceRecorder_->record(static_cast<uint64_t>(now.count()), getClientIP(req), nodeIds);
+        }
+
         // Validate node IDs
         for (const auto& nodeId : nodeIds) {
             if (!validateNodeId(nodeId)) {
@@ -155,15 +274,47 @@ crow::response APIHandler::handleReadRequest(const crow::request& req) {
                     "Invalid node ID format: " + nodeId);
             }
         }
+        parseTimer.reset();
+
+        // Timing figures make each body unique, so those reads always go the long way
+        if (responseCache_.isEnabled() && !isTimingDebugRequested(req)) {
+            auto startTime = std::chrono::steady_clock::now();
+            auto source = ResponseCache::Source::BUILT;
+            auto cached = responseCache_.getOrBuild(nodeIds, [this, &nodeIds]() {
+                return buildCachedReadResponse(nodeIds);
+            }, &source);
+
+            // Only the build went through processNodeRequests(). A stored body was
+            // validated as all FRESH; a shared build is counted by the paths it took.
+            if (source != ResponseCache::Source::BUILT) {
+                if (source == ResponseCache::Source::STORED) {
+                    readStrategy_->recordFreshResponse(cached->nodeIds, startTime);
+                } else {
+                    readStrategy_->recordSharedResponse(cached->nodeIds.size(), cached->paths, startTime);
+                }
+                cacheHits_ += cached->nodeIds.size() - cached->failures;
+                cacheMisses_ += cached->failures;
+            }
+            successfulRequests_++;
+            return buildRawJSONResponse(cached->body);
+        }
 
         // Process the requests
         std::vector<ReadResult> results = processNodeRequests(nodeIds);
 
         // Build response
-        nlohmann::json responseData = buildReadResponse(results);
+        RequestTiming::StageTimer serializeTimer(RequestTiming::Stage::SERIALIZE);
+        nlohmann::json extraFields;
+
+        // Taken before the body is built, so serialize_ms here leaves out writing the
+        // body; the Server-Timing header added afterwards has the full figure
+        auto* timing = RequestTiming::current();
+        if (timing && isTimingDebugRequested(req)) {
+            extraFields["timing"] = timing->toJSON();
+        }
 
         successfulRequests_++;
-        return buildJSONResponse(responseData);
+        return buildRawJSONResponse(buildReadResponseBody(results, extraFields));
 
     } catch (const std::exception& e) {
         failedRequests_++;
@@ -193,6 +344,108 @@ crow::response APIHandler::handleReadRequest(const crow::request& req) {
     }
 }
 
+crow::response APIHandler::handleGroupReadRequest(const crow::request& req, const std::string& name) {
+    totalRequests_++;
+
+    try {
+        auto group = tagGroups_.find(name);
+        if (!group) {
+            validationErrors_++;
+            return buildErrorResponse(404, "Not Found", "Unknown tag group: " + name);
+        }
+
+        // Members were validated when the group was defined; nothing to parse here
+        std::vector<ReadResult> results = readStrategy_->processGroupRequest(*group);
+
+        RequestTiming::StageTimer serializeTimer(RequestTiming::Stage::SERIALIZE);
+        nlohmann::json extraFields;
+        extraFields["group"] = group->getName();
+
+        auto* timing = RequestTiming::current();
+        if (timing && isTimingDebugRequested(req)) {
+            extraFields["timing"] = timing->toJSON();
+        }
+
+        successfulRequests_++;
+        return buildRawJSONResponse(buildReadResponseBody(results, extraFields));
+
+    } catch (const std::exception& e) {
+        failedRequests_++;
+        std::cerr << "Error handling tag group read for " << name << ": " << e.what() << std::endl;
+        return buildErrorResponse(500, "Internal Server Error", e.what());
+    }
+}
+
+crow::response APIHandler::handleGroupDefineRequest(const crow::request& req) {
+    totalRequests_++;
+
+    nlohmann::json body = nlohmann::json::parse(req.body, nullptr, false);
+    if (body.is_discarded() || !body.is_object() ||
+        !body.contains("name") || !body["name"].is_string() ||
+        !body.contains("ids") || !body["ids"].is_array()) {
+        validationErrors_++;
+        return buildErrorResponse(400, "Bad Request",
+            "Expected a JSON body {\"name\": \"...\", \"ids\": [\"ns=2;s=...\", ...]}");
+    }
+
+    std::vector<std::string> nodeIds;
+    nodeIds.reserve(body["ids"].size());
+    for (const auto& id : body["ids"]) {
+        if (!id.is_string()) {
+            validationErrors_++;
+            return buildErrorResponse(400, "Bad Request", "Node IDs must be strings");
+        }
+        nodeIds.push_back(trim(id.get<std::string>()));
+    }
+
+    try {
+        auto group = defineTagGroup(body["name"].get<std::string>(), nodeIds);
+
+        successfulRequests_++;
+        return buildJSONResponse({
+            {"name", group->getName()},
+            {"size", group->size()}
+        }, 201);
+
+    } catch (const std::invalid_argument& e) {
+        validationErrors_++;
+        return buildErrorResponse(400, "Bad Request", e.what());
+    }
+}
+
+crow::response APIHandler::handleGroupListRequest() {
+    totalRequests_++;
+
+    nlohmann::json groups = nlohmann::json::array();
+    for (const auto& group : tagGroups_.list()) {
+        groups.push_back({
+            {"name", group->getName()},
+            {"size", group->size()},
+            {"ids", group->getNodeIds()}
+        });
+    }
+
+    successfulRequests_++;
+    return buildJSONResponse({
+        {"groups", groups},
+        {"max_groups", tagGroups_.getMaxGroups()},
+        {"max_group_size", tagGroups_.getMaxGroupSize()}
+    });
+}
+
+crow::response APIHandler::handleGroupDeleteRequest(const std::string& name) {
+    totalRequests_++;
+
+    if (!tagGroups_.remove(name)) {
+        validationErrors_++;
+        return buildErrorResponse(404, "Not Found", "Unknown tag group: " + name);
+    }
+
+    std::cout << "Tag group '" << name << "' removed" << std::endl;
+    successfulRequests_++;
+    return buildJSONResponse({{"removed", name}});
+}
+
 crow::response APIHandler::handleHealthRequest() {
     try {
         // Perform actual health check
@@ -221,6 +474,16 @@ crow::response APIHandler::handleHealthRequest() {
             };
         }
 
+        // Reads fail fast while the circuit breaker is open
+        health["circuit_breaker"] = buildCircuitBreakerStatus();
+        if (opcClient_->getCircuitBreaker().getState() != CircuitBreaker::State::CLOSED) {
+            health["status"] = "degraded";
+            if (!health.contains("warnings")) {
+                health["warnings"] = nlohmann::json::array();
+            }
+            health["warnings"].push_back("OPC UA circuit breaker is not closed; reads are served from cache");
+        }
+
         // Add enhanced cache metrics if available
         if (cacheMetrics_) {
             auto cacheStats = cacheMetrics_->getStatistics();
@@ -272,7 +535,7 @@ crow::response APIHandler::handleStatusRequest() {
             {"opc_ua", {
                 {"connected", opcClient_->isConnected()},
                 {"healthy", opcClient_->performHealthCheck()},
-                {"endpoint", config_.opcEndpoint},
+                {"endpoint", opcClient_->getEndpoint()},
                 {"connection_state", static_cast<int>(opcClient_->getConnectionState())},
                 {"connection_info", opcClient_->getConnectionInfo()},
                 {"last_error", opcClient_->getLastError()}
@@ -292,10 +555,67 @@ crow::response APIHandler::handleStatusRequest() {
                 {"validation_errors", stats.validationErrors},
                 {"cache_hits", stats.cacheHits},
                 {"cache_misses", stats.cacheMisses},
-                {"average_response_time_ms", stats.averageResponseTimeMs}
+                {"average_response_time_ms", stats.averageResponseTimeMs},
+                {"response_time", stats.responseTime.toJSON()}
             }}
         };
 
+        // Add OPC read budget utilization
+        auto budgetStats = opcClient_->getReadBudget().getStats();
+        status["read_budget"] = {
+            {"enabled", opcClient_->getReadBudget().isEnabled()},
+            {"nodes_per_second", budgetStats.nodesPerSecond},
+            {"requests_per_second", budgetStats.requestsPerSecond},
+            {"synchronous_reserve", budgetStats.synchronousReserve},
+            {"node_utilization", budgetStats.nodeUtilization},
+            {"request_utilization", budgetStats.requestUtilization},
+            {"granted_requests", budgetStats.grantedRequests},
+            {"granted_nodes", budgetStats.grantedNodes},
+            {"rejected_requests", budgetStats.rejectedRequests},
+            {"rejected_nodes", budgetStats.rejectedNodes},
+            {"rejected_synchronous", budgetStats.rejectedSynchronous},
+            {"rejected_background", budgetStats.rejectedBackground},
+            {"rejected_retries", budgetStats.rejectedRetries}
+        };
+
+        auto responseCacheStats = responseCache_.getStats();
+        status["response_cache"] = {
+            {"enabled", responseCache_.isEnabled()},
+            {"hits", responseCacheStats.hits},
+            {"builds", responseCacheStats.builds},
+            {"shared_builds", responseCacheStats.sharedBuilds},
+            {"invalidated", responseCacheStats.invalidated},
+            {"evictions", responseCacheStats.evictions},
+            {"entries", responseCacheStats.entries}
+        };
+
+        auto limiterStats = rateLimiter_.getStats();
+        status["rate_limiter"] = {
+            {"requests_per_second", rateLimiter_.getSettings().requestsPerSecond},
+            {"allowed", limiterStats.allowed},
+            {"rate_limited", limiterStats.rateLimited},
+            {"blocked_requests", limiterStats.blockedRequests},
+            {"blocks", limiterStats.blocks},
+            {"evictions", limiterStats.evictions},
+            {"tracked_clients", limiterStats.trackedClients}
+        };
+
+        status["circuit_breaker"] = buildCircuitBreakerStatus();
+
+        // Add redundancy state when backup endpoints are configured
+        if (!config_.opcBackupEndpoints.empty()) {
+            auto failoverStats = opcClient_->getFailoverStats();
+            status["failover"] = {
+                {"failovers", failoverStats.failovers},
+                {"active_endpoint", failoverStats.activeEndpoint},
+                {"standby_endpoint", failoverStats.standbyEndpoint},
+                {"standby_ready", failoverStats.standbyReady},
+                {"active_service_level", failoverStats.activeServiceLevel},
+                {"standby_service_level", failoverStats.standbyServiceLevel},
+                {"last_switch_ms", failoverStats.lastSwitchDuration.count()}
+            };
+        }
+
         // Add enhanced cache metrics if available
         if (cacheMetrics_) {
             status["cache_metrics"] = cacheMetrics_->getMetricsJSON(true);
@@ -312,6 +632,11 @@ crow::response APIHandler::handleStatusRequest() {
                 {"retry_attempts", errorStats.retryAttempts},
                 {"successful_retries", errorStats.successfulRetries},
                 {"failed_retries", errorStats.failedRetries},
+                {"budget_exhausted", errorStats.budgetExhausted},
+                {"circuit_open", errorStats.circuitOpen},
+                {"retries_scheduled", errorStats.retriesScheduled},
+                {"retries_coalesced", errorStats.retriesCoalesced},
+                {"pending_retries", errorStats.pendingRetries},
                 {"error_rate_per_minute", errorStats.errorRate},
                 {"error_rate_threshold", errorHandler_->getErrorRateThreshold()},
                 {"error_rate_exceeded", errorHandler_->isErrorRateExceeded()},
@@ -328,6 +653,88 @@ crow::response APIHandler::handleStatusRequest() {
             }
         }
 
+        // Add hot-path timings if available
+        if (performanceMonitor_) {
+            auto perf = performanceMonitor_->getMetrics();
+            auto lockJSON = [](const PerformanceMonitor::LockMetrics& lock) {
+                return nlohmann::json{
+                    {"acquisitions", lock.acquisitions},
+                    {"contentions", lock.contentions},
+                    {"contention_ratio", lock.contentionRatio},
+                    {"average_wait_ms", lock.avgWaitTime}
+                };
+            };
+            // OPC read percentiles keyed by batch size range
+            nlohmann::json opcLatency = nlohmann::json::object();
+            for (const auto& batch : performanceMonitor_->getOpcReadLatencies()) {
+                opcLatency[batch.label] = batch.latency.toJSON();
+            }
+            status["performance"] = {
+                {"enabled", performanceMonitor_->isEnabled()},
+                {"operations", {
+                    {"cache_reads", perf.cacheReads},
+                    {"cache_writes", perf.cacheWrites},
+                    {"opc_reads", perf.opcReads},
+                    {"opc_batch_reads", perf.opcBatchReads},
+                    {"background_updates", perf.backgroundUpdates},
+                    {"operations_per_second", perf.operationsPerSecond}
+                }},
+                {"timing", {
+                    {"cache_read_ms", perf.avgCacheReadTime},
+                    {"cache_write_ms", perf.avgCacheWriteTime},
+                    {"opc_read_ms", perf.avgOPCReadTime},
+                    {"opc_batch_read_ms", perf.avgBatchReadTime},
+                    {"background_update_ms", perf.avgBackgroundUpdateTime}
+                }},
+                {"locks", {
+                    {"cache_mutex", lockJSON(perf.cacheLock)},
+                    {"client_mutex", lockJSON(perf.clientLock)}
+                }},
+                {"opc_read_latency", opcLatency},
+                {"is_performance_good", perf.isPerformanceGood},
+                {"recommendations", perf.recommendations}
+            };
+        }
+
+        // Add periodic task accounting if available
+        if (timerService_) {
+            auto timerStats = timerService_->getStats();
+            nlohmann::json tasks = nlohmann::json::object();
+            for (const auto& task : timerService_->getTaskStats()) {
+                tasks[task.name] = {
+                    {"interval_ms", task.interval.count()},
+                    {"runs", task.runs},
+                    {"average_run_ms", task.getAverageRunTimeMs()},
+                    {"max_run_ms", task.maxRunTime.count() / 1000.0},
+                    {"last_run_ms", task.lastRunTime.count() / 1000.0},
+                    {"max_lateness_ms", task.maxLateness.count() / 1000.0},
+                    {"overruns", task.overruns},
+                    {"missed_periods", task.missedPeriods},
+                    {"failures", task.failures}
+                };
+            }
+            status["timers"] = {
+                {"running", timerService_->isRunning()},
+                {"wakeups", timerStats.wakeups},
+                {"idle_wakeups", timerStats.idleWakeups},
+                {"coalesced_runs", timerStats.coalescedRuns},
+                {"tasks", tasks}
+            };
+        }
+
+        // Add request trace accounting if recording
+        if (traceRecorder_) {
+            auto traceStats = traceRecorder_->getStats();
+            status["request_trace"] = {
+                {"file", traceRecorder_->getPath()},
+                {"recording", traceRecorder_->isRunning()},
+                {"recorded", traceStats.recorded},
+                {"dropped", traceStats.dropped},
+                {"bytes_written", traceStats.bytesWritten},
+                {"write_errors", traceStats.writeErrors}
+            };
+        }
+
         return buildJSONResponse(status);
 
     } catch (const std::exception& e) {
@@ -339,14 +746,14 @@ crow::response APIHandler::handleStatusRequest() {
 APIHandler::AuthResult APIHandler::authenticateRequest(const crow::request& req) {
     std::string clientIP = getClientIP(req);
 
-    // Check rate limiting first
-    if (!checkRateLimit(clientIP)) {
-        return AuthResult::createFailure("Rate limit exceeded");
-    }
-
-    // Check if IP is blocked due to too many failed attempts
-    if (isIPBlocked(clientIP)) {
-        return AuthResult::createFailure("IP temporarily blocked");
+    // Rate limit and failed-attempt block, in one lookup
+    switch (rateLimiter_.check(clientIP)) {
+        case RateLimiter::Decision::ALLOWED:
+            break;
+        case RateLimiter::Decision::RATE_LIMITED:
+            return AuthResult::createRateLimited("Rate limit exceeded");
+        case RateLimiter::Decision::BLOCKED:
+            return AuthResult::createFailure("IP temporarily blocked");
     }
 
     // If no authentication is configured, allow all requests
@@ -358,7 +765,7 @@ APIHandler::AuthResult APIHandler::authenticateRequest(const crow::request& req)
 
     // Try API Key authentication first
     if (!config_.apiKey.empty()) {
-        std::string apiKey = extractAPIKey(req);
+        const std::string& apiKey = extractAPIKey(req);
         if (!apiKey.empty()) {
             authAttempted = true;
             if (validateAPIKey(apiKey)) {
@@ -372,7 +779,7 @@ APIHandler::AuthResult APIHandler::authenticateRequest(const crow::request& req)
 
     // Try Basic Authentication
     if (!config_.authUsername.empty() && !config_.authPassword.empty()) {
-        std::string authHeader = extractAuthHeader(req);
+        const std::string& authHeader = extractAuthHeader(req);
         if (!authHeader.empty()) {
             authAttempted = true;
             if (validateBasicAuth(authHeader)) {
@@ -427,6 +834,85 @@ nlohmann::json APIHandler::buildReadResponse(const std::vector<ReadResult>& resu
     return response;
 }
 
+std::shared_ptr<const ResponseCache::Response> APIHandler::buildCachedReadResponse(
+    const std::vector<std::string>& nodeIds) {
+    // The paths are kept for requests that wait on this build; without a request
+    // timing to count into, a local one collects them
+    std::optional<RequestTiming> localTiming;
+    std::optional<RequestTiming::Scope> localScope;
+    if (!RequestTiming::current()) {
+        localTiming.emplace();
+        localScope.emplace(&*localTiming);
+    }
+    RequestTiming::NodeCounts before = RequestTiming::current()->nodes();
+
+    std::vector<ReadResult> results = processNodeRequests(nodeIds);
+
+    RequestTiming::StageTimer serializeTimer(RequestTiming::Stage::SERIALIZE);
+    auto response = std::make_shared<ResponseCache::Response>();
+    const auto& after = RequestTiming::current()->nodes();
+    response->paths.fresh = after.fresh - before.fresh;
+    response->paths.stale = after.stale - before.stale;
+    response->paths.expired = after.expired - before.expired;
+    response->paths.miss = after.miss - before.miss;
+    response->paths.fallback = after.fallback - before.fallback;
+    response->body = buildReadResponseBody(results);
+    response->nodeIds.reserve(results.size());
+    response->versions.reserve(results.size());
+    for (auto& result : results) {
+        if (!result.success) {
+            response->failures++;
+        }
+        response->nodeIds.push_back(std::move(result.id));
+        response->versions.push_back(std::move(result.json));
+    }
+    return response;
+}
+
+std::string APIHandler::buildReadResponseBody(const std::vector<ReadResult>& results,
+                                              const nlohmann::json& extraFields) {
+    static const std::string READ_RESULTS_KEY = "readResults";
+
+    size_t expectedSize = 32;
+    for (const auto& result : results) {
+        expectedSize += (result.json ? result.json->size() : 160) + 1;
+    }
+    std::string body;
+    body.reserve(expectedSize);
+
+    auto appendField = [&body](const std::string& key, const nlohmann::json& value) {
+        body += nlohmann::json(key).dump();
+        body += ':';
+        body += value.dump();
+    };
+
+    // dump() writes object keys in sorted order; keep that order so the text is
+    // the same as the nlohmann-built response
+    body += '{';
+    auto extra = extraFields.begin();
+    for (; extra != extraFields.end() && extra.key() < READ_RESULTS_KEY; ++extra) {
+        appendField(extra.key(), extra.value());
+        body += ',';
+    }
+
+    body += "\"readResults\":[";
+    for (size_t i = 0; i < results.size(); ++i) {
+        if (i > 0) {
+            body += ',';
+        }
+        results[i].appendJson(body);
+    }
+    body += ']';
+
+    for (; extra != extraFields.end(); ++extra) {
+        body += ',';
+        appendField(extra.key(), extra.value());
+    }
+    body += '}';
+
+    return body;
+}
+
 crow::response APIHandler::buildErrorResponse(int statusCode,
                                             const std::string& message,
                                             const std::string& details) {
@@ -479,10 +965,26 @@ crow::response APIHandler::buildErrorResponse(int statusCode,
     return response;
 }
 
+bool APIHandler::isTimingDebugRequested(const crow::request& req) {
+    const char* debug = req.url_params.get("debug");
+    return debug != nullptr && std::strcmp(debug, "timing") == 0;
+}
+
+void APIHandler::addServerTiming(const crow::request& req, crow::response& response,
+                                 const RequestTiming& timing) const {
+    if (config_.serverTimingEnabled || isTimingDebugRequested(req)) {
+        response.add_header("Server-Timing", timing.toServerTimingHeader());
+    }
+}
+
 crow::response APIHandler::buildJSONResponse(const nlohmann::json& data, int statusCode) {
+    return buildRawJSONResponse(data.dump(), statusCode);
+}
+
+crow::response APIHandler::buildRawJSONResponse(std::string body, int statusCode) {
     crow::response response(statusCode);
     response.add_header("Content-Type", "application/json; charset=utf-8");
-    response.write(data.dump());
+    response.body = std::move(body);
 
     // Add security headers
     response.add_header("X-Content-Type-Options", "nosniff");
@@ -559,69 +1061,21 @@ ReadResult APIHandler::processNodeRequest(const std::string& nodeId) {
 }
 
 bool APIHandler::validateAPIKey(const std::string& apiKey) {
-    return !config_.apiKey.empty() && apiKey == config_.apiKey;
+    return credentials_.verifyAPIKey(apiKey);
 }
 
 bool APIHandler::validateBasicAuth(const std::string& authHeader) {
-    if (config_.authUsername.empty() || config_.authPassword.empty()) {
-        return false;
-    }
-
-    // Check if it starts with "Basic "
-    const std::string basicPrefix = "Basic ";
-    if (authHeader.length() <= basicPrefix.length() ||
-        authHeader.substr(0, basicPrefix.length()) != basicPrefix) {
-        return false;
-    }
-
-    // Extract and decode the credentials
-    std::string encoded = authHeader.substr(basicPrefix.length());
-    std::string decoded = decodeBase64(encoded);
-
-    // Find the colon separator
-    size_t colonPos = decoded.find(':');
-    if (colonPos == std::string::npos) {
-        return false;
-    }
-
-    std::string username = decoded.substr(0, colonPos);
-    std::string password = decoded.substr(colonPos + 1);
-
-    return username == config_.authUsername && password == config_.authPassword;
+    return credentials_.verifyAuthorizationHeader(authHeader);
 }
 
-std::string APIHandler::extractAPIKey(const crow::request& req) {
+const std::string& APIHandler::extractAPIKey(const crow::request& req) {
     return req.get_header_value("X-API-Key");
 }
 
-std::string APIHandler::extractAuthHeader(const crow::request& req) {
+const std::string& APIHandler::extractAuthHeader(const crow::request& req) {
     return req.get_header_value("Authorization");
 }
 
-std::string APIHandler::decodeBase64(const std::string& encoded) {
-    // Simple Base64 decoder implementation
-    // Note: In production, you'd want to use a more robust implementation
-    const std::string chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-    std::string decoded;
-
-    int val = 0, valb = -8;
-    for (unsigned char c : encoded) {
-        if (c == '=') break;
-
-        auto pos = chars.find(c);
-        if (pos == std::string::npos) continue;
-
-        val = (val << 6) + static_cast<int>(pos);
-        valb += 6;
-        if (valb >= 0) {
-            decoded.push_back(char((val >> valb) & 0xFF));
-            valb -= 8;
-        }
-    }
-
-    return decoded;
-}
-
 bool APIHandler::validateRequest(const crow::request& req) {
     // Check if it's a GET request
     if (req.method != crow::HTTPMethod::Get) {
@@ -671,10 +1125,7 @@ void APIHandler::updateStats(bool success, double responseTimeMs, bool /* cacheH
         failedRequests_++;
     }
 
-    // Update average response time using exponential moving average
-    double currentAvg = averageResponseTimeMs_.load();
-    double newAvg = currentAvg == 0.0 ? responseTimeMs : (currentAvg * 0.9 + responseTimeMs * 0.1);
-    averageResponseTimeMs_.store(newAvg);
+    requestLatency_.recordMs(responseTimeMs);
 
     lastRequest_.store(std::chrono::steady_clock::now());
 }
@@ -703,25 +1154,27 @@ void APIHandler::logRequest(const crow::request& req, const crow::response& resp
 }
 
 std::string APIHandler::getClientIP(const crow::request& req) {
-    // Try to get real IP from headers (in case of proxy)
-    std::string xForwardedFor = req.get_header_value("X-Forwarded-For");
-    if (!xForwardedFor.empty()) {
-        // Take the first IP in the list
-        size_t commaPos = xForwardedFor.find(',');
-        return commaPos != std::string::npos ?
-               trim(xForwardedFor.substr(0, commaPos)) : trim(xForwardedFor);
-    }
+    // Forwarding headers are set by the client unless a trusted proxy rewrites them
+    if (config_.trustProxyHeaders) {
+        std::string xForwardedFor = req.get_header_value("X-Forwarded-For");
+        if (!xForwardedFor.empty()) {
+            // Take the first IP in the list
+            size_t commaPos = xForwardedFor.find(',');
+            return commaPos != std::string::npos ?
+                   trim(xForwardedFor.substr(0, commaPos)) : trim(xForwardedFor);
+        }
 
-    std::string xRealIP = req.get_header_value("X-Real-IP");
-    if (!xRealIP.empty()) {
-        return trim(xRealIP);
+        std::string xRealIP = req.get_header_value("X-Real-IP");
+        if (!xRealIP.empty()) {
+            return trim(xRealIP);
+        }
     }
 
-    // Fall back to remote address (may not be available in all Crow versions)
-    return "unknown";
+    return req.remote_ip_address.empty() ? "unknown" : req.remote_ip_address;
 }
 
 APIHandler::RequestStats APIHandler::getStats() const {
+    auto responseTime = requestLatency_.snapshot();
     return RequestStats{
         totalRequests_.load(),
         successfulRequests_.load(),
@@ -732,7 +1185,8 @@ APIHandler::RequestStats APIHandler::getStats() const {
         cacheMisses_.load(),
         startTime_,
         lastRequest_.load(),
-        averageResponseTimeMs_.load()
+        responseTime.meanMs(),
+        responseTime
     };
 }
 
@@ -744,10 +1198,34 @@ void APIHandler::resetStats() {
     validationErrors_.store(0);
     cacheHits_.store(0);
     cacheMisses_.store(0);
-    averageResponseTimeMs_.store(0.0);
+    requestLatency_.reset();
     startTime_ = std::chrono::steady_clock::now();
 }
 
+void APIHandler::setTimerService(const TimerService* timerService) {
+    timerService_ = timerService;
+}
+
+void APIHandler::setPerformanceMonitor(const PerformanceMonitor* performanceMonitor) {
+    performanceMonitor_ = performanceMonitor;
+}
+
+void APIHandler::setMetricsExporter(MetricsExporter* metricsExporter) {
+    metricsExporter_ = metricsExporter;
+}
+
+void APIHandler::setRequestTraceRecorder(RequestTraceRecorder* recorder) {
+    traceRecorder_ = recorder;
+}
+
+void APIHandler::setLockProfiler(LockProfiler* profiler) {
+    lockProfiler_ = profiler;
+}
+
+const LatencyHistogram& APIHandler::getRequestLatency() const {
+    return requestLatency_;
+}
+
 void APIHandler::setDetailedLoggingEnabled(bool enabled) {
     detailedLoggingEnabled_.store(enabled);
 }
@@ -811,76 +1289,21 @@ bool APIHandler::isEmptyOrWhitespace(const std::string& str) {
     return str.empty() || str.find_first_not_of(" \t\r\n") == std::string::npos;
 }
 
-bool APIHandler::checkRateLimit(const std::string& clientIP) {
-    std::lock_guard<std::mutex> lock(rateLimitMutex_);
-
-    auto now = std::chrono::steady_clock::now();
-    auto& info = rateLimitMap_[clientIP];
-
-    // Allow up to 60 requests per minute per IP
-    const auto timeWindow = std::chrono::minutes(1);
-    const int maxRequests = 60;
-
-    // Reset counter if time window has passed
-    if (now - info.lastAttempt > timeWindow) {
-        info.failedAttempts = 0;
-        info.lastAttempt = now;
-        return true;
-    }
-
-    // Check if we're within the rate limit
-    if (info.failedAttempts < maxRequests) {
-        info.lastAttempt = now;
-        return true;
-    }
-
-    return false;
-}
-
-void APIHandler::recordFailedAuth(const std::string& clientIP) {
-    std::lock_guard<std::mutex> lock(rateLimitMutex_);
-
-    auto now = std::chrono::steady_clock::now();
-    auto& info = rateLimitMap_[clientIP];
-
-    info.failedAttempts++;
-    info.lastAttempt = now;
-
-    // Block IP for 15 minutes after 5 failed attempts
-    const int maxFailedAttempts = 5;
-    const auto blockDuration = std::chrono::minutes(15);
-
-    if (info.failedAttempts >= maxFailedAttempts) {
-        info.blockUntil = now + blockDuration;
-
-        if (detailedLoggingEnabled_) {
-            std::cout << "IP " << clientIP << " blocked for "
-                      << std::chrono::duration_cast<std::chrono::minutes>(blockDuration).count()
-                      << " minutes due to " << info.failedAttempts << " failed attempts" << std::endl;
+std::shared_ptr<const TagGroup> APIHandler::defineTagGroup(const std::string& name,
+                                                          const std::vector<std::string>& nodeIds) {
+    for (const auto& nodeId : nodeIds) {
+        if (!validateNodeId(nodeId)) {
+            throw std::invalid_argument("Invalid node ID format in group '" + name + "': " + nodeId);
         }
     }
+    return tagGroups_.define(name, nodeIds);
 }
 
-bool APIHandler::isIPBlocked(const std::string& clientIP) {
-    std::lock_guard<std::mutex> lock(rateLimitMutex_);
-
-    auto it = rateLimitMap_.find(clientIP);
-    if (it == rateLimitMap_.end()) {
-        return false;
-    }
-
-    auto now = std::chrono::steady_clock::now();
-    if (now < it->second.blockUntil) {
-        return true;
-    }
-
-    // Block period has expired, reset failed attempts
-    if (now >= it->second.blockUntil && it->second.failedAttempts > 0) {
-        it->second.failedAttempts = 0;
-        it->second.blockUntil = std::chrono::steady_clock::time_point{};
+void APIHandler::recordFailedAuth(const std::string& clientIP) {
+    if (rateLimiter_.recordFailure(clientIP) && detailedLoggingEnabled_) {
+        std::cout << "IP " << clientIP << " blocked for " << config_.authBlockSeconds
+                  << " seconds due to " << config_.authMaxFailures << " failed attempts" << std::endl;
     }
-
-    return false;
 }
 
 std::string APIHandler::formatTimestamp(uint64_t timestamp) {
@@ -990,6 +1413,23 @@ nlohmann::json APIHandler::buildResponseWithMetadata(const std::vector<ReadResul
     return response;
 }
 
+nlohmann::json APIHandler::buildCircuitBreakerStatus() const {
+    const CircuitBreaker& breaker = opcClient_->getCircuitBreaker();
+    auto stats = breaker.getStats();
+
+    return {
+        {"enabled", breaker.isEnabled()},
+        {"state", CircuitBreaker::stateToString(stats.state)},
+        {"failure_threshold", stats.failureThreshold},
+        {"consecutive_failures", stats.consecutiveFailures},
+        {"trips", stats.trips},
+        {"rejected_reads", stats.rejectedReads},
+        {"probes", stats.probes},
+        {"open_ms", stats.openFor.count()},
+        {"retry_in_ms", stats.retryIn.count()}
+    };
+}
+
 std::string APIHandler::getErrorType(int statusCode) {
     switch (statusCode / 100) {
         case 4:
@@ -1039,8 +1479,8 @@ ReadResult APIHandler::handleOPCConnectionError(const std::string& nodeId) {
             ReadResult result = cachedEntry->toReadResult();
 
             // Modify the result to indicate it's from cache due to connection error
-            result.reason = "Connection Error - Using Cached Data (age: " +
-                          std::to_string(cachedEntry->getAge().count()) + "s)";
+            result.withReason("Connection Error - Using Cached Data (age: " +
+                              std::to_string(cachedEntry->getAge().count()) + "s)");
 
             if (detailedLoggingEnabled_) {
                 std::cout << "OPC connection error for node " << nodeId
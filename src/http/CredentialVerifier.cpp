@@ -0,0 +1,106 @@
+#include "http/CredentialVerifier.h"
+
+#include <cstdint>
+
+namespace opcua2http {
+
+namespace {
+
+constexpr std::string_view BASIC_SCHEME = "Basic";
+
+bool startsWithScheme(std::string_view header) {
+    if (header.size() <= BASIC_SCHEME.size() || header[BASIC_SCHEME.size()] != ' ') {
+        return false;
+    }
+    for (size_t i = 0; i < BASIC_SCHEME.size(); ++i) {
+        char c = header[i];
+        if (c >= 'A' && c <= 'Z') {
+            c = static_cast<char>(c - 'A' + 'a');
+        }
+        char expected = BASIC_SCHEME[i];
+        if (expected >= 'A' && expected <= 'Z') {
+            expected = static_cast<char>(expected - 'A' + 'a');
+        }
+        if (c != expected) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+CredentialVerifier::CredentialVerifier(const std::string& apiKey, const std::string& username,
+                                       const std::string& password)
+    : apiKey_(apiKey) {
+    if (!username.empty() && !password.empty()) {
+        basicCredentials_ = encodeBase64(username + ":" + password);
+    }
+}
+
+bool CredentialVerifier::verifyAPIKey(std::string_view apiKey) const noexcept {
+    return hasAPIKey() && constantTimeEquals(apiKey_, apiKey);
+}
+
+bool CredentialVerifier::verifyAuthorizationHeader(std::string_view header) const noexcept {
+    if (!hasBasicAuth() || !startsWithScheme(header)) {
+        return false;
+    }
+
+    // Tolerate extra spaces between the scheme and the credentials
+    auto credentials = header.substr(BASIC_SCHEME.size());
+    auto start = credentials.find_first_not_of(' ');
+    if (start == std::string_view::npos) {
+        return false;
+    }
+    return constantTimeEquals(basicCredentials_, credentials.substr(start));
+}
+
+bool CredentialVerifier::constantTimeEquals(std::string_view expected, std::string_view actual) noexcept {
+    // Walk the expected value in full whatever the supplied length; bytes past
+    // the end of a short value read as zero and the length mismatch alone
+    // decides the result, so the loop never depends on the supplied content
+    uint8_t difference = expected.size() == actual.size() ? 0 : 1;
+    for (size_t i = 0; i < expected.size(); ++i) {
+        uint8_t supplied = i < actual.size() ? static_cast<uint8_t>(actual[i]) : 0;
+        difference |= static_cast<uint8_t>(expected[i]) ^ supplied;
+    }
+
+    // Keep the compiler from turning the accumulated difference into an early exit
+    volatile uint8_t result = difference;
+    return result == 0 && !expected.empty();
+}
+
+std::string CredentialVerifier::encodeBase64(std::string_view data) {
+    static constexpr char ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    std::string encoded;
+    encoded.reserve((data.size() + 2) / 3 * 4);
+
+    size_t i = 0;
+    for (; i + 2 < data.size(); i += 3) {
+        uint32_t triple = (static_cast<uint8_t>(data[i]) << 16) |
+                          (static_cast<uint8_t>(data[i + 1]) << 8) |
+                          static_cast<uint8_t>(data[i + 2]);
+        encoded.push_back(ALPHABET[(triple >> 18) & 0x3F]);
+        encoded.push_back(ALPHABET[(triple >> 12) & 0x3F]);
+        encoded.push_back(ALPHABET[(triple >> 6) & 0x3F]);
+        encoded.push_back(ALPHABET[triple & 0x3F]);
+    }
+
+    size_t remaining = data.size() - i;
+    if (remaining > 0) {
+        uint32_t triple = static_cast<uint8_t>(data[i]) << 16;
+        if (remaining == 2) {
+            triple |= static_cast<uint8_t>(data[i + 1]) << 8;
+        }
+        encoded.push_back(ALPHABET[(triple >> 18) & 0x3F]);
+        encoded.push_back(ALPHABET[(triple >> 12) & 0x3F]);
+        encoded.push_back(remaining == 2 ? ALPHABET[(triple >> 6) & 0x3F] : '=');
+        encoded.push_back('=');
+    }
+
+    return encoded;
+}
+
+} // namespace opcua2http
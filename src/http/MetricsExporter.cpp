@@ -0,0 +1,272 @@
+#include "http/MetricsExporter.h"
+#include "cache/CacheManager.h"
+#include "cache/CacheMetrics.h"
+#include "cache/PerformanceMonitor.h"
+#include "core/BackgroundUpdater.h"
+#include "core/CacheErrorHandler.h"
+#include "subscription/SubscriptionManager.h"
+#include "reconnection/ReconnectionManager.h"
+#include <spdlog/fmt/fmt.h>
+#include <iterator>
+
+namespace opcua2http {
+
+void MetricsExporter::setCacheManager(const CacheManager* cacheManager) {
+    cacheManager_ = cacheManager;
+}
+
+void MetricsExporter::setCacheMetrics(const CacheMetrics* cacheMetrics) {
+    cacheMetrics_ = cacheMetrics;
+}
+
+void MetricsExporter::setBackgroundUpdater(const BackgroundUpdater* backgroundUpdater) {
+    backgroundUpdater_ = backgroundUpdater;
+}
+
+void MetricsExporter::setSubscriptionManager(const SubscriptionManager* subscriptionManager) {
+    subscriptionManager_ = subscriptionManager;
+}
+
+void MetricsExporter::setReconnectionManager(const ReconnectionManager* reconnectionManager) {
+    reconnectionManager_ = reconnectionManager;
+}
+
+void MetricsExporter::setErrorHandler(const CacheErrorHandler* errorHandler) {
+    errorHandler_ = errorHandler;
+}
+
+void MetricsExporter::setPerformanceMonitor(const PerformanceMonitor* performanceMonitor) {
+    performanceMonitor_ = performanceMonitor;
+}
+
+void MetricsExporter::setRequestLatency(const LatencyHistogram* requestLatency) {
+    requestLatency_ = requestLatency;
+}
+
+void MetricsExporter::render(std::string& out) {
+    std::lock_guard<std::mutex> lock(renderMutex_);
+
+    // clear() keeps the capacity reached by earlier scrapes
+    buffer_.clear();
+
+    auto uptime = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime_);
+    writeGauge("opcua2http_uptime_seconds", "Time since the exporter was created", uptime.count());
+
+    renderCache();
+    renderBackgroundUpdater();
+    renderSubscriptions();
+    renderReconnection();
+    renderErrorHandling();
+    renderLatency();
+
+    out.assign(buffer_);
+    scrapes_.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t MetricsExporter::getScrapeCount() const {
+    return scrapes_.load(std::memory_order_relaxed);
+}
+
+void MetricsExporter::renderCache() {
+    if (!cacheManager_) {
+        return;
+    }
+
+    auto stats = cacheManager_->getCounters();
+    writeGauge("opcua2http_cache_entries", "Cached nodes", static_cast<double>(stats.totalEntries));
+    writeGauge("opcua2http_cache_memory_bytes", "Estimated cache memory usage",
+               static_cast<double>(stats.memoryUsageBytes));
+    writeCounter("opcua2http_cache_hits_total", "Cache lookups that found an entry", stats.totalHits);
+    writeCounter("opcua2http_cache_misses_total", "Cache lookups that found no entry", stats.totalMisses);
+    writeCounter("opcua2http_cache_reads_total", "Cache read operations", stats.totalReads);
+    writeCounter("opcua2http_cache_writes_total", "Cache write operations", stats.totalWrites);
+
+    if (const auto* memoryManager = cacheManager_->getMemoryManager()) {
+        auto memoryStats = memoryManager->getStats();
+        writeCounter("opcua2http_cache_evictions_total", "Entries evicted by the memory manager",
+                     memoryStats.totalEvictions);
+    }
+}
+
+void MetricsExporter::renderBackgroundUpdater() {
+    if (!backgroundUpdater_) {
+        return;
+    }
+
+    auto stats = backgroundUpdater_->getCounters();
+    writeCounter("opcua2http_background_updates_total", "Background updates processed", stats.totalUpdates);
+    writeCounter("opcua2http_background_update_failures_total", "Background updates that failed",
+                 stats.failedUpdates);
+    writeCounter("opcua2http_background_update_duplicates_total", "Update requests merged into a queued update",
+                 stats.duplicateUpdates);
+    writeCounter("opcua2http_background_update_reprioritized_total", "Queued updates moved earlier by demand",
+                 stats.reprioritizedUpdates);
+    writeCounter("opcua2http_background_update_budget_shed_total", "Updates dropped by the OPC read budget",
+                 stats.budgetShedUpdates);
+    writeCounter("opcua2http_background_update_timeouts_total", "Updates abandoned after the update timeout",
+                 stats.timedOutUpdates);
+    writeCounter("opcua2http_refresh_ahead_reads_total", "OPC reads spent on refresh-ahead",
+                 stats.refreshAheadReads);
+    writeGauge("opcua2http_background_update_queue_depth", "Updates waiting in the queue",
+               static_cast<double>(stats.queuedUpdates));
+    writeGauge("opcua2http_background_update_active_workers", "Workers allowed to take updates",
+               static_cast<double>(stats.activeWorkers));
+}
+
+void MetricsExporter::renderSubscriptions() {
+    if (!subscriptionManager_) {
+        return;
+    }
+
+    auto stats = subscriptionManager_->getCounters();
+    writeGauge("opcua2http_subscription_active", "Whether the OPC UA subscription is active",
+               stats.isSubscriptionActive ? 1.0 : 0.0);
+    writeGauge("opcua2http_subscription_monitored_items", "Monitored items on the subscription",
+               static_cast<double>(stats.totalMonitoredItems));
+    writeCounter("opcua2http_subscription_notifications_total", "Data change notifications received",
+                 stats.totalNotifications);
+    writeCounter("opcua2http_subscription_errors_total", "Subscription errors", stats.totalErrors);
+}
+
+void MetricsExporter::renderReconnection() {
+    if (!reconnectionManager_) {
+        return;
+    }
+
+    auto stats = reconnectionManager_->getStats();
+    writeGauge("opcua2http_reconnection_state",
+               "Reconnection state (0 idle, 1 monitoring, 2 reconnecting, 3 recovering subscriptions)",
+               static_cast<double>(static_cast<int>(stats.currentState)));
+    writeCounter("opcua2http_reconnection_attempts_total", "Reconnection attempts",
+                 stats.totalReconnectionAttempts);
+    writeCounter("opcua2http_reconnection_successes_total", "Successful reconnections",
+                 stats.successfulReconnections);
+    writeCounter("opcua2http_reconnection_failures_total", "Failed reconnections", stats.failedReconnections);
+    writeCounter("opcua2http_subscription_recoveries_total", "Subscription recoveries after reconnecting",
+                 stats.successfulSubscriptionRecoveries);
+    writeCounter("opcua2http_downtime_seconds_total", "Accumulated time without a server connection",
+                 stats.totalDowntime.count() / 1000.0);
+    writeGauge("opcua2http_reconnect_latency_seconds", "Drop detection to reconnect, last outage",
+               stats.lastReconnectLatency.count() / 1000.0);
+}
+
+void MetricsExporter::renderErrorHandling() {
+    if (!errorHandler_) {
+        return;
+    }
+
+    auto stats = errorHandler_->getStats();
+    writeCounter("opcua2http_errors_total", "Read errors handled", stats.totalErrors);
+    writeCounter("opcua2http_connection_errors_total", "Read errors caused by the connection",
+                 stats.connectionErrors);
+    writeCounter("opcua2http_cache_fallbacks_total", "Errors answered from cache", stats.cacheHitOnError);
+    writeCounter("opcua2http_cache_fallback_misses_total", "Errors with no cached data to fall back on",
+                 stats.cacheMissOnError);
+    writeCounter("opcua2http_budget_exhausted_total", "Reads shed by the OPC read budget", stats.budgetExhausted);
+    writeCounter("opcua2http_circuit_open_total", "Reads failed fast by the open circuit breaker",
+                 stats.circuitOpen);
+    writeCounter("opcua2http_retries_scheduled_total", "Nodes queued for a background retry",
+                 stats.retriesScheduled);
+    writeCounter("opcua2http_retries_coalesced_total", "Retry requests merged into a queued retry",
+                 stats.retriesCoalesced);
+    writeCounter("opcua2http_retry_successes_total", "Background retries that succeeded",
+                 stats.successfulRetries);
+    writeCounter("opcua2http_retry_failures_total", "Background retries that failed", stats.failedRetries);
+    writeGauge("opcua2http_pending_retries", "Nodes queued or being retried",
+               static_cast<double>(stats.pendingRetries));
+    writeGauge("opcua2http_error_rate_per_minute", "Recent read errors per minute", stats.errorRate);
+}
+
+void MetricsExporter::renderLatency() {
+    if (requestLatency_) {
+        writeHeader("opcua2http_http_request_duration_seconds", "histogram",
+                    "End-to-end latency of /iotgateway/read requests");
+        writeHistogram("opcua2http_http_request_duration_seconds", nullptr, nullptr, requestLatency_->snapshot());
+    }
+
+    if (cacheMetrics_) {
+        static constexpr std::array<std::pair<CacheMetrics::ReadPath, const char*>, CacheMetrics::READ_PATH_COUNT>
+            paths{{
+                {CacheMetrics::ReadPath::FRESH, "fresh"},
+                {CacheMetrics::ReadPath::STALE, "stale"},
+                {CacheMetrics::ReadPath::EXPIRED, "expired"},
+                {CacheMetrics::ReadPath::MISS, "miss"},
+                {CacheMetrics::ReadPath::FALLBACK, "fallback"}
+            }};
+
+        writeHeader("opcua2http_read_path_duration_seconds", "histogram",
+                    "Time a request spent on each cache read path");
+        for (const auto& [path, label] : paths) {
+            writeHistogram("opcua2http_read_path_duration_seconds", "path", label,
+                           cacheMetrics_->getPathLatency(path));
+        }
+    }
+
+    if (performanceMonitor_) {
+        writeHeader("opcua2http_opc_read_duration_seconds", "histogram",
+                    "OPC UA read latency by number of nodes read");
+        for (size_t i = 0; i < PerformanceMonitor::OPC_BATCH_CLASS_COUNT; ++i) {
+            writeHistogram("opcua2http_opc_read_duration_seconds", "batch_size",
+                           PerformanceMonitor::OPC_BATCH_LABELS[i], performanceMonitor_->getOpcReadLatency(i));
+        }
+    }
+}
+
+void MetricsExporter::writeHeader(const char* name, const char* type, const char* help) {
+    fmt::format_to(std::back_inserter(buffer_), "# HELP {} {}\n# TYPE {} {}\n", name, help, name, type);
+}
+
+void MetricsExporter::writeCounter(const char* name, const char* help, uint64_t value) {
+    writeHeader(name, "counter", help);
+    fmt::format_to(std::back_inserter(buffer_), "{} {}\n", name, value);
+}
+
+void MetricsExporter::writeCounter(const char* name, const char* help, double value) {
+    writeHeader(name, "counter", help);
+    fmt::format_to(std::back_inserter(buffer_), "{} {}\n", name, value);
+}
+
+void MetricsExporter::writeGauge(const char* name, const char* help, double value) {
+    writeHeader(name, "gauge", help);
+    fmt::format_to(std::back_inserter(buffer_), "{} {}\n", name, value);
+}
+
+void MetricsExporter::writeHistogram(const char* name, const char* labelName, const char* labelValue,
+                                     const LatencyHistogram::Snapshot& snapshot) {
+    auto out = std::back_inserter(buffer_);
+
+    // Label prefix inside the braces of every bucket line, e.g. path="fresh",
+    auto writeBucket = [&](const char* le, uint64_t cumulative) {
+        if (labelName) {
+            fmt::format_to(out, "{}_bucket{{{}=\"{}\",le=\"{}\"}} {}\n", name, labelName, labelValue, le, cumulative);
+        } else {
+            fmt::format_to(out, "{}_bucket{{le=\"{}\"}} {}\n", name, le, cumulative);
+        }
+    };
+
+    uint64_t cumulative = 0;
+    size_t bucket = 0;
+    for (uint64_t bound : HISTOGRAM_BOUNDS_NS) {
+        while (bucket < LatencyHistogram::BUCKET_COUNT && LatencyHistogram::bucketUpperBound(bucket) <= bound) {
+            cumulative += snapshot.buckets[bucket++];
+        }
+
+        // Format the bound into a stack buffer so no temporary string is built
+        char le[32];
+        auto end = fmt::format_to_n(le, sizeof(le) - 1, "{}", static_cast<double>(bound) / 1e9).out;
+        *end = '\0';
+        writeBucket(le, cumulative);
+    }
+    writeBucket("+Inf", snapshot.count);
+
+    double sum = static_cast<double>(snapshot.totalNanos) / 1e9;
+    if (labelName) {
+        fmt::format_to(out, "{}_sum{{{}=\"{}\"}} {}\n", name, labelName, labelValue, sum);
+        fmt::format_to(out, "{}_count{{{}=\"{}\"}} {}\n", name, labelName, labelValue, snapshot.count);
+    } else {
+        fmt::format_to(out, "{}_sum {}\n", name, sum);
+        fmt::format_to(out, "{}_count {}\n", name, snapshot.count);
+    }
+}
+
+} // namespace opcua2http
@@ -0,0 +1,193 @@
+#include "http/RateLimiter.h"
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+
+namespace opcua2http {
+
+RateLimiter::RateLimiter() {
+    configure(Settings{});
+}
+
+void RateLimiter::configure(const Settings& settings) {
+    settings_ = settings;
+    if (settings_.requestsPerSecond < 0.0) {
+        std::cerr << "RateLimiter: Invalid rate " << settings_.requestsPerSecond << ", using unlimited" << std::endl;
+        settings_.requestsPerSecond = 0.0;
+    }
+    if (settings_.maxClients == 0) {
+        settings_.maxClients = Settings{}.maxClients;
+    }
+
+    // A bucket must hold at least one request, or nothing would ever pass
+    burst_ = settings_.burst > 0.0 ? settings_.burst : settings_.requestsPerSecond;
+    burst_ = std::max(burst_, 1.0);
+    shardCapacity_ = std::max<size_t>(1, (settings_.maxClients + SHARD_COUNT - 1) / SHARD_COUNT);
+
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.entries.clear();
+    }
+}
+
+RateLimiter::Decision RateLimiter::check(const std::string& client, std::chrono::steady_clock::time_point now) {
+    bool limited = settings_.requestsPerSecond > 0.0;
+    if (!limited && settings_.maxFailedAuth <= 0) {
+        allowed_.fetch_add(1, std::memory_order_relaxed);
+        return Decision::ALLOWED;
+    }
+
+    Decision decision = Decision::ALLOWED;
+    {
+        Shard& shard = shardFor(client);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        Entry* entry = nullptr;
+        if (limited) {
+            entry = &entryFor(shard, client, now);
+        } else {
+            // Unlimited rate: only clients that failed authentication are tracked
+            auto it = shard.entries.find(client);
+            entry = it != shard.entries.end() ? &it->second : nullptr;
+        }
+
+        if (entry) {
+            refill(*entry, now);
+            if (now < entry->blockUntil) {
+                decision = Decision::BLOCKED;
+            } else if (limited) {
+                if (entry->tokens >= 1.0) {
+                    entry->tokens -= 1.0;
+                } else {
+                    decision = Decision::RATE_LIMITED;
+                }
+            }
+        }
+    }
+
+    switch (decision) {
+        case Decision::ALLOWED:
+            allowed_.fetch_add(1, std::memory_order_relaxed);
+            break;
+        case Decision::RATE_LIMITED:
+            rateLimited_.fetch_add(1, std::memory_order_relaxed);
+            break;
+        case Decision::BLOCKED:
+            blockedRequests_.fetch_add(1, std::memory_order_relaxed);
+            break;
+    }
+    return decision;
+}
+
+bool RateLimiter::recordFailure(const std::string& client, std::chrono::steady_clock::time_point now) {
+    if (settings_.maxFailedAuth <= 0) {
+        return false;
+    }
+
+    Shard& shard = shardFor(client);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    Entry& entry = entryFor(shard, client, now);
+    refill(entry, now);
+
+    if (now - entry.lastFailure > FAILURE_WINDOW) {
+        entry.failures = 0;
+    }
+    entry.failures++;
+    entry.lastFailure = now;
+
+    if (entry.failures < settings_.maxFailedAuth) {
+        return false;
+    }
+
+    entry.blockUntil = now + settings_.blockDuration;
+    entry.failures = 0;
+    blocks_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+RateLimiter::Stats RateLimiter::getStats() const {
+    Stats stats;
+    stats.allowed = allowed_.load(std::memory_order_relaxed);
+    stats.rateLimited = rateLimited_.load(std::memory_order_relaxed);
+    stats.blockedRequests = blockedRequests_.load(std::memory_order_relaxed);
+    stats.blocks = blocks_.load(std::memory_order_relaxed);
+    stats.evictions = evictions_.load(std::memory_order_relaxed);
+
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        stats.trackedClients += shard.entries.size();
+    }
+    return stats;
+}
+
+RateLimiter::Shard& RateLimiter::shardFor(const std::string& client) {
+    return shards_[std::hash<std::string>{}(client) % SHARD_COUNT];
+}
+
+RateLimiter::Entry& RateLimiter::entryFor(Shard& shard, const std::string& client,
+                                          std::chrono::steady_clock::time_point now) {
+    auto it = shard.entries.find(client);
+    if (it != shard.entries.end()) {
+        return it->second;
+    }
+
+    if (shard.entries.size() >= shardCapacity_) {
+        makeRoom(shard, now);
+    }
+
+    Entry entry;
+    entry.tokens = burst_;
+    entry.lastSeen = now;
+    return shard.entries.emplace(client, entry).first->second;
+}
+
+void RateLimiter::makeRoom(Shard& shard, std::chrono::steady_clock::time_point now) {
+    std::erase_if(shard.entries, [this, now](const auto& item) {
+        return isForgettable(item.second, now);
+    });
+    if (shard.entries.size() < shardCapacity_) {
+        return;
+    }
+
+    // Least recently seen, sparing blocked clients while there is anyone else
+    auto oldest = std::min_element(shard.entries.begin(), shard.entries.end(),
+        [now](const auto& a, const auto& b) {
+            bool aBlocked = now < a.second.blockUntil;
+            bool bBlocked = now < b.second.blockUntil;
+            if (aBlocked != bBlocked) {
+                return bBlocked;
+            }
+            return a.second.lastSeen < b.second.lastSeen;
+        });
+    shard.entries.erase(oldest);
+    evictions_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void RateLimiter::refill(Entry& entry, std::chrono::steady_clock::time_point now) const {
+    if (now <= entry.lastSeen) {
+        return;
+    }
+    if (settings_.requestsPerSecond > 0.0) {
+        double elapsed = std::chrono::duration<double>(now - entry.lastSeen).count();
+        entry.tokens = std::min(burst_, entry.tokens + elapsed * settings_.requestsPerSecond);
+    }
+    entry.lastSeen = now;
+}
+
+bool RateLimiter::isForgettable(const Entry& entry, std::chrono::steady_clock::time_point now) const {
+    if (now < entry.blockUntil) {
+        return false;
+    }
+    if (entry.failures > 0 && now - entry.lastFailure <= FAILURE_WINDOW) {
+        return false;
+    }
+    if (settings_.requestsPerSecond <= 0.0) {
+        return true;
+    }
+    double elapsed = std::chrono::duration<double>(now - entry.lastSeen).count();
+    return entry.tokens + elapsed * settings_.requestsPerSecond >= burst_;
+}
+
+} // namespace opcua2http
@@ -0,0 +1,340 @@
+#include "http/RequestTrace.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <spdlog/spdlog.h>
+
+namespace opcua2http {
+
+namespace {
+
+void putUInt16(std::string& out, uint16_t value) {
+    out.push_back(static_cast<char>(value & 0xFF));
+    out.push_back(static_cast<char>((value >> 8) & 0xFF));
+}
+
+void putUInt32(std::string& out, uint32_t value) {
+    for (int shift = 0; shift < 32; shift += 8) {
+        out.push_back(static_cast<char>((value >> shift) & 0xFF));
+    }
+}
+
+void putUInt64(std::string& out, uint64_t value) {
+    for (int shift = 0; shift < 64; shift += 8) {
+        out.push_back(static_cast<char>((value >> shift) & 0xFF));
+    }
+}
+
+// Length-prefixed string; anything past 64 KiB is cut off
+void putString16(std::string& out, const std::string& value) {
+    auto length = static_cast<uint16_t>(std::min<size_t>(value.size(), UINT16_MAX));
+    putUInt16(out, length);
+    out.append(value, 0, length);
+}
+
+// Bounds-checked little-endian decoding of one record payload
+class PayloadCursor {
+public:
+    explicit PayloadCursor(const std::string& data) : data_(data) {}
+
+    bool readUInt16(uint16_t& value) {
+        uint64_t raw;
+        if (!readBytes(2, raw)) return false;
+        value = static_cast<uint16_t>(raw);
+        return true;
+    }
+
+    bool readUInt32(uint32_t& value) {
+        uint64_t raw;
+        if (!readBytes(4, raw)) return false;
+        value = static_cast<uint32_t>(raw);
+        return true;
+    }
+
+    bool readUInt64(uint64_t& value) {
+        return readBytes(8, value);
+    }
+
+    bool readString16(std::string& value) {
+        uint16_t length;
+        if (!readUInt16(length) || data_.size() - pos_ < length) return false;
+        value.assign(data_, pos_, length);
+        pos_ += length;
+        return true;
+    }
+
+    bool atEnd() const { return pos_ == data_.size(); }
+
+private:
+    const std::string& data_;
+    size_t pos_{0};
+
+    bool readBytes(size_t count, uint64_t& value) {
+        if (data_.size() - pos_ < count) return false;
+        value = 0;
+        for (size_t i = 0; i < count; ++i) {
+            value |= static_cast<uint64_t>(static_cast<unsigned char>(data_[pos_ + i])) << (8 * i);
+        }
+        pos_ += count;
+        return true;
+    }
+};
+
+std::string encodeHeader() {
+    std::string header(RequestTraceFormat::MAGIC, sizeof(RequestTraceFormat::MAGIC));
+    putUInt16(header, RequestTraceFormat::VERSION);
+    putUInt16(header, 0);
+    return header;
+}
+
+} // namespace
+
+RequestTraceRecorder::RequestTraceRecorder(std::string path, size_t maxBufferBytes)
+    : path_(std::move(path))
+    , maxBufferBytes_(maxBufferBytes) {
+}
+
+RequestTraceRecorder::~RequestTraceRecorder() {
+    stop();
+}
+
+bool RequestTraceRecorder::start() {
+    if (running_) {
+        return true;
+    }
+
+    // Appending to an existing trace is fine as long as it is one
+    std::string header = encodeHeader();
+    {
+        std::ifstream existing(path_, std::ios::binary);
+        if (existing) {
+            std::string existingHeader(RequestTraceFormat::HEADER_SIZE, '\0');
+            existing.read(existingHeader.data(), static_cast<std::streamsize>(existingHeader.size()));
+            auto length = static_cast<size_t>(existing.gcount());
+            if (length > 0 && (length != header.size() || existingHeader != header)) {
+                spdlog::error("Request trace file {} exists but is not a version {} trace",
+                              path_, RequestTraceFormat::VERSION);
+                return false;
+            }
+            if (length > 0) {
+                header.clear();
+            }
+        }
+    }
+
+    file_.open(path_, std::ios::binary | std::ios::app);
+    if (!file_) {
+        spdlog::error("Cannot open request trace file {}", path_);
+        return false;
+    }
+    if (!header.empty()) {
+        file_.write(header.data(), static_cast<std::streamsize>(header.size()));
+        file_.flush();
+    }
+
+    buffer_.reserve(FLUSH_THRESHOLD * 2);
+    running_ = true;
+    writerThread_ = std::thread(&RequestTraceRecorder::writerLoop, this);
+    spdlog::info("Recording read requests to {}", path_);
+    return true;
+}
+
+void RequestTraceRecorder::stop() {
+    {
+        std::lock_guard<std::mutex> lock(bufferMutex_);
+        if (!running_) {
+            return;
+        }
+        running_ = false;
+    }
+    flushCondition_.notify_one();
+
+    if (writerThread_.joinable()) {
+        writerThread_.join();
+    }
+    file_.close();
+}
+
+void RequestTraceRecorder::record(uint64_t timestampUs, const std::string& client,
+                                  const std::vector<std::string>& nodeIds) {
+    bool flushNow = false;
+    {
+        std::lock_guard<std::mutex> lock(bufferMutex_);
+        if (!running_) {
+            return;
+        }
+        if (buffer_.size() >= maxBufferBytes_) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        encodeRecord(timestampUs, client, nodeIds, buffer_);
+        flushNow = buffer_.size() >= FLUSH_THRESHOLD;
+    }
+    recorded_.fetch_add(1, std::memory_order_relaxed);
+
+    if (flushNow) {
+        flushCondition_.notify_one();
+    }
+}
+
+RequestTraceRecorder::Stats RequestTraceRecorder::getStats() const {
+    return Stats{
+        recorded_.load(std::memory_order_relaxed),
+        dropped_.load(std::memory_order_relaxed),
+        bytesWritten_.load(std::memory_order_relaxed),
+        writeErrors_.load(std::memory_order_relaxed)
+    };
+}
+
+void RequestTraceRecorder::encodeRecord(uint64_t timestampUs, const std::string& client,
+                                        const std::vector<std::string>& nodeIds, std::string& out) {
+    size_t lengthPos = out.size();
+    putUInt32(out, 0);   // Patched below once the payload size is known
+
+    putUInt64(out, timestampUs);
+    putString16(out, client);
+    putUInt32(out, static_cast<uint32_t>(nodeIds.size()));
+    for (const auto& nodeId : nodeIds) {
+        putString16(out, nodeId);
+    }
+
+    auto payloadSize = static_cast<uint32_t>(out.size() - lengthPos - 4);
+    for (int i = 0; i < 4; ++i) {
+        out[lengthPos + i] = static_cast<char>((payloadSize >> (8 * i)) & 0xFF);
+    }
+}
+
+void RequestTraceRecorder::writerLoop() {
+    std::string pending;
+    pending.reserve(FLUSH_THRESHOLD * 2);
+
+    while (true) {
+        bool stopping;
+        {
+            std::unique_lock<std::mutex> lock(bufferMutex_);
+            flushCondition_.wait_for(lock, FLUSH_INTERVAL, [this]() {
+                return !running_ || buffer_.size() >= FLUSH_THRESHOLD;
+            });
+            stopping = !running_;
+            // Swap so recording continues into the old write buffer while we write
+            pending.clear();
+            pending.swap(buffer_);
+        }
+
+        if (!pending.empty()) {
+            writeOut(pending);
+        }
+        if (stopping) {
+            break;
+        }
+    }
+}
+
+void RequestTraceRecorder::writeOut(const std::string& data) {
+    file_.write(data.data(), static_cast<std::streamsize>(data.size()));
+    file_.flush();
+    if (!file_) {
+        writeErrors_.fetch_add(1, std::memory_order_relaxed);
+        spdlog::warn("Failed to write {} bytes to request trace {}", data.size(), path_);
+        file_.clear();
+        return;
+    }
+    bytesWritten_.fetch_add(data.size(), std::memory_order_relaxed);
+}
+
+bool RequestTraceReader::open(const std::string& path) {
+    file_.close();
+    file_.clear();
+    truncated_ = false;
+    error_.clear();
+
+    file_.open(path, std::ios::binary);
+    if (!file_) {
+        error_ = "Cannot open " + path;
+        return false;
+    }
+
+    std::string header(RequestTraceFormat::HEADER_SIZE, '\0');
+    file_.read(header.data(), static_cast<std::streamsize>(header.size()));
+    if (file_.gcount() != static_cast<std::streamsize>(header.size()) || header != encodeHeader()) {
+        error_ = path + " is not a version " + std::to_string(RequestTraceFormat::VERSION) + " request trace";
+        file_.close();
+        return false;
+    }
+    return true;
+}
+
+bool RequestTraceReader::next(RequestTraceRecord& record) {
+    if (!file_.is_open() || truncated_) {
+        return false;
+    }
+
+    char lengthBytes[4];
+    file_.read(lengthBytes, sizeof(lengthBytes));
+    if (file_.gcount() == 0) {
+        return false;   // Clean end of trace
+    }
+    if (file_.gcount() != sizeof(lengthBytes)) {
+        truncated_ = true;
+        return false;
+    }
+
+    uint32_t length = 0;
+    for (int i = 0; i < 4; ++i) {
+        length |= static_cast<uint32_t>(static_cast<unsigned char>(lengthBytes[i])) << (8 * i);
+    }
+    if (length > RequestTraceFormat::MAX_RECORD_SIZE) {
+        truncated_ = true;
+        return false;
+    }
+
+    payload_.resize(length);
+    file_.read(payload_.data(), length);
+    if (file_.gcount() != static_cast<std::streamsize>(length)) {
+        truncated_ = true;
+        return false;
+    }
+
+    PayloadCursor cursor(payload_);
+    uint32_t count = 0;
+    if (!cursor.readUInt64(record.timestampUs) ||
+        !cursor.readString16(record.client) ||
+        !cursor.readUInt32(count)) {
+        truncated_ = true;
+        return false;
+    }
+
+    record.nodeIds.resize(std::min<size_t>(count, length / 2));
+    for (auto& nodeId : record.nodeIds) {
+        if (!cursor.readString16(nodeId)) {
+            truncated_ = true;
+            return false;
+        }
+    }
+    if (record.nodeIds.size() != count || !cursor.atEnd()) {
+        truncated_ = true;
+        return false;
+    }
+    return true;
+}
+
+bool RequestTraceReader::readAll(const std::string& path, std::vector<RequestTraceRecord>& records,
+                                 std::string& error) {
+    RequestTraceReader reader;
+    if (!reader.open(path)) {
+        error = reader.getError();
+        return false;
+    }
+
+    RequestTraceRecord record;
+    while (reader.next(record)) {
+        records.push_back(std::move(record));
+    }
+    if (reader.isTruncated()) {
+        spdlog::warn("Request trace {} ends with a damaged record; read {} records", path, records.size());
+    }
+    return true;
+}
+
+} // namespace opcua2http
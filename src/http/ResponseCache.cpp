@@ -0,0 +1,184 @@
+#include "http/ResponseCache.h"
+#include "cache/CacheManager.h"
+
+#include <stdexcept>
+
+namespace opcua2http {
+
+bool ResponseCache::Response::isCacheable() const {
+    if (nodeIds.empty() || nodeIds.size() != versions.size()) {
+        return false;
+    }
+    for (const auto& version : versions) {
+        if (!version) {
+            return false;
+        }
+    }
+    return true;
+}
+
+ResponseCache::ResponseCache(CacheManager* cacheManager, size_t maxEntries)
+    : cacheManager_(cacheManager)
+    , maxEntries_(maxEntries) {
+    if (!cacheManager_) {
+        throw std::invalid_argument("CacheManager cannot be null");
+    }
+}
+
+std::shared_ptr<const ResponseCache::Response> ResponseCache::getOrBuild(const std::vector<std::string>& nodeIds,
+                                                                        const Builder& build, Source* source) {
+    Source unused;
+    Source& from = source ? *source : unused;
+    from = Source::BUILT;
+
+    if (!isEnabled()) {
+        builds_.fetch_add(1, std::memory_order_relaxed);
+        return build();
+    }
+
+    std::string key = makeKey(nodeIds);
+
+    std::shared_ptr<const Response> stored;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = slots_.find(key);
+        if (it != slots_.end()) {
+            stored = it->second.response;
+        }
+    }
+
+    // Validated outside mutex_ so a long list does not hold up other keys
+    if (stored) {
+        if (cacheManager_->isFreshAndUnchanged(stored->nodeIds, stored->versions)) {
+            hits_.fetch_add(1, std::memory_order_relaxed);
+            from = Source::STORED;
+            return stored;
+        }
+        invalidated_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::promise<std::shared_ptr<const Response>> promise;
+    std::shared_future<std::shared_ptr<const Response>> pending;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = slots_.find(key);
+        if (it == slots_.end()) {
+            if (slots_.size() >= maxEntries_) {
+                evictOneLocked();
+            }
+            it = slots_.emplace(key, Slot{}).first;
+        }
+
+        if (it->second.pending.valid()) {
+            pending = it->second.pending;
+        } else {
+            // Drop the outdated body now so other requests wait for this build
+            // rather than revalidate it
+            if (it->second.response == stored) {
+                it->second.response.reset();
+            }
+            it->second.pending = promise.get_future().share();
+        }
+    }
+
+    if (pending.valid()) {
+        // get() rethrows the builder's exception
+        sharedBuilds_.fetch_add(1, std::memory_order_relaxed);
+        from = Source::SHARED;
+        return pending.get();
+    }
+
+    builds_.fetch_add(1, std::memory_order_relaxed);
+
+    std::shared_ptr<const Response> response;
+    try {
+        response = build();
+    } catch (...) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = slots_.find(key);
+            if (it != slots_.end()) {
+                it->second.pending = {};
+                if (!it->second.response) {
+                    slots_.erase(it);
+                }
+            }
+        }
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = slots_.find(key);
+        if (it != slots_.end()) {
+            it->second.pending = {};
+            if (response && response->isCacheable()) {
+                it->second.response = response;
+            } else if (!it->second.response) {
+                slots_.erase(it);
+            }
+        }
+    }
+    promise.set_value(response);
+
+    return response;
+}
+
+void ResponseCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Builds in progress keep their slot so waiting requests still get the result
+    for (auto it = slots_.begin(); it != slots_.end();) {
+        if (it->second.pending.valid()) {
+            it->second.response.reset();
+            ++it;
+        } else {
+            it = slots_.erase(it);
+        }
+    }
+}
+
+ResponseCache::Stats ResponseCache::getStats() const {
+    Stats stats;
+    stats.hits = hits_.load(std::memory_order_relaxed);
+    stats.builds = builds_.load(std::memory_order_relaxed);
+    stats.sharedBuilds = sharedBuilds_.load(std::memory_order_relaxed);
+    stats.invalidated = invalidated_.load(std::memory_order_relaxed);
+    stats.evictions = evictions_.load(std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats.entries = slots_.size();
+    return stats;
+}
+
+std::string ResponseCache::makeKey(const std::vector<std::string>& nodeIds) {
+    size_t size = 0;
+    for (const auto& nodeId : nodeIds) {
+        size += nodeId.size() + 1;
+    }
+
+    std::string key;
+    key.reserve(size);
+    for (const auto& nodeId : nodeIds) {
+        if (!key.empty()) {
+            key += ',';
+        }
+        key += nodeId;
+    }
+    return key;
+}
+
+void ResponseCache::evictOneLocked() {
+    // No usage order is kept: any idle slot will do, since a polled list comes
+    // straight back on its next request
+    for (auto it = slots_.begin(); it != slots_.end(); ++it) {
+        if (!it->second.pending.valid()) {
+            slots_.erase(it);
+            evictions_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+}
+
+} // namespace opcua2http
@@ -0,0 +1,192 @@
+#include "opcua/CircuitBreaker.h"
+#include <spdlog/spdlog.h>
+
+namespace opcua2http {
+
+CircuitBreaker::CircuitBreaker() = default;
+
+void CircuitBreaker::configure(int failureThreshold,
+                               std::chrono::milliseconds openTimeout,
+                               std::chrono::milliseconds probeInterval) {
+    if (failureThreshold < 0) {
+        spdlog::warn("CircuitBreaker: Invalid failure threshold {}, disabling", failureThreshold);
+        failureThreshold = 0;
+    }
+    if (openTimeout.count() <= 0) {
+        spdlog::warn("CircuitBreaker: Invalid open timeout {}ms, using 5000ms", openTimeout.count());
+        openTimeout = std::chrono::milliseconds(5000);
+    }
+    if (probeInterval.count() <= 0) {
+        spdlog::warn("CircuitBreaker: Invalid probe interval {}ms, using 1000ms", probeInterval.count());
+        probeInterval = std::chrono::milliseconds(1000);
+    }
+
+    std::lock_guard<std::mutex> lock(breakerMutex_);
+    failureThreshold_ = failureThreshold;
+    openTimeout_ = openTimeout;
+    probeInterval_ = probeInterval;
+    state_ = State::CLOSED;
+    consecutiveFailures_ = 0;
+
+    if (failureThreshold > 0) {
+        spdlog::info("CircuitBreaker: Opening after {} consecutive failures for {}ms, probing every {}ms",
+                     failureThreshold, openTimeout.count(), probeInterval.count());
+    }
+}
+
+bool CircuitBreaker::isEnabled() const {
+    std::lock_guard<std::mutex> lock(breakerMutex_);
+    return failureThreshold_ > 0;
+}
+
+bool CircuitBreaker::allowRequest() {
+    {
+        std::lock_guard<std::mutex> lock(breakerMutex_);
+
+        if (state_ == State::CLOSED) {
+            return true;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (state_ == State::OPEN && now >= openedAt_ + openTimeout_) {
+            state_ = State::HALF_OPEN;
+            nextProbe_ = now;
+            spdlog::info("CircuitBreaker: Half-open, probing OPC UA server");
+        }
+
+        if (state_ == State::HALF_OPEN && now >= nextProbe_) {
+            nextProbe_ = now + probeInterval_;
+            probes_++;
+            return true;
+        }
+    }
+
+    rejectedReads_++;
+    return false;
+}
+
+bool CircuitBreaker::isOpen() const {
+    std::lock_guard<std::mutex> lock(breakerMutex_);
+    auto now = std::chrono::steady_clock::now();
+
+    switch (state_) {
+        case State::OPEN:
+            return now < openedAt_ + openTimeout_;
+        case State::HALF_OPEN:
+            return now < nextProbe_;
+        case State::CLOSED:
+            break;
+    }
+    return false;
+}
+
+void CircuitBreaker::recordSuccess() {
+    std::lock_guard<std::mutex> lock(breakerMutex_);
+    consecutiveFailures_ = 0;
+
+    if (state_ != State::CLOSED) {
+        state_ = State::CLOSED;
+        spdlog::info("CircuitBreaker: Closed, OPC UA server is answering again");
+    }
+}
+
+void CircuitBreaker::recordFailure() {
+    std::lock_guard<std::mutex> lock(breakerMutex_);
+    if (failureThreshold_ <= 0) {
+        return;
+    }
+
+    consecutiveFailures_++;
+
+    switch (state_) {
+        case State::CLOSED:
+            if (consecutiveFailures_ >= static_cast<uint32_t>(failureThreshold_)) {
+                open(std::chrono::steady_clock::now());
+            }
+            break;
+        case State::HALF_OPEN:
+            // The probe failed; wait out another open timeout
+            open(std::chrono::steady_clock::now());
+            break;
+        case State::OPEN:
+            // Late result of a read admitted before the circuit opened
+            break;
+    }
+}
+
+void CircuitBreaker::reset() {
+    std::lock_guard<std::mutex> lock(breakerMutex_);
+    consecutiveFailures_ = 0;
+
+    if (state_ != State::CLOSED) {
+        state_ = State::CLOSED;
+        spdlog::info("CircuitBreaker: Closed after reconnection");
+    }
+}
+
+CircuitBreaker::State CircuitBreaker::getState() const {
+    std::lock_guard<std::mutex> lock(breakerMutex_);
+    return state_;
+}
+
+const char* CircuitBreaker::stateToString(State state) {
+    switch (state) {
+        case State::CLOSED: return "closed";
+        case State::OPEN: return "open";
+        case State::HALF_OPEN: return "half_open";
+    }
+    return "unknown";
+}
+
+bool CircuitBreaker::isOpenError(const std::string& error) {
+    return error.find(OPEN_ERROR) != std::string::npos;
+}
+
+CircuitBreaker::BreakerStats CircuitBreaker::getStats() const {
+    BreakerStats stats;
+
+    {
+        std::lock_guard<std::mutex> lock(breakerMutex_);
+        auto now = std::chrono::steady_clock::now();
+
+        stats.state = state_;
+        stats.failureThreshold = failureThreshold_;
+        stats.consecutiveFailures = consecutiveFailures_;
+
+        if (state_ != State::CLOSED) {
+            auto probeAt = state_ == State::OPEN ? openedAt_ + openTimeout_ : nextProbe_;
+            stats.openFor = std::chrono::duration_cast<std::chrono::milliseconds>(now - openedAt_);
+            if (probeAt > now) {
+                stats.retryIn = std::chrono::duration_cast<std::chrono::milliseconds>(probeAt - now);
+            }
+        }
+    }
+
+    stats.trips = trips_.load();
+    stats.rejectedReads = rejectedReads_.load();
+    stats.probes = probes_.load();
+
+    return stats;
+}
+
+void CircuitBreaker::clearStats() {
+    trips_ = 0;
+    rejectedReads_ = 0;
+    probes_ = 0;
+}
+
+void CircuitBreaker::open(std::chrono::steady_clock::time_point now) {
+    bool probeFailed = state_ == State::HALF_OPEN;
+    state_ = State::OPEN;
+    openedAt_ = now;
+    trips_++;
+
+    if (probeFailed) {
+        spdlog::warn("CircuitBreaker: Probe failed, reopening for {}ms", openTimeout_.count());
+    } else {
+        spdlog::warn("CircuitBreaker: Opened after {} consecutive failures, failing OPC reads fast for {}ms",
+                     consecutiveFailures_, openTimeout_.count());
+    }
+}
+
+} // namespace opcua2http
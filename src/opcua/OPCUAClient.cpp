@@ -1,4 +1,5 @@
 #include "opcua/OPCUAClient.h"
+#include "core/RequestTiming.h"
 #include <spdlog/spdlog.h>
 #include <iostream>
 #include <sstream>
@@ -6,9 +7,11 @@
 #include <chrono>
 #include <cstring>
 #include <algorithm>
+#include <optional>
 
 // Additional open62541 includes for batch reading
 #include <open62541/client_config_default.h>
+#include <open62541/client_subscriptions.h>
 #include <open62541/types_generated.h>
 
 namespace opcua2http {
@@ -23,10 +26,17 @@ OPCUAClient::OPCUAClient()
     , connectionTimeout_(std::chrono::milliseconds(10000))
     , retryCount_(3)
     , batchSize_(50)
-    , connectionHealthy_(false) {
+    , connectionHealthy_(false)
+    , standby_([this]() { return createClient(); })
+    , standbyRunning_(false)
+    , sessionWanted_(false)
+    , failovers_(0)
+    , activeServiceLevel_(StandbySession::SERVICE_LEVEL_UNKNOWN)
+    , lastSwitchDuration_(std::chrono::milliseconds::zero()) {
 }
 
 OPCUAClient::~OPCUAClient() {
+    stopStandbyMonitor();
     disconnect();
     if (client_) {
         UA_Client_delete(client_);
@@ -35,7 +45,7 @@ OPCUAClient::~OPCUAClient() {
 }
 
 bool OPCUAClient::initialize(const Configuration& config) {
-    std::lock_guard<std::mutex> lock(clientMutex_);
+    auto lock = lockClient();
 
     if (initialized_) {
         spdlog::error("OPCUAClient already initialized");
@@ -43,62 +53,86 @@ bool OPCUAClient::initialize(const Configuration& config) {
     }
 
     appConfig_ = config;
-    endpoint_ = config.opcEndpoint;
+    setEndpoint(config.opcEndpoint);
 
     // Configure batch reading and connection parameters
     readTimeout_ = std::chrono::milliseconds(config.opcReadTimeoutMs);
     connectionTimeout_ = std::chrono::milliseconds(config.opcConnectionTimeoutMs);
     batchSize_ = static_cast<size_t>(config.opcBatchSize);
+    readBudget_.configure(config.opcReadBudgetNodesPerSecond,
+                          config.opcReadBudgetRequestsPerSecond,
+                          config.opcReadBudgetSyncReservePercent / 100.0);
+    circuitBreaker_.configure(config.opcCircuitBreakerFailureThreshold,
+                              std::chrono::milliseconds(config.opcCircuitBreakerOpenMs),
+                              std::chrono::milliseconds(config.opcCircuitBreakerProbeIntervalMs));
 
     if (endpoint_.empty()) {
         spdlog::error("OPC UA endpoint is empty");
         return false;
     }
 
-    client_ = UA_Client_new();
+    client_ = createClient();
     if (!client_) {
-        spdlog::error("Failed to create UA_Client");
         return false;
     }
-
     config_ = UA_Client_getConfig(client_);
-    if (!config_) {
+
+    initialized_ = true;
+    updateConnectionState(ConnectionState::DISCONNECTED);
+
+    // Redundant endpoints: the primary first, then the backups in configured order
+    if (!config.opcBackupEndpoints.empty()) {
+        std::vector<std::string> endpoints{config.opcEndpoint};
+        endpoints.insert(endpoints.end(), config.opcBackupEndpoints.begin(), config.opcBackupEndpoints.end());
+        standby_.setEndpoints(endpoints);
+
+        standbyRunning_ = true;
+        standbyThread_ = std::thread(&OPCUAClient::standbyMonitorLoop, this);
+        spdlog::info("Hot-standby failover enabled across {} endpoints", endpoints.size());
+    }
+
+    spdlog::info("OPCUAClient initialized successfully for endpoint: {}", endpoint_);
+    return true;
+}
+
+UA_Client* OPCUAClient::createClient() {
+    UA_Client* client = UA_Client_new();
+    if (!client) {
+        spdlog::error("Failed to create UA_Client");
+        return nullptr;
+    }
+
+    UA_ClientConfig* clientConfig = UA_Client_getConfig(client);
+    if (!clientConfig) {
         spdlog::error("Failed to get client configuration");
-        UA_Client_delete(client_);
-        client_ = nullptr;
-        return false;
+        UA_Client_delete(client);
+        return nullptr;
     }
 
-    UA_StatusCode status = UA_ClientConfig_setDefault(config_);
+    UA_StatusCode status = UA_ClientConfig_setDefault(clientConfig);
     if (status != UA_STATUSCODE_GOOD) {
         spdlog::error("Failed to set default client configuration: {}", statusCodeToString(status));
-        UA_Client_delete(client_);
-        client_ = nullptr;
-        return false;
+        UA_Client_delete(client);
+        return nullptr;
     }
 
     // Note: OPC UA logging integration will be added later
 
-    if (!configureClientSecurity()) {
+    if (!configureClientSecurity(clientConfig)) {
         spdlog::error("Failed to configure client security");
-        UA_Client_delete(client_);
-        client_ = nullptr;
-        return false;
+        UA_Client_delete(client);
+        return nullptr;
     }
 
-    config_->stateCallback = stateCallback;
-    config_->clientContext = this;
-    config_->timeout = static_cast<UA_UInt32>(connectionTimeout_.count());
-
-    initialized_ = true;
-    updateConnectionState(ConnectionState::DISCONNECTED);
+    clientConfig->stateCallback = stateCallback;
+    clientConfig->clientContext = this;
+    clientConfig->timeout = static_cast<UA_UInt32>(connectionTimeout_.count());
 
-    spdlog::info("OPCUAClient initialized successfully for endpoint: {}", endpoint_);
-    return true;
+    return client;
 }
 
 bool OPCUAClient::connect() {
-    std::lock_guard<std::mutex> lock(clientMutex_);
+    auto lock = lockClient();
 
     if (!initialized_) {
         spdlog::error("Client not initialized");
@@ -109,12 +143,14 @@ bool OPCUAClient::connect() {
         return true;
     }
 
+    sessionWanted_ = true;
     updateConnectionState(ConnectionState::CONNECTING);
     lastConnectionAttempt_ = std::chrono::steady_clock::now();
 
-    spdlog::info("Connecting to OPC UA server: {}", endpoint_);
+    std::string endpoint = getEndpoint();
+    spdlog::info("Connecting to OPC UA server: {}", endpoint);
 
-    UA_StatusCode status = UA_Client_connect(client_, endpoint_.c_str());
+    UA_StatusCode status = UA_Client_connect(client_, endpoint.c_str());
 
     if (status == UA_STATUSCODE_GOOD) {
         updateConnectionState(ConnectionState::CONNECTED);
@@ -132,12 +168,15 @@ bool OPCUAClient::connect() {
 }
 
 void OPCUAClient::disconnect() {
-    std::lock_guard<std::mutex> lock(clientMutex_);
+    auto lock = lockClient();
 
     if (!initialized_ || !client_) {
         return;
     }
 
+    // A deliberate disconnect must not be undone by an automatic failover
+    sessionWanted_ = false;
+
     if (connectionState_ == ConnectionState::CONNECTED ||
         connectionState_ == ConnectionState::CONNECTING) {
 
@@ -160,15 +199,24 @@ UA_Client* OPCUAClient::getClient() const {
     return client_;
 }
 
-ReadResult OPCUAClient::readNode(const std::string& nodeId) {
-    std::lock_guard<std::mutex> lock(clientMutex_);
+ReadResult OPCUAClient::readNode(const std::string& nodeId, ReadBudget::Priority priority) {
+    PerformanceMonitor::ScopedTimer timer(performanceMonitor_, PerformanceMonitor::OperationType::OPC_READ, 1);
+    RequestTiming::StageTimer stageTimer(RequestTiming::Stage::OPC);
 
-    if (!isConnected()) {
+    // Checked before taking the client so callers never queue behind a dead server
+    if (!circuitBreaker_.allowRequest()) {
+        return ReadResult::createError(nodeId, CircuitBreaker::OPEN_ERROR, getCurrentTimestamp());
+    }
+
+    auto lock = lockClient();
+
+    if (!isConnected() && !failoverLocked("active session lost")) {
         std::string error = "Client not connected";
         if (!lastError_.empty()) {
             error += " - " + lastError_;
         }
         setLastError(error);
+        circuitBreaker_.recordFailure();
         return ReadResult::createError(nodeId, error, getCurrentTimestamp());
     }
 
@@ -176,12 +224,18 @@ ReadResult OPCUAClient::readNode(const std::string& nodeId) {
         return ReadResult::createError(nodeId, "Invalid NodeId format", getCurrentTimestamp());
     }
 
+    if (!readBudget_.tryAcquire(1, 1, priority)) {
+        return ReadResult::createError(nodeId, ReadBudget::EXHAUSTED_ERROR, getCurrentTimestamp());
+    }
+
     UA_NodeId uaNodeId = parseNodeId(nodeId);
 
     UA_Variant value;
     UA_Variant_init(&value);
 
+    RequestTiming::countOpcRequest();
     UA_StatusCode status = UA_Client_readValueAttribute(client_, uaNodeId, &value);
+    recordReadOutcome(status);
 
     ReadResult result;
     if (status == UA_STATUSCODE_GOOD) {
@@ -205,17 +259,139 @@ ReadResult OPCUAClient::readNode(const std::string& nodeId) {
     return result;
 }
 
-std::vector<ReadResult> OPCUAClient::readNodes(const std::vector<std::string>& nodeIds) {
+ReadResult OPCUAClient::readNodeWithDeadline(const std::string& nodeId,
+                                             std::chrono::milliseconds timeout,
+                                             const std::atomic<bool>* cancel,
+                                             ReadBudget::Priority priority) {
+    PerformanceMonitor::ScopedTimer timer(performanceMonitor_, PerformanceMonitor::OperationType::OPC_READ, 1);
+
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    auto isCancelled = [cancel] { return cancel != nullptr && cancel->load(); };
+
+    if (!circuitBreaker_.allowRequest()) {
+        return ReadResult::createError(nodeId, CircuitBreaker::OPEN_ERROR, getCurrentTimestamp());
+    }
+
+    // Wait for the client in slices so a read stuck elsewhere cannot hold us past the deadline
+    std::unique_lock<std::timed_mutex> clientLock(clientMutex_, std::defer_lock);
+    std::optional<std::chrono::nanoseconds> lockWait;
+    if (clientLock.try_lock()) {
+        if (performanceMonitor_) {
+            performanceMonitor_->recordLockAcquisition(PerformanceMonitor::LockType::CLIENT_MUTEX);
+        }
+    } else {
+        auto waitStart = std::chrono::steady_clock::now();
+        while (!clientLock.try_lock_for(ASYNC_POLL_INTERVAL)) {
+            if (isCancelled()) {
+                return ReadResult::createError(nodeId, READ_CANCELLED_ERROR, getCurrentTimestamp());
+            }
+            if (std::chrono::steady_clock::now() >= deadline) {
+                return ReadResult::createError(nodeId, READ_TIMEOUT_ERROR, getCurrentTimestamp());
+            }
+        }
+        lockWait = std::chrono::steady_clock::now() - waitStart;
+        if (performanceMonitor_) {
+            performanceMonitor_->recordLockWait(PerformanceMonitor::LockType::CLIENT_MUTEX, *lockWait);
+        }
+    }
+    auto lock = LockProfiler::adopt(lockProfiler_, LockProfiler::LockId::CLIENT_MUTEX, std::move(clientLock),
+                                    lockWait, std::source_location::current());
+
+    if (!isConnected() && !failoverLocked("active session lost")) {
+        std::string error = "Client not connected";
+        if (!lastError_.empty()) {
+            error += " - " + lastError_;
+        }
+        setLastError(error);
+        circuitBreaker_.recordFailure();
+        return ReadResult::createError(nodeId, error, getCurrentTimestamp());
+    }
+
+    if (!validateNodeIdFormat(nodeId)) {
+        return ReadResult::createError(nodeId, "Invalid NodeId format", getCurrentTimestamp());
+    }
+
+    if (!readBudget_.tryAcquire(1, 1, priority)) {
+        return ReadResult::createError(nodeId, ReadBudget::EXHAUSTED_ERROR, getCurrentTimestamp());
+    }
+
+    PendingRead pending{this, nodeId, false, {}};
+    UA_ReadRequest request = createReadRequest({nodeId});
+    UA_UInt32 requestId = 0;
+    UA_StatusCode status = UA_Client_sendAsyncReadRequest(client_, &request, asyncReadCallback,
+                                                          &pending, &requestId);
+    UA_ReadRequest_clear(&request);
+
+    if (status != UA_STATUSCODE_GOOD) {
+        recordReadOutcome(status);
+        return ReadResult::createError(nodeId, statusCodeToString(status), getCurrentTimestamp());
+    }
+
+    // Drive the client until the response arrives, the deadline passes or the caller cancels
+    while (!pending.completed) {
+        const char* abandonReason = nullptr;
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now());
+
+        if (isCancelled()) {
+            abandonReason = READ_CANCELLED_ERROR;
+        } else if (remaining.count() <= 0) {
+            abandonReason = READ_TIMEOUT_ERROR;
+        }
+
+        if (abandonReason) {
+            // Detach the request from this stack frame; a late response is discarded
+            // and the client reaps the request when its own timeout expires
+            UA_Client_modifyAsyncCallback(client_, requestId, nullptr, discardAsyncResponse);
+            if (abandonReason == READ_TIMEOUT_ERROR) {
+                circuitBreaker_.recordFailure();
+            }
+            spdlog::debug("Abandoned read of node {}: {}", nodeId, abandonReason);
+            return ReadResult::createError(nodeId, abandonReason, getCurrentTimestamp());
+        }
+
+        UA_Client_run_iterate(client_, static_cast<UA_UInt32>(std::min(remaining, ASYNC_POLL_INTERVAL).count()));
+    }
+
+    return pending.result;
+}
+
+void OPCUAClient::asyncReadCallback(UA_Client* /*client*/, void* userdata,
+                                    UA_UInt32 /*requestId*/, UA_ReadResponse* response) {
+    auto* pending = static_cast<PendingRead*>(userdata);
+    if (!pending) {
+        return;
+    }
+
+    if (response) {
+        pending->client->recordReadOutcome(response->responseHeader.serviceResult);
+        auto results = pending->client->processReadResponse({pending->nodeId}, *response);
+        pending->result = results.front();
+    } else {
+        pending->result = ReadResult::createError(pending->nodeId, "Empty read response",
+                                                  pending->client->getCurrentTimestamp());
+    }
+    pending->completed = true;
+}
+
+void OPCUAClient::discardAsyncResponse(UA_Client* /*client*/, void* /*userdata*/,
+                                       UA_UInt32 /*requestId*/, void* /*response*/) {
+}
+
+std::vector<ReadResult> OPCUAClient::readNodes(const std::vector<std::string>& nodeIds,
+                                               ReadBudget::Priority priority) {
     std::vector<ReadResult> results;
     results.reserve(nodeIds.size());
 
-    if (!isConnected()) {
+    // The delegated reads fail over themselves if a standby is ready
+    if (!isConnected() && !standby_.isReady()) {
         uint64_t timestamp = getCurrentTimestamp();
         std::string error = "Client not connected";
         if (!lastError_.empty()) {
             error += " - " + lastError_;
         }
         setLastError(error);
+        circuitBreaker_.recordFailure();
         for (const auto& nodeId : nodeIds) {
             results.push_back(ReadResult::createError(nodeId, error, timestamp));
         }
@@ -224,23 +400,24 @@ std::vector<ReadResult> OPCUAClient::readNodes(const std::vector<std::string>& n
 
     // Use batch reading for multiple nodes to improve performance
     if (nodeIds.size() > 1) {
-        return readNodesBatch(nodeIds);
+        return readNodesBatch(nodeIds, priority);
     }
 
     // Single node - use individual read
     for (const auto& nodeId : nodeIds) {
-        results.push_back(readNode(nodeId));
+        results.push_back(readNode(nodeId, priority));
     }
 
     return results;
 }
 
 void OPCUAClient::setStateChangeCallback(StateChangeCallback callback) {
+    std::lock_guard<std::mutex> lock(callbackMutex_);
     stateChangeCallback_ = callback;
 }
 
 UA_StatusCode OPCUAClient::runIterate(uint16_t timeoutMs) {
-    std::lock_guard<std::mutex> lock(clientMutex_);
+    auto lock = lockClient();
 
     if (!initialized_ || !client_) {
         return UA_STATUSCODE_BADINTERNALERROR;
@@ -249,13 +426,50 @@ UA_StatusCode OPCUAClient::runIterate(uint16_t timeoutMs) {
     return UA_Client_run_iterate(client_, timeoutMs);
 }
 
-const std::string& OPCUAClient::getEndpoint() const {
+std::vector<bool> OPCUAClient::deleteMonitoredItems(UA_UInt32 subscriptionId,
+                                                    const std::vector<UA_UInt32>& monitoredItemIds) {
+    std::vector<bool> deleted(monitoredItemIds.size(), false);
+    if (monitoredItemIds.empty()) {
+        return deleted;
+    }
+
+    auto lock = lockClient();
+
+    if (!initialized_ || !client_ || connectionState_ != ConnectionState::CONNECTED) {
+        return deleted;
+    }
+
+    UA_DeleteMonitoredItemsRequest request;
+    UA_DeleteMonitoredItemsRequest_init(&request);
+    request.subscriptionId = subscriptionId;
+    request.monitoredItemIdsSize = monitoredItemIds.size();
+    request.monitoredItemIds = const_cast<UA_UInt32*>(monitoredItemIds.data());
+
+    UA_DeleteMonitoredItemsResponse response = UA_Client_MonitoredItems_delete(client_, request);
+
+    if (response.responseHeader.serviceResult == UA_STATUSCODE_GOOD) {
+        for (size_t i = 0; i < response.resultsSize && i < deleted.size(); ++i) {
+            deleted[i] = response.results[i] == UA_STATUSCODE_GOOD;
+        }
+    }
+
+    UA_DeleteMonitoredItemsResponse_clear(&response);
+    return deleted;
+}
+
+std::string OPCUAClient::getEndpoint() const {
+    std::lock_guard<std::mutex> lock(endpointMutex_);
     return endpoint_;
 }
 
+void OPCUAClient::setEndpoint(const std::string& endpoint) {
+    std::lock_guard<std::mutex> lock(endpointMutex_);
+    endpoint_ = endpoint;
+}
+
 std::string OPCUAClient::getConnectionInfo() const {
     std::ostringstream oss;
-    oss << "Endpoint: " << endpoint_ << ", State: ";
+    oss << "Endpoint: " << getEndpoint() << ", State: ";
 
     switch (connectionState_) {
         case ConnectionState::DISCONNECTED: oss << "DISCONNECTED"; break;
@@ -265,9 +479,119 @@ std::string OPCUAClient::getConnectionInfo() const {
         case ConnectionState::CONNECTION_ERROR: oss << "CONNECTION_ERROR"; break;
     }
 
+    std::string standbyEndpoint = standby_.getEndpoint();
+    if (!standbyEndpoint.empty()) {
+        oss << ", Standby: " << standbyEndpoint;
+    }
+
     return oss.str();
 }
 
+bool OPCUAClient::failover() {
+    auto lock = lockClient();
+    if (!initialized_) {
+        return false;
+    }
+
+    sessionWanted_ = true;
+    return failoverLocked("requested");
+}
+
+OPCUAClient::FailoverStats OPCUAClient::getFailoverStats() const {
+    FailoverStats stats;
+    stats.failovers = failovers_.load();
+    stats.activeEndpoint = getEndpoint();
+    stats.standbyEndpoint = standby_.getEndpoint();
+    stats.standbyReady = standby_.isReady();
+    stats.activeServiceLevel = activeServiceLevel_.load();
+    stats.standbyServiceLevel = standby_.getServiceLevel();
+    stats.lastSwitchDuration = lastSwitchDuration_.load();
+    return stats;
+}
+
+bool OPCUAClient::shouldFailOver(int activeServiceLevel, int standbyServiceLevel, int minServiceLevel) {
+    // Only switch away from a server that reports itself degraded, and only to
+    // one that reports itself healthy; an unknown level never triggers a switch
+    return minServiceLevel > 0 &&
+           activeServiceLevel != StandbySession::SERVICE_LEVEL_UNKNOWN &&
+           activeServiceLevel < minServiceLevel &&
+           standbyServiceLevel >= minServiceLevel;
+}
+
+bool OPCUAClient::failoverLocked(const char* reason) {
+    // No automatic switch before the first connect() or after a deliberate disconnect()
+    if (!sessionWanted_) {
+        return false;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::string promotedEndpoint;
+    UA_Client* promoted = standby_.promote(client_, promotedEndpoint);
+    if (!promoted) {
+        return false;
+    }
+
+    std::string previousEndpoint = getEndpoint();
+    client_ = promoted;
+    config_ = UA_Client_getConfig(promoted);
+    setEndpoint(promotedEndpoint);
+    activeServiceLevel_ = StandbySession::SERVICE_LEVEL_UNKNOWN;
+    failovers_++;
+    lastSwitchDuration_ = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+
+    spdlog::warn("Failed over from {} to standby {} ({})", previousEndpoint, promotedEndpoint, reason);
+
+    // Pass through RECONNECTING so listeners see a new session even when the
+    // previous one was still connected (ServiceLevel-driven switch)
+    updateConnectionState(ConnectionState::RECONNECTING);
+    updateConnectionState(ConnectionState::CONNECTED);
+    return true;
+}
+
+void OPCUAClient::standbyMonitorLoop() {
+    auto retryDelay = std::chrono::milliseconds(appConfig_.connectionRetryDelay);
+
+    while (standbyRunning_) {
+        standby_.maintain(getEndpoint(), retryDelay);
+
+        if (standby_.isReady()) {
+            // Never wait behind a slow read; the next round samples again
+            std::unique_lock<std::timed_mutex> clientLock(clientMutex_, std::try_to_lock);
+            if (clientLock.owns_lock()) {
+                auto lock = LockProfiler::adopt(lockProfiler_, LockProfiler::LockId::CLIENT_MUTEX,
+                                                std::move(clientLock), std::nullopt,
+                                                std::source_location::current());
+                if (!isConnected()) {
+                    failoverLocked("active session lost");
+                } else if (isConnected() && appConfig_.opcFailoverMinServiceLevel > 0) {
+                    activeServiceLevel_ = StandbySession::readServiceLevel(client_);
+                    if (shouldFailOver(activeServiceLevel_, standby_.getServiceLevel(),
+                                       appConfig_.opcFailoverMinServiceLevel)) {
+                        failoverLocked("active server ServiceLevel degraded");
+                    }
+                }
+            }
+        }
+
+        std::unique_lock<std::mutex> waitLock(standbyWaitMutex_);
+        standbyCondition_.wait_for(waitLock, STANDBY_CHECK_INTERVAL, [this]() { return !standbyRunning_; });
+    }
+}
+
+void OPCUAClient::stopStandbyMonitor() {
+    {
+        std::lock_guard<std::mutex> lock(standbyWaitMutex_);
+        standbyRunning_ = false;
+    }
+    standbyCondition_.notify_all();
+
+    if (standbyThread_.joinable()) {
+        standbyThread_.join();
+    }
+}
+
 void OPCUAClient::stateCallback(UA_Client *client,
                                UA_SecureChannelState channelState,
                                UA_SessionState sessionState,
@@ -280,6 +604,11 @@ void OPCUAClient::stateCallback(UA_Client *client,
 
     OPCUAClient* self = static_cast<OPCUAClient*>(config->clientContext);
 
+    // The standby session shares the callback but must not move the active state
+    if (client != self->client_.load()) {
+        return;
+    }
+
     ConnectionState newState = ConnectionState::DISCONNECTED;
 
     // Handle session states according to open62541 documentation
@@ -436,30 +765,30 @@ uint64_t OPCUAClient::dateTimeToTimestamp(UA_DateTime dateTime) {
     return unixTime100ns / 10000; // Convert from 100ns to milliseconds
 }
 
-bool OPCUAClient::configureClientSecurity() {
-    if (!config_) {
+bool OPCUAClient::configureClientSecurity(UA_ClientConfig* clientConfig) {
+    if (!clientConfig) {
         return false;
     }
 
     switch (appConfig_.securityMode) {
         case 1:
-            config_->securityMode = UA_MESSAGESECURITYMODE_NONE;
+            clientConfig->securityMode = UA_MESSAGESECURITYMODE_NONE;
             break;
         case 2:
-            config_->securityMode = UA_MESSAGESECURITYMODE_SIGN;
+            clientConfig->securityMode = UA_MESSAGESECURITYMODE_SIGN;
             break;
         case 3:
-            config_->securityMode = UA_MESSAGESECURITYMODE_SIGNANDENCRYPT;
+            clientConfig->securityMode = UA_MESSAGESECURITYMODE_SIGNANDENCRYPT;
             break;
         default:
-            config_->securityMode = UA_MESSAGESECURITYMODE_NONE;
+            clientConfig->securityMode = UA_MESSAGESECURITYMODE_NONE;
             spdlog::warn("Unknown security mode {}, using None", appConfig_.securityMode);
             break;
     }
 
     if (!appConfig_.applicationUri.empty()) {
-        UA_String_clear(&config_->clientDescription.applicationUri);
-        config_->clientDescription.applicationUri =
+        UA_String_clear(&clientConfig->clientDescription.applicationUri);
+        clientConfig->clientDescription.applicationUri =
             UA_STRING_ALLOC(appConfig_.applicationUri.c_str());
     }
 
@@ -475,6 +804,8 @@ void OPCUAClient::updateConnectionState(ConnectionState newState, UA_StatusCode
     switch (newState) {
         case ConnectionState::CONNECTED:
             connectionHealthy_ = true;
+            // A fresh session proves the server is back; stop failing reads fast
+            circuitBreaker_.reset();
             break;
         case ConnectionState::CONNECTION_ERROR:
         case ConnectionState::DISCONNECTED:
@@ -523,8 +854,14 @@ void OPCUAClient::updateConnectionState(ConnectionState newState, UA_StatusCode
             }
         }
 
-        if (stateChangeCallback_) {
-            stateChangeCallback_(newState, statusCode);
+        // Copy under the lock so the callback can be replaced from another thread
+        StateChangeCallback callback;
+        {
+            std::lock_guard<std::mutex> lock(callbackMutex_);
+            callback = stateChangeCallback_;
+        }
+        if (callback) {
+            callback(newState, statusCode);
         }
     }
 }
@@ -538,27 +875,31 @@ bool OPCUAClient::validateNodeIdFormat(const std::string& nodeIdStr) {
     return std::regex_match(nodeIdStr, nodeIdPattern);
 }
 
-std::vector<ReadResult> OPCUAClient::readNodesBatch(const std::vector<std::string>& nodeIds) {
-    std::lock_guard<std::mutex> lock(clientMutex_);
+std::vector<ReadResult> OPCUAClient::readNodesBatch(const std::vector<std::string>& nodeIds,
+                                                    ReadBudget::Priority priority) {
+    PerformanceMonitor::ScopedTimer timer(performanceMonitor_, PerformanceMonitor::OperationType::OPC_BATCH_READ,
+                                          nodeIds.size());
+    RequestTiming::StageTimer stageTimer(RequestTiming::Stage::OPC);
 
     if (nodeIds.empty()) {
         return {};
     }
 
-    if (!isConnected()) {
-        uint64_t timestamp = getCurrentTimestamp();
-        std::string error = "Client not connected";
-        if (!lastError_.empty()) {
-            error += " - " + lastError_;
-        }
-        setLastError(error);
+    if (!circuitBreaker_.allowRequest()) {
+        return createCircuitRejection(nodeIds);
+    }
 
-        std::vector<ReadResult> results;
-        results.reserve(nodeIds.size());
-        for (const auto& nodeId : nodeIds) {
-            results.push_back(ReadResult::createError(nodeId, error, timestamp));
-        }
-        return results;
+    auto lock = lockClient();
+
+    if (!isConnected() && !failoverLocked("active session lost")) {
+        return createNotConnectedErrors(nodeIds);
+    }
+
+    // The whole call is admitted or shed at once so callers never see a
+    // half-served batch; each sub-batch is one read request to the server
+    size_t requestCount = (nodeIds.size() + batchSize_ - 1) / batchSize_;
+    if (!readBudget_.tryAcquire(nodeIds.size(), requestCount, priority)) {
+        return createBudgetRejection(nodeIds);
     }
 
     // Process nodes in batches to respect batch size limits
@@ -576,6 +917,120 @@ std::vector<ReadResult> OPCUAClient::readNodesBatch(const std::vector<std::strin
     return allResults;
 }
 
+OPCUAClient::PreparedRead::~PreparedRead() {
+    // Only the node IDs were allocated; index range and encoding are static
+    for (auto& readValueId : readValueIds_) {
+        UA_NodeId_clear(&readValueId.nodeId);
+    }
+}
+
+std::shared_ptr<const OPCUAClient::PreparedRead> OPCUAClient::prepareRead(const std::vector<std::string>& nodeIds) {
+    std::shared_ptr<PreparedRead> prepared(new PreparedRead());
+    prepared->nodeIds_ = nodeIds;
+    prepared->readValueIds_.resize(nodeIds.size());
+    prepared->valid_.resize(nodeIds.size());
+
+    for (size_t i = 0; i < nodeIds.size(); ++i) {
+        UA_ReadValueId& readValueId = prepared->readValueIds_[i];
+        UA_ReadValueId_init(&readValueId);
+        readValueId.attributeId = UA_ATTRIBUTEID_VALUE;
+        readValueId.indexRange = UA_STRING_NULL;
+        readValueId.dataEncoding = UA_QUALIFIEDNAME(0, NULL);
+
+        if (validateNodeIdFormat(nodeIds[i])) {
+            readValueId.nodeId = parseNodeId(nodeIds[i]);
+            prepared->valid_[i] = !UA_NodeId_isNull(&readValueId.nodeId);
+        }
+    }
+
+    return prepared;
+}
+
+std::vector<ReadResult> OPCUAClient::readPrepared(const PreparedRead& prepared, const std::vector<size_t>& members,
+                                                  ReadBudget::Priority priority) {
+    PerformanceMonitor::ScopedTimer timer(performanceMonitor_, PerformanceMonitor::OperationType::OPC_BATCH_READ,
+                                          members.size());
+    RequestTiming::StageTimer stageTimer(RequestTiming::Stage::OPC);
+
+    if (members.empty()) {
+        return {};
+    }
+
+    std::vector<std::string> nodeIds;
+    nodeIds.reserve(members.size());
+    for (size_t member : members) {
+        nodeIds.push_back(prepared.nodeId(member));
+    }
+
+    if (!circuitBreaker_.allowRequest()) {
+        return createCircuitRejection(nodeIds);
+    }
+
+    auto lock = lockClient();
+
+    if (!isConnected() && !failoverLocked("active session lost")) {
+        return createNotConnectedErrors(nodeIds);
+    }
+
+    // Members whose node ID did not parse fail here and are left out of the requests
+    uint64_t timestamp = getCurrentTimestamp();
+    std::vector<ReadResult> results(members.size());
+    std::vector<size_t> readable;
+    readable.reserve(members.size());
+    for (size_t i = 0; i < members.size(); ++i) {
+        if (prepared.isValid(members[i])) {
+            readable.push_back(i);
+        } else {
+            results[i] = ReadResult::createError(nodeIds[i], "Invalid NodeId format", timestamp);
+        }
+    }
+    if (readable.empty()) {
+        return results;
+    }
+
+    size_t requestCount = (readable.size() + batchSize_ - 1) / batchSize_;
+    if (!readBudget_.tryAcquire(readable.size(), requestCount, priority)) {
+        return createBudgetRejection(nodeIds);
+    }
+
+    // The request borrows the prepared read value IDs, so it is never cleared
+    UA_ReadRequest request;
+    UA_ReadRequest_init(&request);
+    request.requestHeader.timeoutHint = static_cast<UA_UInt32>(readTimeout_.count());
+
+    std::vector<UA_ReadValueId> nodesToRead;
+    std::vector<std::string> batchNodeIds;
+    nodesToRead.reserve(std::min(batchSize_, readable.size()));
+    batchNodeIds.reserve(std::min(batchSize_, readable.size()));
+
+    for (size_t start = 0; start < readable.size(); start += batchSize_) {
+        size_t end = std::min(start + batchSize_, readable.size());
+        nodesToRead.clear();
+        batchNodeIds.clear();
+        for (size_t i = start; i < end; ++i) {
+            nodesToRead.push_back(prepared.readValueIds_[members[readable[i]]]);
+            batchNodeIds.push_back(nodeIds[readable[i]]);
+        }
+
+        request.requestHeader.timestamp = UA_DateTime_now();
+        request.nodesToReadSize = nodesToRead.size();
+        request.nodesToRead = nodesToRead.data();
+
+        RequestTiming::countOpcRequest();
+        UA_ReadResponse response = UA_Client_Service_read(client_, request);
+        recordReadOutcome(response.responseHeader.serviceResult);
+
+        auto batchResults = processReadResponse(batchNodeIds, response);
+        UA_ReadResponse_clear(&response);
+
+        for (size_t i = start; i < end && i - start < batchResults.size(); ++i) {
+            results[readable[i]] = std::move(batchResults[i - start]);
+        }
+    }
+
+    return results;
+}
+
 std::vector<ReadResult> OPCUAClient::performBatchRead(const std::vector<std::string>& nodeIds) {
     std::vector<ReadResult> results;
     results.reserve(nodeIds.size());
@@ -609,7 +1064,9 @@ std::vector<ReadResult> OPCUAClient::performBatchRead(const std::vector<std::str
     UA_ReadRequest request = createReadRequest(validNodeIds);
 
     // Perform the batch read operation
+    RequestTiming::countOpcRequest();
     UA_ReadResponse response = UA_Client_Service_read(client_, request);
+    recordReadOutcome(response.responseHeader.serviceResult);
 
     // Process response for valid nodes
     std::vector<ReadResult> validResults = processReadResponse(validNodeIds, response);
@@ -704,13 +1161,113 @@ std::vector<ReadResult> OPCUAClient::processReadResponse(const std::vector<std::
     return results;
 }
 
+ReadBudget& OPCUAClient::getReadBudget() {
+    return readBudget_;
+}
+
+const ReadBudget& OPCUAClient::getReadBudget() const {
+    return readBudget_;
+}
+
+std::vector<ReadResult> OPCUAClient::createNotConnectedErrors(const std::vector<std::string>& nodeIds) {
+    uint64_t timestamp = getCurrentTimestamp();
+    std::string error = "Client not connected";
+    if (!lastError_.empty()) {
+        error += " - " + lastError_;
+    }
+    setLastError(error);
+    circuitBreaker_.recordFailure();
+
+    std::vector<ReadResult> results;
+    results.reserve(nodeIds.size());
+    for (const auto& nodeId : nodeIds) {
+        results.push_back(ReadResult::createError(nodeId, error, timestamp));
+    }
+    return results;
+}
+
+std::vector<ReadResult> OPCUAClient::createBudgetRejection(const std::vector<std::string>& nodeIds) {
+    uint64_t timestamp = getCurrentTimestamp();
+    std::vector<ReadResult> results;
+    results.reserve(nodeIds.size());
+    for (const auto& nodeId : nodeIds) {
+        results.push_back(ReadResult::createError(nodeId, ReadBudget::EXHAUSTED_ERROR, timestamp));
+    }
+    return results;
+}
+
+CircuitBreaker& OPCUAClient::getCircuitBreaker() {
+    return circuitBreaker_;
+}
+
+const CircuitBreaker& OPCUAClient::getCircuitBreaker() const {
+    return circuitBreaker_;
+}
+
+bool OPCUAClient::isServerUnreachable(UA_StatusCode statusCode) {
+    // Node-level errors (unknown node, access denied, ...) prove the server is answering
+    switch (statusCode) {
+        case UA_STATUSCODE_BADCONNECTIONCLOSED:
+        case UA_STATUSCODE_BADCONNECTIONREJECTED:
+        case UA_STATUSCODE_BADSECURECHANNELCLOSED:
+        case UA_STATUSCODE_BADSECURECHANNELIDINVALID:
+        case UA_STATUSCODE_BADSESSIONCLOSED:
+        case UA_STATUSCODE_BADSESSIONIDINVALID:
+        case UA_STATUSCODE_BADSESSIONNOTACTIVATED:
+        case UA_STATUSCODE_BADNOTCONNECTED:
+        case UA_STATUSCODE_BADSERVERNOTCONNECTED:
+        case UA_STATUSCODE_BADDISCONNECT:
+        case UA_STATUSCODE_BADCOMMUNICATIONERROR:
+        case UA_STATUSCODE_BADNOCOMMUNICATION:
+        case UA_STATUSCODE_BADTIMEOUT:
+        case UA_STATUSCODE_BADREQUESTTIMEOUT:
+        case UA_STATUSCODE_BADSHUTDOWN:
+        case UA_STATUSCODE_BADSERVERHALTED:
+            return true;
+        default:
+            return false;
+    }
+}
+
+std::vector<ReadResult> OPCUAClient::createCircuitRejection(const std::vector<std::string>& nodeIds) {
+    uint64_t timestamp = getCurrentTimestamp();
+    std::vector<ReadResult> results;
+    results.reserve(nodeIds.size());
+    for (const auto& nodeId : nodeIds) {
+        results.push_back(ReadResult::createError(nodeId, CircuitBreaker::OPEN_ERROR, timestamp));
+    }
+    return results;
+}
+
+void OPCUAClient::setPerformanceMonitor(PerformanceMonitor* monitor) {
+    performanceMonitor_ = monitor;
+}
+
+void OPCUAClient::setLockProfiler(LockProfiler* profiler) {
+    lockProfiler_ = profiler;
+}
+
+ProfiledLock<std::unique_lock<std::timed_mutex>> OPCUAClient::lockClient(std::source_location site) const {
+    return LockProfiler::acquire(lockProfiler_, LockProfiler::LockId::CLIENT_MUTEX,
+                                 std::unique_lock<std::timed_mutex>(clientMutex_, std::defer_lock),
+                                 performanceMonitor_, PerformanceMonitor::LockType::CLIENT_MUTEX, site);
+}
+
+void OPCUAClient::recordReadOutcome(UA_StatusCode statusCode) {
+    if (isServerUnreachable(statusCode)) {
+        circuitBreaker_.recordFailure();
+    } else {
+        circuitBreaker_.recordSuccess();
+    }
+}
+
 std::string OPCUAClient::getLastError() const {
     std::lock_guard<std::mutex> lock(errorMutex_);
     return lastError_;
 }
 
 void OPCUAClient::setReadTimeout(std::chrono::milliseconds timeout) {
-    std::lock_guard<std::mutex> lock(clientMutex_);
+    auto lock = lockClient();
     readTimeout_ = timeout;
 
     // Update client configuration if initialized
@@ -722,13 +1279,13 @@ void OPCUAClient::setReadTimeout(std::chrono::milliseconds timeout) {
 }
 
 void OPCUAClient::setRetryCount(int retries) {
-    std::lock_guard<std::mutex> lock(clientMutex_);
+    auto lock = lockClient();
     retryCount_ = retries;
     spdlog::info("OPC UA retry count set to {}", retries);
 }
 
 void OPCUAClient::setConnectionTimeout(std::chrono::milliseconds timeout) {
-    std::lock_guard<std::mutex> lock(clientMutex_);
+    auto lock = lockClient();
     connectionTimeout_ = timeout;
 
     // Update client configuration if initialized
@@ -746,7 +1303,7 @@ bool OPCUAClient::isConnectionHealthy() const {
     }
     
     // Perform a lightweight health check by reading the server status
-    std::lock_guard<std::mutex> lock(clientMutex_);
+    auto lock = lockClient();
     
     if (!client_) {
         return false;
@@ -780,7 +1337,7 @@ bool OPCUAClient::performHealthCheck() const {
         return false;
     }
     
-    std::lock_guard<std::mutex> lock(clientMutex_);
+    auto lock = lockClient();
     
     if (!client_) {
         return false;
@@ -798,12 +1355,12 @@ bool OPCUAClient::performHealthCheck() const {
 }
 
 std::chrono::steady_clock::time_point OPCUAClient::getLastConnectionAttempt() const {
-    std::lock_guard<std::mutex> lock(clientMutex_);
+    auto lock = lockClient();
     return lastConnectionAttempt_;
 }
 
 std::chrono::milliseconds OPCUAClient::getTimeSinceLastAttempt() const {
-    std::lock_guard<std::mutex> lock(clientMutex_);
+    auto lock = lockClient();
     auto now = std::chrono::steady_clock::now();
     return std::chrono::duration_cast<std::chrono::milliseconds>(now - lastConnectionAttempt_);
 }
@@ -0,0 +1,165 @@
+#include "opcua/ReadBudget.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+
+namespace opcua2http {
+
+ReadBudget::ReadBudget()
+    : lastRefill_(std::chrono::steady_clock::now()) {
+}
+
+void ReadBudget::configure(double nodesPerSecond, double requestsPerSecond, double synchronousReserve) {
+    if (nodesPerSecond < 0.0) {
+        spdlog::warn("ReadBudget: Invalid node rate {}, using unlimited", nodesPerSecond);
+        nodesPerSecond = 0.0;
+    }
+    if (requestsPerSecond < 0.0) {
+        spdlog::warn("ReadBudget: Invalid request rate {}, using unlimited", requestsPerSecond);
+        requestsPerSecond = 0.0;
+    }
+    if (synchronousReserve < 0.0 || synchronousReserve > 1.0) {
+        spdlog::warn("ReadBudget: Invalid synchronous reserve {}, using 0.3", synchronousReserve);
+        synchronousReserve = 0.3;
+    }
+
+    std::lock_guard<std::mutex> lock(budgetMutex_);
+    nodeBucket_.rate = nodesPerSecond;
+    nodeBucket_.tokens = nodesPerSecond;
+    requestBucket_.rate = requestsPerSecond;
+    requestBucket_.tokens = requestsPerSecond;
+    synchronousReserve_ = synchronousReserve;
+    lastRefill_ = std::chrono::steady_clock::now();
+
+    if (nodesPerSecond > 0.0 || requestsPerSecond > 0.0) {
+        spdlog::info("ReadBudget: Limiting OPC reads to {} nodes/s, {} requests/s ({}% reserved for synchronous reads)",
+                     nodesPerSecond, requestsPerSecond, synchronousReserve * 100.0);
+    }
+}
+
+bool ReadBudget::isEnabled() const {
+    std::lock_guard<std::mutex> lock(budgetMutex_);
+    return nodeBucket_.rate > 0.0 || requestBucket_.rate > 0.0;
+}
+
+bool ReadBudget::tryAcquire(size_t nodeCount, size_t requestCount, Priority priority) {
+    {
+        std::lock_guard<std::mutex> lock(budgetMutex_);
+
+        if (nodeBucket_.rate <= 0.0 && requestBucket_.rate <= 0.0) {
+            grantedRequests_ += requestCount;
+            grantedNodes_ += nodeCount;
+            return true;
+        }
+
+        refill(std::chrono::steady_clock::now());
+
+        double nodeCost = static_cast<double>(nodeCount);
+        double requestCost = static_cast<double>(requestCount);
+
+        if (canAfford(nodeBucket_, nodeCost, priority) &&
+            canAfford(requestBucket_, requestCost, priority)) {
+            // Reads larger than a bucket may drive it negative; the debt is
+            // repaid by later refills, which keeps the long-run rate bounded.
+            if (nodeBucket_.rate > 0.0) {
+                nodeBucket_.tokens -= nodeCost;
+            }
+            if (requestBucket_.rate > 0.0) {
+                requestBucket_.tokens -= requestCost;
+            }
+            grantedRequests_ += requestCount;
+            grantedNodes_ += nodeCount;
+            return true;
+        }
+    }
+
+    rejectedRequests_ += requestCount;
+    rejectedNodes_ += nodeCount;
+    switch (priority) {
+        case Priority::SYNCHRONOUS:
+            rejectedSynchronous_++;
+            break;
+        case Priority::BACKGROUND:
+            rejectedBackground_++;
+            break;
+        case Priority::RETRY:
+            rejectedRetries_++;
+            break;
+    }
+    return false;
+}
+
+bool ReadBudget::isExhaustedError(const std::string& error) {
+    return error.find(EXHAUSTED_ERROR) != std::string::npos;
+}
+
+ReadBudget::BudgetStats ReadBudget::getStats() const {
+    BudgetStats stats;
+
+    {
+        std::lock_guard<std::mutex> lock(budgetMutex_);
+        // Refill on a copy so reading stats does not move the bucket state
+        Bucket nodes = nodeBucket_;
+        Bucket requests = requestBucket_;
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - lastRefill_).count();
+        nodes.tokens = std::min(nodes.rate, nodes.tokens + elapsed * nodes.rate);
+        requests.tokens = std::min(requests.rate, requests.tokens + elapsed * requests.rate);
+
+        stats.nodesPerSecond = nodeBucket_.rate;
+        stats.requestsPerSecond = requestBucket_.rate;
+        stats.synchronousReserve = synchronousReserve_;
+        stats.nodeUtilization = utilization(nodes);
+        stats.requestUtilization = utilization(requests);
+    }
+
+    stats.grantedRequests = grantedRequests_.load();
+    stats.grantedNodes = grantedNodes_.load();
+    stats.rejectedRequests = rejectedRequests_.load();
+    stats.rejectedNodes = rejectedNodes_.load();
+    stats.rejectedSynchronous = rejectedSynchronous_.load();
+    stats.rejectedBackground = rejectedBackground_.load();
+    stats.rejectedRetries = rejectedRetries_.load();
+
+    return stats;
+}
+
+void ReadBudget::clearStats() {
+    grantedRequests_ = 0;
+    grantedNodes_ = 0;
+    rejectedRequests_ = 0;
+    rejectedNodes_ = 0;
+    rejectedSynchronous_ = 0;
+    rejectedBackground_ = 0;
+    rejectedRetries_ = 0;
+}
+
+void ReadBudget::refill(std::chrono::steady_clock::time_point now) {
+    double elapsed = std::chrono::duration<double>(now - lastRefill_).count();
+    lastRefill_ = now;
+
+    nodeBucket_.tokens = std::min(nodeBucket_.rate, nodeBucket_.tokens + elapsed * nodeBucket_.rate);
+    requestBucket_.tokens = std::min(requestBucket_.rate, requestBucket_.tokens + elapsed * requestBucket_.rate);
+}
+
+bool ReadBudget::canAfford(const Bucket& bucket, double cost, Priority priority) const {
+    if (bucket.rate <= 0.0) {
+        return true;
+    }
+
+    // Non-synchronous reads must leave the reserved share untouched
+    double floor = priority == Priority::SYNCHRONOUS ? 0.0 : bucket.rate * synchronousReserve_;
+
+    // A read larger than the usable part of the bucket is admitted once the
+    // bucket is full, otherwise it could never run
+    double required = std::min(cost, bucket.rate - floor);
+
+    return bucket.tokens - floor >= required && required > 0.0;
+}
+
+double ReadBudget::utilization(const Bucket& bucket) {
+    if (bucket.rate <= 0.0) {
+        return 0.0;
+    }
+    return std::clamp(1.0 - bucket.tokens / bucket.rate, 0.0, 1.0);
+}
+
+} // namespace opcua2http
@@ -0,0 +1,163 @@
+#include "opcua/StandbySession.h"
+#include <spdlog/spdlog.h>
+
+#include <open62541/client_highlevel.h>
+
+namespace opcua2http {
+
+StandbySession::StandbySession(ClientFactory factory)
+    : factory_(std::move(factory))
+    , client_(nullptr)
+    , nextCandidate_(0)
+    , ready_(false)
+    , serviceLevel_(SERVICE_LEVEL_UNKNOWN) {
+}
+
+StandbySession::~StandbySession() {
+    std::lock_guard<std::mutex> lock(sessionMutex_);
+    if (client_) {
+        UA_Client_disconnect(client_);
+        UA_Client_delete(client_);
+        client_ = nullptr;
+    }
+}
+
+void StandbySession::setEndpoints(const std::vector<std::string>& endpoints) {
+    std::lock_guard<std::mutex> lock(sessionMutex_);
+    endpoints_ = endpoints;
+    nextCandidate_ = 0;
+}
+
+bool StandbySession::isEnabled() const {
+    // endpoints_ is only written during initialization, before the monitor starts
+    return endpoints_.size() > 1;
+}
+
+void StandbySession::maintain(const std::string& activeEndpoint, std::chrono::milliseconds retryDelay) {
+    std::lock_guard<std::mutex> lock(sessionMutex_);
+
+    if (endpoints_.size() < 2) {
+        return;
+    }
+
+    if (!client_) {
+        client_ = factory_();
+        if (!client_) {
+            spdlog::error("Failed to create standby OPC UA client");
+            return;
+        }
+    }
+
+    if (ready_) {
+        // Reading ServiceLevel doubles as the keep-alive for the idle session
+        UA_Client_run_iterate(client_, 0);
+        serviceLevel_ = readServiceLevel(client_);
+
+        if (isSessionActive(client_)) {
+            return;
+        }
+
+        spdlog::warn("Standby session to {} lost", getEndpoint());
+        ready_ = false;
+        serviceLevel_ = SERVICE_LEVEL_UNKNOWN;
+        setEndpoint("");
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (now - lastAttempt_ < retryDelay) {
+        return;
+    }
+    lastAttempt_ = now;
+
+    // Rotate through the endpoints the active session is not using
+    std::string candidate;
+    for (size_t i = 0; i < endpoints_.size() && candidate.empty(); ++i) {
+        size_t index = (nextCandidate_ + i) % endpoints_.size();
+        if (endpoints_[index] != activeEndpoint) {
+            candidate = endpoints_[index];
+            nextCandidate_ = index + 1;
+        }
+    }
+    if (candidate.empty()) {
+        return;
+    }
+
+    UA_Client_disconnect(client_);
+    UA_StatusCode status = UA_Client_connect(client_, candidate.c_str());
+    if (status != UA_STATUSCODE_GOOD) {
+        spdlog::debug("Standby connection to {} failed: {}", candidate, UA_StatusCode_name(status));
+        return;
+    }
+
+    serviceLevel_ = readServiceLevel(client_);
+    setEndpoint(candidate);
+    ready_ = true;
+    spdlog::info("Standby session established to {} (ServiceLevel {})", candidate, serviceLevel_.load());
+}
+
+bool StandbySession::isReady() const {
+    return ready_;
+}
+
+int StandbySession::getServiceLevel() const {
+    return serviceLevel_;
+}
+
+std::string StandbySession::getEndpoint() const {
+    std::lock_guard<std::mutex> lock(endpointMutex_);
+    return endpoint_;
+}
+
+UA_Client* StandbySession::promote(UA_Client* demoted, std::string& promotedEndpoint) {
+    std::unique_lock<std::mutex> lock(sessionMutex_, std::try_to_lock);
+    if (!lock.owns_lock() || !ready_) {
+        return nullptr;
+    }
+
+    UA_Client* promoted = client_;
+    promotedEndpoint = getEndpoint();
+
+    // The demoted client is reconnected by the next maintain() call
+    client_ = demoted;
+    ready_ = false;
+    serviceLevel_ = SERVICE_LEVEL_UNKNOWN;
+    lastAttempt_ = std::chrono::steady_clock::time_point{};
+    setEndpoint("");
+
+    return promoted;
+}
+
+int StandbySession::readServiceLevel(UA_Client* client) {
+    if (!client) {
+        return SERVICE_LEVEL_UNKNOWN;
+    }
+
+    UA_Variant value;
+    UA_Variant_init(&value);
+    UA_StatusCode status = UA_Client_readValueAttribute(
+        client, UA_NODEID_NUMERIC(0, UA_NS0ID_SERVER_SERVICELEVEL), &value);
+
+    int level = SERVICE_LEVEL_UNKNOWN;
+    if (status == UA_STATUSCODE_GOOD && !UA_Variant_isEmpty(&value) &&
+        value.type == &UA_TYPES[UA_TYPES_BYTE]) {
+        level = *static_cast<UA_Byte*>(value.data);
+    }
+
+    UA_Variant_clear(&value);
+    return level;
+}
+
+bool StandbySession::isSessionActive(UA_Client* client) {
+    UA_SecureChannelState channelState;
+    UA_SessionState sessionState;
+    UA_StatusCode connectStatus;
+    UA_Client_getState(client, &channelState, &sessionState, &connectStatus);
+    return channelState == UA_SECURECHANNELSTATE_OPEN && sessionState == UA_SESSIONSTATE_ACTIVATED;
+}
+
+void StandbySession::setEndpoint(const std::string& endpoint) {
+    std::lock_guard<std::mutex> lock(endpointMutex_);
+    endpoint_ = endpoint;
+}
+
+} // namespace opcua2http
@@ -55,12 +55,23 @@ bool ReconnectionManager::startMonitoring() {
     monitoring_.store(true);
     updateState(ReconnectionState::MONITORING);
 
+    {
+        std::lock_guard<std::mutex> eventLock(eventMutex_);
+        stateEventPending_ = false;
+        dropDetectedTime_ = std::chrono::steady_clock::time_point{};
+    }
+    seenFailovers_.store(opcClient_->getFailoverStats().failovers);
+    opcClient_->setStateChangeCallback([this](OPCUAClient::ConnectionState state, UA_StatusCode) {
+        onClientStateChange(state == OPCUAClient::ConnectionState::CONNECTED);
+    });
+
     try {
         monitorThread_ = std::thread(&ReconnectionManager::monitoringLoop, this);
         logActivity("Connection monitoring thread started successfully");
         return true;
     } catch (const std::exception& e) {
         monitoring_.store(false);
+        opcClient_->setStateChangeCallback(nullptr);
         updateState(ReconnectionState::IDLE);
         std::ostringstream oss;
         oss << "Failed to start monitoring thread: " << e.what();
@@ -78,7 +89,13 @@ void ReconnectionManager::stopMonitoring() {
 
     logActivity("Stopping connection monitoring");
 
-    monitoring_.store(false);
+    opcClient_->setStateChangeCallback(nullptr);
+    {
+        // Store under the event mutex so the wakeup cannot be missed
+        std::lock_guard<std::mutex> eventLock(eventMutex_);
+        monitoring_.store(false);
+    }
+    eventCondition_.notify_all();
     updateState(ReconnectionState::IDLE);
 
     if (monitorThread_.joinable()) {
@@ -119,6 +136,12 @@ ReconnectionManager::ReconnectionStats ReconnectionManager::getStats() const {
     stats.isMonitoring = monitoring_.load();
     stats.currentRetryAttempt = currentRetryAttempt_.load();
     stats.nextRetryDelay = const_cast<ReconnectionManager*>(this)->calculateRetryDelay(currentRetryAttempt_.load());
+    stats.lastReconnectLatency = lastReconnectLatency_.load();
+    stats.maxReconnectLatency = maxReconnectLatency_.load();
+    uint64_t measured = measuredReconnects_.load();
+    stats.averageReconnectLatency = measured > 0 ?
+        totalReconnectLatency_.load() / static_cast<std::chrono::milliseconds::rep>(measured) :
+        std::chrono::milliseconds::zero();
 
     return stats;
 }
@@ -204,6 +227,8 @@ std::string ReconnectionManager::getDetailedStatus() const {
         }
     }
     oss << "\n";
+    oss << "Last Reconnect Latency: " << lastReconnectLatency_.load().count() << "ms\n";
+    oss << "Max Reconnect Latency: " << maxReconnectLatency_.load().count() << "ms\n";
 
     // Timing information
     auto now = std::chrono::steady_clock::now();
@@ -240,6 +265,25 @@ void ReconnectionManager::setDetailedLoggingEnabled(bool enabled) {
     logActivity(oss.str());
 }
 
+void ReconnectionManager::setExternalPolling(bool enabled) {
+    externalPolling_.store(enabled);
+    // Re-evaluate the current wait under the new pacing
+    requestCheck();
+}
+
+void ReconnectionManager::requestCheck() {
+    {
+        std::lock_guard<std::mutex> lock(eventMutex_);
+        stateEventPending_ = true;
+    }
+    eventCondition_.notify_all();
+}
+
+void ReconnectionManager::requestSubscriptionCleanup() {
+    subscriptionCleanupPending_.store(true);
+    requestCheck();
+}
+
 bool ReconnectionManager::isDetailedLoggingEnabled() const {
     return detailedLoggingEnabled_.load();
 }
@@ -253,6 +297,10 @@ void ReconnectionManager::resetStats() {
     subscriptionRecoveries_.store(0);
     successfulSubscriptionRecoveries_.store(0);
     totalDowntime_.store(std::chrono::milliseconds::zero());
+    measuredReconnects_.store(0);
+    lastReconnectLatency_.store(std::chrono::milliseconds::zero());
+    totalReconnectLatency_.store(std::chrono::milliseconds::zero());
+    maxReconnectLatency_.store(std::chrono::milliseconds::zero());
 
     lastAttemptTime_ = std::chrono::steady_clock::time_point{};
     disconnectionTime_ = std::chrono::steady_clock::time_point{};
@@ -291,17 +339,23 @@ void ReconnectionManager::monitoringLoop() {
     while (monitoring_.load()) {
         try {
             // CRITICAL: Process network events to detect connection state changes
-            // Without this, the client cannot detect when server goes down or comes back up
+            // Without this, the client cannot detect when server goes down or comes back up.
+            // Drops noticed by other client calls wake the wait below via onClientStateChange.
             opcClient_->runIterate(10);
 
             bool isConnected = checkConnectionStatus();
 
             // Detect connection state changes
-            if (wasConnected && !isConnected) {
+            if (isConnected && handleClientFailover()) {
+                // Already running on the standby session
+                connectionLost = false;
+            } else if (wasConnected && !isConnected) {
                 // Connection lost
                 logActivity("Connection lost detected", true);
                 connectionLost = true;
-                disconnectionTime_ = std::chrono::steady_clock::now();
+                auto detectedTime = takeDropDetectedTime();
+                disconnectionTime_ = detectedTime != std::chrono::steady_clock::time_point{} ?
+                    detectedTime : std::chrono::steady_clock::now();
                 resetRetryAttempts();
                 handleConnectionStateChange(false, false);
             } else if (!wasConnected && isConnected && connectionLost) {
@@ -320,6 +374,7 @@ void ReconnectionManager::monitoringLoop() {
                 if (attemptReconnection()) {
                     // Reconnection successful
                     connectionLost = false;
+                    isConnected = true;
                     handleConnectionStateChange(true, true);
                     updateState(ReconnectionState::MONITORING);
                 } else {
@@ -335,6 +390,7 @@ void ReconnectionManager::monitoringLoop() {
                         logActivity(oss.str());
                     }
 
+                    // The backoff is cut short if the client reports a state change
                     if (!waitOrStop(delay)) {
                         // Monitoring was stopped during wait
                         break;
@@ -346,12 +402,23 @@ void ReconnectionManager::monitoringLoop() {
 
             wasConnected = isConnected;
 
-            // Regular monitoring interval - faster when disconnected for quicker reconnection
-            auto monitorInterval = isConnected ?
-                std::chrono::milliseconds(1000) :  // 1 second when connected
-                std::chrono::milliseconds(100);    // 100ms when disconnected for faster reconnection
+            // Deletes go out on this thread, so they never overlap runIterate
+            if (isConnected && subscriptionCleanupPending_.exchange(false)) {
+                subscriptionManager_->cleanupUnusedItems();
+            }
 
-            if (!waitOrStop(monitorInterval)) {
+            // While connected, poll once a second (or on the external timer's
+            // request) unless the client reports a change. While reconnecting
+            // the backoff above already paced the loop; disconnected without a
+            // drop to recover from (the initial connect failed), only wait
+            bool active = true;
+            if (isConnected) {
+                active = externalPolling_.load() ? waitForEventOrStop()
+                                                 : waitOrStop(std::chrono::milliseconds(1000));
+            } else if (!connectionLost) {
+                active = waitOrStop(std::chrono::milliseconds(1000));
+            }
+            if (!active) {
                 break;
             }
 
@@ -420,11 +487,19 @@ bool ReconnectionManager::attemptReconnection() {
     bool wasConnected = opcClient_->isConnected();
 
     try {
-        // Force disconnect before reconnecting (safe even if already disconnected)
-        opcClient_->disconnect();
+        // A connected standby session takes over without waiting for the lost server
+        bool failedOver = !wasConnected && opcClient_->failover();
+        if (failedOver) {
+            seenFailovers_.store(opcClient_->getFailoverStats().failovers);
+            logActivity("Switched to standby endpoint " + opcClient_->getEndpoint());
+            success = true;
+        } else {
+            // Force disconnect before reconnecting (safe even if already disconnected)
+            opcClient_->disconnect();
 
-        // Attempt to reconnect
-        success = opcClient_->connect();
+            // Attempt to reconnect
+            success = opcClient_->connect();
+        }
 
         if (success) {
             successfulReconnections_.fetch_add(1);
@@ -463,6 +538,25 @@ bool ReconnectionManager::attemptReconnection() {
     return success;
 }
 
+bool ReconnectionManager::handleClientFailover() {
+    uint64_t failovers = opcClient_->getFailoverStats().failovers;
+    uint64_t seen = seenFailovers_.exchange(failovers);
+    if (failovers == seen) {
+        return false;
+    }
+
+    logActivity("Client failed over to standby endpoint " + opcClient_->getEndpoint());
+    successfulReconnections_.fetch_add(1);
+    updateDowntimeStats();
+    handleConnectionStateChange(true, true);
+
+    if (!recoverSubscriptions()) {
+        logActivity("Subscription recovery after failover failed", true);
+    }
+    updateState(ReconnectionState::MONITORING);
+    return true;
+}
+
 bool ReconnectionManager::recoverSubscriptions() {
     if (!subscriptionManager_) {
         logActivity("No subscription manager available for recovery", true);
@@ -583,13 +677,55 @@ void ReconnectionManager::logActivity(const std::string& message, bool isError)
     std::cout << prefix << "ReconnectionManager: " << message << std::endl;
 }
 
+void ReconnectionManager::onClientStateChange(bool connected) {
+    // Transitions caused by our own disconnect/connect cycle are not news
+    if (reconnecting_.load()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(eventMutex_);
+        if (connected) {
+            // Keep the detection time for a failover so its latency can be measured
+            if (opcClient_->getFailoverStats().failovers == seenFailovers_.load()) {
+                dropDetectedTime_ = std::chrono::steady_clock::time_point{};
+            }
+        } else if (dropDetectedTime_ == std::chrono::steady_clock::time_point{}) {
+            dropDetectedTime_ = std::chrono::steady_clock::now();
+        }
+        stateEventPending_ = true;
+    }
+    eventCondition_.notify_all();
+}
+
+std::chrono::steady_clock::time_point ReconnectionManager::takeDropDetectedTime() {
+    std::lock_guard<std::mutex> lock(eventMutex_);
+    auto detectedTime = dropDetectedTime_;
+    dropDetectedTime_ = std::chrono::steady_clock::time_point{};
+    return detectedTime;
+}
+
 void ReconnectionManager::updateDowntimeStats() {
+    // A manual reconnect without a detected drop still consumes a stale detection time
+    auto detectedTime = takeDropDetectedTime();
+    if (disconnectionTime_ == std::chrono::steady_clock::time_point{}) {
+        disconnectionTime_ = detectedTime;
+    }
+
     if (disconnectionTime_ != std::chrono::steady_clock::time_point{}) {
         auto now = std::chrono::steady_clock::now();
         auto downtime = std::chrono::duration_cast<std::chrono::milliseconds>(now - disconnectionTime_);
         auto currentDowntime = totalDowntime_.load();
         totalDowntime_.store(currentDowntime + downtime);
 
+        // Detection-to-reconnect latency of this outage
+        measuredReconnects_.fetch_add(1);
+        lastReconnectLatency_.store(downtime);
+        totalReconnectLatency_.store(totalReconnectLatency_.load() + downtime);
+        if (downtime > maxReconnectLatency_.load()) {
+            maxReconnectLatency_.store(downtime);
+        }
+
         if (detailedLoggingEnabled_.load()) {
             std::ostringstream oss;
             oss << "Downtime for this disconnection: " << downtime.count() << "ms";
@@ -610,13 +746,23 @@ bool ReconnectionManager::hasReachedMaxRetries() const {
 }
 
 bool ReconnectionManager::waitOrStop(std::chrono::milliseconds duration) {
-    auto endTime = std::chrono::steady_clock::now() + duration;
+    std::unique_lock<std::mutex> lock(eventMutex_);
+    eventCondition_.wait_for(lock, duration, [this]() {
+        return !monitoring_.load() || stateEventPending_;
+    });
+    stateEventPending_ = false;
 
-    while (monitoring_.load() && std::chrono::steady_clock::now() < endTime) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(100)); // Check every 100ms
-    }
+    return monitoring_.load(); // Return true if monitoring continues, false if stopped
+}
 
-    return monitoring_.load(); // Return true if we completed the wait, false if stopped
+bool ReconnectionManager::waitForEventOrStop() {
+    std::unique_lock<std::mutex> lock(eventMutex_);
+    eventCondition_.wait(lock, [this]() {
+        return !monitoring_.load() || stateEventPending_;
+    });
+    stateEventPending_ = false;
+
+    return monitoring_.load();
 }
 
 bool ReconnectionManager::validateConfiguration(const Configuration& config) const {
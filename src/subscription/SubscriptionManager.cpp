@@ -1,5 +1,6 @@
 #include "subscription/SubscriptionManager.h"
 #include "opcua/OPCUAClient.h"
+#include "core/AllocationTracker.h"
 
 #include <iostream>
 #include <sstream>
@@ -59,7 +60,7 @@ SubscriptionManager::~SubscriptionManager() {
 }
 
 bool SubscriptionManager::initializeSubscription() {
-    std::lock_guard<std::mutex> lock(subscriptionMutex_);
+    auto lock = lockSubscriptions();
     
     if (!opcClient_->isConnected()) {
         logActivity("Cannot initialize subscription: OPC UA client not connected", true);
@@ -98,7 +99,7 @@ bool SubscriptionManager::addMonitoredItem(const std::string& nodeId) {
         return false;
     }
     
-    std::lock_guard<std::mutex> lock(subscriptionMutex_);
+    auto lock = lockSubscriptions();
     
     // Check if monitored item already exists
     auto it = monitoredItems_.find(nodeId);
@@ -110,6 +111,7 @@ bool SubscriptionManager::addMonitoredItem(const std::string& nodeId) {
         } else {
             // Remove inactive item first
             monitoredItems_.erase(it);
+            monitoredItemCount_.store(monitoredItems_.size(), std::memory_order_relaxed);
         }
     }
     
@@ -158,6 +160,7 @@ bool SubscriptionManager::addMonitoredItem(const std::string& nodeId) {
     // Store monitored item info
     MonitoredItemInfo info(nodeId, result.monitoredItemId, clientHandle);
     monitoredItems_[nodeId] = info;
+    monitoredItemCount_.store(monitoredItems_.size(), std::memory_order_relaxed);
     handleToNodeId_[clientHandle] = nodeId;
     
     // Mark cache entry as having subscription
@@ -178,7 +181,7 @@ bool SubscriptionManager::removeMonitoredItem(const std::string& nodeId) {
         return false;
     }
     
-    std::lock_guard<std::mutex> lock(subscriptionMutex_);
+    auto lock = lockSubscriptions();
     
     auto it = monitoredItems_.find(nodeId);
     if (it == monitoredItems_.end()) {
@@ -193,6 +196,7 @@ bool SubscriptionManager::removeMonitoredItem(const std::string& nodeId) {
     if (success) {
         // Remove from our tracking
         monitoredItems_.erase(it);
+        monitoredItemCount_.store(monitoredItems_.size(), std::memory_order_relaxed);
         handleToNodeId_.erase(clientHandle);
         
         // Update cache to indicate no subscription
@@ -213,7 +217,7 @@ bool SubscriptionManager::removeMonitoredItem(const std::string& nodeId) {
 }
 
 std::vector<std::string> SubscriptionManager::getActiveMonitoredItems() const {
-    std::lock_guard<std::mutex> lock(subscriptionMutex_);
+    auto lock = lockSubscriptions();
     
     std::vector<std::string> activeItems;
     for (const auto& pair : monitoredItems_) {
@@ -226,7 +230,7 @@ std::vector<std::string> SubscriptionManager::getActiveMonitoredItems() const {
 }
 
 std::vector<std::string> SubscriptionManager::getAllMonitoredItems() const {
-    std::lock_guard<std::mutex> lock(subscriptionMutex_);
+    auto lock = lockSubscriptions();
     
     std::vector<std::string> allItems;
     for (const auto& pair : monitoredItems_) {
@@ -237,7 +241,7 @@ std::vector<std::string> SubscriptionManager::getAllMonitoredItems() const {
 }
 
 bool SubscriptionManager::recreateAllMonitoredItems() {
-    std::lock_guard<std::mutex> lock(subscriptionMutex_);
+    auto lock = lockSubscriptions();
     
     if (!opcClient_->isConnected()) {
         logActivity("Cannot recreate monitored items: OPC UA client not connected", true);
@@ -276,29 +280,11 @@ bool SubscriptionManager::recreateAllMonitoredItems() {
     
     // Clear current monitored items tracking
     monitoredItems_.clear();
+    monitoredItemCount_.store(monitoredItems_.size(), std::memory_order_relaxed);
     handleToNodeId_.clear();
     
-    // Recreate each monitored item
-    bool allSuccess = true;
-    for (const std::string& nodeId : nodeIds) {
-        UA_MonitoredItemCreateResult result = createMonitoredItem(nodeId);
-        if (result.statusCode == UA_STATUSCODE_GOOD) {
-            UA_UInt32 clientHandle = getNextClientHandle() - 1; // We just incremented it in createMonitoredItem
-            MonitoredItemInfo info(nodeId, result.monitoredItemId, clientHandle);
-            monitoredItems_[nodeId] = info;
-            handleToNodeId_[clientHandle] = nodeId;
-            
-            // Ensure cache knows about the subscription
-            cacheManager_->setSubscriptionStatus(nodeId, true);
-        } else {
-            std::ostringstream oss;
-            oss << "Failed to recreate monitored item for node " << nodeId 
-                << ": " << UA_StatusCode_name(result.statusCode);
-            logActivity(oss.str(), true);
-            allSuccess = false;
-            totalErrors_.fetch_add(1);
-        }
-    }
+    // Recreate in batches so a failover costs a few round trips, not one per item
+    bool allSuccess = createMonitoredItemsBatch(nodeIds) == nodeIds.size();
     
     std::ostringstream oss;
     oss << "Recreated " << monitoredItems_.size() << " monitored items";
@@ -316,17 +302,22 @@ size_t SubscriptionManager::cleanupUnusedItems() {
         return 0;
     }
     
-    std::lock_guard<std::mutex> lock(subscriptionMutex_);
-    
-    std::vector<std::string> itemsToRemove;
-    
-    for (const auto& pair : monitoredItems_) {
-        if (isMonitoredItemExpired(pair.second)) {
-            itemsToRemove.push_back(pair.first);
+    // Collect under the subscription lock only; the delete below needs the
+    // client lock, which notification callbacks hold while taking this one
+    std::vector<MonitoredItemInfo> itemsToRemove;
+    UA_UInt32 subscriptionId = 0;
+    {
+        auto lock = lockSubscriptions();
+        
+        for (const auto& pair : monitoredItems_) {
+            if (isMonitoredItemExpired(pair.second)) {
+                itemsToRemove.push_back(pair.second);
+            }
         }
+        subscriptionId = subscriptionId_;
     }
     
-    if (itemsToRemove.empty()) {
+    if (itemsToRemove.empty() || !subscriptionActive_.load()) {
         return 0;
     }
     
@@ -334,61 +325,82 @@ size_t SubscriptionManager::cleanupUnusedItems() {
     oss << "Found " << itemsToRemove.size() << " expired monitored items to clean up";
     logActivity(oss.str());
     
+    std::vector<UA_UInt32> monitoredItemIds;
+    monitoredItemIds.reserve(itemsToRemove.size());
+    for (const auto& item : itemsToRemove) {
+        monitoredItemIds.push_back(item.monitoredItemId);
+    }
+    std::vector<bool> deleted = opcClient_->deleteMonitoredItems(subscriptionId, monitoredItemIds);
+    
     size_t removedCount = 0;
-    for (const std::string& nodeId : itemsToRemove) {
-        auto it = monitoredItems_.find(nodeId);
-        if (it != monitoredItems_.end()) {
-            UA_UInt32 monitoredItemId = it->second.monitoredItemId;
-            UA_UInt32 clientHandle = it->second.clientHandle;
+    {
+        auto lock = lockSubscriptions();
+        
+        for (size_t i = 0; i < itemsToRemove.size(); ++i) {
+            const auto& item = itemsToRemove[i];
+            if (!deleted[i]) {
+                std::ostringstream errorOss;
+                errorOss << "Failed to clean up monitored item for node: " << item.nodeId;
+                logActivity(errorOss.str(), true);
+                totalErrors_.fetch_add(1);
+                continue;
+            }
             
-            if (deleteMonitoredItem(monitoredItemId)) {
+            // Forget the item only if it was not recreated while the lock was released
+            auto it = monitoredItems_.find(item.nodeId);
+            if (it != monitoredItems_.end() && it->second.monitoredItemId == item.monitoredItemId) {
                 monitoredItems_.erase(it);
-                handleToNodeId_.erase(clientHandle);
-                cacheManager_->setSubscriptionStatus(nodeId, false);
-                removedCount++;
-                
-                {
-                    std::ostringstream cleanupOss;
-                    cleanupOss << "Cleaned up unused monitored item for node: " << nodeId;
-                    logActivity(cleanupOss.str());
-                }
-            } else {
-                {
-                    std::ostringstream errorOss;
-                    errorOss << "Failed to clean up monitored item for node: " << nodeId;
-                    logActivity(errorOss.str(), true);
-                }
-                totalErrors_.fetch_add(1);
+                monitoredItemCount_.store(monitoredItems_.size(), std::memory_order_relaxed);
+                handleToNodeId_.erase(item.clientHandle);
+                cacheManager_->setSubscriptionStatus(item.nodeId, false);
             }
+            removedCount++;
+            
+            std::ostringstream cleanupOss;
+            cleanupOss << "Cleaned up unused monitored item for node: " << item.nodeId;
+            logActivity(cleanupOss.str());
+        }
+        
+        if (removedCount > 0) {
+            updateActivity();
         }
     }
     
     if (removedCount > 0) {
-        {
-            std::ostringstream summaryOss;
-            summaryOss << "Successfully cleaned up " << removedCount << " unused monitored items";
-            logActivity(summaryOss.str());
-        }
-        updateActivity();
+        std::ostringstream summaryOss;
+        summaryOss << "Successfully cleaned up " << removedCount << " unused monitored items";
+        logActivity(summaryOss.str());
     }
     
     return removedCount;
 }
 
 void SubscriptionManager::updateLastAccessed(const std::string& nodeId) {
-    std::lock_guard<std::mutex> lock(subscriptionMutex_);
+    auto lock = lockSubscriptions();
     updateLastAccessedUnsafe(nodeId);
 }
 
 bool SubscriptionManager::hasMonitoredItem(const std::string& nodeId) const {
-    std::lock_guard<std::mutex> lock(subscriptionMutex_);
+    auto lock = lockSubscriptions();
     
     auto it = monitoredItems_.find(nodeId);
     return it != monitoredItems_.end() && it->second.isActive;
 }
 
+SubscriptionManager::SubscriptionStats SubscriptionManager::getCounters() const {
+    SubscriptionStats stats{};
+    stats.totalMonitoredItems = monitoredItemCount_.load(std::memory_order_relaxed);
+    // Items are only kept while their subscription on the server succeeded
+    stats.activeMonitoredItems = stats.totalMonitoredItems;
+    stats.totalNotifications = totalNotifications_.load(std::memory_order_relaxed);
+    stats.totalErrors = totalErrors_.load(std::memory_order_relaxed);
+    stats.creationTime = creationTime_;
+    stats.isSubscriptionActive = subscriptionActive_.load();
+    return stats;
+}
+
 SubscriptionManager::SubscriptionStats SubscriptionManager::getStats() const {
-    std::lock_guard<std::mutex> lock(subscriptionMutex_);
+    auto lock = lockSubscriptions();
     
     SubscriptionStats stats;
     stats.subscriptionId = subscriptionId_;
@@ -414,7 +426,7 @@ SubscriptionManager::SubscriptionStats SubscriptionManager::getStats() const {
 }
 
 bool SubscriptionManager::clearAllMonitoredItems() {
-    std::lock_guard<std::mutex> lock(subscriptionMutex_);
+    auto lock = lockSubscriptions();
     
     logActivity("Clearing all monitored items");
     
@@ -439,6 +451,7 @@ bool SubscriptionManager::clearAllMonitoredItems() {
     
     // Clear tracking
     monitoredItems_.clear();
+    monitoredItemCount_.store(monitoredItems_.size(), std::memory_order_relaxed);
     handleToNodeId_.clear();
     
     // Reset subscription
@@ -480,7 +493,7 @@ bool SubscriptionManager::isAutoCleanupEnabled() const {
 }
 
 std::vector<std::string> SubscriptionManager::getUnusedMonitoredItems() const {
-    std::lock_guard<std::mutex> lock(subscriptionMutex_);
+    auto lock = lockSubscriptions();
     
     std::vector<std::string> unusedItems;
     for (const auto& pair : monitoredItems_) {
@@ -493,7 +506,7 @@ std::vector<std::string> SubscriptionManager::getUnusedMonitoredItems() const {
 }
 
 std::string SubscriptionManager::getDetailedStatus() const {
-    std::lock_guard<std::mutex> lock(subscriptionMutex_);
+    auto lock = lockSubscriptions();
     
     std::ostringstream oss;
     oss << "=== Subscription Manager Status ===\n";
@@ -556,6 +569,15 @@ bool SubscriptionManager::isDetailedLoggingEnabled() const {
     return detailedLoggingEnabled_.load();
 }
 
+void SubscriptionManager::setLockProfiler(LockProfiler* profiler) {
+    lockProfiler_ = profiler;
+}
+
+ProfiledLock<std::unique_lock<std::mutex>> SubscriptionManager::lockSubscriptions(std::source_location site) const {
+    return LockProfiler::acquire(lockProfiler_, LockProfiler::LockId::SUBSCRIPTION_MUTEX,
+                                 std::unique_lock<std::mutex>(subscriptionMutex_, std::defer_lock), site);
+}
+
 // Static callback functions
 
 void SubscriptionManager::dataChangeNotificationCallback(UA_Client *client, UA_UInt32 subId, 
@@ -670,37 +692,7 @@ UA_MonitoredItemCreateResult SubscriptionManager::createMonitoredItem(const std:
     
     // Parse node ID
     UA_NodeId nodeIdUA = UA_NODEID_NULL;
-    if (nodeId.find("ns=") == 0) {
-        // Parse namespace and identifier
-        size_t nsEnd = nodeId.find(';');
-        if (nsEnd != std::string::npos) {
-            std::string nsStr = nodeId.substr(3, nsEnd - 3);
-            std::string idPart = nodeId.substr(nsEnd + 1);
-            
-            try {
-                UA_UInt16 namespaceIndex = static_cast<UA_UInt16>(std::stoi(nsStr));
-                
-                if (idPart.find("i=") == 0) {
-                    // Numeric identifier
-                    UA_UInt32 identifier = static_cast<UA_UInt32>(std::stoul(idPart.substr(2)));
-                    nodeIdUA = UA_NODEID_NUMERIC(namespaceIndex, identifier);
-                } else if (idPart.find("s=") == 0) {
-                    // String identifier
-                    std::string identifier = idPart.substr(2);
-                    nodeIdUA = UA_NODEID_STRING_ALLOC(namespaceIndex, identifier.c_str());
-                } else {
-                    result.statusCode = UA_STATUSCODE_BADNODEIDUNKNOWN;
-                    return result;
-                }
-            } catch (const std::exception&) {
-                result.statusCode = UA_STATUSCODE_BADNODEIDUNKNOWN;
-                return result;
-            }
-        } else {
-            result.statusCode = UA_STATUSCODE_BADNODEIDUNKNOWN;
-            return result;
-        }
-    } else {
+    if (!parseMonitoredNodeId(nodeId, nodeIdUA)) {
         result.statusCode = UA_STATUSCODE_BADNODEIDUNKNOWN;
         return result;
     }
@@ -729,6 +721,143 @@ UA_MonitoredItemCreateResult SubscriptionManager::createMonitoredItem(const std:
     return result;
 }
 
+size_t SubscriptionManager::createMonitoredItemsBatch(const std::vector<std::string>& nodeIds) {
+    UA_Client* client = opcClient_->getClient();
+    if (!client) {
+        totalErrors_.fetch_add(nodeIds.size());
+        return 0;
+    }
+    
+    size_t created = 0;
+    for (size_t start = 0; start < nodeIds.size(); start += MONITORED_ITEM_BATCH_SIZE) {
+        size_t end = std::min(start + MONITORED_ITEM_BATCH_SIZE, nodeIds.size());
+        
+        std::vector<std::string> batchNodeIds;
+        std::vector<UA_MonitoredItemCreateRequest> items;
+        batchNodeIds.reserve(end - start);
+        items.reserve(end - start);
+        
+        for (size_t i = start; i < end; ++i) {
+            UA_NodeId nodeIdUA = UA_NODEID_NULL;
+            if (!parseMonitoredNodeId(nodeIds[i], nodeIdUA)) {
+                logActivity("Failed to recreate monitored item for node " + nodeIds[i] + ": invalid node ID", true);
+                totalErrors_.fetch_add(1);
+                continue;
+            }
+            
+            UA_MonitoredItemCreateRequest item;
+            UA_MonitoredItemCreateRequest_init(&item);
+            item.itemToMonitor.nodeId = nodeIdUA;
+            item.itemToMonitor.attributeId = UA_ATTRIBUTEID_VALUE;
+            item.monitoringMode = UA_MONITORINGMODE_REPORTING;
+            item.requestedParameters.clientHandle = getNextClientHandle();
+            item.requestedParameters.samplingInterval = 1000.0;  // 1 second
+            item.requestedParameters.queueSize = 1;
+            item.requestedParameters.discardOldest = true;
+            
+            items.push_back(item);
+            batchNodeIds.push_back(nodeIds[i]);
+        }
+        
+        if (items.empty()) {
+            continue;
+        }
+        
+        UA_CreateMonitoredItemsRequest request;
+        UA_CreateMonitoredItemsRequest_init(&request);
+        request.subscriptionId = subscriptionId_;
+        request.timestampsToReturn = UA_TIMESTAMPSTORETURN_BOTH;
+        request.itemsToCreate = items.data();
+        request.itemsToCreateSize = items.size();
+        
+        std::vector<void*> contexts(items.size(), this);
+        std::vector<UA_Client_DataChangeNotificationCallback> callbacks(items.size(), dataChangeNotificationCallback);
+        std::vector<UA_Client_DeleteMonitoredItemCallback> deleteCallbacks(items.size(), nullptr);
+        
+        UA_CreateMonitoredItemsResponse response = UA_Client_MonitoredItems_createDataChanges(
+            client, request, contexts.data(), callbacks.data(), deleteCallbacks.data());
+        
+        // The request array is owned by the vector; only the node IDs were allocated
+        for (auto& item : items) {
+            UA_NodeId_clear(&item.itemToMonitor.nodeId);
+        }
+        
+        if (response.responseHeader.serviceResult != UA_STATUSCODE_GOOD) {
+            std::ostringstream oss;
+            oss << "Failed to recreate batch of " << items.size() << " monitored items: "
+                << UA_StatusCode_name(response.responseHeader.serviceResult);
+            logActivity(oss.str(), true);
+            totalErrors_.fetch_add(items.size());
+            UA_CreateMonitoredItemsResponse_clear(&response);
+            continue;
+        }
+        
+        for (size_t i = 0; i < batchNodeIds.size(); ++i) {
+            const std::string& nodeId = batchNodeIds[i];
+            UA_StatusCode status = i < response.resultsSize ?
+                response.results[i].statusCode : UA_STATUSCODE_BADINTERNALERROR;
+            
+            if (status != UA_STATUSCODE_GOOD) {
+                std::ostringstream oss;
+                oss << "Failed to recreate monitored item for node " << nodeId
+                    << ": " << UA_StatusCode_name(status);
+                logActivity(oss.str(), true);
+                totalErrors_.fetch_add(1);
+                continue;
+            }
+            
+            UA_UInt32 clientHandle = items[i].requestedParameters.clientHandle;
+            monitoredItems_[nodeId] = MonitoredItemInfo(nodeId, response.results[i].monitoredItemId, clientHandle);
+            monitoredItemCount_.store(monitoredItems_.size(), std::memory_order_relaxed);
+            handleToNodeId_[clientHandle] = nodeId;
+            
+            // Ensure cache knows about the subscription
+            cacheManager_->setSubscriptionStatus(nodeId, true);
+            created++;
+        }
+        
+        UA_CreateMonitoredItemsResponse_clear(&response);
+    }
+    
+    return created;
+}
+
+bool SubscriptionManager::parseMonitoredNodeId(const std::string& nodeId, UA_NodeId& result) {
+    if (nodeId.find("ns=") != 0) {
+        return false;
+    }
+    
+    // Parse namespace and identifier
+    size_t nsEnd = nodeId.find(';');
+    if (nsEnd == std::string::npos) {
+        return false;
+    }
+    
+    std::string nsStr = nodeId.substr(3, nsEnd - 3);
+    std::string idPart = nodeId.substr(nsEnd + 1);
+    
+    try {
+        UA_UInt16 namespaceIndex = static_cast<UA_UInt16>(std::stoi(nsStr));
+        
+        if (idPart.find("i=") == 0) {
+            // Numeric identifier
+            UA_UInt32 identifier = static_cast<UA_UInt32>(std::stoul(idPart.substr(2)));
+            result = UA_NODEID_NUMERIC(namespaceIndex, identifier);
+            return true;
+        }
+        if (idPart.find("s=") == 0) {
+            // String identifier
+            std::string identifier = idPart.substr(2);
+            result = UA_NODEID_STRING_ALLOC(namespaceIndex, identifier.c_str());
+            return true;
+        }
+    } catch (const std::exception&) {
+        return false;
+    }
+    
+    return false;
+}
+
 bool SubscriptionManager::deleteMonitoredItem(UA_UInt32 monitoredItemId) {
     UA_Client* client = opcClient_->getClient();
     if (!client || !subscriptionActive_.load()) {
@@ -759,7 +888,8 @@ void SubscriptionManager::handleDataChangeNotification(UA_UInt32 monId, const UA
         return;
     }
     
-    std::lock_guard<std::mutex> lock(subscriptionMutex_);
+    AllocationTracker::TagScope allocationTag(AllocationTracker::Tag::SUBSCRIPTION);
+    auto lock = lockSubscriptions();
     
     // Find the node ID for this monitored item
     std::string nodeId;
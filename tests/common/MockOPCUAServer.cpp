@@ -1,9 +1,32 @@
 #include "MockOPCUAServer.h"
+#include <algorithm>
 #include <chrono>
+#include <stdexcept>
 
 namespace opcua2http {
 namespace test {
 
+namespace {
+
+const UA_DataType* dataTypeOf(GeneratedValueType type) {
+    switch (type) {
+        case GeneratedValueType::BOOLEAN:      return &UA_TYPES[UA_TYPES_BOOLEAN];
+        case GeneratedValueType::INT32:
+        case GeneratedValueType::INT32_ARRAY:  return &UA_TYPES[UA_TYPES_INT32];
+        case GeneratedValueType::FLOAT:        return &UA_TYPES[UA_TYPES_FLOAT];
+        case GeneratedValueType::DOUBLE:
+        case GeneratedValueType::DOUBLE_ARRAY: return &UA_TYPES[UA_TYPES_DOUBLE];
+        case GeneratedValueType::STRING:       return &UA_TYPES[UA_TYPES_STRING];
+    }
+    return &UA_TYPES[UA_TYPES_DOUBLE];
+}
+
+bool isArrayType(GeneratedValueType type) {
+    return type == GeneratedValueType::INT32_ARRAY || type == GeneratedValueType::DOUBLE_ARRAY;
+}
+
+} // namespace
+
 MockOPCUAServer::MockOPCUAServer(uint16_t port, const std::string& namespaceName)
     : port_(port)
     , namespaceName_(namespaceName)
@@ -40,6 +63,7 @@ bool MockOPCUAServer::start() {
         server_ = nullptr;
         return false;
     }
+    applyOperationLimits(config);
 
     // Add test namespace
     testNamespaceIndex_ = UA_Server_addNamespace(server_, namespaceName_.c_str());
@@ -50,6 +74,20 @@ bool MockOPCUAServer::start() {
         addTestVariableInternal(testVar.nodeId, testVar.name, testVar.value);
     }
 
+    // Add generated variable sets and the tick that changes their values
+    for (auto& set : generatedSets_) {
+        if (!addGeneratedVariablesInternal(*set)) {
+            UA_Server_delete(server_);
+            server_ = nullptr;
+            return false;
+        }
+    }
+    if (!generatedSets_.empty()) {
+        lastChangeTick_ = std::chrono::steady_clock::now();
+        UA_Server_addRepeatedCallback(server_, &MockOPCUAServer::changeTickCallback, this,
+                                      CHANGE_TICK_MS, nullptr);
+    }
+
     // Start server in separate thread
     running_ = true;
     serverReady_ = false;
@@ -151,6 +189,68 @@ std::string MockOPCUAServer::getNodeIdString(UA_UInt32 nodeId) const {
     return "ns=" + std::to_string(testNamespaceIndex_) + ";i=" + std::to_string(nodeId);
 }
 
+size_t MockOPCUAServer::addGeneratedVariables(const GeneratedVariableSpec& spec) {
+    if (running_) {
+        throw std::logic_error("Generated variables must be added before the server starts");
+    }
+    if (spec.count == 0 || spec.types.empty()) {
+        throw std::invalid_argument("Generated variable set needs a count and at least one type");
+    }
+
+    auto set = std::make_unique<GeneratedVariableSet>();
+    set->owner = this;
+    set->spec = spec;
+    set->changesPerSecond = spec.changesPerSecond;
+
+    UA_DateTime now = UA_DateTime_now();
+    set->variables.reserve(spec.count);
+    for (size_t i = 0; i < spec.count; ++i) {
+        set->variables.push_back({set.get(), static_cast<UA_UInt32>(i),
+                                  spec.types[i % spec.types.size()], 0, now});
+    }
+
+    generatedSets_.push_back(std::move(set));
+    return generatedSets_.size() - 1;
+}
+
+std::string MockOPCUAServer::getGeneratedNodeId(size_t setIndex, size_t index) const {
+    const auto& set = *generatedSets_.at(setIndex);
+    if (index >= set.variables.size()) {
+        throw std::out_of_range("Generated variable index out of range");
+    }
+
+    std::string nodeId = "ns=" + std::to_string(testNamespaceIndex_);
+    if (set.spec.stringNodeIds) {
+        return nodeId + ";s=" + set.spec.namePrefix + "." + std::to_string(index);
+    }
+    return nodeId + ";i=" + std::to_string(set.spec.firstNumericId + index);
+}
+
+std::vector<std::string> MockOPCUAServer::getGeneratedNodeIds(size_t setIndex) const {
+    std::vector<std::string> nodeIds;
+    size_t count = generatedSets_.at(setIndex)->variables.size();
+    nodeIds.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        nodeIds.push_back(getGeneratedNodeId(setIndex, i));
+    }
+    return nodeIds;
+}
+
+GeneratedValueType MockOPCUAServer::getGeneratedType(size_t setIndex, size_t index) const {
+    return generatedSets_.at(setIndex)->variables.at(index).type;
+}
+
+void MockOPCUAServer::setChangesPerSecond(size_t setIndex, double changesPerSecond) {
+    generatedSets_.at(setIndex)->changesPerSecond = changesPerSecond;
+}
+
+void MockOPCUAServer::setReadFaultInjection(const ReadFaultInjection& faults) {
+    readLatencyUs_ = faults.latency.count();
+    readJitterUs_ = faults.jitter.count();
+    readFailureRate_ = std::clamp(faults.failureRate, 0.0, 1.0);
+    readFailureStatus_ = faults.failureStatus;
+}
+
 void MockOPCUAServer::serverThreadFunction() {
     // Start the server
     UA_StatusCode status = UA_Server_run_startup(server_);
@@ -163,10 +263,11 @@ void MockOPCUAServer::serverThreadFunction() {
     serverReady_ = true;
     logMessage("Mock OPC UA server started on port " + std::to_string(port_));
 
-    // Run server loop
+    // Run server loop; each iteration waits for network activity or the next
+    // timed callback (at most 50 ms), so no extra sleep is needed
     while (running_) {
+        readLatencyPending_ = true;
         UA_Server_run_iterate(server_, true);
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
     }
 
     // Shutdown server
@@ -242,6 +343,226 @@ bool MockOPCUAServer::addTestVariableInternal(UA_UInt32 nodeId, const std::strin
     }
 }
 
+void MockOPCUAServer::applyOperationLimits(UA_ServerConfig* config) const {
+    if (operationLimits_.maxNodesPerRead > 0) {
+        config->maxNodesPerRead = operationLimits_.maxNodesPerRead;
+    }
+    if (operationLimits_.maxNodesPerBrowse > 0) {
+        config->maxNodesPerBrowse = operationLimits_.maxNodesPerBrowse;
+    }
+    if (operationLimits_.maxMonitoredItemsPerCall > 0) {
+        config->maxMonitoredItemsPerCall = operationLimits_.maxMonitoredItemsPerCall;
+    }
+#ifdef UA_ENABLE_SUBSCRIPTIONS
+    if (operationLimits_.maxMonitoredItems > 0) {
+        config->maxMonitoredItems = operationLimits_.maxMonitoredItems;
+    }
+    if (operationLimits_.maxSubscriptionsPerSession > 0) {
+        config->maxSubscriptionsPerSession = operationLimits_.maxSubscriptionsPerSession;
+    }
+#endif
+}
+
+bool MockOPCUAServer::addGeneratedVariablesInternal(GeneratedVariableSet& set) {
+    const auto& spec = set.spec;
+
+    // One folder per set keeps the Objects folder small enough to browse
+    UA_ObjectAttributes folderAttr = UA_ObjectAttributes_default;
+    folderAttr.displayName = UA_LOCALIZEDTEXT(const_cast<char*>("en-US"), const_cast<char*>(spec.namePrefix.c_str()));
+
+    UA_NodeId folderId;
+    UA_StatusCode status = UA_Server_addObjectNode(server_, UA_NODEID_NULL,
+                              UA_NODEID_NUMERIC(0, UA_NS0ID_OBJECTSFOLDER),
+                              UA_NODEID_NUMERIC(0, UA_NS0ID_ORGANIZES),
+                              UA_QUALIFIEDNAME(testNamespaceIndex_, const_cast<char*>(spec.namePrefix.c_str())),
+                              UA_NODEID_NUMERIC(0, UA_NS0ID_FOLDERTYPE),
+                              folderAttr, nullptr, &folderId);
+    if (status != UA_STATUSCODE_GOOD) {
+        logMessage("Failed to add folder '" + spec.namePrefix + "': " + std::string(UA_StatusCode_name(status)));
+        return false;
+    }
+
+    UA_DataSource dataSource;
+    dataSource.read = &MockOPCUAServer::generatedDataSourceRead;
+    dataSource.write = nullptr;
+
+    for (auto& variable : set.variables) {
+        std::string name = spec.namePrefix + "." + std::to_string(variable.index);
+
+        UA_VariableAttributes attr = UA_VariableAttributes_default;
+        attr.displayName = UA_LOCALIZEDTEXT(const_cast<char*>("en-US"), const_cast<char*>(name.c_str()));
+        attr.dataType = dataTypeOf(variable.type)->typeId;
+        attr.valueRank = isArrayType(variable.type) ? UA_VALUERANK_ONE_DIMENSION : UA_VALUERANK_SCALAR;
+        attr.accessLevel = UA_ACCESSLEVELMASK_READ;
+        attr.userAccessLevel = UA_ACCESSLEVELMASK_READ;
+
+        UA_NodeId nodeId = generatedNodeId(set, variable.index);
+        status = UA_Server_addDataSourceVariableNode(server_, nodeId, folderId,
+                    UA_NODEID_NUMERIC(0, UA_NS0ID_ORGANIZES),
+                    UA_QUALIFIEDNAME(testNamespaceIndex_, const_cast<char*>(name.c_str())),
+                    UA_NODEID_NUMERIC(0, UA_NS0ID_BASEDATAVARIABLETYPE),
+                    attr, dataSource, &variable, nullptr);
+        UA_NodeId_clear(&nodeId);
+
+        if (status != UA_STATUSCODE_GOOD) {
+            logMessage("Failed to add generated variable '" + name + "': " + std::string(UA_StatusCode_name(status)));
+            UA_NodeId_clear(&folderId);
+            return false;
+        }
+    }
+
+    UA_NodeId_clear(&folderId);
+    logMessage("Added " + std::to_string(set.variables.size()) + " generated variables '" +
+               spec.namePrefix + ".*'");
+    return true;
+}
+
+UA_NodeId MockOPCUAServer::generatedNodeId(const GeneratedVariableSet& set, size_t index) const {
+    if (set.spec.stringNodeIds) {
+        std::string identifier = set.spec.namePrefix + "." + std::to_string(index);
+        return UA_NODEID_STRING_ALLOC(testNamespaceIndex_, identifier.c_str());
+    }
+    return UA_NODEID_NUMERIC(testNamespaceIndex_, set.spec.firstNumericId + static_cast<UA_UInt32>(index));
+}
+
+UA_StatusCode MockOPCUAServer::generatedDataSourceRead(UA_Server* /*server*/, const UA_NodeId* /*sessionId*/,
+                                                       void* /*sessionContext*/, const UA_NodeId* /*nodeId*/,
+                                                       void* nodeContext, UA_Boolean includeSourceTimestamp,
+                                                       const UA_NumericRange* range, UA_DataValue* value) {
+    auto* variable = static_cast<GeneratedVariable*>(nodeContext);
+    return variable->set->owner->readGenerated(*variable, includeSourceTimestamp, range, value);
+}
+
+UA_StatusCode MockOPCUAServer::readGenerated(GeneratedVariable& variable, UA_Boolean includeSourceTimestamp,
+                                             const UA_NumericRange* range, UA_DataValue* value) {
+    // Node creation reads the value for type checking; faults apply to client reads only
+    if (serverReady_) {
+        generatedReads_++;
+        injectReadLatency();
+
+        double failureRate = readFailureRate_.load(std::memory_order_relaxed);
+        if (failureRate > 0.0 && std::uniform_real_distribution<double>(0.0, 1.0)(faultRng_) < failureRate) {
+            injectedFailures_++;
+            return readFailureStatus_.load(std::memory_order_relaxed);
+        }
+    }
+
+    UA_Variant generated;
+    UA_Variant_init(&generated);
+    fillGeneratedValue(variable, generated);
+
+    if (range) {
+        UA_StatusCode status = UA_Variant_copyRange(&generated, &value->value, *range);
+        UA_Variant_clear(&generated);
+        if (status != UA_STATUSCODE_GOOD) {
+            return status;
+        }
+    } else {
+        value->value = generated;
+    }
+    value->hasValue = true;
+
+    if (includeSourceTimestamp) {
+        value->sourceTimestamp = variable.changedAt;
+        value->hasSourceTimestamp = true;
+    }
+    return UA_STATUSCODE_GOOD;
+}
+
+void MockOPCUAServer::injectReadLatency() {
+    if (!readLatencyPending_) {
+        return;
+    }
+    readLatencyPending_ = false;
+
+    int64_t latencyUs = readLatencyUs_.load(std::memory_order_relaxed);
+    int64_t jitterUs = readJitterUs_.load(std::memory_order_relaxed);
+    if (jitterUs > 0) {
+        latencyUs += std::uniform_int_distribution<int64_t>(0, jitterUs)(faultRng_);
+    }
+    if (latencyUs > 0) {
+        std::this_thread::sleep_for(std::chrono::microseconds(latencyUs));
+    }
+}
+
+void MockOPCUAServer::changeTickCallback(UA_Server* /*server*/, void* data) {
+    static_cast<MockOPCUAServer*>(data)->changeGeneratedValues();
+}
+
+void MockOPCUAServer::changeGeneratedValues() {
+    // Owe changes for the time actually elapsed, since ticks run late under load
+    auto now = std::chrono::steady_clock::now();
+    double elapsedSeconds = std::chrono::duration<double>(now - lastChangeTick_).count();
+    lastChangeTick_ = now;
+    UA_DateTime timestamp = UA_DateTime_now();
+
+    for (auto& set : generatedSets_) {
+        double changesPerSecond = set->changesPerSecond.load(std::memory_order_relaxed);
+        if (changesPerSecond <= 0.0) {
+            set->changesOwed = 0.0;
+            continue;
+        }
+
+        set->changesOwed += changesPerSecond * elapsedSeconds;
+        auto due = static_cast<size_t>(set->changesOwed);
+        set->changesOwed -= static_cast<double>(due);
+
+        for (size_t i = 0; i < due; ++i) {
+            auto& variable = set->variables[set->changeCursor];
+            variable.changes++;
+            variable.changedAt = timestamp;
+            set->changeCursor = (set->changeCursor + 1) % set->variables.size();
+        }
+        valueChanges_ += due;
+    }
+}
+
+void MockOPCUAServer::fillGeneratedValue(const GeneratedVariable& variable, UA_Variant& out) {
+    uint64_t number = variable.index + variable.changes;
+    const UA_DataType* type = dataTypeOf(variable.type);
+
+    switch (variable.type) {
+        case GeneratedValueType::BOOLEAN: {
+            UA_Boolean value = number % 2 == 0;
+            UA_Variant_setScalarCopy(&out, &value, type);
+            break;
+        }
+        case GeneratedValueType::INT32: {
+            auto value = static_cast<UA_Int32>(number & 0x7FFFFFFF);
+            UA_Variant_setScalarCopy(&out, &value, type);
+            break;
+        }
+        case GeneratedValueType::FLOAT: {
+            auto value = static_cast<UA_Float>(number);
+            UA_Variant_setScalarCopy(&out, &value, type);
+            break;
+        }
+        case GeneratedValueType::DOUBLE: {
+            auto value = static_cast<UA_Double>(number);
+            UA_Variant_setScalarCopy(&out, &value, type);
+            break;
+        }
+        case GeneratedValueType::STRING: {
+            std::string text = "Value " + std::to_string(variable.index) + "." + std::to_string(variable.changes);
+            UA_String value;
+            value.length = text.size();
+            value.data = reinterpret_cast<UA_Byte*>(text.data());
+            UA_Variant_setScalarCopy(&out, &value, type);
+            break;
+        }
+        case GeneratedValueType::INT32_ARRAY: {
+            std::vector<UA_Int32> values(variable.set->spec.arrayLength, static_cast<UA_Int32>(number & 0x7FFFFFFF));
+            UA_Variant_setArrayCopy(&out, values.data(), values.size(), type);
+            break;
+        }
+        case GeneratedValueType::DOUBLE_ARRAY: {
+            std::vector<UA_Double> values(variable.set->spec.arrayLength, static_cast<UA_Double>(number));
+            UA_Variant_setArrayCopy(&out, values.data(), values.size(), type);
+            break;
+        }
+    }
+}
+
 void MockOPCUAServer::logMessage(const std::string& message) const {
     if (verboseLogging_) {
         std::cout << "[MockOPCUAServer] " << message << std::endl;
@@ -3,6 +3,8 @@
 #include <memory>
 #include <thread>
 #include <atomic>
+#include <chrono>
+#include <random>
 #include <string>
 #include <vector>
 #include <functional>
@@ -55,6 +57,65 @@ struct TestVariable {
     TestVariable& operator=(const TestVariable&) = delete;
 };
 
+/**
+ * @brief Value types for generated variables
+ */
+enum class GeneratedValueType {
+    BOOLEAN,
+    INT32,
+    FLOAT,
+    DOUBLE,
+    STRING,
+    INT32_ARRAY,
+    DOUBLE_ARRAY
+};
+
+/**
+ * @brief Bulk variable set for performance and resilience tests
+ *
+ * Variables are served from a data source instead of being stored in the
+ * server's nodes, so 100k+ variables stay cheap to create and to change.
+ * The value of variable n is derived from n and its change count: numbers
+ * are n + changes, booleans whether that sum is even, strings are
+ * "Value n.changes" and arrays repeat the number arrayLength times.
+ */
+struct GeneratedVariableSpec {
+    size_t count{1000};
+    std::string namePrefix{"PerfVar"};     // Browse names are "<prefix>.<n>"; also the folder name
+    bool stringNodeIds{false};             // ns=<idx>;s=<prefix>.<n> instead of numeric IDs
+    UA_UInt32 firstNumericId{100000};      // Numeric ID of variable 0 (numeric IDs only)
+    std::vector<GeneratedValueType> types{ // Cycled through by variable index
+        GeneratedValueType::DOUBLE, GeneratedValueType::INT32, GeneratedValueType::BOOLEAN,
+        GeneratedValueType::FLOAT, GeneratedValueType::STRING, GeneratedValueType::DOUBLE_ARRAY};
+    size_t arrayLength{8};                 // Element count of array variables
+    double changesPerSecond{0.0};          // Value changes per second across the set, round-robin
+};
+
+/**
+ * @brief Faults injected into reads of generated variables
+ *
+ * The latency is spent once per server iteration that reads generated
+ * variables, which for a synchronous client means once per Read request,
+ * independent of its size - like a slow PLC with a fixed turnaround time.
+ */
+struct ReadFaultInjection {
+    std::chrono::microseconds latency{0};  // Added delay
+    std::chrono::microseconds jitter{0};   // Uniform extra delay in [0, jitter]
+    double failureRate{0.0};               // Fraction of variable reads that fail (0.0 - 1.0)
+    UA_StatusCode failureStatus{UA_STATUSCODE_BADCOMMUNICATIONERROR};
+};
+
+/**
+ * @brief Server operation limits; 0 keeps open62541's default (no limit)
+ */
+struct ServerOperationLimits {
+    UA_UInt32 maxNodesPerRead{0};
+    UA_UInt32 maxNodesPerBrowse{0};
+    UA_UInt32 maxMonitoredItemsPerCall{0};
+    UA_UInt32 maxMonitoredItems{0};        // Per server
+    UA_UInt32 maxSubscriptionsPerSession{0};
+};
+
 /**
  * @brief Reusable mock OPC UA server for testing
  *
@@ -136,6 +197,62 @@ public:
      */
     std::string getNodeIdString(UA_UInt32 nodeId) const;
 
+    /**
+     * @brief Add a bulk set of generated variables (before start() only)
+     * @param spec Variable set specification
+     * @return Index of the new set, used by the other generated-variable methods
+     */
+    size_t addGeneratedVariables(const GeneratedVariableSpec& spec);
+
+    /**
+     * @brief Get the node ID string of a generated variable (valid after start())
+     * @param setIndex Set returned by addGeneratedVariables
+     * @param index Variable index within the set
+     */
+    std::string getGeneratedNodeId(size_t setIndex, size_t index) const;
+
+    /**
+     * @brief Get the node ID strings of all variables in a generated set (valid after start())
+     */
+    std::vector<std::string> getGeneratedNodeIds(size_t setIndex) const;
+
+    /**
+     * @brief Get the value type of a generated variable
+     */
+    GeneratedValueType getGeneratedType(size_t setIndex, size_t index) const;
+
+    /**
+     * @brief Change the value-change rate of a generated set; takes effect on the next tick
+     * @param setIndex Set returned by addGeneratedVariables
+     * @param changesPerSecond Value changes per second across the set
+     */
+    void setChangesPerSecond(size_t setIndex, double changesPerSecond);
+
+    /**
+     * @brief Set the faults injected into reads of generated variables; may be changed while running
+     */
+    void setReadFaultInjection(const ReadFaultInjection& faults);
+
+    /**
+     * @brief Set server operation limits (before start() or restart())
+     */
+    void setOperationLimits(const ServerOperationLimits& limits) { operationLimits_ = limits; }
+
+    /**
+     * @brief Get the number of generated variable reads served, including injected failures
+     */
+    uint64_t getGeneratedReadCount() const { return generatedReads_; }
+
+    /**
+     * @brief Get the number of generated variable reads failed by fault injection
+     */
+    uint64_t getInjectedFailureCount() const { return injectedFailures_; }
+
+    /**
+     * @brief Get the number of generated variable value changes so far
+     */
+    uint64_t getValueChangeCount() const { return valueChanges_; }
+
     /**
      * @brief Set startup timeout in milliseconds (default: 1000ms)
      */
@@ -147,10 +264,46 @@ public:
     void setVerboseLogging(bool enabled) { verboseLogging_ = enabled; }
 
 private:
+    struct GeneratedVariableSet;
+
+    // Per-variable state of a generated set; the node context points here
+    struct GeneratedVariable {
+        GeneratedVariableSet* set;
+        UA_UInt32 index;
+        GeneratedValueType type;
+        uint64_t changes;                 // Value version, bumped by the change tick
+        UA_DateTime changedAt;
+    };
+
+    struct GeneratedVariableSet {
+        MockOPCUAServer* owner;
+        GeneratedVariableSpec spec;
+        std::vector<GeneratedVariable> variables;  // Never resized after creation
+        std::atomic<double> changesPerSecond{0.0};
+        double changesOwed{0.0};          // Fractional changes carried to the next tick
+        size_t changeCursor{0};           // Next variable to change
+    };
+
+    static constexpr double CHANGE_TICK_MS = 10.0;
+
     void serverThreadFunction();
     bool waitForServerReady();
     void logMessage(const std::string& message) const;
     bool addTestVariableInternal(UA_UInt32 nodeId, const std::string& name, const UA_Variant& value);
+    void applyOperationLimits(UA_ServerConfig* config) const;
+    bool addGeneratedVariablesInternal(GeneratedVariableSet& set);
+    UA_NodeId generatedNodeId(const GeneratedVariableSet& set, size_t index) const;
+    UA_StatusCode readGenerated(GeneratedVariable& variable, UA_Boolean includeSourceTimestamp,
+                                const UA_NumericRange* range, UA_DataValue* value);
+    void injectReadLatency();
+    void changeGeneratedValues();
+
+    static UA_StatusCode generatedDataSourceRead(UA_Server* server, const UA_NodeId* sessionId,
+                                                 void* sessionContext, const UA_NodeId* nodeId,
+                                                 void* nodeContext, UA_Boolean includeSourceTimestamp,
+                                                 const UA_NumericRange* range, UA_DataValue* value);
+    static void changeTickCallback(UA_Server* server, void* data);
+    static void fillGeneratedValue(const GeneratedVariable& variable, UA_Variant& out);
 
     uint16_t port_;
     std::string namespaceName_;
@@ -163,6 +316,21 @@ private:
     bool verboseLogging_;
 
     std::vector<TestVariable> testVariables_;
+
+    // Generated variables and fault injection; everything without std::atomic is
+    // touched only by the server thread once the server runs
+    std::vector<std::unique_ptr<GeneratedVariableSet>> generatedSets_;
+    ServerOperationLimits operationLimits_;
+    std::atomic<int64_t> readLatencyUs_{0};
+    std::atomic<int64_t> readJitterUs_{0};
+    std::atomic<double> readFailureRate_{0.0};
+    std::atomic<UA_StatusCode> readFailureStatus_{UA_STATUSCODE_BADCOMMUNICATIONERROR};
+    bool readLatencyPending_{false};      // Latency not yet spent in this server iteration
+    std::mt19937_64 faultRng_{4840};
+    std::chrono::steady_clock::time_point lastChangeTick_;
+    std::atomic<uint64_t> generatedReads_{0};
+    std::atomic<uint64_t> injectedFailures_{0};
+    std::atomic<uint64_t> valueChanges_{0};
 };
 
 /**
@@ -0,0 +1,222 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <chrono>
+#include <memory>
+
+#include "common/MockOPCUAServer.h"
+#include "opcua/OPCUAClient.h"
+#include "config/Configuration.h"
+
+namespace opcua2http {
+namespace test {
+
+/**
+ * @brief Integration tests for MockOPCUAServer's generated variables
+ *
+ * Perf and resilience tests rely on generated variable sets and on the
+ * injected latency, failures and operation limits, so these tests read them
+ * through a real OPCUAClient session.
+ */
+class MockServerScalingTest : public ::testing::Test {
+protected:
+    static constexpr uint16_t SERVER_PORT = 4848;
+
+    void SetUp() override {
+        server_ = std::make_unique<MockOPCUAServer>(SERVER_PORT, "http://test.mock.scaling");
+        server_->setVerboseLogging(false);
+        server_->setStartupTimeout(30000);
+    }
+
+    void TearDown() override {
+        if (client_) {
+            if (client_->isConnected()) {
+                client_->disconnect();
+            }
+            client_.reset();
+        }
+        server_->stop();
+        server_.reset();
+    }
+
+    void startAndConnect(int batchSize = 50) {
+        ASSERT_TRUE(server_->start()) << "Failed to start mock server";
+
+        Configuration config;
+        config.opcEndpoint = server_->getEndpoint();
+        config.securityMode = 1; // None
+        config.securityPolicy = "None";
+        config.defaultNamespace = server_->getTestNamespaceIndex();
+        config.applicationUri = "urn:test:opcua:mock:scaling:client";
+        config.opcReadTimeoutMs = 5000;
+        config.opcConnectionTimeoutMs = 2000;
+        config.opcBatchSize = batchSize;
+
+        client_ = std::make_unique<OPCUAClient>();
+        ASSERT_TRUE(client_->initialize(config));
+        ASSERT_TRUE(client_->connect());
+    }
+
+    std::unique_ptr<MockOPCUAServer> server_;
+    std::unique_ptr<OPCUAClient> client_;
+};
+
+TEST_F(MockServerScalingTest, GeneratesMixedTypesWithNumericAndStringIds) {
+    GeneratedVariableSpec numeric;
+    numeric.count = 2000;
+    numeric.namePrefix = "Numeric";
+    numeric.firstNumericId = 50000;
+    size_t numericSet = server_->addGeneratedVariables(numeric);
+
+    GeneratedVariableSpec named;
+    named.count = 500;
+    named.namePrefix = "Plant.Line1";
+    named.stringNodeIds = true;
+    named.types = {GeneratedValueType::STRING, GeneratedValueType::INT32_ARRAY};
+    size_t namedSet = server_->addGeneratedVariables(named);
+
+    startAndConnect();
+
+    std::string ns = std::to_string(server_->getTestNamespaceIndex());
+    EXPECT_EQ(server_->getGeneratedNodeId(numericSet, 7), "ns=" + ns + ";i=50007");
+    EXPECT_EQ(server_->getGeneratedNodeId(namedSet, 7), "ns=" + ns + ";s=Plant.Line1.7");
+    EXPECT_EQ(server_->getGeneratedType(numericSet, 4), GeneratedValueType::STRING);
+    EXPECT_EQ(server_->getGeneratedNodeIds(namedSet).size(), 500u);
+
+    // One variable of every type in the default mix, plus the last one
+    auto numericIds = server_->getGeneratedNodeIds(numericSet);
+    std::vector<std::string> ids(numericIds.begin(), numericIds.begin() + 6);
+    ids.push_back(numericIds.back());
+    auto results = client_->readNodes(ids);
+    ASSERT_EQ(results.size(), ids.size());
+    for (const auto& result : results) {
+        EXPECT_TRUE(result.success) << result.id << ": " << result.reason;
+    }
+    EXPECT_EQ(results[1].value, "1");            // INT32: index + changes
+    EXPECT_EQ(results[2].value, "true");         // BOOLEAN: 2 is even
+    EXPECT_EQ(results[4].value, "Value 4.0");    // STRING
+
+    auto named0 = client_->readNode(server_->getGeneratedNodeId(namedSet, 0));
+    EXPECT_TRUE(named0.success) << named0.reason;
+    EXPECT_EQ(named0.value, "Value 0.0");
+    auto namedArray = client_->readNode(server_->getGeneratedNodeId(namedSet, 1));
+    EXPECT_TRUE(namedArray.success) << namedArray.reason;
+
+    EXPECT_GE(server_->getGeneratedReadCount(), 9u);
+}
+
+TEST_F(MockServerScalingTest, ServesOneHundredThousandVariables) {
+    GeneratedVariableSpec spec;
+    spec.count = 100000;
+    size_t set = server_->addGeneratedVariables(spec);
+
+    startAndConnect();
+
+    auto results = client_->readNodes({server_->getGeneratedNodeId(set, 0),
+                                       server_->getGeneratedNodeId(set, 54321),
+                                       server_->getGeneratedNodeId(set, 99999)});
+    ASSERT_EQ(results.size(), 3u);
+    for (const auto& result : results) {
+        EXPECT_TRUE(result.success) << result.id << ": " << result.reason;
+    }
+}
+
+TEST_F(MockServerScalingTest, ChangeRateAdvancesValues) {
+    GeneratedVariableSpec spec;
+    spec.count = 100;
+    spec.types = {GeneratedValueType::INT32};
+    size_t set = server_->addGeneratedVariables(spec);
+
+    startAndConnect();
+    std::string nodeId = server_->getGeneratedNodeId(set, 0);
+    auto before = client_->readNode(nodeId);
+    ASSERT_TRUE(before.success);
+    EXPECT_EQ(before.value, "0");
+    EXPECT_EQ(server_->getValueChangeCount(), 0u);
+
+    // 1000 changes/s over 100 variables changes each about 10 times a second
+    server_->setChangesPerSecond(set, 1000.0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    server_->setChangesPerSecond(set, 0.0);
+
+    uint64_t changes = server_->getValueChangeCount();
+    EXPECT_GT(changes, 200u);
+    EXPECT_LT(changes, 1000u);
+
+    auto after = client_->readNode(nodeId);
+    ASSERT_TRUE(after.success);
+    EXPECT_NE(after.value, before.value);
+}
+
+TEST_F(MockServerScalingTest, InjectedFailuresFailReads) {
+    GeneratedVariableSpec spec;
+    spec.count = 20;
+    size_t set = server_->addGeneratedVariables(spec);
+
+    startAndConnect();
+
+    ReadFaultInjection faults;
+    faults.failureRate = 1.0;
+    faults.failureStatus = UA_STATUSCODE_BADNOTREADABLE;
+    server_->setReadFaultInjection(faults);
+
+    auto results = client_->readNodes(server_->getGeneratedNodeIds(set));
+    ASSERT_EQ(results.size(), 20u);
+    for (const auto& result : results) {
+        EXPECT_FALSE(result.success) << result.id;
+    }
+    EXPECT_EQ(server_->getInjectedFailureCount(), 20u);
+
+    server_->setReadFaultInjection(ReadFaultInjection{});
+    EXPECT_TRUE(client_->readNode(server_->getGeneratedNodeId(set, 0)).success);
+}
+
+TEST_F(MockServerScalingTest, InjectedLatencyIsPaidOncePerReadRequest) {
+    GeneratedVariableSpec spec;
+    spec.count = 20;
+    size_t set = server_->addGeneratedVariables(spec);
+
+    startAndConnect();
+
+    ReadFaultInjection faults;
+    faults.latency = std::chrono::milliseconds(100);
+    faults.jitter = std::chrono::milliseconds(20);
+    server_->setReadFaultInjection(faults);
+
+    auto start = std::chrono::steady_clock::now();
+    auto results = client_->readNodes(server_->getGeneratedNodeIds(set));
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    ASSERT_EQ(results.size(), 20u);
+    for (const auto& result : results) {
+        EXPECT_TRUE(result.success) << result.id << ": " << result.reason;
+    }
+    EXPECT_GE(elapsed, std::chrono::milliseconds(100));
+    EXPECT_LT(elapsed, std::chrono::milliseconds(1000)) << "Latency should not scale with batch size";
+}
+
+TEST_F(MockServerScalingTest, OperationLimitsRejectOversizedReads) {
+    GeneratedVariableSpec spec;
+    spec.count = 20;
+    size_t set = server_->addGeneratedVariables(spec);
+
+    ServerOperationLimits limits;
+    limits.maxNodesPerRead = 10;
+    server_->setOperationLimits(limits);
+
+    startAndConnect(50);
+    auto ids = server_->getGeneratedNodeIds(set);
+
+    auto oversized = client_->readNodes(ids);
+    ASSERT_EQ(oversized.size(), 20u);
+    for (const auto& result : oversized) {
+        EXPECT_FALSE(result.success) << result.id;
+    }
+
+    std::vector<std::string> withinLimit(ids.begin(), ids.begin() + 10);
+    for (const auto& result : client_->readNodes(withinLimit)) {
+        EXPECT_TRUE(result.success) << result.id << ": " << result.reason;
+    }
+}
+
+} // namespace test
+} // namespace opcua2http
@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <chrono>
+#include <memory>
+
+#include "common/MockOPCUAServer.h"
+#include "opcua/OPCUAClient.h"
+#include "subscription/SubscriptionManager.h"
+#include "reconnection/ReconnectionManager.h"
+#include "cache/CacheManager.h"
+#include "config/Configuration.h"
+
+namespace opcua2http {
+namespace test {
+
+/**
+ * @brief Integration tests for redundant endpoint failover
+ *
+ * Two mock servers stand in for a redundant server pair. The client keeps a
+ * hot-standby session to the backup and must switch to it as soon as the
+ * primary is lost, recreating monitored items on the new session.
+ */
+class RedundantFailoverTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        primaryServer_ = std::make_unique<MockOPCUAServer>(4846, "http://test.failover");
+        backupServer_ = std::make_unique<MockOPCUAServer>(4847, "http://test.failover");
+        primaryServer_->addStandardTestVariables();
+        backupServer_->addStandardTestVariables();
+        ASSERT_TRUE(primaryServer_->start()) << "Failed to start primary server";
+        ASSERT_TRUE(backupServer_->start()) << "Failed to start backup server";
+
+        config_.opcEndpoint = primaryServer_->getEndpoint();
+        config_.opcBackupEndpoints = {backupServer_->getEndpoint()};
+        config_.opcFailoverMinServiceLevel = 200;
+        config_.securityMode = 1; // None
+        config_.securityPolicy = "None";
+        config_.defaultNamespace = primaryServer_->getTestNamespaceIndex();
+        config_.applicationUri = "urn:test:opcua:failover:client";
+        config_.opcReadTimeoutMs = 5000;
+        config_.opcConnectionTimeoutMs = 2000;
+        config_.opcBatchSize = 50;
+
+        config_.connectionRetryMax = 3;
+        config_.connectionInitialDelay = 100;
+        config_.connectionMaxRetry = 5;
+        config_.connectionMaxDelay = 2000;
+        config_.connectionRetryDelay = 500;
+
+        opcClient_ = std::make_unique<OPCUAClient>();
+        cacheManager_ = std::make_unique<CacheManager>(60, 1000);
+
+        ASSERT_TRUE(opcClient_->initialize(config_));
+        ASSERT_TRUE(opcClient_->connect());
+
+        subscriptionManager_ = std::make_unique<SubscriptionManager>(
+            opcClient_.get(), cacheManager_.get(), 1);
+        reconnectionManager_ = std::make_unique<ReconnectionManager>(
+            opcClient_.get(), subscriptionManager_.get(), config_);
+    }
+
+    void TearDown() override {
+        if (reconnectionManager_) {
+            reconnectionManager_->stopMonitoring();
+            reconnectionManager_.reset();
+        }
+        subscriptionManager_.reset();
+        opcClient_.reset();
+        cacheManager_.reset();
+
+        if (primaryServer_) {
+            primaryServer_->stop();
+        }
+        if (backupServer_) {
+            backupServer_->stop();
+        }
+    }
+
+    std::string getTestNodeId(UA_UInt32 nodeId) const {
+        return "ns=" + std::to_string(config_.defaultNamespace) + ";i=" + std::to_string(nodeId);
+    }
+
+    bool waitForStandby(std::chrono::milliseconds timeout) {
+        auto start = std::chrono::steady_clock::now();
+        while (std::chrono::steady_clock::now() - start < timeout) {
+            if (opcClient_->getFailoverStats().standbyReady) {
+                return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+        return false;
+    }
+
+    std::unique_ptr<MockOPCUAServer> primaryServer_;
+    std::unique_ptr<MockOPCUAServer> backupServer_;
+    std::unique_ptr<OPCUAClient> opcClient_;
+    std::unique_ptr<CacheManager> cacheManager_;
+    std::unique_ptr<SubscriptionManager> subscriptionManager_;
+    std::unique_ptr<ReconnectionManager> reconnectionManager_;
+    Configuration config_;
+};
+
+// Reads move to the standby session as soon as the primary is lost
+TEST_F(RedundantFailoverTest, ReadsRedirectWhenPrimaryStops) {
+    ASSERT_TRUE(waitForStandby(std::chrono::seconds(5))) << "Standby session should be established";
+
+    auto stats = opcClient_->getFailoverStats();
+    EXPECT_EQ(stats.activeEndpoint, primaryServer_->getEndpoint());
+    EXPECT_EQ(stats.standbyEndpoint, backupServer_->getEndpoint());
+    EXPECT_EQ(stats.failovers, 0u);
+
+    ASSERT_TRUE(reconnectionManager_->startMonitoring());
+    ASSERT_TRUE(subscriptionManager_->addMonitoredItem(getTestNodeId(1001)));
+    ASSERT_TRUE(subscriptionManager_->addMonitoredItem(getTestNodeId(1002)));
+
+    primaryServer_->stop();
+    auto stopTime = std::chrono::steady_clock::now();
+
+    // The first read may be the one that discovers the loss; the next goes to the standby
+    ReadResult result;
+    while (std::chrono::steady_clock::now() - stopTime < std::chrono::seconds(5)) {
+        result = opcClient_->readNode(getTestNodeId(1001));
+        if (result.success) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    auto switchTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - stopTime);
+
+    ASSERT_TRUE(result.success) << "Reads should be served by the backup server";
+    EXPECT_EQ(result.value, "42");
+    EXPECT_LT(switchTime, std::chrono::milliseconds(2000)) << "Switch took " << switchTime.count() << "ms";
+
+    stats = opcClient_->getFailoverStats();
+    EXPECT_EQ(stats.failovers, 1u);
+    EXPECT_EQ(stats.activeEndpoint, backupServer_->getEndpoint());
+    EXPECT_LT(stats.lastSwitchDuration, std::chrono::milliseconds(100));
+
+    // Monitored items are recreated on the promoted session
+    auto waitStart = std::chrono::steady_clock::now();
+    while (reconnectionManager_->getStats().successfulSubscriptionRecoveries == 0 &&
+           std::chrono::steady_clock::now() - waitStart < std::chrono::seconds(5)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    EXPECT_GE(reconnectionManager_->getStats().successfulSubscriptionRecoveries, 1u);
+    EXPECT_EQ(subscriptionManager_->getActiveMonitoredItems().size(), 2u);
+}
+
+// A deliberate disconnect is not undone by the standby monitor
+TEST_F(RedundantFailoverTest, NoFailoverAfterDeliberateDisconnect) {
+    ASSERT_TRUE(waitForStandby(std::chrono::seconds(5)));
+
+    opcClient_->disconnect();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1200));
+
+    EXPECT_FALSE(opcClient_->isConnected());
+    EXPECT_EQ(opcClient_->getFailoverStats().failovers, 0u);
+
+    // An explicit request still switches
+    EXPECT_TRUE(opcClient_->failover());
+    EXPECT_TRUE(opcClient_->isConnected());
+    EXPECT_EQ(opcClient_->getEndpoint(), backupServer_->getEndpoint());
+}
+
+// ServiceLevel only triggers a switch from a degraded server to a healthy one
+TEST_F(RedundantFailoverTest, ServiceLevelDecision) {
+    constexpr int UNKNOWN = StandbySession::SERVICE_LEVEL_UNKNOWN;
+
+    EXPECT_TRUE(OPCUAClient::shouldFailOver(150, 255, 200));
+    EXPECT_FALSE(OPCUAClient::shouldFailOver(255, 255, 200));
+    EXPECT_FALSE(OPCUAClient::shouldFailOver(150, 180, 200));
+    EXPECT_FALSE(OPCUAClient::shouldFailOver(UNKNOWN, 255, 200));
+    EXPECT_FALSE(OPCUAClient::shouldFailOver(150, UNKNOWN, 200));
+    EXPECT_FALSE(OPCUAClient::shouldFailOver(0, 255, 0));
+}
+
+} // namespace test
+} // namespace opcua2http
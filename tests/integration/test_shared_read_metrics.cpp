@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include <crow.h>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "common/MockOPCUAServer.h"
+#include "opcua/OPCUAClient.h"
+#include "cache/CacheManager.h"
+#include "cache/CacheMetrics.h"
+#include "core/ReadStrategy.h"
+#include "core/RequestTiming.h"
+#include "http/APIHandler.h"
+#include "config/Configuration.h"
+
+namespace opcua2http {
+namespace test {
+
+/**
+ * @brief Integration test for metrics of reads that share a response cache build
+ *
+ * Requests for an ids list whose body is being built wait for that build
+ * instead of reading themselves. Their metrics must still show the paths the
+ * shared build took. The server delays and fails reads of its generated
+ * variables, so the build stays in flight long enough for a second request to
+ * join it.
+ */
+class SharedReadMetricsTest : public ::testing::Test {
+protected:
+    static constexpr uint16_t SERVER_PORT = 4852;
+    static constexpr std::chrono::milliseconds READ_LATENCY{300};
+
+    void SetUp() override {
+        server_ = std::make_unique<MockOPCUAServer>(SERVER_PORT, "http://test.shared.read");
+        server_->setVerboseLogging(false);
+        server_->setStartupTimeout(30000);
+
+        GeneratedVariableSpec spec;
+        spec.count = 2;
+        spec.types = {GeneratedValueType::INT32};
+        set_ = server_->addGeneratedVariables(spec);
+        ASSERT_TRUE(server_->start()) << "Failed to start mock server";
+
+        config_.opcEndpoint = server_->getEndpoint();
+        config_.securityMode = 1; // None
+        config_.securityPolicy = "None";
+        config_.defaultNamespace = server_->getTestNamespaceIndex();
+        config_.applicationUri = "urn:test:opcua:shared:read:client";
+        config_.opcReadTimeoutMs = 5000;
+        config_.opcConnectionTimeoutMs = 2000;
+        config_.apiKey = "test-api-key";
+        config_.responseCacheSize = 8;
+
+        client_ = std::make_unique<OPCUAClient>();
+        ASSERT_TRUE(client_->initialize(config_));
+        ASSERT_TRUE(client_->connect());
+
+        cacheManager_ = std::make_unique<CacheManager>(60, 100);
+        cacheMetrics_ = std::make_unique<CacheMetrics>(cacheManager_.get());
+        readStrategy_ = std::make_unique<ReadStrategy>(cacheManager_.get(), client_.get());
+        readStrategy_->setCacheMetrics(cacheMetrics_.get());
+        apiHandler_ = std::make_unique<APIHandler>(cacheManager_.get(), readStrategy_.get(), client_.get(), config_);
+    }
+
+    void TearDown() override {
+        apiHandler_.reset();
+        readStrategy_.reset();
+        cacheMetrics_.reset();
+        cacheManager_.reset();
+        if (client_) {
+            if (client_->isConnected()) {
+                client_->disconnect();
+            }
+            client_.reset();
+        }
+        server_->stop();
+        server_.reset();
+    }
+
+    Configuration config_;
+    std::unique_ptr<MockOPCUAServer> server_;
+    std::unique_ptr<OPCUAClient> client_;
+    std::unique_ptr<CacheManager> cacheManager_;
+    std::unique_ptr<CacheMetrics> cacheMetrics_;
+    std::unique_ptr<ReadStrategy> readStrategy_;
+    std::unique_ptr<APIHandler> apiHandler_;
+    size_t set_{0};
+};
+
+TEST_F(SharedReadMetricsTest, WaiterRecordsThePathsOfTheSharedBuild) {
+    // One node fresh in the cache, one missing whose server read is slow and fails
+    std::string freshId = server_->getGeneratedNodeId(set_, 0);
+    std::string failingId = server_->getGeneratedNodeId(set_, 1);
+    cacheManager_->updateCache(freshId, "42", "Good", "Good", 1000);
+
+    ReadFaultInjection faults;
+    faults.latency = READ_LATENCY;
+    faults.failureRate = 1.0;
+    faults.failureStatus = UA_STATUSCODE_BADNOTREADABLE;
+    server_->setReadFaultInjection(faults);
+
+    crow::request request;
+    request.url = "/iotgateway/read";
+    request.url_params = crow::query_string("ids=" + freshId + "," + failingId);
+
+    auto statsBefore = cacheMetrics_->getStatistics();
+    auto handlerBefore = apiHandler_->getStats();
+
+    auto serve = [&](RequestTiming& timing, crow::response& response) {
+        RequestTiming::Scope timingScope(&timing);
+        response = apiHandler_->handleReadRequest(request);
+    };
+
+    // The builder starts first; the waiter joins while the server read is in flight
+    RequestTiming builderTiming;
+    RequestTiming waiterTiming;
+    crow::response builderResponse;
+    crow::response waiterResponse;
+    std::thread builder([&]() { serve(builderTiming, builderResponse); });
+    while (apiHandler_->getResponseCache().getStats().builds < 1) {
+        std::this_thread::yield();
+    }
+    std::thread waiter([&]() { serve(waiterTiming, waiterResponse); });
+    builder.join();
+    waiter.join();
+
+    auto responseStats = apiHandler_->getResponseCache().getStats();
+    ASSERT_EQ(responseStats.builds, 1u) << "The waiter did not join the build in time";
+    ASSERT_EQ(responseStats.sharedBuilds, 1u);
+    EXPECT_EQ(builderResponse.code, 200);
+    EXPECT_EQ(waiterResponse.body, builderResponse.body);
+
+    // Both requests count one FRESH and one MISS node, nothing else
+    for (const auto* timing : {&builderTiming, &waiterTiming}) {
+        EXPECT_EQ(timing->nodes().fresh, 1u);
+        EXPECT_EQ(timing->nodes().miss, 1u);
+        EXPECT_EQ(timing->nodes().stale + timing->nodes().expired + timing->nodes().fallback, 0u);
+    }
+
+    auto statsAfter = cacheMetrics_->getStatistics();
+    EXPECT_EQ(statsAfter.freshHits - statsBefore.freshHits, 2u);
+    EXPECT_EQ(statsAfter.cacheHits - statsBefore.cacheHits, 2u);
+    EXPECT_EQ(statsAfter.expiredReads - statsBefore.expiredReads, 2u);
+    EXPECT_EQ(statsAfter.cacheMisses - statsBefore.cacheMisses, 2u);
+    EXPECT_EQ(cacheMetrics_->getPathLatency(CacheMetrics::ReadPath::FRESH).count, 2u);
+    EXPECT_EQ(cacheMetrics_->getPathLatency(CacheMetrics::ReadPath::MISS).count, 2u);
+
+    // The failed node is a miss for both requests in the handler's counters too
+    auto handlerAfter = apiHandler_->getStats();
+    EXPECT_EQ(handlerAfter.cacheHits - handlerBefore.cacheHits, 2u);
+    EXPECT_EQ(handlerAfter.cacheMisses - handlerBefore.cacheMisses, 2u);
+}
+
+} // namespace test
+} // namespace opcua2http
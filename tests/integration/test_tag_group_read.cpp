@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/MockOPCUAServer.h"
+#include "opcua/OPCUAClient.h"
+#include "cache/CacheManager.h"
+#include "core/ReadStrategy.h"
+#include "core/RequestTiming.h"
+#include "core/TagGroup.h"
+#include "config/Configuration.h"
+
+namespace opcua2http {
+namespace test {
+
+/**
+ * @brief Integration tests for tag group reads through prepared OPC UA requests
+ *
+ * Groups are read with OPCUAClient::readPrepared(), which sends any subset of
+ * the prepared members in batches of opcBatchSize. These tests read groups
+ * larger than a batch, with a member that does not parse, against generated
+ * INT32 variables whose value is their index.
+ */
+class TagGroupReadTest : public ::testing::Test {
+protected:
+    static constexpr uint16_t SERVER_PORT = 4851;
+    static constexpr int BATCH_SIZE = 3;
+    static constexpr const char* INVALID_NODE_ID = "not-a-node-id";
+
+    void SetUp() override {
+        server_ = std::make_unique<MockOPCUAServer>(SERVER_PORT, "http://test.tag.group");
+        server_->setVerboseLogging(false);
+        server_->setStartupTimeout(30000);
+
+        GeneratedVariableSpec spec;
+        spec.count = 10;
+        spec.types = {GeneratedValueType::INT32};
+        set_ = server_->addGeneratedVariables(spec);
+        ASSERT_TRUE(server_->start()) << "Failed to start mock server";
+
+        Configuration config;
+        config.opcEndpoint = server_->getEndpoint();
+        config.securityMode = 1; // None
+        config.securityPolicy = "None";
+        config.defaultNamespace = server_->getTestNamespaceIndex();
+        config.applicationUri = "urn:test:opcua:tag:group:client";
+        config.opcReadTimeoutMs = 5000;
+        config.opcConnectionTimeoutMs = 2000;
+        config.opcBatchSize = BATCH_SIZE;
+
+        client_ = std::make_unique<OPCUAClient>();
+        ASSERT_TRUE(client_->initialize(config));
+        ASSERT_TRUE(client_->connect());
+
+        // Generated variables 0-9, with the unparseable member in the middle
+        nodeIds_ = server_->getGeneratedNodeIds(set_);
+        nodeIds_.insert(nodeIds_.begin() + 5, INVALID_NODE_ID);
+    }
+
+    void TearDown() override {
+        if (client_) {
+            if (client_->isConnected()) {
+                client_->disconnect();
+            }
+            client_.reset();
+        }
+        server_->stop();
+        server_.reset();
+    }
+
+    // Value served for nodeIds_[member]
+    static std::string expectedValue(size_t member) {
+        return std::to_string(member < 5 ? member : member - 1);
+    }
+
+    std::unique_ptr<MockOPCUAServer> server_;
+    std::unique_ptr<OPCUAClient> client_;
+    size_t set_{0};
+    std::vector<std::string> nodeIds_;
+};
+
+TEST_F(TagGroupReadTest, ReadPreparedKeepsMemberOrderAcrossBatches) {
+    auto prepared = client_->prepareRead(nodeIds_);
+    ASSERT_EQ(prepared->size(), nodeIds_.size());
+    EXPECT_FALSE(prepared->isValid(5));
+    EXPECT_TRUE(prepared->isValid(4));
+
+    // Out of group order, and more readable members than fit one request
+    std::vector<size_t> members = {10, 0, 5, 7, 3, 9, 1, 6};
+    uint64_t readsBefore = server_->getGeneratedReadCount();
+
+    RequestTiming timing;
+    std::vector<ReadResult> results;
+    {
+        RequestTiming::Scope timingScope(&timing);
+        results = client_->readPrepared(*prepared, members);
+    }
+
+    ASSERT_EQ(results.size(), members.size());
+    for (size_t i = 0; i < members.size(); ++i) {
+        EXPECT_EQ(results[i].id, nodeIds_[members[i]]);
+        if (members[i] == 5) {
+            EXPECT_FALSE(results[i].success);
+            EXPECT_EQ(results[i].reason, "Invalid NodeId format");
+        } else {
+            EXPECT_TRUE(results[i].success) << results[i].id << ": " << results[i].reason;
+            EXPECT_EQ(results[i].value, expectedValue(members[i]));
+        }
+    }
+
+    // The unparseable member never reaches the server; seven members take three requests
+    EXPECT_EQ(server_->getGeneratedReadCount() - readsBefore, members.size() - 1);
+    EXPECT_EQ(timing.getOpcRequests(), 3u);
+}
+
+TEST_F(TagGroupReadTest, GroupReadSendsOnlyExpiredMembers) {
+    CacheManager cacheManager(60, 100);
+    ReadStrategy readStrategy(&cacheManager, client_.get());
+    TagGroup group("line1", nodeIds_, client_->prepareRead(nodeIds_));
+
+    // Fresh members come from the cache; the rest are missing and read from the server
+    std::vector<size_t> cachedMembers = {1, 4, 8};
+    for (size_t member : cachedMembers) {
+        cacheManager.updateCache(nodeIds_[member], "cached", "Good", "Good", 1000);
+    }
+    uint64_t readsBefore = server_->getGeneratedReadCount();
+
+    RequestTiming timing;
+    std::vector<ReadResult> results;
+    {
+        RequestTiming::Scope timingScope(&timing);
+        results = readStrategy.processGroupRequest(group);
+    }
+
+    ASSERT_EQ(results.size(), nodeIds_.size());
+    for (size_t i = 0; i < nodeIds_.size(); ++i) {
+        EXPECT_EQ(results[i].id, nodeIds_[i]);
+        if (i == 1 || i == 4 || i == 8) {
+            EXPECT_EQ(results[i].value, "cached");
+        } else if (i == 5) {
+            EXPECT_FALSE(results[i].success);
+        } else {
+            EXPECT_TRUE(results[i].success) << results[i].id << ": " << results[i].reason;
+            EXPECT_EQ(results[i].value, expectedValue(i));
+        }
+    }
+
+    // Only the seven readable expired members are sent, in batches of BATCH_SIZE
+    EXPECT_EQ(server_->getGeneratedReadCount() - readsBefore, 7u);
+    EXPECT_EQ(timing.getOpcRequests(), 3u);
+}
+
+} // namespace test
+} // namespace opcua2http
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+
+#include "core/AllocationTracker.h"
+#include "core/RequestTiming.h"
+
+using namespace opcua2http;
+
+namespace {
+
+// Keeps the compiler from eliding a new/delete pair
+void* volatile sink = nullptr;
+
+void allocate(size_t bytes) {
+    char* p = new char[bytes];
+    sink = p;
+    delete[] static_cast<char*>(sink);
+}
+
+} // namespace
+
+TEST(AllocationTrackerTest, HooksAreLinkedIntoTests) {
+    EXPECT_TRUE(AllocationTracker::isEnabled());
+}
+
+TEST(AllocationTrackerTest, CountsAllocationsOfThisThread) {
+    auto before = AllocationTracker::thread();
+    allocate(100);
+    allocate(28);
+    auto used = AllocationTracker::thread() - before;
+
+    EXPECT_EQ(used.allocations, 2u);
+    EXPECT_EQ(used.bytes, 128u);
+
+    // Another thread's allocations are its own
+    before = AllocationTracker::thread();
+    std::thread other([]() { allocate(64); });
+    other.join();
+    auto afterJoin = AllocationTracker::thread() - before;
+    EXPECT_LT(afterJoin.bytes, 64u);
+}
+
+TEST(AllocationTrackerTest, TagScopesAttributeAndRestore) {
+    EXPECT_EQ(AllocationTracker::currentTag(), AllocationTracker::Tag::UNTAGGED);
+    AllocationTracker::reset();
+
+    {
+        AllocationTracker::TagScope outer(AllocationTracker::Tag::BACKGROUND);
+        allocate(10);
+        {
+            AllocationTracker::TagScope inner(AllocationTracker::Tag::SUBSCRIPTION);
+            EXPECT_EQ(AllocationTracker::currentTag(), AllocationTracker::Tag::SUBSCRIPTION);
+            allocate(20);
+        }
+        EXPECT_EQ(AllocationTracker::currentTag(), AllocationTracker::Tag::BACKGROUND);
+    }
+    EXPECT_EQ(AllocationTracker::currentTag(), AllocationTracker::Tag::UNTAGGED);
+
+    EXPECT_EQ(AllocationTracker::total(AllocationTracker::Tag::BACKGROUND).allocations, 1u);
+    EXPECT_EQ(AllocationTracker::total(AllocationTracker::Tag::BACKGROUND).bytes, 10u);
+    EXPECT_EQ(AllocationTracker::total(AllocationTracker::Tag::SUBSCRIPTION).bytes, 20u);
+
+    AllocationTracker::reset();
+    EXPECT_EQ(AllocationTracker::total(AllocationTracker::Tag::BACKGROUND).allocations, 0u);
+}
+
+TEST(AllocationTrackerTest, StageTimersCountAllocationsPerStage) {
+    RequestTiming timing;
+    {
+        RequestTiming::Scope scope(&timing);
+        {
+            RequestTiming::StageTimer timer(RequestTiming::Stage::SERIALIZE);
+            EXPECT_EQ(AllocationTracker::currentTag(), AllocationTracker::Tag::SERIALIZE);
+            allocate(50);
+        }
+        EXPECT_EQ(AllocationTracker::currentTag(), AllocationTracker::Tag::UNTAGGED);
+    }
+
+    EXPECT_EQ(timing.getAllocations(RequestTiming::Stage::SERIALIZE).allocations, 1u);
+    EXPECT_EQ(timing.getAllocations(RequestTiming::Stage::SERIALIZE).bytes, 50u);
+    EXPECT_EQ(timing.getAllocations(RequestTiming::Stage::PARSE).allocations, 0u);
+
+    auto json = timing.toJSON();
+    ASSERT_TRUE(json.contains("allocations"));
+    EXPECT_EQ(json["allocations"]["serialize"]["allocations"], 1);
+    EXPECT_EQ(json["allocations"]["serialize"]["bytes"], 50);
+}
+
+TEST(AllocationTrackerTest, StageTimersOutsideARequestKeepTheThreadTag) {
+    AllocationTracker::TagScope tag(AllocationTracker::Tag::BACKGROUND);
+    RequestTiming::StageTimer timer(RequestTiming::Stage::OPC);
+    EXPECT_EQ(AllocationTracker::currentTag(), AllocationTracker::Tag::BACKGROUND);
+}
+
+TEST(AllocationTrackerTest, JSONListsAllTags) {
+    auto json = AllocationTracker::toJSON();
+    EXPECT_TRUE(json["enabled"].get<bool>());
+    for (size_t i = 0; i < AllocationTracker::TAG_COUNT; ++i) {
+        auto name = AllocationTracker::tagName(static_cast<AllocationTracker::Tag>(i));
+        ASSERT_TRUE(json["tags"].contains(name)) << name;
+        EXPECT_TRUE(json["tags"][name].contains("bytes"));
+    }
+    EXPECT_TRUE(json["total"].contains("allocations"));
+}
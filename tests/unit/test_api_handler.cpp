@@ -4,12 +4,16 @@
 #include <memory>
 #include <string>
 #include <map>
+#include <utility>
+#include <vector>
 
 #include "common/OPCUATestBase.h"
 #include "http/APIHandler.h"
 #include "config/Configuration.h"
 #include "core/ReadResult.h"
 #include "core/ReadStrategy.h"
+#include "core/RequestTiming.h"
+#include "cache/CacheMetrics.h"
 
 using namespace opcua2http;
 using namespace opcua2http::test;
@@ -68,6 +72,8 @@ public:
     using APIHandler::validateAPIKey;
     using APIHandler::validateBasicAuth;
     using APIHandler::buildJSONResponse;
+    using APIHandler::buildReadResponse;
+    using APIHandler::buildReadResponseBody;
     using APIHandler::buildErrorResponse;
     using APIHandler::formatTimestamp;
 
@@ -241,6 +247,83 @@ TEST_F(APIHandlerTest, BuildJSONResponse_ValidData_ReturnsFormattedResponse) {
     EXPECT_EQ(responseJson["number"], 42);
 }
 
+TEST_F(APIHandlerTest, BuildReadResponseBody_MatchesJsonResponse) {
+    // Arrange: one result with its JSON pre-serialized as the cache does, one without
+    ReadResult cached = ReadResult::createSuccess("ns=2;s=Cached", "21.5", 1700000000123);
+    cached.json = cached.serializeJson();
+    std::vector<ReadResult> results = {
+        cached,
+        ReadResult::createError("ns=2;s=Missing", "Bad \"node\"", 1700000000456)
+    };
+
+    nlohmann::json extraFields;
+    extraFields["group"] = "line1";
+    extraFields["timing"] = {{"total_ms", 1.5}};
+
+    // Act
+    std::string body = apiHandler_->buildReadResponseBody(results, extraFields);
+    std::string plainBody = apiHandler_->buildReadResponseBody(results);
+
+    // Assert: same text as the nlohmann-built response
+    nlohmann::json expected = apiHandler_->buildReadResponse(results);
+    EXPECT_EQ(plainBody, expected.dump());
+    expected["group"] = "line1";
+    expected["timing"] = {{"total_ms", 1.5}};
+    EXPECT_EQ(body, expected.dump());
+}
+
+TEST_F(APIHandlerTest, HandleReadRequest_ReusedBody_RecordsSameMetricsAsRebuild) {
+    // Arrange: response cache on, and path metrics recorded
+    config_.responseCacheSize = 8;
+    CacheMetrics cacheMetrics(cacheManager_.get());
+    readStrategy_->setCacheMetrics(&cacheMetrics);
+    TestableAPIHandler handler(cacheManager_.get(), readStrategy_.get(), opcClient_.get(), config_);
+
+    cacheManager_->updateCache("ns=2;s=A", "1", "Good", "Good", 1000);
+    cacheManager_->updateCache("ns=2;s=B", "2", "Good", "Good", 1000);
+    auto request = createMockRequest("/iotgateway/read?ids=ns=2;s=A,ns=2;s=B",
+                                   {{"X-API-Key", "test-api-key"}});
+
+    // What one request adds to every counter a read feeds
+    auto readOnce = [&]() {
+        auto statsBefore = cacheMetrics.getStatistics();
+        auto hitsBefore = handler.getStats().cacheHits;
+        auto latencyBefore = cacheMetrics.getPathLatency(CacheMetrics::ReadPath::FRESH).count;
+
+        RequestTiming timing;
+        RequestTiming::Scope timingScope(&timing);
+        crow::response response = handler.handleReadRequest(request);
+        EXPECT_EQ(response.code, 200);
+
+        auto statsAfter = cacheMetrics.getStatistics();
+        return std::vector<uint64_t>{
+            handler.getStats().cacheHits - hitsBefore,
+            statsAfter.freshHits - statsBefore.freshHits,
+            statsAfter.cacheHits - statsBefore.cacheHits,
+            statsAfter.batchOperations - statsBefore.batchOperations,
+            cacheMetrics.getPathLatency(CacheMetrics::ReadPath::FRESH).count - latencyBefore,
+            timing.nodes().fresh
+        };
+    };
+
+    // Act: build, reuse, then rebuild after a write
+    auto built = readOnce();
+    auto reused = readOnce();
+    cacheManager_->updateCache("ns=2;s=B", "3", "Good", "Good", 2000);
+    auto rebuilt = readOnce();
+
+    // Assert
+    auto responseStats = handler.getResponseCache().getStats();
+    EXPECT_EQ(responseStats.hits, 1u);
+    EXPECT_EQ(responseStats.builds, 2u);
+
+    EXPECT_EQ(built, (std::vector<uint64_t>{2, 2, 2, 1, 1, 2}));
+    EXPECT_EQ(reused, built);
+    EXPECT_EQ(rebuilt, built);
+
+    readStrategy_->setCacheMetrics(nullptr);
+}
+
 TEST_F(APIHandlerTest, BuildErrorResponse_WithDetails_ReturnsFormattedError) {
     // Arrange
     int statusCode = 404;
@@ -503,3 +586,52 @@ TEST_F(APIHandlerTest, HandleReadRequest_MultipleValidNodeIdFormat_ProcessesRequ
     // Should either have readResults or error, but not parameter validation error
     EXPECT_TRUE(responseJson.contains("readResults") || responseJson.contains("error"));
 }
+
+TEST_F(APIHandlerTest, HandleGroupDefineRequest_MalformedBodies_ReturnBadRequest) {
+    const std::string shapeError = "Expected a JSON body {\"name\": \"...\", \"ids\": [\"ns=2;s=...\", ...]}";
+    const std::vector<std::pair<std::string, std::string>> cases = {
+        {"not json", shapeError},
+        {"[\"ns=2;s=A\"]", shapeError},
+        {R"({"ids": ["ns=2;s=A"]})", shapeError},
+        {R"({"name": 1, "ids": ["ns=2;s=A"]})", shapeError},
+        {R"({"name": "line1"})", shapeError},
+        {R"({"name": "line1", "ids": "ns=2;s=A"})", shapeError},
+        {R"({"name": "line1", "ids": ["ns=2;s=A", 7]})", "Node IDs must be strings"},
+        {R"({"name": "line1", "ids": ["ns=2;s=A", "bogus"]})",
+         "Invalid node ID format in group 'line1': bogus"},
+        {R"({"name": "line/1", "ids": ["ns=2;s=A"]})", ""},
+        {R"({"name": "line1", "ids": []})", ""}
+    };
+
+    for (const auto& [body, details] : cases) {
+        // Arrange
+        auto request = createMockRequest("/iotgateway/groups", {{"X-API-Key", "test-api-key"}},
+                                         crow::HTTPMethod::Post);
+        request.body = body;
+        auto errorsBefore = apiHandler_->getStats().validationErrors;
+
+        // Act
+        crow::response response = apiHandler_->handleGroupDefineRequest(request);
+
+        // Assert - Rejected with a reason, counted, and nothing defined
+        EXPECT_EQ(response.code, 400) << body;
+        nlohmann::json responseJson = nlohmann::json::parse(response.body);
+        ASSERT_TRUE(responseJson.contains("error")) << body;
+        EXPECT_EQ(responseJson["error"]["message"], "Bad Request") << body;
+        if (!details.empty()) {
+            EXPECT_EQ(responseJson["error"]["details"], details) << body;
+        }
+        EXPECT_EQ(apiHandler_->getStats().validationErrors, errorsBefore + 1) << body;
+    }
+
+    crow::response list = apiHandler_->handleGroupListRequest();
+    EXPECT_TRUE(nlohmann::json::parse(list.body)["groups"].empty());
+
+    // A well-formed body with padded IDs is accepted
+    auto request = createMockRequest("/iotgateway/groups", {{"X-API-Key", "test-api-key"}},
+                                     crow::HTTPMethod::Post);
+    request.body = R"({"name": "line1", "ids": [" ns=2;s=A ", "ns=2;s=B"]})";
+    crow::response response = apiHandler_->handleGroupDefineRequest(request);
+    EXPECT_EQ(response.code, 201);
+    EXPECT_EQ(nlohmann::json::parse(response.body)["size"], 2);
+}
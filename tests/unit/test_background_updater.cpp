@@ -12,6 +12,18 @@
 using namespace opcua2http;
 using namespace std::chrono_literals;
 
+// Test BackgroundUpdater class that exposes the scheduling queue without worker threads
+class TestableBackgroundUpdater : public BackgroundUpdater {
+public:
+    using BackgroundUpdater::BackgroundUpdater;
+    using BackgroundUpdater::EnqueueResult;
+    using BackgroundUpdater::enqueueUpdate;
+    using BackgroundUpdater::getNextUpdate;
+    using BackgroundUpdater::calculateEffectiveDeadline;
+    using BackgroundUpdater::runRefreshAheadCycle;
+    using BackgroundUpdater::calculateTargetWorkers;
+};
+
 class BackgroundUpdaterTest : public ::testing::Test {
 protected:
     void SetUp() override {
@@ -223,4 +235,139 @@ TEST_F(BackgroundUpdaterTest, ThreadSafety) {
     // Should not crash and should have processed some updates
     auto stats = backgroundUpdater_->getStats();
     EXPECT_GE(stats.totalUpdates, 0);
-}
\ No newline at end of file
+}
+
+TEST_F(BackgroundUpdaterTest, DeadlineOrdering) {
+    TestableBackgroundUpdater updater(cacheManager_.get(), opcClient_.get());
+
+    auto addEntry = [this](const std::string& nodeId, std::chrono::seconds age) {
+        CacheManager::CacheEntry entry{};
+        entry.nodeId = nodeId;
+        entry.value = "1";
+        entry.status = "Good";
+        entry.reason = "Good";
+        entry.timestamp = 1234567890;
+        entry.creationTime = std::chrono::steady_clock::now() - age;
+        cacheManager_->addCacheEntry(nodeId, entry);
+    };
+
+    // 10s expire time: "Later" has ~10s of slack, "Sooner" ~2s, "Missing" none
+    addEntry("ns=2;s=Later", 0s);
+    addEntry("ns=2;s=Sooner", 8s);
+
+    using Result = TestableBackgroundUpdater::EnqueueResult;
+    EXPECT_EQ(updater.enqueueUpdate("ns=2;s=Later"), Result::QUEUED);
+    EXPECT_EQ(updater.enqueueUpdate("ns=2;s=Sooner"), Result::QUEUED);
+    EXPECT_EQ(updater.enqueueUpdate("ns=2;s=Missing"), Result::QUEUED);
+    EXPECT_EQ(updater.getStats().queuedUpdates, 3);
+
+    EXPECT_EQ(updater.getNextUpdate(), "ns=2;s=Missing");
+    EXPECT_EQ(updater.getNextUpdate(), "ns=2;s=Sooner");
+    EXPECT_EQ(updater.getNextUpdate(), "ns=2;s=Later");
+    EXPECT_EQ(updater.getStats().queuedUpdates, 0);
+}
+
+TEST_F(BackgroundUpdaterTest, RepeatedRequestsRaisePriority) {
+    TestableBackgroundUpdater updater(cacheManager_.get(), opcClient_.get());
+
+    cacheManager_->updateCache("ns=2;s=Cold", "1", "Good", "Good", 1234567890);
+    cacheManager_->updateCache("ns=2;s=Hot", "2", "Good", "Good", 1234567890);
+
+    using Result = TestableBackgroundUpdater::EnqueueResult;
+    EXPECT_EQ(updater.enqueueUpdate("ns=2;s=Cold"), Result::QUEUED);
+    EXPECT_EQ(updater.enqueueUpdate("ns=2;s=Hot"), Result::QUEUED);
+
+    // Dashboards keep asking for "Hot" while it waits in the queue
+    bool raised = false;
+    for (int i = 0; i < 5; ++i) {
+        raised |= (updater.enqueueUpdate("ns=2;s=Hot") == Result::REPRIORITIZED);
+    }
+    EXPECT_TRUE(raised);
+
+    auto stats = updater.getStats();
+    EXPECT_EQ(stats.queuedUpdates, 2);
+    EXPECT_EQ(stats.duplicateUpdates, 5);
+    EXPECT_GT(stats.reprioritizedUpdates, 0);
+
+    EXPECT_EQ(updater.getNextUpdate(), "ns=2;s=Hot");
+    EXPECT_EQ(updater.getNextUpdate(), "ns=2;s=Cold");
+}
+
+TEST_F(BackgroundUpdaterTest, EffectiveDeadlineWeighting) {
+    auto now = std::chrono::steady_clock::now();
+
+    EXPECT_EQ(TestableBackgroundUpdater::calculateEffectiveDeadline(0ms, 5.0, now), now);
+    EXPECT_EQ(TestableBackgroundUpdater::calculateEffectiveDeadline(4000ms, 0.0, now), now + 4000ms);
+    EXPECT_EQ(TestableBackgroundUpdater::calculateEffectiveDeadline(4000ms, 1.0, now), now + 2000ms);
+}
+
+TEST_F(BackgroundUpdaterTest, RefreshAheadWithinBudget) {
+    TestableBackgroundUpdater updater(cacheManager_.get(), opcClient_.get());
+    updater.setRefreshAheadLead(1000ms);
+    updater.setRefreshAheadBudget(1.0);
+
+    auto addHotEntry = [this](const std::string& nodeId, std::chrono::milliseconds age) {
+        CacheManager::CacheEntry entry{};
+        entry.nodeId = nodeId;
+        entry.value = "1";
+        entry.status = "Good";
+        entry.reason = "Good";
+        entry.timestamp = 1234567890;
+        entry.creationTime = std::chrono::steady_clock::now() - age;
+        cacheManager_->addCacheEntry(nodeId, entry);
+        cacheManager_->getCachedValue(nodeId); // Client read makes the entry hot
+    };
+
+    // 3s refresh threshold: "Soon" turns stale in ~0.5s, "Later" in ~0.8s, "Far" in ~3s
+    addHotEntry("ns=2;s=Soon", 2500ms);
+    addHotEntry("ns=2;s=Later", 2200ms);
+    addHotEntry("ns=2;s=Far", 0ms);
+    addHotEntry("ns=2;s=Subscribed", 2500ms);
+    cacheManager_->setSubscriptionStatus("ns=2;s=Subscribed", true);
+
+    // Budget allows one read; the entry closest to turning stale wins
+    EXPECT_EQ(updater.runRefreshAheadCycle(), 1u);
+
+    auto stats = updater.getStats();
+    EXPECT_EQ(stats.refreshAheadReads, 1);
+    EXPECT_EQ(stats.refreshAheadSkipped, 1);
+    EXPECT_EQ(stats.queuedUpdates, 1);
+    EXPECT_EQ(stats.duplicateUpdates, 0);
+
+    EXPECT_EQ(updater.getNextUpdate(), "ns=2;s=Soon");
+}
+
+TEST_F(BackgroundUpdaterTest, WorkerTargetScaling) {
+    // Empty queue: only the minimum stays active
+    EXPECT_EQ(TestableBackgroundUpdater::calculateTargetWorkers(0, 50.0, 50.0, 2, 8), 2u);
+
+    // No latency observed yet: use every worker allowed
+    EXPECT_EQ(TestableBackgroundUpdater::calculateTargetWorkers(10, 0.0, 0.0, 1, 8), 8u);
+
+    // 50ms reads: one worker clears 20 updates per second
+    EXPECT_EQ(TestableBackgroundUpdater::calculateTargetWorkers(10, 50.0, 50.0, 1, 8), 1u);
+    EXPECT_EQ(TestableBackgroundUpdater::calculateTargetWorkers(100, 50.0, 50.0, 1, 8), 5u);
+    EXPECT_EQ(TestableBackgroundUpdater::calculateTargetWorkers(1000, 50.0, 50.0, 1, 8), 8u);
+
+    // Latency far above baseline: upstream is saturated, back off
+    EXPECT_EQ(TestableBackgroundUpdater::calculateTargetWorkers(100, 200.0, 50.0, 1, 32), 10u);
+}
+
+TEST_F(BackgroundUpdaterTest, LiveResize) {
+    backgroundUpdater_->setMaxConcurrentUpdates(2);
+    backgroundUpdater_->start();
+    EXPECT_EQ(backgroundUpdater_->getStats().workerThreads, 2u);
+
+    backgroundUpdater_->setMaxConcurrentUpdates(6);
+    EXPECT_EQ(backgroundUpdater_->getStats().workerThreads, 6u);
+
+    backgroundUpdater_->scheduleBatchUpdate({"ns=2;s=A", "ns=2;s=B", "ns=2;s=C"});
+
+    backgroundUpdater_->setMaxConcurrentUpdates(1);
+    EXPECT_EQ(backgroundUpdater_->getStats().workerThreads, 1u);
+
+    auto start = std::chrono::steady_clock::now();
+    backgroundUpdater_->stop();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 2s);
+    EXPECT_EQ(backgroundUpdater_->getStats().workerThreads, 0u);
+}
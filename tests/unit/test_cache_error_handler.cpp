@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <chrono>
+
+#include "core/CacheErrorHandler.h"
+#include "cache/CacheManager.h"
+#include "opcua/OPCUAClient.h"
+
+using namespace opcua2http;
+using namespace std::chrono_literals;
+
+// The client is never connected, so every retry read fails with a connection error
+class CacheErrorHandlerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        cacheManager_ = std::make_unique<CacheManager>(60, 1000, 3, 10);
+        opcClient_ = std::make_unique<OPCUAClient>();
+        errorHandler_ = std::make_unique<CacheErrorHandler>(cacheManager_.get(), opcClient_.get());
+    }
+
+    void TearDown() override {
+        errorHandler_.reset();
+        opcClient_.reset();
+        cacheManager_.reset();
+    }
+
+    bool waitForRetriesDrained(std::chrono::milliseconds timeout) {
+        auto start = std::chrono::steady_clock::now();
+        while (std::chrono::steady_clock::now() - start < timeout) {
+            if (errorHandler_->getPendingRetryCount() == 0) {
+                return true;
+            }
+            std::this_thread::sleep_for(5ms);
+        }
+        return false;
+    }
+
+    std::unique_ptr<CacheManager> cacheManager_;
+    std::unique_ptr<OPCUAClient> opcClient_;
+    std::unique_ptr<CacheErrorHandler> errorHandler_;
+};
+
+TEST_F(CacheErrorHandlerTest, ConnectionErrorDoesNotBlockCaller) {
+    errorHandler_->setMaxRetryAttempts(3);
+    errorHandler_->setRetryDelay(1000ms);
+
+    auto start = std::chrono::steady_clock::now();
+    ReadResult result = errorHandler_->handleConnectionError("ns=2;i=1", std::nullopt);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_FALSE(result.success);
+    EXPECT_LT(elapsed, 100ms) << "Retries must not run on the calling thread";
+    EXPECT_EQ(errorHandler_->getPendingRetryCount(), 1u);
+    EXPECT_EQ(errorHandler_->getStats().retriesScheduled, 1u);
+}
+
+TEST_F(CacheErrorHandlerTest, CachedFallbackReturnedImmediately) {
+    cacheManager_->updateCache("ns=2;i=1", "42", "Good", "Good", 1000);
+    errorHandler_->setRetryDelay(1000ms);
+
+    auto start = std::chrono::steady_clock::now();
+    ReadResult result = errorHandler_->handleConnectionError("ns=2;i=1",
+                                                             cacheManager_->getCachedValue("ns=2;i=1"));
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_TRUE(result.success);
+    EXPECT_EQ(result.value, "42");
+    EXPECT_LT(elapsed, 100ms);
+
+    // The entry is refreshed in the background
+    EXPECT_EQ(errorHandler_->getPendingRetryCount(), 1u);
+}
+
+TEST_F(CacheErrorHandlerTest, RetriesForSameNodeAreCoalesced) {
+    errorHandler_->setRetryDelay(1000ms);
+
+    for (int i = 0; i < 10; ++i) {
+        errorHandler_->handleConnectionError("ns=2;i=1", std::nullopt);
+    }
+    errorHandler_->handleConnectionError("ns=2;i=2", std::nullopt);
+
+    auto stats = errorHandler_->getStats();
+    EXPECT_EQ(stats.retriesScheduled, 2u);
+    EXPECT_EQ(stats.retriesCoalesced, 9u);
+    EXPECT_EQ(stats.pendingRetries, 2u);
+}
+
+TEST_F(CacheErrorHandlerTest, RetriesBackOffAndGiveUp) {
+    errorHandler_->setMaxRetryAttempts(3);
+    errorHandler_->setRetryDelay(20ms);
+
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(errorHandler_->scheduleRetry("ns=2;i=1"));
+    ASSERT_TRUE(waitForRetriesDrained(2000ms));
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    auto stats = errorHandler_->getStats();
+    EXPECT_EQ(stats.retryAttempts, 3u);
+    EXPECT_EQ(stats.failedRetries, 1u);
+    EXPECT_EQ(stats.successfulRetries, 0u);
+
+    // Jittered backoff keeps at least half of 20 + 40 + 80 ms
+    EXPECT_GE(elapsed, 70ms);
+}
+
+TEST_F(CacheErrorHandlerTest, StopDropsQueuedRetries) {
+    errorHandler_->setRetryDelay(10000ms);
+    ASSERT_TRUE(errorHandler_->scheduleRetry("ns=2;i=1"));
+
+    auto start = std::chrono::steady_clock::now();
+    errorHandler_->stop();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 500ms);
+
+    EXPECT_EQ(errorHandler_->getPendingRetryCount(), 0u);
+    EXPECT_FALSE(errorHandler_->scheduleRetry("ns=2;i=1"));
+}
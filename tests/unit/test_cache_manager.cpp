@@ -55,6 +55,51 @@ TEST_F(CacheManagerTest, CacheUpdate) {
     EXPECT_EQ(result->timestamp, 2000);
 }
 
+TEST_F(CacheManagerTest, SerializedJsonFollowsValue) {
+    cacheManager->updateCache("ns=2;s=TestNode", "100", "Good", "Success", 1000);
+
+    auto result = cacheManager->getCachedValue("ns=2;s=TestNode");
+    ASSERT_TRUE(result.has_value());
+    ASSERT_TRUE(result->json);
+    EXPECT_EQ(*result->json, result->toReadResult().toJson().dump());
+
+    // Rebuilt with the new value, and handed on to the ReadResult unchanged
+    cacheManager->updateCacheBatch({ReadResult::createError("ns=2;s=TestNode", "Bad \"quoted\" reason", 2000)});
+
+    result = cacheManager->getCachedValue("ns=2;s=TestNode");
+    ASSERT_TRUE(result.has_value());
+    ReadResult readResult = result->toReadResult();
+    ASSERT_TRUE(readResult.json);
+    EXPECT_EQ(readResult.json, result->json);
+    EXPECT_EQ(*readResult.json, readResult.toJson().dump());
+
+    std::string appended;
+    readResult.appendJson(appended);
+    EXPECT_EQ(appended, readResult.toJson().dump());
+}
+
+TEST_F(CacheManagerTest, SerializedJsonReplacesInvalidUtf8) {
+    std::string invalid = "abc\xC3\x28";
+
+    // One bad value must not keep the rest of the batch out of the cache
+    cacheManager->updateCacheBatch({ReadResult::createSuccess("ns=2;s=Bad", invalid, 1000),
+                                    ReadResult::createSuccess("ns=2;s=Good", "42", 1000)});
+
+    auto bad = cacheManager->getCachedValue("ns=2;s=Bad");
+    ASSERT_TRUE(bad.has_value());
+    EXPECT_EQ(bad->value, invalid);
+    ASSERT_TRUE(bad->json);
+    EXPECT_NE(bad->json->find("abc\xEF\xBF\xBD("), std::string::npos);
+    EXPECT_TRUE(cacheManager->getCachedValue("ns=2;s=Good").has_value());
+
+    cacheManager->updateCache("ns=2;s=Single", invalid, "Good", "Good", 1000);
+    EXPECT_TRUE(cacheManager->getCachedValue("ns=2;s=Single").has_value());
+
+    std::string appended;
+    ReadResult::createSuccess("ns=2;s=Bad", invalid, 1000).appendJson(appended);
+    EXPECT_EQ(appended, *bad->json);
+}
+
 TEST_F(CacheManagerTest, SubscriptionStatus) {
     // Add entry without subscription
     ReadResult readResult = ReadResult::createSuccess("ns=2;s=TestNode", "42", 1234567890);
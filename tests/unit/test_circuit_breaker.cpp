@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include "opcua/CircuitBreaker.h"
+#include <thread>
+#include <chrono>
+
+using namespace opcua2http;
+
+class CircuitBreakerTest : public ::testing::Test {
+protected:
+    CircuitBreaker breaker;
+
+    void openCircuit() {
+        for (int i = 0; i < 3; ++i) {
+            ASSERT_TRUE(breaker.allowRequest());
+            breaker.recordFailure();
+        }
+        ASSERT_EQ(breaker.getState(), CircuitBreaker::State::OPEN);
+    }
+};
+
+TEST_F(CircuitBreakerTest, DisabledByDefault) {
+    EXPECT_FALSE(breaker.isEnabled());
+
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_TRUE(breaker.allowRequest());
+        breaker.recordFailure();
+    }
+
+    EXPECT_EQ(breaker.getState(), CircuitBreaker::State::CLOSED);
+    EXPECT_EQ(breaker.getStats().trips, 0u);
+}
+
+TEST_F(CircuitBreakerTest, OpensAfterConsecutiveFailures) {
+    breaker.configure(3, std::chrono::milliseconds(5000), std::chrono::milliseconds(1000));
+    EXPECT_TRUE(breaker.isEnabled());
+
+    // A success in between resets the count
+    breaker.recordFailure();
+    breaker.recordFailure();
+    breaker.recordSuccess();
+    breaker.recordFailure();
+    EXPECT_EQ(breaker.getState(), CircuitBreaker::State::CLOSED);
+    EXPECT_EQ(breaker.getStats().consecutiveFailures, 1u);
+
+    breaker.recordFailure();
+    breaker.recordFailure();
+    EXPECT_EQ(breaker.getState(), CircuitBreaker::State::OPEN);
+    EXPECT_TRUE(breaker.isOpen());
+
+    // Rejections are immediate while open
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_FALSE(breaker.allowRequest());
+    }
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(100));
+
+    auto stats = breaker.getStats();
+    EXPECT_EQ(stats.trips, 1u);
+    EXPECT_EQ(stats.rejectedReads, 1000u);
+    EXPECT_GT(stats.retryIn.count(), 4000);
+}
+
+TEST_F(CircuitBreakerTest, HalfOpenAdmitsTrickleOfProbes) {
+    breaker.configure(3, std::chrono::milliseconds(50), std::chrono::milliseconds(200));
+    openCircuit();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    EXPECT_FALSE(breaker.isOpen());
+
+    // One probe goes through, the rest wait for the probe interval
+    EXPECT_TRUE(breaker.allowRequest());
+    EXPECT_EQ(breaker.getState(), CircuitBreaker::State::HALF_OPEN);
+    EXPECT_FALSE(breaker.allowRequest());
+    EXPECT_FALSE(breaker.allowRequest());
+    EXPECT_TRUE(breaker.isOpen());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(210));
+    EXPECT_TRUE(breaker.allowRequest());
+    EXPECT_EQ(breaker.getStats().probes, 2u);
+}
+
+TEST_F(CircuitBreakerTest, SuccessfulProbeClosesCircuit) {
+    breaker.configure(3, std::chrono::milliseconds(50), std::chrono::milliseconds(200));
+    openCircuit();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    ASSERT_TRUE(breaker.allowRequest());
+    breaker.recordSuccess();
+
+    EXPECT_EQ(breaker.getState(), CircuitBreaker::State::CLOSED);
+    EXPECT_TRUE(breaker.allowRequest());
+    EXPECT_EQ(breaker.getStats().consecutiveFailures, 0u);
+}
+
+TEST_F(CircuitBreakerTest, FailedProbeReopensCircuit) {
+    breaker.configure(3, std::chrono::milliseconds(50), std::chrono::milliseconds(200));
+    openCircuit();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    ASSERT_TRUE(breaker.allowRequest());
+    breaker.recordFailure();
+
+    EXPECT_EQ(breaker.getState(), CircuitBreaker::State::OPEN);
+    EXPECT_FALSE(breaker.allowRequest());
+    EXPECT_EQ(breaker.getStats().trips, 2u);
+}
+
+TEST_F(CircuitBreakerTest, ResetClosesCircuit) {
+    breaker.configure(3, std::chrono::milliseconds(5000), std::chrono::milliseconds(1000));
+    openCircuit();
+
+    breaker.reset();
+    EXPECT_EQ(breaker.getState(), CircuitBreaker::State::CLOSED);
+    EXPECT_TRUE(breaker.allowRequest());
+
+    auto stats = breaker.getStats();
+    EXPECT_EQ(stats.openFor.count(), 0);
+    EXPECT_EQ(stats.retryIn.count(), 0);
+}
+
+TEST_F(CircuitBreakerTest, OpenErrorIsRecognized) {
+    EXPECT_TRUE(CircuitBreaker::isOpenError(CircuitBreaker::OPEN_ERROR));
+    EXPECT_FALSE(CircuitBreaker::isOpenError("Client not connected"));
+    EXPECT_STREQ(CircuitBreaker::stateToString(CircuitBreaker::State::HALF_OPEN), "half_open");
+}
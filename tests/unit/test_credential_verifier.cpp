@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include "http/CredentialVerifier.h"
+#include "core/AllocationTracker.h"
+#include <string>
+
+using namespace opcua2http;
+
+class CredentialVerifierTest : public ::testing::Test {
+protected:
+    CredentialVerifier verifier{"test-api-key", "testuser", "testpass"};
+};
+
+TEST_F(CredentialVerifierTest, EncodesBase64WithPadding) {
+    EXPECT_EQ(CredentialVerifier::encodeBase64(""), "");
+    EXPECT_EQ(CredentialVerifier::encodeBase64("f"), "Zg==");
+    EXPECT_EQ(CredentialVerifier::encodeBase64("fo"), "Zm8=");
+    EXPECT_EQ(CredentialVerifier::encodeBase64("foo"), "Zm9v");
+    EXPECT_EQ(CredentialVerifier::encodeBase64("testuser:testpass"), "dGVzdHVzZXI6dGVzdHBhc3M=");
+}
+
+TEST_F(CredentialVerifierTest, ConstantTimeEqualsComparesWholeValue) {
+    EXPECT_TRUE(CredentialVerifier::constantTimeEquals("secret", "secret"));
+    EXPECT_FALSE(CredentialVerifier::constantTimeEquals("secret", "secreT"));
+    EXPECT_FALSE(CredentialVerifier::constantTimeEquals("secret", "secret2"));
+    EXPECT_FALSE(CredentialVerifier::constantTimeEquals("secret", "secre"));
+    EXPECT_FALSE(CredentialVerifier::constantTimeEquals("secret", ""));
+    EXPECT_FALSE(CredentialVerifier::constantTimeEquals("", ""));
+
+    // A shorter value repeating the secret's prefix must not match
+    EXPECT_FALSE(CredentialVerifier::constantTimeEquals("abab", "ab"));
+}
+
+TEST_F(CredentialVerifierTest, VerifiesAPIKey) {
+    EXPECT_TRUE(verifier.hasAPIKey());
+    EXPECT_TRUE(verifier.verifyAPIKey("test-api-key"));
+    EXPECT_FALSE(verifier.verifyAPIKey("test-api-kex"));
+    EXPECT_FALSE(verifier.verifyAPIKey(""));
+}
+
+TEST_F(CredentialVerifierTest, VerifiesBasicAuthorizationHeader) {
+    EXPECT_TRUE(verifier.hasBasicAuth());
+    EXPECT_TRUE(verifier.verifyAuthorizationHeader("Basic dGVzdHVzZXI6dGVzdHBhc3M="));
+    EXPECT_TRUE(verifier.verifyAuthorizationHeader("basic dGVzdHVzZXI6dGVzdHBhc3M="));
+    EXPECT_TRUE(verifier.verifyAuthorizationHeader("Basic   dGVzdHVzZXI6dGVzdHBhc3M="));
+
+    EXPECT_FALSE(verifier.verifyAuthorizationHeader("Basic d3JvbmdVc2VyOndyb25nUGFzcw=="));
+    EXPECT_FALSE(verifier.verifyAuthorizationHeader("Bearer dGVzdHVzZXI6dGVzdHBhc3M="));
+    EXPECT_FALSE(verifier.verifyAuthorizationHeader("BasicdGVzdHVzZXI6dGVzdHBhc3M="));
+    EXPECT_FALSE(verifier.verifyAuthorizationHeader("Basic "));
+    EXPECT_FALSE(verifier.verifyAuthorizationHeader("Basic"));
+    EXPECT_FALSE(verifier.verifyAuthorizationHeader(""));
+}
+
+TEST_F(CredentialVerifierTest, NothingMatchesWhenNotConfigured) {
+    CredentialVerifier none("", "testuser", "");
+
+    EXPECT_FALSE(none.hasAPIKey());
+    EXPECT_FALSE(none.hasBasicAuth());
+    EXPECT_FALSE(none.verifyAPIKey(""));
+    EXPECT_FALSE(none.verifyAuthorizationHeader("Basic " + CredentialVerifier::encodeBase64("testuser:")));
+}
+
+TEST_F(CredentialVerifierTest, VerificationDoesNotAllocate) {
+    if (!AllocationTracker::isEnabled()) {
+        GTEST_SKIP() << "Allocation hooks not built in";
+    }
+
+    std::string apiKey = "test-api-key";
+    std::string header = "Basic dGVzdHVzZXI6dGVzdHBhc3M=";
+
+    auto before = AllocationTracker::thread();
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_TRUE(verifier.verifyAPIKey(apiKey));
+        EXPECT_TRUE(verifier.verifyAuthorizationHeader(header));
+    }
+    EXPECT_EQ((AllocationTracker::thread() - before).allocations, 0u);
+}
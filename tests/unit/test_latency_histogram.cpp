@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+#include "cache/LatencyHistogram.h"
+#include "cache/PerformanceMonitor.h"
+
+using namespace opcua2http;
+using namespace std::chrono_literals;
+
+TEST(LatencyHistogramTest, BucketsCoverEveryValue) {
+    // Small values are exact; larger buckets are contiguous and at most 1/16 wide
+    for (uint64_t value = 0; value < LatencyHistogram::SUB_BUCKETS; ++value) {
+        EXPECT_EQ(LatencyHistogram::bucketIndex(value), value);
+    }
+
+    size_t previous = 0;
+    for (uint64_t value = 1; value < (uint64_t{1} << 30); value = value * 3 / 2 + 1) {
+        size_t index = LatencyHistogram::bucketIndex(value);
+        EXPECT_GE(index, previous);
+        EXPECT_GE(LatencyHistogram::bucketUpperBound(index), value);
+        EXPECT_LE(LatencyHistogram::bucketUpperBound(index) - value, value / LatencyHistogram::SUB_BUCKETS);
+        previous = index;
+    }
+
+    EXPECT_EQ(LatencyHistogram::bucketIndex(LatencyHistogram::MAX_VALUE), LatencyHistogram::BUCKET_COUNT - 1);
+    EXPECT_EQ(LatencyHistogram::bucketIndex(UINT64_MAX), LatencyHistogram::BUCKET_COUNT - 1);
+}
+
+TEST(LatencyHistogramTest, PercentilesFollowTheTail) {
+    LatencyHistogram histogram;
+
+    // 990 fast requests and a 1% tail the average would hide
+    for (int i = 0; i < 990; ++i) {
+        histogram.record(100us);
+    }
+    for (int i = 0; i < 10; ++i) {
+        histogram.record(50ms);
+    }
+
+    auto snapshot = histogram.snapshot();
+    EXPECT_EQ(snapshot.count, 1000u);
+    EXPECT_NEAR(snapshot.percentileMs(50.0), 0.1, 0.1 / 16);
+    EXPECT_NEAR(snapshot.percentileMs(99.0), 0.1, 0.1 / 16);
+    EXPECT_NEAR(snapshot.percentileMs(99.9), 50.0, 50.0 / 16);
+    EXPECT_DOUBLE_EQ(snapshot.maxMs(), 50.0);
+    EXPECT_NEAR(snapshot.meanMs(), 0.599, 0.001);
+
+    auto json = snapshot.toJSON();
+    EXPECT_EQ(json["count"], 1000);
+    EXPECT_TRUE(json.contains("p999_ms"));
+}
+
+TEST(LatencyHistogramTest, EmptyAndReset) {
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.snapshot().percentileMs(99.0), 0.0);
+
+    histogram.recordMs(3.0);
+    histogram.reset();
+
+    auto snapshot = histogram.snapshot();
+    EXPECT_EQ(snapshot.count, 0u);
+    EXPECT_EQ(snapshot.maxMs(), 0.0);
+}
+
+TEST(LatencyHistogramTest, ThreadsRecordAndSnapshotsMerge) {
+    LatencyHistogram fast;
+    LatencyHistogram slow;
+    const int threads = 8;
+    const int perThread = 5000;
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&]() {
+            for (int i = 0; i < perThread; ++i) {
+                fast.record(10us);
+                slow.record(10ms);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    auto merged = fast.snapshot();
+    EXPECT_EQ(merged.count, static_cast<uint64_t>(threads * perThread));
+    merged.merge(slow.snapshot());
+
+    EXPECT_EQ(merged.count, static_cast<uint64_t>(2 * threads * perThread));
+    EXPECT_NEAR(merged.percentileMs(25.0), 0.01, 0.01 / 16);
+    EXPECT_NEAR(merged.percentileMs(75.0), 10.0, 10.0 / 16);
+}
+
+TEST(LatencyHistogramTest, OpcReadLatencyIsSplitByBatchSize) {
+    PerformanceMonitor monitor;
+
+    {
+        PerformanceMonitor::ScopedTimer timer(&monitor, PerformanceMonitor::OperationType::OPC_READ, 1);
+    }
+    monitor.recordOpcReadLatency(20, 4ms);
+    monitor.recordOpcReadLatency(500, 40ms);
+
+    auto latencies = monitor.getOpcReadLatencies();
+    ASSERT_EQ(latencies.size(), PerformanceMonitor::OPC_BATCH_CLASS_COUNT);
+    EXPECT_EQ(latencies[0].label, "1");
+    EXPECT_EQ(latencies[1].label, "2-8");
+    EXPECT_EQ(latencies[2].label, "9-32");
+    EXPECT_EQ(latencies[4].label, "129+");
+
+    EXPECT_EQ(latencies[0].latency.count, 1u);
+    EXPECT_EQ(latencies[1].latency.count, 0u);
+    EXPECT_EQ(latencies[2].latency.count, 1u);
+    EXPECT_EQ(latencies[4].latency.count, 1u);
+    EXPECT_NEAR(latencies[4].latency.percentileMs(50.0), 40.0, 40.0 / 16);
+}
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#include "cache/LockProfiler.h"
+
+using namespace opcua2http;
+using namespace std::chrono_literals;
+
+namespace {
+
+ProfiledLock<std::unique_lock<std::mutex>> lockAt(LockProfiler* profiler, std::mutex& mutex,
+                                                  std::source_location site = std::source_location::current()) {
+    return LockProfiler::acquire(profiler, LockProfiler::LockId::SUBSCRIPTION_MUTEX,
+                                 std::unique_lock<std::mutex>(mutex, std::defer_lock), site);
+}
+
+} // namespace
+
+TEST(LockProfilerTest, WithoutProfilerLocksPlainly) {
+    std::mutex mutex;
+    {
+        auto lock = lockAt(nullptr, mutex);
+        EXPECT_TRUE(lock.owns_lock());
+        EXPECT_FALSE(mutex.try_lock());
+    }
+    EXPECT_TRUE(mutex.try_lock());
+    mutex.unlock();
+}
+
+TEST(LockProfilerTest, RecordsHoldTimeAndCallSites) {
+    LockProfiler profiler;
+    std::mutex mutex;
+
+    for (int i = 0; i < 3; ++i) {
+        auto lock = lockAt(&profiler, mutex);
+        std::this_thread::sleep_for(2ms);
+    }
+    {
+        auto lock = lockAt(&profiler, mutex);
+        lock.unlock();
+        EXPECT_FALSE(lock.owns_lock());
+    }
+
+    auto report = profiler.getLockReport(LockProfiler::LockId::SUBSCRIPTION_MUTEX);
+    EXPECT_EQ(report.acquisitions, 4u);
+    EXPECT_EQ(report.contentions, 0u);
+    EXPECT_EQ(report.wait.count, 4u);
+    EXPECT_EQ(report.hold.count, 4u);
+    EXPECT_GE(report.hold.maxMs(), 2.0);
+    EXPECT_EQ(profiler.getLockReport(LockProfiler::LockId::CACHE_MUTEX).acquisitions, 0u);
+
+    // The loop and the block are two call sites; the loop held the lock longer
+    auto sites = profiler.getTopCallSites();
+    ASSERT_EQ(sites.size(), 2u);
+    EXPECT_EQ(sites[0].acquisitions, 3u);
+    EXPECT_EQ(sites[1].acquisitions, 1u);
+    EXPECT_GE(sites[0].totalHoldMs, 6.0);
+    EXPECT_NE(sites[0].line, sites[1].line);
+    EXPECT_NE(sites[0].file.find("test_lock_profiler.cpp"), std::string::npos);
+}
+
+TEST(LockProfilerTest, AttributesWaitToTheWaitingCallSite) {
+    LockProfiler profiler;
+    std::mutex mutex;
+
+    auto holder = lockAt(&profiler, mutex);
+    std::thread waiter([&]() {
+        auto lock = lockAt(&profiler, mutex);
+    });
+    std::this_thread::sleep_for(20ms);
+    holder.unlock();
+    waiter.join();
+
+    auto report = profiler.getLockReport(LockProfiler::LockId::SUBSCRIPTION_MUTEX);
+    EXPECT_EQ(report.acquisitions, 2u);
+    EXPECT_EQ(report.contentions, 1u);
+    EXPECT_GE(report.wait.maxMs(), 10.0);
+
+    auto sites = profiler.getTopCallSites(1);
+    ASSERT_EQ(sites.size(), 1u);
+    EXPECT_EQ(sites[0].contentions, 1u);
+    EXPECT_GE(sites[0].totalWaitMs, 10.0);
+}
+
+TEST(LockProfilerTest, RecordsToPerformanceMonitorToo) {
+    LockProfiler profiler;
+    PerformanceMonitor monitor;
+    std::shared_mutex mutex;
+
+    {
+        auto lock = LockProfiler::acquire(&profiler, LockProfiler::LockId::CACHE_MUTEX,
+                                          std::shared_lock<std::shared_mutex>(mutex, std::defer_lock),
+                                          &monitor, PerformanceMonitor::LockType::CACHE_MUTEX,
+                                          std::source_location::current());
+        EXPECT_TRUE(lock.owns_lock());
+    }
+
+    EXPECT_EQ(monitor.getMetrics().cacheLock.acquisitions, 1u);
+    EXPECT_EQ(profiler.getLockReport(LockProfiler::LockId::CACHE_MUTEX).acquisitions, 1u);
+}
+
+TEST(LockProfilerTest, MovedGuardReportsOnce) {
+    LockProfiler profiler;
+    std::mutex mutex;
+
+    {
+        auto first = lockAt(&profiler, mutex);
+        auto second = std::move(first);
+        EXPECT_FALSE(first.owns_lock());
+        EXPECT_TRUE(second.owns_lock());
+    }
+
+    EXPECT_EQ(profiler.getLockReport(LockProfiler::LockId::SUBSCRIPTION_MUTEX).hold.count, 1u);
+}
+
+TEST(LockProfilerTest, ResetClearsStatisticsAndJSONListsAllLocks) {
+    LockProfiler profiler;
+    std::mutex mutex;
+    {
+        auto lock = lockAt(&profiler, mutex);
+    }
+    profiler.reset();
+
+    EXPECT_EQ(profiler.getLockReport(LockProfiler::LockId::SUBSCRIPTION_MUTEX).acquisitions, 0u);
+    EXPECT_TRUE(profiler.getTopCallSites().empty());
+
+    auto json = profiler.toJSON();
+    EXPECT_TRUE(json["locks"].contains("cache_mutex"));
+    EXPECT_TRUE(json["locks"].contains("client_mutex"));
+    EXPECT_TRUE(json["locks"].contains("subscription_mutex"));
+    EXPECT_TRUE(json["locks"]["cache_mutex"]["wait"].contains("p99_ms"));
+    EXPECT_TRUE(json["top_call_sites"].is_array());
+}
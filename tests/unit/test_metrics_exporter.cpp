@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include <string>
+
+#include "http/MetricsExporter.h"
+#include "cache/CacheManager.h"
+#include "cache/PerformanceMonitor.h"
+
+using namespace opcua2http;
+using namespace std::chrono_literals;
+
+namespace {
+
+bool contains(const std::string& text, const std::string& needle) {
+    return text.find(needle) != std::string::npos;
+}
+
+} // namespace
+
+TEST(MetricsExporterTest, UnsetSourcesAreSkipped) {
+    MetricsExporter exporter;
+    std::string text;
+    exporter.render(text);
+
+    EXPECT_TRUE(contains(text, "# TYPE opcua2http_uptime_seconds gauge\n"));
+    EXPECT_FALSE(contains(text, "opcua2http_cache_"));
+    EXPECT_FALSE(contains(text, "opcua2http_http_request_duration_seconds"));
+    EXPECT_EQ(exporter.getScrapeCount(), 1u);
+}
+
+TEST(MetricsExporterTest, RendersCacheCounters) {
+    CacheManager cacheManager(1, 100);
+    cacheManager.updateCache("ns=2;s=Node1", "100", "Good", "Success", 1000);
+    cacheManager.getCachedValue("ns=2;s=Node1");
+    cacheManager.getCachedValue("ns=2;s=Missing");
+
+    MetricsExporter exporter;
+    exporter.setCacheManager(&cacheManager);
+
+    std::string text;
+    exporter.render(text);
+
+    EXPECT_TRUE(contains(text, "# TYPE opcua2http_cache_hits_total counter\n"));
+    EXPECT_TRUE(contains(text, "\nopcua2http_cache_entries 1\n"));
+    EXPECT_TRUE(contains(text, "\nopcua2http_cache_hits_total 1\n"));
+    EXPECT_TRUE(contains(text, "\nopcua2http_cache_misses_total 1\n"));
+    EXPECT_TRUE(contains(text, "\nopcua2http_cache_writes_total 1\n"));
+    EXPECT_TRUE(contains(text, "# TYPE opcua2http_cache_evictions_total counter\n"));
+}
+
+TEST(MetricsExporterTest, HistogramBucketsAreCumulative) {
+    LatencyHistogram requestLatency;
+    requestLatency.record(200us);
+    requestLatency.record(3ms);
+    requestLatency.record(20s);
+
+    MetricsExporter exporter;
+    exporter.setRequestLatency(&requestLatency);
+
+    std::string text;
+    exporter.render(text);
+
+    const std::string name = "opcua2http_http_request_duration_seconds";
+    EXPECT_TRUE(contains(text, "# TYPE " + name + " histogram\n"));
+    EXPECT_TRUE(contains(text, name + "_bucket{le=\"0.0001\"} 0\n"));
+    EXPECT_TRUE(contains(text, name + "_bucket{le=\"0.00025\"} 1\n"));
+    EXPECT_TRUE(contains(text, name + "_bucket{le=\"0.005\"} 2\n"));
+    EXPECT_TRUE(contains(text, name + "_bucket{le=\"10\"} 2\n"));
+    EXPECT_TRUE(contains(text, name + "_bucket{le=\"+Inf\"} 3\n"));
+    EXPECT_TRUE(contains(text, name + "_count 3\n"));
+}
+
+TEST(MetricsExporterTest, OpcReadLatencyIsLabelledByBatchSize) {
+    PerformanceMonitor monitor;
+    monitor.recordOpcReadLatency(20, 4ms);
+
+    MetricsExporter exporter;
+    exporter.setPerformanceMonitor(&monitor);
+
+    std::string first;
+    exporter.render(first);
+
+    const std::string name = "opcua2http_opc_read_duration_seconds";
+    EXPECT_TRUE(contains(first, name + "_count{batch_size=\"9-32\"} 1\n"));
+    EXPECT_TRUE(contains(first, name + "_count{batch_size=\"1\"} 0\n"));
+    EXPECT_TRUE(contains(first, name + "_bucket{batch_size=\"9-32\",le=\"+Inf\"} 1\n"));
+
+    // The family header is written once, not once per series
+    EXPECT_EQ(first.find("# TYPE " + name), first.rfind("# TYPE " + name));
+
+    // A second scrape replaces the output instead of appending to it
+    std::string second;
+    exporter.render(second);
+    EXPECT_EQ(second.find("# TYPE " + name), second.rfind("# TYPE " + name));
+    EXPECT_EQ(exporter.getScrapeCount(), 2u);
+}
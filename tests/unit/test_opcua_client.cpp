@@ -179,6 +179,58 @@ TEST_F(OPCUAClientTest, LastErrorTracking) {
     // Note: Error tracking is implementation dependent, so we just verify the method works
 }
 
+// Test deadline-bounded reads and abandonment
+TEST_F(OPCUAClientTest, ReadWithDeadline) {
+    auto client = createConnectedOPCClient();
+    ASSERT_NE(client, nullptr);
+
+    ReadResult result = client->readNodeWithDeadline(getTestNodeId(1001), std::chrono::milliseconds(2000));
+    EXPECT_TRUE(result.success);
+    EXPECT_EQ(result.value, "42");
+
+    // A cancelled read is abandoned without waiting for the response
+    std::atomic<bool> cancel{true};
+    auto start = std::chrono::steady_clock::now();
+    result = client->readNodeWithDeadline(getTestNodeId(1002), std::chrono::milliseconds(2000), &cancel);
+    EXPECT_FALSE(result.success);
+    EXPECT_EQ(result.reason, OPCUAClient::READ_CANCELLED_ERROR);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(500));
+
+    // The abandoned response is discarded and the client keeps working
+    result = client->readNodeWithDeadline(getTestNodeId(1002), std::chrono::milliseconds(2000));
+    EXPECT_TRUE(result.success);
+    EXPECT_EQ(result.value, "Hello World");
+}
+
+// Test that reads fail fast once the circuit breaker opens and recover on connect
+TEST_F(OPCUAClientTest, CircuitBreakerFailsFastWhileDisconnected) {
+    auto client = createOPCClient();
+    ASSERT_NE(client, nullptr);
+    ASSERT_TRUE(client->getCircuitBreaker().isEnabled());
+
+    for (int i = 0; i < config_.opcCircuitBreakerFailureThreshold; ++i) {
+        ReadResult result = client->readNode(getTestNodeId(1001));
+        EXPECT_FALSE(result.success);
+        EXPECT_FALSE(CircuitBreaker::isOpenError(result.reason));
+    }
+    EXPECT_EQ(client->getCircuitBreaker().getState(), CircuitBreaker::State::OPEN);
+
+    ReadResult result = client->readNode(getTestNodeId(1001));
+    EXPECT_FALSE(result.success);
+    EXPECT_EQ(result.reason, CircuitBreaker::OPEN_ERROR);
+
+    auto batch = client->readNodesBatch({getTestNodeId(1001), getTestNodeId(1002)});
+    ASSERT_EQ(batch.size(), 2u);
+    EXPECT_EQ(batch[1].reason, CircuitBreaker::OPEN_ERROR);
+
+    // A new session closes the circuit
+    ASSERT_TRUE(client->connect());
+    EXPECT_EQ(client->getCircuitBreaker().getState(), CircuitBreaker::State::CLOSED);
+    result = client->readNode(getTestNodeId(1001));
+    EXPECT_TRUE(result.success);
+    EXPECT_EQ(result.value, "42");
+}
+
 // Custom test with additional variables
 class CustomVariableTest : public OPCUATestBase {
 protected:
@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include <mutex>
+#include <shared_mutex>
+#include <atomic>
+
+#include "cache/PerformanceMonitor.h"
+#include "cache/CacheManager.h"
+
+using namespace opcua2http;
+using namespace std::chrono_literals;
+
+using OperationType = PerformanceMonitor::OperationType;
+using LockType = PerformanceMonitor::LockType;
+
+TEST(PerformanceMonitorTest, ScopedTimerRecordsOperation) {
+    PerformanceMonitor monitor;
+
+    {
+        PerformanceMonitor::ScopedTimer timer(&monitor, OperationType::OPC_READ);
+        std::this_thread::sleep_for(5ms);
+    }
+
+    auto metrics = monitor.getMetrics();
+    EXPECT_EQ(metrics.opcReads, 1u);
+    EXPECT_GE(metrics.avgOPCReadTime, 5.0);
+    EXPECT_EQ(metrics.totalOperations, 1u);
+}
+
+TEST(PerformanceMonitorTest, NullOrDisabledMonitorIsNoOp) {
+    {
+        PerformanceMonitor::ScopedTimer timer(nullptr, OperationType::CACHE_READ);
+    }
+
+    PerformanceMonitor monitor;
+    monitor.setEnabled(false);
+    {
+        PerformanceMonitor::ScopedTimer timer(&monitor, OperationType::CACHE_READ);
+    }
+    std::mutex mutex;
+    std::unique_lock<std::mutex> lock(mutex, std::defer_lock);
+    PerformanceMonitor::acquireLock(&monitor, LockType::CACHE_MUTEX, lock);
+    EXPECT_TRUE(lock.owns_lock());
+
+    auto metrics = monitor.getMetrics();
+    EXPECT_EQ(metrics.totalOperations, 0u);
+    EXPECT_EQ(metrics.cacheLock.acquisitions, 0u);
+}
+
+TEST(PerformanceMonitorTest, CacheOperationsAreCountedButSampled) {
+    PerformanceMonitor monitor;
+
+    const uint64_t reads = PerformanceMonitor::CACHE_SAMPLE_INTERVAL * 10;
+    for (uint64_t i = 0; i < reads; ++i) {
+        PerformanceMonitor::ScopedTimer timer(&monitor, OperationType::CACHE_READ);
+    }
+
+    auto metrics = monitor.getMetrics();
+    EXPECT_EQ(metrics.cacheReads, reads);
+    EXPECT_GE(metrics.avgCacheReadTime, 0.0);
+    EXPECT_LT(metrics.avgCacheReadTime, 1.0);
+}
+
+TEST(PerformanceMonitorTest, CountsAreExactAcrossThreads) {
+    PerformanceMonitor monitor;
+    const int threads = 8;
+    const int perThread = 10000;
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&monitor]() {
+            for (int i = 0; i < perThread; ++i) {
+                PerformanceMonitor::ScopedTimer timer(&monitor, OperationType::CACHE_WRITE);
+            }
+            monitor.recordOperationTime(OperationType::BACKGROUND_UPDATE, 2.0);
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    auto metrics = monitor.getMetrics();
+    EXPECT_EQ(metrics.cacheWrites, static_cast<uint64_t>(threads * perThread));
+    EXPECT_EQ(metrics.backgroundUpdates, static_cast<uint64_t>(threads));
+    EXPECT_DOUBLE_EQ(metrics.avgBackgroundUpdateTime, 2.0);
+}
+
+TEST(PerformanceMonitorTest, UncontendedLockIsNotAWait) {
+    PerformanceMonitor monitor;
+    std::shared_mutex mutex;
+
+    for (int i = 0; i < 100; ++i) {
+        std::shared_lock<std::shared_mutex> lock(mutex, std::defer_lock);
+        PerformanceMonitor::acquireLock(&monitor, LockType::CACHE_MUTEX, lock);
+        ASSERT_TRUE(lock.owns_lock());
+    }
+
+    auto metrics = monitor.getMetrics();
+    EXPECT_EQ(metrics.cacheLock.acquisitions, 100u);
+    EXPECT_EQ(metrics.cacheLock.contentions, 0u);
+    EXPECT_EQ(metrics.lockContentionRatio, 0.0);
+}
+
+TEST(PerformanceMonitorTest, ContendedLockRecordsWait) {
+    PerformanceMonitor monitor;
+    std::timed_mutex mutex;
+    std::atomic<bool> held{false};
+
+    std::thread holder([&]() {
+        std::lock_guard<std::timed_mutex> lock(mutex);
+        held = true;
+        std::this_thread::sleep_for(30ms);
+    });
+    while (!held.load()) {
+        std::this_thread::sleep_for(1ms);
+    }
+
+    std::unique_lock<std::timed_mutex> lock(mutex, std::defer_lock);
+    PerformanceMonitor::acquireLock(&monitor, LockType::CLIENT_MUTEX, lock);
+    EXPECT_TRUE(lock.owns_lock());
+    lock.unlock();
+    holder.join();
+
+    auto metrics = monitor.getMetrics();
+    EXPECT_EQ(metrics.clientLock.acquisitions, 1u);
+    EXPECT_EQ(metrics.clientLock.contentions, 1u);
+    EXPECT_GT(metrics.clientLock.avgWaitTime, 5.0);
+    EXPECT_EQ(metrics.totalLockWaits, 1u);
+}
+
+TEST(PerformanceMonitorTest, ResetClearsCounters) {
+    PerformanceMonitor monitor;
+    monitor.recordOperationTime(OperationType::OPC_BATCH_READ, 10.0);
+    monitor.recordLockWait(LockType::CACHE_MUTEX, 1ms);
+
+    monitor.reset();
+
+    auto metrics = monitor.getMetrics();
+    EXPECT_EQ(metrics.totalOperations, 0u);
+    EXPECT_EQ(metrics.cacheLock.acquisitions, 0u);
+    EXPECT_EQ(metrics.avgBatchReadTime, 0.0);
+}
+
+TEST(PerformanceMonitorTest, CacheManagerReportsOperationsAndLocks) {
+    PerformanceMonitor monitor;
+    CacheManager cache(60, 1000, 3, 10);
+    cache.setPerformanceMonitor(&monitor);
+
+    cache.updateCache("ns=2;i=1", "42", "Good", "Good", 1000);
+    for (int i = 0; i < 10; ++i) {
+        cache.getCachedValue("ns=2;i=1");
+    }
+    cache.getCachedValuesWithStatus({"ns=2;i=1", "ns=2;i=2"});
+
+    auto metrics = monitor.getMetrics();
+    EXPECT_EQ(metrics.cacheWrites, 1u);
+    EXPECT_EQ(metrics.cacheReads, 11u);
+    EXPECT_GE(metrics.cacheLock.acquisitions, 12u);
+}
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include "http/RateLimiter.h"
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace opcua2http;
+using namespace std::chrono_literals;
+
+class RateLimiterTest : public ::testing::Test {
+protected:
+    RateLimiter limiter;
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+
+    RateLimiter::Settings limited(double rate, double burst = 0.0) {
+        RateLimiter::Settings settings;
+        settings.requestsPerSecond = rate;
+        settings.burst = burst;
+        return settings;
+    }
+};
+
+TEST_F(RateLimiterTest, UnlimitedByDefaultAndTracksNobody) {
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(limiter.check("10.0.0." + std::to_string(i % 200), t0), RateLimiter::Decision::ALLOWED);
+    }
+
+    auto stats = limiter.getStats();
+    EXPECT_EQ(stats.allowed, 1000u);
+    EXPECT_EQ(stats.trackedClients, 0u);
+}
+
+TEST_F(RateLimiterTest, BucketAllowsBurstThenRefills) {
+    limiter.configure(limited(2.0, 4.0));
+
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(limiter.check("10.0.0.1", t0), RateLimiter::Decision::ALLOWED) << "request " << i;
+    }
+    EXPECT_EQ(limiter.check("10.0.0.1", t0), RateLimiter::Decision::RATE_LIMITED);
+
+    // Other clients have their own bucket
+    EXPECT_EQ(limiter.check("10.0.0.2", t0), RateLimiter::Decision::ALLOWED);
+
+    // 2 requests/s: one token after 500ms
+    EXPECT_EQ(limiter.check("10.0.0.1", t0 + 500ms), RateLimiter::Decision::ALLOWED);
+    EXPECT_EQ(limiter.check("10.0.0.1", t0 + 500ms), RateLimiter::Decision::RATE_LIMITED);
+
+    auto stats = limiter.getStats();
+    EXPECT_EQ(stats.allowed, 6u);
+    EXPECT_EQ(stats.rateLimited, 2u);
+    EXPECT_EQ(stats.trackedClients, 2u);
+}
+
+TEST_F(RateLimiterTest, FailedAuthenticationsBlockForBlockDuration) {
+    auto settings = limited(0.0);
+    settings.maxFailedAuth = 3;
+    settings.blockDuration = 60s;
+    limiter.configure(settings);
+
+    EXPECT_FALSE(limiter.recordFailure("10.0.0.1", t0));
+    EXPECT_FALSE(limiter.recordFailure("10.0.0.1", t0 + 1s));
+    EXPECT_EQ(limiter.check("10.0.0.1", t0 + 2s), RateLimiter::Decision::ALLOWED);
+    EXPECT_TRUE(limiter.recordFailure("10.0.0.1", t0 + 2s));
+
+    EXPECT_EQ(limiter.check("10.0.0.1", t0 + 3s), RateLimiter::Decision::BLOCKED);
+    EXPECT_EQ(limiter.check("10.0.0.2", t0 + 3s), RateLimiter::Decision::ALLOWED);
+    EXPECT_EQ(limiter.check("10.0.0.1", t0 + 63s), RateLimiter::Decision::ALLOWED);
+
+    auto stats = limiter.getStats();
+    EXPECT_EQ(stats.blocks, 1u);
+    EXPECT_EQ(stats.blockedRequests, 1u);
+}
+
+TEST_F(RateLimiterTest, FailuresOutsideTheWindowDoNotAddUp) {
+    auto settings = limited(0.0);
+    settings.maxFailedAuth = 2;
+    limiter.configure(settings);
+
+    EXPECT_FALSE(limiter.recordFailure("10.0.0.1", t0));
+    EXPECT_FALSE(limiter.recordFailure("10.0.0.1", t0 + RateLimiter::FAILURE_WINDOW + 1s));
+    EXPECT_TRUE(limiter.recordFailure("10.0.0.1", t0 + RateLimiter::FAILURE_WINDOW + 2s));
+}
+
+TEST_F(RateLimiterTest, MemoryIsBoundedByMaxClients) {
+    auto settings = limited(1.0, 1.0);
+    settings.maxClients = RateLimiter::SHARD_COUNT * 4;
+    limiter.configure(settings);
+
+    // Every client drains its bucket, so no entry is idle and the oldest are evicted
+    for (int i = 0; i < 10000; ++i) {
+        limiter.check("client-" + std::to_string(i), t0);
+    }
+    auto stats = limiter.getStats();
+    EXPECT_LE(stats.trackedClients, settings.maxClients);
+    EXPECT_GT(stats.evictions, 0u);
+
+    // One request per client per second: earlier buckets have refilled by the
+    // time a new client arrives, so idle entries make room without evictions
+    auto evictions = stats.evictions;
+    for (int i = 0; i < 10000; ++i) {
+        limiter.check("later-" + std::to_string(i), t0 + 2s + std::chrono::seconds(i));
+    }
+    stats = limiter.getStats();
+    EXPECT_LE(stats.trackedClients, settings.maxClients);
+    EXPECT_EQ(stats.evictions, evictions);
+}
+
+TEST_F(RateLimiterTest, BlockedClientsAreNotIdle) {
+    auto settings = limited(0.0);
+    settings.maxFailedAuth = 2;
+    settings.maxClients = RateLimiter::SHARD_COUNT * 4;
+    limiter.configure(settings);
+
+    limiter.recordFailure("attacker", t0);
+    EXPECT_TRUE(limiter.recordFailure("attacker", t0));
+
+    // A flood of newer failing clients evicts unblocked entries before blocked ones
+    for (int i = 0; i < 1000; ++i) {
+        limiter.recordFailure("client-" + std::to_string(i), t0 + 1s);
+    }
+    EXPECT_GT(limiter.getStats().evictions, 0u);
+    EXPECT_EQ(limiter.check("attacker", t0 + 2s), RateLimiter::Decision::BLOCKED);
+}
+
+TEST_F(RateLimiterTest, ConcurrentClientsKeepExactCounts) {
+    limiter.configure(limited(1000000.0));
+
+    constexpr int THREADS = 8;
+    constexpr int REQUESTS = 5000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([this, t]() {
+            for (int i = 0; i < REQUESTS; ++i) {
+                limiter.check("10.0." + std::to_string(t) + "." + std::to_string(i % 16));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    auto stats = limiter.getStats();
+    EXPECT_EQ(stats.allowed + stats.rateLimited, static_cast<uint64_t>(THREADS * REQUESTS));
+    EXPECT_EQ(stats.trackedClients, static_cast<size_t>(THREADS * 16));
+}
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include "opcua/ReadBudget.h"
+#include <thread>
+#include <chrono>
+
+using namespace opcua2http;
+
+class ReadBudgetTest : public ::testing::Test {
+protected:
+    ReadBudget budget;
+};
+
+TEST_F(ReadBudgetTest, UnlimitedByDefault) {
+    EXPECT_FALSE(budget.isEnabled());
+
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_TRUE(budget.tryAcquire(50, 1, ReadBudget::Priority::BACKGROUND));
+    }
+
+    auto stats = budget.getStats();
+    EXPECT_EQ(stats.grantedRequests, 1000u);
+    EXPECT_EQ(stats.grantedNodes, 50000u);
+    EXPECT_EQ(stats.rejectedRequests, 0u);
+    EXPECT_DOUBLE_EQ(stats.nodeUtilization, 0.0);
+}
+
+TEST_F(ReadBudgetTest, BackgroundReadsLeaveSynchronousReserve) {
+    // 10 nodes/s with 30% reserved: background may take 7, synchronous the rest
+    budget.configure(10, 0, 0.3);
+    EXPECT_TRUE(budget.isEnabled());
+
+    for (int i = 0; i < 7; ++i) {
+        EXPECT_TRUE(budget.tryAcquire(1, 1, ReadBudget::Priority::BACKGROUND)) << "background read " << i;
+    }
+    EXPECT_FALSE(budget.tryAcquire(1, 1, ReadBudget::Priority::BACKGROUND));
+    EXPECT_FALSE(budget.tryAcquire(1, 1, ReadBudget::Priority::RETRY));
+
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_TRUE(budget.tryAcquire(1, 1, ReadBudget::Priority::SYNCHRONOUS)) << "synchronous read " << i;
+    }
+    EXPECT_FALSE(budget.tryAcquire(1, 1, ReadBudget::Priority::SYNCHRONOUS));
+
+    auto stats = budget.getStats();
+    EXPECT_EQ(stats.grantedNodes, 10u);
+    EXPECT_EQ(stats.rejectedBackground, 1u);
+    EXPECT_EQ(stats.rejectedRetries, 1u);
+    EXPECT_EQ(stats.rejectedSynchronous, 1u);
+    EXPECT_GT(stats.nodeUtilization, 0.9);
+}
+
+TEST_F(ReadBudgetTest, RequestRateLimitsServiceCalls) {
+    budget.configure(0, 2, 0.0);
+
+    EXPECT_TRUE(budget.tryAcquire(100, 1, ReadBudget::Priority::SYNCHRONOUS));
+    EXPECT_TRUE(budget.tryAcquire(100, 1, ReadBudget::Priority::SYNCHRONOUS));
+    EXPECT_FALSE(budget.tryAcquire(1, 1, ReadBudget::Priority::SYNCHRONOUS));
+
+    auto stats = budget.getStats();
+    EXPECT_EQ(stats.grantedRequests, 2u);
+    EXPECT_EQ(stats.rejectedRequests, 1u);
+    EXPECT_DOUBLE_EQ(stats.nodeUtilization, 0.0);
+}
+
+TEST_F(ReadBudgetTest, OversizedReadAdmittedWhenBucketFull) {
+    budget.configure(10, 0, 0.0);
+
+    // Larger than the bucket: admitted once, then the debt blocks further reads
+    EXPECT_TRUE(budget.tryAcquire(50, 1, ReadBudget::Priority::SYNCHRONOUS));
+    EXPECT_FALSE(budget.tryAcquire(1, 1, ReadBudget::Priority::SYNCHRONOUS));
+}
+
+TEST_F(ReadBudgetTest, RefillsOverTime) {
+    budget.configure(100, 0, 0.0);
+
+    EXPECT_TRUE(budget.tryAcquire(100, 1, ReadBudget::Priority::SYNCHRONOUS));
+    EXPECT_FALSE(budget.tryAcquire(5, 1, ReadBudget::Priority::SYNCHRONOUS));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_TRUE(budget.tryAcquire(5, 1, ReadBudget::Priority::SYNCHRONOUS));
+}
+
+TEST_F(ReadBudgetTest, ExhaustedErrorRecognized) {
+    EXPECT_TRUE(ReadBudget::isExhaustedError(ReadBudget::EXHAUSTED_ERROR));
+    EXPECT_FALSE(ReadBudget::isExhaustedError("Client not connected"));
+
+    budget.configure(1, 0, 0.0);
+    EXPECT_TRUE(budget.tryAcquire(1, 1, ReadBudget::Priority::SYNCHRONOUS));
+    EXPECT_FALSE(budget.tryAcquire(1, 1, ReadBudget::Priority::SYNCHRONOUS));
+
+    budget.clearStats();
+    auto stats = budget.getStats();
+    EXPECT_EQ(stats.grantedRequests, 0u);
+    EXPECT_EQ(stats.rejectedRequests, 0u);
+}
@@ -8,6 +8,7 @@
 #include <spdlog/sinks/stdout_color_sinks.h>
 
 #include "core/ReadStrategy.h"
+#include "core/AllocationTracker.h"
 #include "core/IBackgroundUpdater.h"
 #include "cache/CacheManager.h"
 #include "opcua/OPCUAClient.h"
@@ -299,6 +300,26 @@ TEST_F(ReadStrategyTest, BatchProcessingFreshNodesOnly) {
     EXPECT_EQ(results[1].value, "200");
 }
 
+TEST_F(ReadStrategyTest, GroupRequestReturnsMembersInGroupOrder) {
+    cacheManager_->updateCache("ns=2;s=Node1", "100", "Good", "Success", 1000);
+    cacheManager_->updateCache("ns=2;s=Node2", "200", "Good", "Success", 2000);
+    cacheManager_->updateCache("ns=2;s=Node3", "300", "Good", "Success", 3000);
+
+    TagGroup group("line1", {"ns=2;s=Node3", "ns=2;s=Node1", "ns=2;s=Node2"}, nullptr);
+    auto results = readStrategy_->processGroupRequest(group);
+    ASSERT_EQ(results.size(), 3);
+
+    EXPECT_EQ(results[0].id, "ns=2;s=Node3");
+    EXPECT_EQ(results[0].value, "300");
+    EXPECT_EQ(results[1].id, "ns=2;s=Node1");
+    EXPECT_EQ(results[1].value, "100");
+    EXPECT_EQ(results[2].id, "ns=2;s=Node2");
+    EXPECT_EQ(results[2].value, "200");
+    for (const auto& result : results) {
+        EXPECT_TRUE(result.success);
+    }
+}
+
 TEST_F(ReadStrategyTest, BatchProcessingStaleNodesWithBackgroundUpdate) {
     // Add stale cache entries
     auto staleEntry1 = CacheManager::CacheEntry{};
@@ -509,3 +530,88 @@ TEST_F(ReadStrategyTest, ConcurrencyControlBatchRequests) {
         EXPECT_EQ(allResults[i].size(), 5);
     }
 }
+
+TEST_F(ReadStrategyTest, PathLatencyHistograms) {
+    CacheMetrics metrics(cacheManager_.get());
+    readStrategy_->setCacheMetrics(&metrics);
+
+    cacheManager_->updateCache("ns=2;s=Fresh", "100", "Good", "Success", 1000);
+    readStrategy_->processNodeRequest("ns=2;s=Fresh");
+    readStrategy_->processNodeRequests({"ns=2;s=Fresh", "ns=2;s=Missing1", "ns=2;s=Missing2"});
+
+    // One sample per request and path; the unconnected client turns both misses into errors
+    EXPECT_EQ(metrics.getPathLatency(CacheMetrics::ReadPath::FRESH).count, 2u);
+    EXPECT_EQ(metrics.getPathLatency(CacheMetrics::ReadPath::MISS).count, 1u);
+    EXPECT_EQ(metrics.getPathLatency(CacheMetrics::ReadPath::EXPIRED).count, 0u);
+    EXPECT_EQ(metrics.getPathLatency(CacheMetrics::ReadPath::FALLBACK).count, 0u);
+
+    auto latency = metrics.getLatencyJSON();
+    EXPECT_EQ(latency["fresh"]["count"], 2);
+    EXPECT_TRUE(latency["miss"].contains("p99_ms"));
+
+    readStrategy_->setCacheMetrics(nullptr);
+}
+
+TEST_F(ReadStrategyTest, RequestTimingCountsNodesPerPath) {
+    cacheManager_->updateCache("ns=2;s=Fresh", "100", "Good", "Success", 1000);
+
+    RequestTiming timing;
+    {
+        RequestTiming::Scope scope(&timing);
+        readStrategy_->processNodeRequests({"ns=2;s=Fresh", "ns=2;s=Missing1", "ns=2;s=Missing2"});
+    }
+
+    EXPECT_EQ(timing.nodes().fresh, 1u);
+    EXPECT_EQ(timing.nodes().stale, 0u);
+    EXPECT_EQ(timing.nodes().miss, 2u);
+    EXPECT_EQ(timing.nodes().expired, 0u);
+    EXPECT_EQ(timing.nodes().fallback, 0u);
+    EXPECT_GT(timing.getStage(RequestTiming::Stage::CACHE).count(), 0);
+
+    // Without a current timing nothing is recorded
+    readStrategy_->processNodeRequests({"ns=2;s=Fresh"});
+    EXPECT_EQ(timing.nodes().fresh, 1u);
+}
+
+TEST_F(ReadStrategyTest, FreshHitAllocationBudget) {
+    ASSERT_TRUE(AllocationTracker::isEnabled());
+
+    // Budgets for an all-fresh batch; about 5 allocations per node today (node ID
+    // and value copies through the plan, the cache lookups and the results).
+    // Lower these when the path gets cheaper; raising them needs a reason.
+    constexpr uint64_t ALLOCATIONS_PER_NODE = 8;
+    constexpr uint64_t ALLOCATIONS_PER_REQUEST = 16;
+
+    // Log formatting allocates and is not part of the budget; the level is
+    // restored however the test exits, so later tests log as before
+    struct LogLevelGuard {
+        spdlog::level::level_enum saved = spdlog::default_logger()->level();
+        ~LogLevelGuard() { spdlog::default_logger()->set_level(saved); }
+    } logLevelGuard;
+    spdlog::default_logger()->set_level(spdlog::level::warn);
+
+    for (size_t count : {1, 100}) {
+        std::vector<std::string> nodeIds;
+        for (size_t i = 0; i < count; ++i) {
+            nodeIds.push_back("ns=2;s=Budget.Node" + std::to_string(i));
+            cacheManager_->updateCache(nodeIds.back(), "21.5", "Good", "Success", 1000);
+        }
+        readStrategy_->processNodeRequests(nodeIds);
+
+        RequestTiming timing;
+        auto before = AllocationTracker::thread();
+        {
+            RequestTiming::Scope scope(&timing);
+            auto results = readStrategy_->processNodeRequests(nodeIds);
+            ASSERT_EQ(results.size(), count);
+        }
+        auto used = AllocationTracker::thread() - before;
+
+        EXPECT_LE(used.allocations, ALLOCATIONS_PER_NODE * count + ALLOCATIONS_PER_REQUEST)
+            << count << " fresh nodes";
+        EXPECT_EQ(timing.nodes().fresh, count);
+        EXPECT_GT(timing.getAllocations(RequestTiming::Stage::CACHE).allocations, 0u);
+        EXPECT_LE(timing.getAllocations(RequestTiming::Stage::CACHE).allocations, used.allocations);
+        EXPECT_EQ(timing.getAllocations(RequestTiming::Stage::OPC).allocations, 0u);
+    }
+}
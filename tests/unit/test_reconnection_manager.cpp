@@ -530,5 +530,35 @@ TEST_F(ReconnectionManagerTest, TimeUntilNextAttempt) {
     reconnectionManager_->stopMonitoring();
 }
 
+// Test that a drop reported by the client wakes the monitor immediately
+TEST_F(ReconnectionManagerTest, EventDrivenReconnection) {
+    EXPECT_TRUE(reconnectionManager_->startMonitoring());
+
+    // Let the monitor settle into its connected wait
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    // The drop is reported through the client's state callback, so the monitor
+    // must not sit out its 1 second connected poll interval
+    auto dropTime = std::chrono::steady_clock::now();
+    opcClient_->disconnect();
+
+    while (reconnectionManager_->getStats().successfulReconnections == 0 &&
+           std::chrono::steady_clock::now() - dropTime < std::chrono::seconds(5)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    auto stats = reconnectionManager_->getStats();
+    EXPECT_EQ(stats.successfulReconnections, 1);
+    EXPECT_TRUE(opcClient_->isConnected());
+    EXPECT_LT(stats.lastReconnectLatency, std::chrono::milliseconds(900));
+    EXPECT_EQ(stats.maxReconnectLatency, stats.lastReconnectLatency);
+    EXPECT_EQ(stats.averageReconnectLatency, stats.lastReconnectLatency);
+
+    // Stopping is not delayed by the monitor's wait
+    auto stopStart = std::chrono::steady_clock::now();
+    reconnectionManager_->stopMonitoring();
+    EXPECT_LT(std::chrono::steady_clock::now() - stopStart, std::chrono::milliseconds(500));
+}
+
 } // namespace test
 } // namespace opcua2http
\ No newline at end of file
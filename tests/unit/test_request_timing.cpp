@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "core/RequestTiming.h"
+
+using namespace opcua2http;
+using namespace std::chrono_literals;
+
+TEST(RequestTimingTest, StageTimersAddToCurrentTiming) {
+    RequestTiming timing;
+    {
+        RequestTiming::Scope scope(&timing);
+        EXPECT_EQ(RequestTiming::current(), &timing);
+
+        {
+            RequestTiming::StageTimer timer(RequestTiming::Stage::PARSE);
+            std::this_thread::sleep_for(2ms);
+        }
+        {
+            RequestTiming::StageTimer timer(RequestTiming::Stage::PARSE);
+            std::this_thread::sleep_for(2ms);
+        }
+        RequestTiming::countOpcRequest();
+    }
+
+    EXPECT_EQ(RequestTiming::current(), nullptr);
+    EXPECT_GE(timing.getStage(RequestTiming::Stage::PARSE), 4ms);
+    EXPECT_EQ(timing.getStage(RequestTiming::Stage::OPC).count(), 0);
+    EXPECT_EQ(timing.getOpcRequests(), 1u);
+    EXPECT_GE(timing.getElapsed(), timing.getStage(RequestTiming::Stage::PARSE));
+}
+
+TEST(RequestTimingTest, TimersOutsideAScopeDoNothing) {
+    RequestTiming timing;
+    {
+        RequestTiming::StageTimer timer(RequestTiming::Stage::OPC);
+        RequestTiming::countOpcRequest();
+    }
+    EXPECT_EQ(timing.getStage(RequestTiming::Stage::OPC).count(), 0);
+    EXPECT_EQ(timing.getOpcRequests(), 0u);
+}
+
+TEST(RequestTimingTest, ScopesNestAndRestore) {
+    RequestTiming outer;
+    RequestTiming inner;
+
+    RequestTiming::Scope outerScope(&outer);
+    {
+        RequestTiming::Scope innerScope(&inner);
+        RequestTiming::countOpcRequest();
+    }
+    RequestTiming::countOpcRequest();
+    RequestTiming::countOpcRequest();
+
+    EXPECT_EQ(inner.getOpcRequests(), 1u);
+    EXPECT_EQ(outer.getOpcRequests(), 2u);
+}
+
+TEST(RequestTimingTest, TimingIsPerThread) {
+    RequestTiming timing;
+    RequestTiming::Scope scope(&timing);
+
+    std::thread other([]() {
+        EXPECT_EQ(RequestTiming::current(), nullptr);
+        RequestTiming::countOpcRequest();
+    });
+    other.join();
+
+    EXPECT_EQ(timing.getOpcRequests(), 0u);
+}
+
+TEST(RequestTimingTest, FormatsServerTimingHeader) {
+    RequestTiming timing;
+    timing.add(RequestTiming::Stage::AUTH, 4us);
+    timing.add(RequestTiming::Stage::OPC, 12310us);
+    timing.nodes().fresh = 3;
+    timing.nodes().miss = 1;
+    {
+        RequestTiming::Scope scope(&timing);
+        RequestTiming::countOpcRequest();
+    }
+
+    std::string header = timing.toServerTimingHeader();
+    EXPECT_EQ(header.rfind("auth;dur=0.004, opc;dur=12.310;desc=\"1 request\", total;dur=", 0), 0u) << header;
+    EXPECT_EQ(header.find("parse"), std::string::npos) << header;
+    EXPECT_NE(header.find("nodes;desc=\"fresh=3 stale=0 expired=0 miss=1 fallback=0\""), std::string::npos)
+        << header;
+}
+
+TEST(RequestTimingTest, FormatsDebugJSON) {
+    RequestTiming timing;
+    timing.add(RequestTiming::Stage::SERIALIZE, 1500us);
+    timing.nodes().stale = 2;
+
+    auto json = timing.toJSON();
+    EXPECT_DOUBLE_EQ(json["stages"]["serialize_ms"].get<double>(), 1.5);
+    EXPECT_DOUBLE_EQ(json["stages"]["auth_ms"].get<double>(), 0.0);
+    EXPECT_EQ(json["nodes"]["stale"], 2);
+    EXPECT_EQ(json["opc_requests"], 0);
+    EXPECT_TRUE(json.contains("total_ms"));
+}
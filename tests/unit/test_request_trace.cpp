@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "http/RequestTrace.h"
+
+using namespace opcua2http;
+
+class RequestTraceTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        const auto* info = ::testing::UnitTest::GetInstance()->current_test_info();
+        path_ = (std::filesystem::temp_directory_path() /
+                 (std::string("opcua2http_trace_") + info->name() + ".bin")).string();
+        std::filesystem::remove(path_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove(path_);
+    }
+
+    std::vector<RequestTraceRecord> readAll() {
+        std::vector<RequestTraceRecord> records;
+        std::string error;
+        EXPECT_TRUE(RequestTraceReader::readAll(path_, records, error)) << error;
+        return records;
+    }
+
+    std::string path_;
+};
+
+TEST_F(RequestTraceTest, RecordsAndReadsBackRequests) {
+    {
+        RequestTraceRecorder recorder(path_, 1024 * 1024);
+        ASSERT_TRUE(recorder.start());
+        recorder.record(1000, "10.0.0.1", {"ns=2;s=Line1.Speed", "ns=2;i=1001"});
+        recorder.record(2500, "10.0.0.2", {"ns=3;s=Tank.Level"});
+        recorder.stop();
+
+        auto stats = recorder.getStats();
+        EXPECT_EQ(stats.recorded, 2u);
+        EXPECT_EQ(stats.dropped, 0u);
+        EXPECT_GT(stats.bytesWritten, 0u);
+    }
+
+    auto records = readAll();
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_EQ(records[0].timestampUs, 1000u);
+    EXPECT_EQ(records[0].client, "10.0.0.1");
+    EXPECT_EQ(records[0].nodeIds, (std::vector<std::string>{"ns=2;s=Line1.Speed", "ns=2;i=1001"}));
+    EXPECT_EQ(records[1].timestampUs, 2500u);
+    EXPECT_EQ(records[1].client, "10.0.0.2");
+    EXPECT_EQ(records[1].nodeIds, (std::vector<std::string>{"ns=3;s=Tank.Level"}));
+}
+
+TEST_F(RequestTraceTest, AppendsToExistingTrace) {
+    for (uint64_t run = 0; run < 2; ++run) {
+        RequestTraceRecorder recorder(path_, 1024 * 1024);
+        ASSERT_TRUE(recorder.start());
+        recorder.record(run, "client", {"ns=2;i=" + std::to_string(run)});
+    }
+
+    auto records = readAll();
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_EQ(records[0].nodeIds[0], "ns=2;i=0");
+    EXPECT_EQ(records[1].nodeIds[0], "ns=2;i=1");
+}
+
+TEST_F(RequestTraceTest, RefusesToAppendToOtherFiles) {
+    {
+        std::ofstream other(path_);
+        other << "not a request trace";
+    }
+
+    RequestTraceRecorder recorder(path_, 1024 * 1024);
+    EXPECT_FALSE(recorder.start());
+
+    RequestTraceReader reader;
+    EXPECT_FALSE(reader.open(path_));
+    EXPECT_FALSE(reader.getError().empty());
+}
+
+TEST_F(RequestTraceTest, StopsAtTruncatedRecord) {
+    {
+        RequestTraceRecorder recorder(path_, 1024 * 1024);
+        ASSERT_TRUE(recorder.start());
+        recorder.record(1, "client", {"ns=2;i=1"});
+        recorder.record(2, "client", {"ns=2;i=2"});
+    }
+
+    // Cut the last record short, as a crash in the middle of a write would
+    auto size = std::filesystem::file_size(path_);
+    std::filesystem::resize_file(path_, size - 3);
+
+    RequestTraceReader reader;
+    ASSERT_TRUE(reader.open(path_));
+    RequestTraceRecord record;
+    ASSERT_TRUE(reader.next(record));
+    EXPECT_EQ(record.timestampUs, 1u);
+    EXPECT_FALSE(reader.next(record));
+    EXPECT_TRUE(reader.isTruncated());
+}
+
+TEST_F(RequestTraceTest, DropsRecordsWhenBufferIsFull) {
+    RequestTraceRecorder recorder(path_, 64);
+    ASSERT_TRUE(recorder.start());
+
+    // The writer flushes every FLUSH_INTERVAL, so a burst overflows a tiny buffer
+    std::vector<std::string> nodeIds{"ns=2;s=A.Rather.Long.Node.Identifier"};
+    for (int i = 0; i < 100; ++i) {
+        recorder.record(static_cast<uint64_t>(i), "client", nodeIds);
+    }
+    recorder.stop();
+
+    auto stats = recorder.getStats();
+    EXPECT_GT(stats.dropped, 0u);
+    EXPECT_EQ(stats.recorded + stats.dropped, 100u);
+    EXPECT_EQ(readAll().size(), stats.recorded);
+}
+
+TEST_F(RequestTraceTest, IgnoresRecordsWhenNotRunning) {
+    RequestTraceRecorder recorder(path_, 1024 * 1024);
+    recorder.record(1, "client", {"ns=2;i=1"});
+    EXPECT_EQ(recorder.getStats().recorded, 0u);
+    EXPECT_FALSE(std::filesystem::exists(path_));
+}
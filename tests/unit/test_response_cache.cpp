@@ -0,0 +1,212 @@
+#include <gtest/gtest.h>
+#include "http/ResponseCache.h"
+#include "cache/CacheManager.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace opcua2http;
+
+class ResponseCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        cacheManager.updateCache("ns=2;s=A", "1", "Good", "Good", 1000);
+        cacheManager.updateCache("ns=2;s=B", "2", "Good", "Good", 1000);
+    }
+
+    // Stands in for the read path: serves the IDs from the cache, as fresh hits do
+    ResponseCache::Builder builderFor(const std::vector<std::string>& nodeIds) {
+        return [this, nodeIds]() {
+            builds++;
+            auto response = std::make_shared<ResponseCache::Response>();
+            for (const auto& nodeId : nodeIds) {
+                auto entry = cacheManager.getCachedValue(nodeId);
+                response->body += entry ? entry->value : "-";
+                response->nodeIds.push_back(nodeId);
+                response->versions.push_back(entry ? entry->json : nullptr);
+            }
+            return std::shared_ptr<const ResponseCache::Response>(response);
+        };
+    }
+
+    CacheManager cacheManager{60, 100};
+    ResponseCache responseCache{&cacheManager, 8};
+    std::atomic<int> builds{0};
+};
+
+TEST_F(ResponseCacheTest, ReusesBodyWhileEntriesUnchanged) {
+    std::vector<std::string> ids = {"ns=2;s=A", "ns=2;s=B"};
+
+    auto firstSource = ResponseCache::Source::STORED;
+    auto secondSource = ResponseCache::Source::BUILT;
+    auto first = responseCache.getOrBuild(ids, builderFor(ids), &firstSource);
+    auto second = responseCache.getOrBuild(ids, builderFor(ids), &secondSource);
+
+    EXPECT_EQ(firstSource, ResponseCache::Source::BUILT);
+    EXPECT_EQ(secondSource, ResponseCache::Source::STORED);
+    EXPECT_EQ(first->body, "12");
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(builds, 1);
+
+    auto stats = responseCache.getStats();
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.builds, 1u);
+    EXPECT_EQ(stats.entries, 1u);
+}
+
+TEST_F(ResponseCacheTest, RebuildsAfterAnEntryChanges) {
+    std::vector<std::string> ids = {"ns=2;s=A", "ns=2;s=B"};
+    responseCache.getOrBuild(ids, builderFor(ids));
+
+    // Any write replaces the entry version
+    cacheManager.updateCache("ns=2;s=B", "3", "Good", "Good", 2000);
+
+    auto rebuilt = responseCache.getOrBuild(ids, builderFor(ids));
+    EXPECT_EQ(rebuilt->body, "13");
+    EXPECT_EQ(builds, 2);
+    EXPECT_EQ(responseCache.getStats().invalidated, 1u);
+}
+
+TEST_F(ResponseCacheTest, RebuildsOnceEntriesAreNoLongerFresh) {
+    CacheManager timedCache(60, 100, 1, 10);
+    ResponseCache timedResponses(&timedCache, 8);
+    timedCache.updateCache("ns=2;s=A", "1", "Good", "Good", 1000);
+
+    std::vector<std::string> ids = {"ns=2;s=A"};
+    int timedBuilds = 0;
+    auto build = [&]() {
+        timedBuilds++;
+        auto response = std::make_shared<ResponseCache::Response>();
+        response->nodeIds = ids;
+        response->versions.push_back(timedCache.getCachedValue("ns=2;s=A")->json);
+        return std::shared_ptr<const ResponseCache::Response>(response);
+    };
+
+    timedResponses.getOrBuild(ids, build);
+    timedResponses.getOrBuild(ids, build);
+    EXPECT_EQ(timedBuilds, 1);
+
+    // STALE entries go back through the read path so it can schedule refreshes
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    timedResponses.getOrBuild(ids, build);
+    EXPECT_EQ(timedBuilds, 2);
+}
+
+TEST_F(ResponseCacheTest, KeepsOnlyBodiesServedFromTheCache) {
+    std::vector<std::string> ids = {"ns=2;s=A", "ns=2;s=Missing"};
+
+    responseCache.getOrBuild(ids, builderFor(ids));
+    responseCache.getOrBuild(ids, builderFor(ids));
+
+    EXPECT_EQ(builds, 2);
+    EXPECT_EQ(responseCache.getStats().entries, 0u);
+}
+
+TEST_F(ResponseCacheTest, ConcurrentRequestsShareOneBuild) {
+    std::vector<std::string> ids = {"ns=2;s=A", "ns=2;s=B"};
+    std::atomic<bool> release{false};
+    auto slowBuild = [&, build = builderFor(ids)]() {
+        while (!release) {
+            std::this_thread::yield();
+        }
+        return build();
+    };
+
+    std::vector<std::thread> threads;
+    std::vector<std::shared_ptr<const ResponseCache::Response>> responses(8);
+    std::vector<ResponseCache::Source> sources(responses.size());
+    for (size_t i = 0; i < responses.size(); ++i) {
+        threads.emplace_back([&, i]() {
+            responses[i] = responseCache.getOrBuild(ids, slowBuild, &sources[i]);
+        });
+    }
+
+    // Let every request reach the cache before the build completes
+    while (responseCache.getStats().sharedBuilds < responses.size() - 1) {
+        std::this_thread::yield();
+    }
+    release = true;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(builds, 1);
+    for (const auto& response : responses) {
+        EXPECT_EQ(response, responses[0]);
+    }
+
+    // Waiters are told apart from the build, which their metrics must replay
+    EXPECT_EQ(std::count(sources.begin(), sources.end(), ResponseCache::Source::BUILT), 1);
+    EXPECT_EQ(std::count(sources.begin(), sources.end(), ResponseCache::Source::SHARED),
+              static_cast<std::ptrdiff_t>(responses.size() - 1));
+}
+
+TEST_F(ResponseCacheTest, BuildErrorsReachWaitingRequests) {
+    std::vector<std::string> ids = {"ns=2;s=A"};
+    std::atomic<bool> release{false};
+    auto failing = [&]() -> std::shared_ptr<const ResponseCache::Response> {
+        while (!release) {
+            std::this_thread::yield();
+        }
+        throw std::runtime_error("OPC connection lost");
+    };
+
+    std::atomic<int> errors{0};
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 2; ++i) {
+        threads.emplace_back([&]() {
+            try {
+                responseCache.getOrBuild(ids, failing);
+            } catch (const std::runtime_error&) {
+                errors++;
+            }
+        });
+    }
+    while (responseCache.getStats().sharedBuilds < 1) {
+        std::this_thread::yield();
+    }
+    release = true;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(errors, 2);
+
+    // The failed build leaves nothing behind
+    EXPECT_EQ(responseCache.getStats().entries, 0u);
+    auto response = responseCache.getOrBuild(ids, builderFor(ids));
+    EXPECT_EQ(response->body, "1");
+}
+
+TEST_F(ResponseCacheTest, KeepsAtMostMaxEntries) {
+    for (int i = 0; i < 20; ++i) {
+        std::string nodeId = "ns=2;s=N" + std::to_string(i);
+        cacheManager.updateCache(nodeId, std::to_string(i), "Good", "Good", 1000);
+        std::vector<std::string> ids = {nodeId};
+        responseCache.getOrBuild(ids, builderFor(ids));
+    }
+
+    auto stats = responseCache.getStats();
+    EXPECT_EQ(stats.entries, 8u);
+    EXPECT_EQ(stats.evictions, 12u);
+}
+
+TEST_F(ResponseCacheTest, DisabledCacheAlwaysBuilds) {
+    ResponseCache disabled(&cacheManager, 0);
+    std::vector<std::string> ids = {"ns=2;s=A"};
+
+    disabled.getOrBuild(ids, builderFor(ids));
+    disabled.getOrBuild(ids, builderFor(ids));
+
+    EXPECT_FALSE(disabled.isEnabled());
+    EXPECT_EQ(builds, 2);
+    EXPECT_EQ(disabled.getStats().entries, 0u);
+}
+
+TEST_F(ResponseCacheTest, KeysKeepRequestOrder) {
+    EXPECT_EQ(ResponseCache::makeKey({"ns=2;s=A", "ns=2;s=B"}), "ns=2;s=A,ns=2;s=B");
+    EXPECT_NE(ResponseCache::makeKey({"ns=2;s=A", "ns=2;s=B"}),
+              ResponseCache::makeKey({"ns=2;s=B", "ns=2;s=A"}));
+}
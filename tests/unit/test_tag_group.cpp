@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include "core/TagGroup.h"
+#include "config/Configuration.h"
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace opcua2http;
+
+class TagGroupRegistryTest : public ::testing::Test {
+protected:
+    // No client: groups are defined without a prepared read
+    TagGroupRegistry registry{nullptr, 3, 4};
+};
+
+TEST_F(TagGroupRegistryTest, DefineAndFind) {
+    auto group = registry.define("line1", {"ns=2;s=A", "ns=2;s=B"});
+    ASSERT_NE(group, nullptr);
+    EXPECT_EQ(group->getName(), "line1");
+    EXPECT_EQ(group->getNodeIds(), (std::vector<std::string>{"ns=2;s=A", "ns=2;s=B"}));
+    EXPECT_EQ(group->getPreparedRead(), nullptr);
+
+    EXPECT_EQ(registry.find("line1"), group);
+    EXPECT_EQ(registry.find("line2"), nullptr);
+    EXPECT_EQ(registry.size(), 1u);
+}
+
+TEST_F(TagGroupRegistryTest, RedefiningReplacesTheGroup) {
+    auto first = registry.define("line1", {"ns=2;s=A"});
+    auto second = registry.define("line1", {"ns=2;s=B", "ns=2;s=C"});
+
+    EXPECT_EQ(registry.size(), 1u);
+    EXPECT_EQ(registry.find("line1"), second);
+
+    // Readers holding the old group keep a complete one
+    EXPECT_EQ(first->getNodeIds(), std::vector<std::string>{"ns=2;s=A"});
+}
+
+TEST_F(TagGroupRegistryTest, RemovedGroupOutlivesItsReaders) {
+    auto group = registry.define("line1", {"ns=2;s=A"});
+
+    EXPECT_TRUE(registry.remove("line1"));
+    EXPECT_FALSE(registry.remove("line1"));
+    EXPECT_EQ(registry.find("line1"), nullptr);
+    EXPECT_EQ(group->getName(), "line1");
+}
+
+TEST_F(TagGroupRegistryTest, RejectsInvalidDefinitions) {
+    EXPECT_THROW(registry.define("", {"ns=2;s=A"}), std::invalid_argument);
+    EXPECT_THROW(registry.define("line/1", {"ns=2;s=A"}), std::invalid_argument);
+    EXPECT_THROW(registry.define(std::string(TagGroupRegistry::MAX_NAME_LENGTH + 1, 'a'), {"ns=2;s=A"}),
+                 std::invalid_argument);
+    EXPECT_THROW(registry.define("line1", {}), std::invalid_argument);
+    EXPECT_THROW(registry.define("line1", {"ns=2;s=A", "ns=2;s=A"}), std::invalid_argument);
+    EXPECT_THROW(registry.define("line1", {"ns=2;s=A", "ns=2;s=B", "ns=2;s=C", "ns=2;s=D", "ns=2;s=E"}),
+                 std::invalid_argument);
+    EXPECT_EQ(registry.size(), 0u);
+}
+
+TEST_F(TagGroupRegistryTest, GroupCountIsBounded) {
+    registry.define("a", {"ns=2;s=A"});
+    registry.define("b", {"ns=2;s=A"});
+    registry.define("c", {"ns=2;s=A"});
+
+    EXPECT_THROW(registry.define("d", {"ns=2;s=A"}), std::invalid_argument);
+
+    // Replacing an existing group does not need room
+    EXPECT_NO_THROW(registry.define("b", {"ns=2;s=B"}));
+    EXPECT_EQ(registry.size(), 3u);
+}
+
+TEST_F(TagGroupRegistryTest, ListIsOrderedByName) {
+    registry.define("zeta", {"ns=2;s=A"});
+    registry.define("alpha", {"ns=2;s=A"});
+    registry.define("mid", {"ns=2;s=A"});
+
+    auto groups = registry.list();
+    ASSERT_EQ(groups.size(), 3u);
+    EXPECT_EQ(groups[0]->getName(), "alpha");
+    EXPECT_EQ(groups[1]->getName(), "mid");
+    EXPECT_EQ(groups[2]->getName(), "zeta");
+}
+
+TEST_F(TagGroupRegistryTest, ConcurrentReadersSeeWholeGroups) {
+    registry.define("line1", {"ns=2;s=A"});
+
+    std::thread writer([this]() {
+        for (int i = 0; i < 1000; ++i) {
+            registry.define("line1", i % 2 ? std::vector<std::string>{"ns=2;s=A"}
+                                           : std::vector<std::string>{"ns=2;s=B", "ns=2;s=C"});
+        }
+    });
+    for (int i = 0; i < 1000; ++i) {
+        auto group = registry.find("line1");
+        ASSERT_NE(group, nullptr);
+        EXPECT_TRUE(group->size() == 1 || group->size() == 2);
+    }
+    writer.join();
+}
+
+TEST(TagGroupConfigTest, ParsesTagGroups) {
+    auto groups = Configuration::parseTagGroups(
+        "line1: ns=2;s=A, ns=2;s=B | line2:ns=2;i=7|malformed||");
+
+    ASSERT_EQ(groups.size(), 2u);
+    EXPECT_EQ(groups["line1"], (std::vector<std::string>{"ns=2;s=A", "ns=2;s=B"}));
+    EXPECT_EQ(groups["line2"], std::vector<std::string>{"ns=2;i=7"});
+    EXPECT_TRUE(Configuration::parseTagGroups("").empty());
+}
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <stdexcept>
+
+#include "core/TimerService.h"
+
+using namespace opcua2http;
+using namespace std::chrono_literals;
+
+class TimerServiceTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        timer_.stop();
+    }
+
+    const TimerService::TaskStats* findTask(const std::vector<TimerService::TaskStats>& stats,
+                                            const std::string& name) {
+        for (const auto& task : stats) {
+            if (task.name == name) {
+                return &task;
+            }
+        }
+        return nullptr;
+    }
+
+    TimerService timer_;
+};
+
+TEST_F(TimerServiceTest, RunsPeriodicTask) {
+    std::atomic<int> runs{0};
+    auto id = timer_.schedulePeriodic("counter", 20ms, [&runs]() { runs++; });
+    ASSERT_NE(id, 0u);
+
+    ASSERT_TRUE(timer_.start());
+    EXPECT_FALSE(timer_.start());
+    std::this_thread::sleep_for(230ms);
+    timer_.stop();
+
+    // Roughly one run per 20 ms period; leave slack for slow CI machines
+    EXPECT_GE(runs.load(), 5);
+    EXPECT_LE(runs.load(), 12);
+
+    auto stats = timer_.getTaskStats();
+    ASSERT_EQ(stats.size(), 1u);
+    EXPECT_EQ(stats[0].runs, static_cast<uint64_t>(runs.load()));
+    EXPECT_EQ(stats[0].failures, 0u);
+}
+
+TEST_F(TimerServiceTest, RejectsInvalidTasks) {
+    EXPECT_EQ(timer_.schedulePeriodic("zero", 0ms, []() {}), 0u);
+    EXPECT_EQ(timer_.schedulePeriodic("empty", 10ms, nullptr), 0u);
+    EXPECT_EQ(timer_.getStats().tasks, 0u);
+}
+
+TEST_F(TimerServiceTest, CoalescesNearbyDeadlines) {
+    std::atomic<int> runs{0};
+    timer_.schedulePeriodic("a", 100ms, [&runs]() { runs++; });
+    timer_.schedulePeriodic("b", 105ms, [&runs]() { runs++; });
+
+    timer_.start();
+    std::this_thread::sleep_for(150ms);
+    timer_.stop();
+
+    // Both deadlines fall inside one coalescing window
+    EXPECT_EQ(runs.load(), 2);
+    auto stats = timer_.getStats();
+    EXPECT_EQ(stats.coalescedRuns, 1u);
+    EXPECT_EQ(stats.wakeups, 1u);
+}
+
+TEST_F(TimerServiceTest, NoWakeupsWhileNothingIsDue) {
+    timer_.schedulePeriodic("slow", 10s, []() {});
+    timer_.start();
+    std::this_thread::sleep_for(100ms);
+
+    auto stats = timer_.getStats();
+    EXPECT_EQ(stats.wakeups, 0u);
+    EXPECT_EQ(stats.idleWakeups, 0u);
+}
+
+TEST_F(TimerServiceTest, CountsOverrunsAndMissedPeriods) {
+    timer_.schedulePeriodic("slow", 20ms, []() {
+        std::this_thread::sleep_for(50ms);
+    }, true);
+
+    timer_.start();
+    std::this_thread::sleep_for(120ms);
+    timer_.stop();
+
+    auto stats = timer_.getTaskStats();
+    ASSERT_EQ(stats.size(), 1u);
+    EXPECT_GE(stats[0].runs, 1u);
+    EXPECT_EQ(stats[0].overruns, stats[0].runs);
+    EXPECT_GE(stats[0].missedPeriods, 1u);
+    EXPECT_GE(stats[0].maxRunTime, std::chrono::microseconds(50000));
+}
+
+TEST_F(TimerServiceTest, FailingTaskKeepsRunning) {
+    std::atomic<int> runs{0};
+    timer_.schedulePeriodic("throws", 20ms, [&runs]() {
+        runs++;
+        throw std::runtime_error("boom");
+    }, true);
+
+    timer_.start();
+    std::this_thread::sleep_for(100ms);
+    timer_.stop();
+
+    EXPECT_GE(runs.load(), 2);
+    auto stats = timer_.getTaskStats();
+    const auto* task = findTask(stats, "throws");
+    ASSERT_NE(task, nullptr);
+    EXPECT_EQ(task->failures, task->runs);
+}
+
+TEST_F(TimerServiceTest, CancelWaitsForRunningTask) {
+    std::atomic<bool> inTask{false};
+    std::atomic<bool> finished{false};
+    auto id = timer_.schedulePeriodic("long", 1s, [&]() {
+        inTask = true;
+        std::this_thread::sleep_for(100ms);
+        finished = true;
+    }, true);
+
+    timer_.start();
+    while (!inTask.load()) {
+        std::this_thread::sleep_for(1ms);
+    }
+
+    EXPECT_TRUE(timer_.cancel(id));
+    EXPECT_TRUE(finished.load()) << "cancel() must not return while the task runs";
+    EXPECT_FALSE(timer_.cancel(id));
+    EXPECT_EQ(timer_.getStats().tasks, 0u);
+}